@@ -232,6 +232,13 @@ void NetPlayUICallbacks::OnDesync(u32 frame, const std::string& player)
   });
 }
 
+void NetPlayUICallbacks::OnDesyncRegion(u32 frame, const std::string& player,
+                                        const std::string& region)
+{
+  AppendChat(
+      fmt::format("The state of {} at frame {} first differs in: {}", player, frame, region));
+}
+
 void NetPlayUICallbacks::OnConnectionLost()
 {
   WithSession([](JNIEnv* env, jobject session) {
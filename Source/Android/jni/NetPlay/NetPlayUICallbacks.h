@@ -42,6 +42,7 @@ public:
   void OnPadBufferChanged(u32 buffer) override;
   void OnHostInputAuthorityChanged(bool enabled) override;
   void OnDesync(u32 frame, const std::string& player) override;
+  void OnDesyncRegion(u32 frame, const std::string& player, const std::string& region) override;
   void OnConnectionLost() override;
   void OnConnectionError(const std::string& message) override;
   void OnTraversalError(Common::TraversalClient::FailureReason error) override;
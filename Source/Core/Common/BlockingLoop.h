@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
+#include <utility>
 
+#include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/Thread.h"
 
 namespace Common
 {
@@ -28,6 +33,18 @@ public:
     BlockAndGiveUp,
   };
 
+  using Clock = std::chrono::steady_clock;
+
+  struct Statistics
+  {
+    // How often the worker was woken up after going to sleep, and how often new work arrived
+    // while it was spinning instead.
+    u64 sleep_wakeups = 0;
+    u64 spin_wakeups = 0;
+    // Time spent spinning or sleeping while waiting for new work.
+    Clock::duration idle_time{};
+  };
+
   BlockingLoop() { m_stopped.Set(); }
   ~BlockingLoop() { Stop(StopMode::BlockAndGiveUp); }
   // Triggers to rerun the payload of the Run() function at least once again.
@@ -162,7 +179,18 @@ public:
       case STATE_DONE:
         // We're done now. So time to check if we want to sleep or if we want to stay in a busy
         // loop.
-        if (m_may_sleep.TestAndClear())
+        if (m_max_spin_time.load(std::memory_order_relaxed) > 0)
+        {
+          // In spinning mode, hints to sleep are ignored. We go to sleep once spinning fails.
+          m_may_sleep.Clear();
+          if (SpinForWakeup())
+            break;
+
+          // Try to set the sleeping state.
+          if (m_running_state-- != STATE_DONE)
+            break;
+        }
+        else if (m_may_sleep.TestAndClear())
         {
           // Try to set the sleeping state.
           if (m_running_state-- != STATE_DONE)
@@ -176,17 +204,24 @@ public:
         [[fallthrough]];
 
       case STATE_SLEEPING:
+      {
         // Just relax
+        const Clock::time_point sleep_start = Clock::now();
+        bool woken_up;
         if (timeout > 0)
         {
-          m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
+          woken_up = m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
         }
         else
         {
           m_new_work_event.Wait();
+          woken_up = true;
         }
+        m_statistics.idle_time += Clock::now() - sleep_start;
+        m_statistics.sleep_wakeups += woken_up;
         break;
       }
+      }
     }
 
     // Shutdown down, so get a safe state
@@ -232,7 +267,55 @@ public:
   // that we will fall back from the busy loop to sleeping.
   void AllowSleep() { m_may_sleep.Set(); }
 
+  // By default, the worker reruns the payload in a busy loop until AllowSleep() is called.
+  // With a non-zero max_spin_time, it instead waits for Wakeup() by spinning, and goes to sleep
+  // if no work arrives in time. The spin time is doubled up to max_spin_time whenever spinning
+  // caught a Wakeup() call, and halved down to min_spin_time whenever it was in vain. The minimum
+  // is at least 1us, as a spin time of zero could never grow again.
+  // This may be called from any thread.
+  void SetSpinTime(std::chrono::microseconds min_spin_time, std::chrono::microseconds max_spin_time)
+  {
+    min_spin_time = std::max(min_spin_time, std::chrono::microseconds(1));
+    m_min_spin_time.store(std::min(min_spin_time, max_spin_time).count());
+    m_max_spin_time.store(max_spin_time.count());
+  }
+
+  // Returns the statistics since the last call. Must only be called from within the payload.
+  Statistics TakeStatistics() { return std::exchange(m_statistics, {}); }
+
 private:
+  // Waits for the state to leave STATE_DONE, which means that Wakeup() was called, for up to the
+  // current spin time. Returns whether that happened.
+  bool SpinForWakeup()
+  {
+    const std::chrono::microseconds min_spin_time(m_min_spin_time.load(std::memory_order_relaxed));
+    const std::chrono::microseconds max_spin_time(m_max_spin_time.load(std::memory_order_relaxed));
+    m_spin_time = std::clamp(m_spin_time, min_spin_time, max_spin_time);
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline = start + m_spin_time;
+    while (true)
+    {
+      if (m_running_state.load(std::memory_order_relaxed) != STATE_DONE)
+      {
+        m_statistics.idle_time += Clock::now() - start;
+        m_statistics.spin_wakeups++;
+        m_spin_time = std::min(m_spin_time * 2, max_spin_time);
+        return true;
+      }
+
+      const Clock::time_point now = Clock::now();
+      if (now >= deadline || m_shutdown.IsSet())
+      {
+        m_statistics.idle_time += now - start;
+        m_spin_time = std::max(m_spin_time / 2, min_spin_time);
+        return false;
+      }
+
+      Common::YieldCPU();
+    }
+  }
+
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
 
@@ -253,5 +336,13 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  // In microseconds. Spinning is disabled if the maximum is zero.
+  std::atomic<s64> m_min_spin_time = 0;
+  std::atomic<s64> m_max_spin_time = 0;
+
+  // Only accessed by the worker thread.
+  std::chrono::microseconds m_spin_time{};
+  Statistics m_statistics;
 };
 }  // namespace Common
@@ -372,6 +372,18 @@ u64 GetSize(FILE* f)
   return size;
 }
 
+s64 GetLastWriteTime(const std::string& path)
+{
+#ifdef ANDROID
+  if (IsPathAndroidContent(path))
+    return 0;
+#endif
+
+  std::error_code error;
+  const fs::file_time_type time = fs::last_write_time(StringToPath(path), error);
+  return error ? 0 : time.time_since_epoch().count();
+}
+
 // creates an empty file filename, returns true on success
 bool CreateEmptyFile(const std::string& filename)
 {
@@ -904,6 +916,7 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERRING_IDX] = s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_RING;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
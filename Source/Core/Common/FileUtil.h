@@ -92,6 +92,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERRING_IDX,
   F_WIISDCARDIMAGE_IDX,
   F_WIISYSCONF_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
@@ -153,6 +154,10 @@ u64 GetSize(const std::string& path);
 // Overloaded GetSize, accepts FILE*
 u64 GetSize(FILE* f);
 
+// Returns the time of the last write to the path in an unspecified unit, or 0 if it's unknown.
+// Only meaningful when compared with another value returned by this function.
+s64 GetLastWriteTime(const std::string& path);
+
 // Creates a single directory. Returns true if successful or if the path already exists.
 bool CreateDir(const std::string& filename);
 
@@ -56,7 +56,7 @@ bool LoadPNG(std::span<const u8> input, Common::UniqueBuffer<u8>* data_out, u32*
 }
 
 bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
-             u32 height, u32 stride, int level)
+             u32 height, u32 stride, int level, bool fast_filtering)
 {
   Common::Timer timer;
   timer.Start();
@@ -86,6 +86,9 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   if (spng_set_option(ctx.get(), SPNG_IMG_COMPRESSION_LEVEL, level))
     return false;
 
+  if (fast_filtering && spng_set_option(ctx.get(), SPNG_FILTER_CHOICE, SPNG_FILTER_CHOICE_SUB))
+    return false;
+
   spng_ihdr ihdr{};
   ihdr.width = width;
   ihdr.height = height;
@@ -119,22 +122,26 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   return true;
 }
 
-static Common::UniqueBuffer<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
+void ConvertRGBAToRGB(u8* output, const u8* input, u32 width, u32 height, u32 stride)
 {
-  Common::UniqueBuffer<u8> buffer;
-  buffer.reset(width * height * 3);
-
   std::size_t buffer_index = 0;
   for (u32 y = 0; y < height; ++y)
   {
-    const u8* pos = input + y * row_stride;
+    const u8* pos = input + y * stride;
     for (u32 x = 0; x < width; ++x)
     {
-      buffer[buffer_index++] = pos[x * 4];
-      buffer[buffer_index++] = pos[x * 4 + 1];
-      buffer[buffer_index++] = pos[x * 4 + 2];
+      output[buffer_index++] = pos[x * 4];
+      output[buffer_index++] = pos[x * 4 + 1];
+      output[buffer_index++] = pos[x * 4 + 2];
     }
   }
+}
+
+static Common::UniqueBuffer<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
+{
+  Common::UniqueBuffer<u8> buffer;
+  buffer.reset(width * height * 3);
+  ConvertRGBAToRGB(buffer.data(), input, width, height, row_stride);
   return buffer;
 }
 
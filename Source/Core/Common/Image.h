@@ -20,8 +20,12 @@ enum class ImageByteFormat
   RGBA,
 };
 
+// fast_filtering only uses the Sub filter instead of picking the best filter for every row.
+// Together with a low level, this is several times faster, at the cost of a larger file.
 bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
-             u32 height, u32 stride, int level = 6);
+             u32 height, u32 stride, int level = 6, bool fast_filtering = false);
+// Drops the alpha channel. output must hold width * height * 3 bytes.
+void ConvertRGBAToRGB(u8* output, const u8* input, u32 width, u32 height, u32 stride);
 bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 width, u32 height,
                                 u32 stride, int level);
 }  // namespace Common
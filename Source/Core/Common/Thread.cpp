@@ -27,6 +27,7 @@
 #endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Tracing.h"
 #ifdef _WIN32
 #include "Common/StringUtil.h"
 #endif
@@ -115,6 +116,7 @@ void SetCurrentThreadName(const char* name)
 {
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
+  Tracing::SetCurrentThreadName(name);
 }
 
 #else  // !WIN32, so must be POSIX threads
@@ -168,6 +170,8 @@ void SwitchCurrentThread()
 
 void SetCurrentThreadName(const char* name)
 {
+  Tracing::SetCurrentThreadName(name);
+
 #ifdef __APPLE__
   pthread_setname_np(name);
 #elif defined __FreeBSD__ || defined __OpenBSD__
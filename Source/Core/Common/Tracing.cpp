@@ -0,0 +1,281 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Tracing.h"
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Tracing
+{
+std::atomic<bool> g_enabled = false;
+
+namespace
+{
+struct Span
+{
+  const char* category;
+  const char* name;
+  u64 start_ns;
+  u64 end_ns;
+};
+
+constexpr size_t SPANS_PER_CHUNK = 4096;
+// About 128 MiB of spans in total. Spans beyond that are dropped.
+constexpr size_t MAX_CHUNKS = 1024;
+
+struct Chunk
+{
+  std::array<Span, SPANS_PER_CHUNK> spans;
+};
+
+std::atomic<size_t> s_num_chunks = 0;
+
+// The spans of one thread. Only the thread itself appends to it, and only while `writing` is set.
+// Everything else happens while tracing is disabled and no thread is writing.
+struct ThreadBuffer
+{
+  void Append(const Span& span)
+  {
+    if (chunks.empty() || last_chunk_size == SPANS_PER_CHUNK)
+    {
+      if (s_num_chunks.fetch_add(1, std::memory_order_relaxed) >= MAX_CHUNKS)
+      {
+        s_num_chunks.fetch_sub(1, std::memory_order_relaxed);
+        ++dropped_spans;
+        return;
+      }
+      chunks.push_back(std::make_unique<Chunk>());
+      last_chunk_size = 0;
+    }
+    chunks.back()->spans[last_chunk_size++] = span;
+  }
+
+  void Clear()
+  {
+    s_num_chunks.fetch_sub(chunks.size(), std::memory_order_relaxed);
+    chunks.clear();
+    last_chunk_size = 0;
+    dropped_spans = 0;
+  }
+
+  std::atomic<bool> writing = false;
+  std::vector<std::unique_ptr<Chunk>> chunks;
+  size_t last_chunk_size = 0;
+  u64 dropped_spans = 0;
+
+  // Protected by s_mutex.
+  u32 thread_id = 0;
+  std::string thread_name;
+  bool thread_exited = false;
+};
+
+std::mutex s_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+u32 s_next_thread_id = 1;
+u64 s_start_ns = 0;
+
+// Buffers are only created once a thread records a span, so that threads don't need one if tracing
+// is never used. They outlive their threads, so that spans of threads that exited are still
+// written.
+struct ThreadBufferHandle
+{
+  ~ThreadBufferHandle()
+  {
+    if (!buffer)
+      return;
+    std::lock_guard lk(s_mutex);
+    // Only this thread appends to its buffer, so if it is empty there is nothing left to write.
+    if (buffer->chunks.empty() && buffer->dropped_spans == 0)
+      std::erase_if(s_buffers, [this](const auto& other) { return other.get() == buffer; });
+    else
+      buffer->thread_exited = true;
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  std::string thread_name;
+};
+
+thread_local ThreadBufferHandle s_thread_buffer;
+
+ThreadBuffer* GetCurrentThreadBuffer()
+{
+  if (s_thread_buffer.buffer) [[likely]]
+    return s_thread_buffer.buffer;
+
+  std::lock_guard lk(s_mutex);
+  auto& buffer = s_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+  buffer->thread_id = s_next_thread_id++;
+  buffer->thread_name = s_thread_buffer.thread_name;
+  s_thread_buffer.buffer = buffer.get();
+  return buffer.get();
+}
+
+void EraseBuffersOfExitedThreads()
+{
+  std::erase_if(s_buffers, [](const auto& buffer) { return buffer->thread_exited; });
+}
+
+// Disables tracing and waits until no thread is appending to its buffer anymore.
+void DisableAndWaitForWriters()
+{
+  g_enabled.store(false);
+
+  std::lock_guard lk(s_mutex);
+  for (const auto& buffer : s_buffers)
+  {
+    while (buffer->writing.load())
+      std::this_thread::yield();
+  }
+}
+
+void AppendEscaped(std::string* out, std::string_view str)
+{
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      out->push_back('\\');
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out->push_back(c);
+  }
+}
+
+// Timestamps in the Chrome trace event format are in microseconds.
+void AppendMicroseconds(std::string* out, u64 ns)
+{
+  fmt::format_to(std::back_inserter(*out), "{}.{:03}", ns / 1000, ns % 1000);
+}
+
+void AppendSpan(std::string* out, u32 thread_id, const Span& span)
+{
+  out->append(",\n{\"ph\":\"X\",\"pid\":1,\"tid\":");
+  fmt::format_to(std::back_inserter(*out), "{}", thread_id);
+  out->append(",\"cat\":\"");
+  AppendEscaped(out, span.category);
+  out->append("\",\"name\":\"");
+  AppendEscaped(out, span.name);
+  out->append("\",\"ts\":");
+  AppendMicroseconds(out, span.start_ns > s_start_ns ? span.start_ns - s_start_ns : 0);
+  out->append(",\"dur\":");
+  AppendMicroseconds(out, span.end_ns > span.start_ns ? span.end_ns - span.start_ns : 0);
+  out->push_back('}');
+}
+}  // namespace
+
+void Start()
+{
+  DisableAndWaitForWriters();
+
+  {
+    std::lock_guard lk(s_mutex);
+    EraseBuffersOfExitedThreads();
+    for (const auto& buffer : s_buffers)
+      buffer->Clear();
+    s_start_ns = GetTimestampNs();
+  }
+
+  g_enabled.store(true);
+}
+
+bool Stop(const std::string& path)
+{
+  DisableAndWaitForWriters();
+
+  std::lock_guard lk(s_mutex);
+
+  File::IOFile file(path, "wb");
+  bool success = file.IsOpen();
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                    "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+                    "\"args\":{\"name\":\"Dolphin\"}}";
+  u64 num_spans = 0;
+  u64 dropped_spans = 0;
+  for (const auto& buffer : s_buffers)
+  {
+    if (!buffer->thread_name.empty())
+    {
+      fmt::format_to(std::back_inserter(out),
+                     ",\n{{\"ph\":\"M\",\"pid\":1,\"tid\":{},\"name\":\"thread_name\","
+                     "\"args\":{{\"name\":\"",
+                     buffer->thread_id);
+      AppendEscaped(&out, buffer->thread_name);
+      out.append("\"}}");
+    }
+
+    for (size_t i = 0; i < buffer->chunks.size(); ++i)
+    {
+      const size_t size =
+          i + 1 == buffer->chunks.size() ? buffer->last_chunk_size : SPANS_PER_CHUNK;
+      for (size_t j = 0; j < size; ++j)
+        AppendSpan(&out, buffer->thread_id, buffer->chunks[i]->spans[j]);
+      num_spans += size;
+
+      if (out.size() >= 1024 * 1024)
+      {
+        success &= file.WriteString(out);
+        out.clear();
+      }
+    }
+
+    dropped_spans += buffer->dropped_spans;
+    buffer->Clear();
+  }
+  EraseBuffersOfExitedThreads();
+  out.append("\n]}\n");
+
+  if (dropped_spans != 0)
+    WARN_LOG_FMT(COMMON, "Trace buffers were full, {} spans were dropped", dropped_spans);
+
+  success &= file.WriteString(out);
+  if (!success || !file.Close())
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to write trace to {}", path);
+    return false;
+  }
+
+  INFO_LOG_FMT(COMMON, "Wrote {} spans to {}", num_spans, path);
+  return true;
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  s_thread_buffer.thread_name = name;
+  if (!s_thread_buffer.buffer)
+    return;
+
+  std::lock_guard lk(s_mutex);
+  s_thread_buffer.buffer->thread_name = name;
+}
+
+u64 GetTimestampNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordSpan(const char* category, const char* name, u64 start_ns, u64 end_ns)
+{
+  if (!IsEnabled())
+    return;
+
+  ThreadBuffer* buffer = GetCurrentThreadBuffer();
+
+  // Together with DisableAndWaitForWriters, this guarantees that no span is appended while the
+  // buffers are being written out or cleared.
+  buffer->writing.store(true);
+  if (g_enabled.load())
+    buffer->Append({category, name, start_ns, end_ns});
+  buffer->writing.store(false, std::memory_order_release);
+}
+}  // namespace Common::Tracing
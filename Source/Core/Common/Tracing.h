@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// A timeline of what each thread is doing, for diagnosing stutter.
+//
+// Code marks interesting spans with TRACE_SCOPE. While tracing is active, every thread records
+// its spans into its own buffer without taking locks. When tracing stops, all spans are written
+// to a file in the Chrome trace event format, which can be opened in ui.perfetto.dev or
+// chrome://tracing. When tracing isn't active, a marker costs a single relaxed load.
+namespace Common::Tracing
+{
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Starts recording spans. Spans of a previous session are discarded.
+void Start();
+// Stops recording and writes the spans that were recorded to path. Returns false on failure.
+bool Stop(const std::string& path);
+
+// Names the current thread in the trace. Common::SetCurrentThreadName calls this.
+void SetCurrentThreadName(const char* name);
+
+u64 GetTimestampNs();
+// category and name must be string literals, or otherwise outlive the tracing session.
+void RecordSpan(const char* category, const char* name, u64 start_ns, u64 end_ns);
+
+class ScopedSpan final
+{
+public:
+  ScopedSpan(const char* category, const char* name)
+  {
+    if (!IsEnabled()) [[likely]]
+      return;
+    m_category = category;
+    m_name = name;
+    m_start_ns = GetTimestampNs();
+  }
+
+  ~ScopedSpan()
+  {
+    if (m_name) [[unlikely]]
+      RecordSpan(m_category, m_name, m_start_ns, GetTimestampNs());
+  }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+  const char* m_category = nullptr;
+  const char* m_name = nullptr;
+  u64 m_start_ns = 0;
+};
+}  // namespace Common::Tracing
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+
+// Records the time from here to the end of the enclosing scope as a span on the current thread.
+#define TRACE_SCOPE(category, name)                                                                \
+  Common::Tracing::ScopedSpan TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(category, name)
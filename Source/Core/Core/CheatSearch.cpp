@@ -3,12 +3,18 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
+#include <cstring>
 #include <expected>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -16,6 +22,8 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -101,111 +109,659 @@ std::vector<u8> Cheats::GetValueAsByteVector(const Cheats::SearchValue& value)
   }
 }
 
-template <typename T>
-static std::optional<PowerPC::ReadResult<T>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+namespace
+{
+// Candidates are searched in chunks of CHUNK_WORDS bitmap words. Chunks that only touch RAM pages
+// which can be read directly are spread across worker threads. Everything else has to go through
+// the MMU and is handled on the calling thread, which is the only one allowed to touch it.
+constexpr u32 PAGE_SHIFT = 12;
+constexpr u32 PAGE_SIZE = 1 << PAGE_SHIFT;
+constexpr u32 PAGE_OFFSET_MASK = PAGE_SIZE - 1;
+constexpr size_t WORD_BITS = 64;
+constexpr size_t CHUNK_WORDS = 64;
+constexpr size_t MAX_SEARCH_THREADS = 8;
+constexpr size_t MIN_CHUNKS_PER_THREAD = 16;
+
+static_assert(PAGE_SIZE == PowerPC::HW_PAGE_SIZE);
+
+enum class PageKind : u8
+{
+  // Maps to host memory that can be read directly from any thread.
+  Host,
+  // Has to be read through the MMU.
+  Slow,
+  // Doesn't map to RAM at all.
+  Inaccessible,
+};
+
+struct PageInfo
+{
+  const u8* host = nullptr;
+  // Number of bytes that can be read starting at host, including any following pages which are
+  // mapped right after this one.
+  u64 contiguous_bytes = 0;
+  PageKind kind = PageKind::Inaccessible;
+};
+
+const u8* GetHostPointer(Memory::MemoryManager& memory, u32 physical_address)
 {
-  return PowerPC::MMU::HostTryRead<T>(guard, addr, space);
+  // Mirrors MMU::IsPhysicalRAMAddress and the lookup order of MMU::ReadFromHardware. All of these
+  // regions are a multiple of the page size, so a page is always backed entirely or not at all.
+  const u32 segment = physical_address >> 28;
+  const u32 offset = physical_address & 0x0FFFFFFF;
+  if (memory.GetL1Cache() && segment == 0xE && offset < memory.GetL1CacheSize())
+    return memory.GetL1Cache() + offset;
+  if (memory.GetRAM() && segment == 0x0 && offset < memory.GetRamSizeReal())
+    return memory.GetRAM() + offset;
+  if (memory.GetEXRAM() && segment == 0x1 && offset < memory.GetExRamSizeReal())
+    return memory.GetEXRAM() + offset;
+  if (memory.GetFakeVMEM() && (physical_address & 0xFE000000) == 0x7E000000)
+    return memory.GetFakeVMEM() + (physical_address & memory.GetFakeVMemMask());
+  return nullptr;
 }
 
+// Translates every page of a segment up front, so the search itself doesn't need the MMU for
+// pages that are backed by host memory.
+class PageMap
+{
+public:
+  PageMap(const Core::CPUThreadGuard& guard, const Cheats::SearchSegment& segment, u32 value_size,
+          bool translate)
+  {
+    const u64 last_byte =
+        segment.m_start_address + (segment.m_count - 1) * segment.m_stride + value_size - 1;
+    m_first_page = segment.m_start_address >> PAGE_SHIFT;
+    m_pages.resize((last_byte >> PAGE_SHIFT) - m_first_page + 1);
+
+    auto& system = guard.GetSystem();
+    auto& memory = system.GetMemory();
+    auto& mmu = system.GetMMU();
+    const bool dcache = system.GetPPCState().m_enable_dcache;
+    for (size_t i = 0; i < m_pages.size(); ++i)
+    {
+      const u32 address = static_cast<u32>((m_first_page + i) << PAGE_SHIFT);
+      const std::optional<u32> physical_address =
+          translate ? mmu.GetTranslatedAddress(address) : address;
+      if (!physical_address)
+        continue;
+
+      PageInfo& page = m_pages[i];
+      page.host = GetHostPointer(memory, *physical_address);
+      if (!page.host)
+        continue;
+
+      // Reads go through the emulated data cache when it's enabled.
+      page.kind = dcache ? PageKind::Slow : PageKind::Host;
+    }
+
+    for (size_t i = m_pages.size(); i-- > 0;)
+    {
+      PageInfo& page = m_pages[i];
+      if (page.kind != PageKind::Host)
+        continue;
+      page.contiguous_bytes = PAGE_SIZE;
+      if (i + 1 < m_pages.size() && m_pages[i + 1].kind == PageKind::Host &&
+          m_pages[i + 1].host == page.host + PAGE_SIZE)
+      {
+        page.contiguous_bytes += m_pages[i + 1].contiguous_bytes;
+      }
+    }
+  }
+
+  const PageInfo& Get(u32 address) const { return m_pages[(address >> PAGE_SHIFT) - m_first_page]; }
+
+  // Returns Host or Inaccessible if every page in [first_byte, last_byte] is of that kind, and Slow
+  // otherwise.
+  PageKind GetKind(u32 first_byte, u32 last_byte) const
+  {
+    const size_t first = (first_byte >> PAGE_SHIFT) - m_first_page;
+    const size_t last = (last_byte >> PAGE_SHIFT) - m_first_page;
+    const PageKind kind = m_pages[first].kind;
+    for (size_t i = first + 1; i <= last; ++i)
+    {
+      if (m_pages[i].kind != kind)
+        return PageKind::Slow;
+    }
+    return kind;
+  }
+
+private:
+  u64 m_first_page = 0;
+  std::vector<PageInfo> m_pages;
+};
+
+struct Chunk
+{
+  size_t segment;
+  size_t first_word;
+  size_t num_words;
+  PageKind kind;
+};
+
 template <typename T>
-auto Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                       std::span<const Cheats::MemoryRange> memory_ranges,
-                       PowerPC::RequestedAddressSpace address_space, bool aligned,
-                       const std::function<bool(const T& value)>& validator)
-    -> std::expected<std::vector<SearchResult<T>>, SearchErrorCode>
+struct SearchContext
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return std::unexpected{Cheats::SearchErrorCode::DisabledInHardcoreMode};
-  auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState(system);
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return std::unexpected{Cheats::SearchErrorCode::NoEmulationActive};
+  const Core::CPUThreadGuard* guard;
+  PowerPC::RequestedAddressSpace address_space;
+  Cheats::SearchFilter<T> filter;
+  std::span<const Cheats::SearchSegment> segments;
+  std::span<const PageMap> page_maps;
+
+  // Only set for a NextSearch.
+  bool has_previous;
+  std::span<const u64> previous_bitmap;
+  std::span<const u64> previous_inaccessible;
+  std::span<const u64> previous_word_ranks;
+  std::span<const T> previous_values;
+
+  // Every chunk writes to its own words.
+  std::span<u64> bitmap;
+  std::span<u64> inaccessible;
+};
+
+// Reads count values from memory that's known to be backed by host memory. Runs of values within
+// contiguous host memory are read with a simple strided loop the compiler can vectorize.
+template <typename T>
+void ReadHostValues(const PageMap& pages, u32 address, u32 stride, size_t count, T* out)
+{
+  size_t i = 0;
+  while (i < count)
+  {
+    const u32 current = address + static_cast<u32>(i * stride);
+    const PageInfo& page = pages.Get(current);
+    const u32 offset = current & PAGE_OFFSET_MASK;
+    const u64 available = page.contiguous_bytes - offset;
+    if (available < sizeof(T))
+    {
+      // The value straddles two pages that aren't next to each other in host memory.
+      std::array<u8, sizeof(T)> bytes;
+      for (u32 j = 0; j < sizeof(T); ++j)
+      {
+        const u32 byte_address = current + j;
+        bytes[j] = pages.Get(byte_address).host[byte_address & PAGE_OFFSET_MASK];
+      }
+      out[i] = Common::FromBigEndian(std::bit_cast<T>(bytes));
+      ++i;
+      continue;
+    }
 
-  const auto& ppc_state = system.GetPPCState();
-  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return std::unexpected{Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible};
+    const size_t run = static_cast<size_t>(
+        std::min<u64>(count - i, (available - sizeof(T)) / stride + 1));
+    const u8* src = page.host + offset;
+    for (size_t j = 0; j < run; ++j)
+    {
+      T value;
+      std::memcpy(&value, src + j * stride, sizeof(T));
+      out[i + j] = Common::FromBigEndian(value);
+    }
+    i += run;
+  }
+}
 
-  for (const Cheats::MemoryRange& range : memory_ranges)
+// Reads the values whose bits are set in mask through the MMU. Returns the bits of the values that
+// could be read.
+template <typename T>
+u64 ReadValuesThroughMMU(const Core::CPUThreadGuard& guard, u32 address, u32 stride, u64 mask,
+                         PowerPC::RequestedAddressSpace address_space, T* out)
+{
+  u64 readable = 0;
+  for (; mask != 0; mask &= mask - 1)
   {
-    if (range.m_length < sizeof(T))
+    const int bit = std::countr_zero(mask);
+    const auto result =
+        PowerPC::MMU::HostTryRead<T>(guard, address + bit * stride, address_space);
+    if (!result)
       continue;
+    out[bit] = result->value;
+    readable |= u64(1) << bit;
+  }
+  return readable;
+}
 
-    const u32 increment_per_loop = aligned ? sizeof(T) : 1;
-    const u32 start_address = aligned ? Common::AlignUp(range.m_start, sizeof(T)) : range.m_start;
-    const u64 aligned_length = range.m_length - (start_address - range.m_start);
+template <typename T, typename Compare>
+u64 MatchWord(const T* values, const T* references, size_t count, Compare compare)
+{
+  u64 matches = 0;
+  for (size_t i = 0; i < count; ++i)
+    matches |= static_cast<u64>(compare(values[i], references[i])) << i;
+  return matches;
+}
 
-    if (aligned_length < sizeof(T))
+template <typename T>
+u64 MatchWord(Cheats::CompareType compare_type, const T* values, const T* references,
+              size_t count)
+{
+  switch (compare_type)
+  {
+  case Cheats::CompareType::Equal:
+    return MatchWord(values, references, count, std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return MatchWord(values, references, count, std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return MatchWord(values, references, count, std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return MatchWord(values, references, count, std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return MatchWord(values, references, count, std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return MatchWord(values, references, count, std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+    return 0;
+  }
+}
+
+template <typename T>
+void SearchChunk(const SearchContext<T>& context, const Chunk& chunk, std::vector<T>& values)
+{
+  const Cheats::SearchSegment& segment = context.segments[chunk.segment];
+  const PageMap& pages = context.page_maps[chunk.segment];
+  const Cheats::SearchFilter<T>& filter = context.filter;
+
+  std::array<T, WORD_BITS> current{};
+  std::array<T, WORD_BITS> references{};
+  if (filter.m_filter_type == Cheats::FilterType::CompareAgainstSpecificValue)
+    references.fill(filter.m_value);
+
+  size_t previous_index = context.has_previous ? context.previous_word_ranks[chunk.first_word] : 0;
+  for (size_t word = chunk.first_word; word < chunk.first_word + chunk.num_words; ++word)
+  {
+    const u64 first_candidate = (word - segment.m_first_word) * WORD_BITS;
+    const size_t count =
+        static_cast<size_t>(std::min<u64>(WORD_BITS, segment.m_count - first_candidate));
+    const u32 address =
+        segment.m_start_address + static_cast<u32>(first_candidate * segment.m_stride);
+    const u64 candidates = context.has_previous ? context.previous_bitmap[word] :
+                           count == WORD_BITS   ? ~u64(0) :
+                                                  (u64(1) << count) - 1;
+    if (candidates == 0)
       continue;
 
-    const u64 length = aligned_length - (sizeof(T) - 1);
-    for (u64 i = 0; i < length; i += increment_per_loop)
+    u64 readable = 0;
+    switch (chunk.kind)
     {
-      const u32 addr = start_address + i;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
-        continue;
+    case PageKind::Host:
+      ReadHostValues(pages, address, segment.m_stride, count, current.data());
+      readable = candidates;
+      break;
+    case PageKind::Slow:
+      readable = ReadValuesThroughMMU(*context.guard, address, segment.m_stride, candidates,
+                                      context.address_space, current.data());
+      break;
+    case PageKind::Inaccessible:
+      break;
+    }
 
-      if (validator(current_value->value))
+    u64 matches = readable;
+    u64 unreadable = 0;
+    if (context.has_previous)
+    {
+      if (filter.m_filter_type == Cheats::FilterType::CompareAgainstLastValue)
+      {
+        for (u64 bits = candidates; bits != 0; bits &= bits - 1)
+          references[std::countr_zero(bits)] = context.previous_values[previous_index++];
+      }
+      else
+      {
+        previous_index += std::popcount(candidates);
+      }
+
+      // If the previous value was inaccessible we always keep the new one, to avoid getting stuck
+      // in an invalid state. Addresses that became inaccessible are kept as well.
+      if (filter.m_filter_type != Cheats::FilterType::DoNotFilter)
       {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        matches &= MatchWord(filter.m_compare_type, current.data(), references.data(), count) |
+                   context.previous_inaccessible[word];
       }
+      unreadable = candidates & ~readable;
+      matches |= unreadable;
+      context.inaccessible[word] = unreadable;
+    }
+    else if (filter.m_filter_type != Cheats::FilterType::DoNotFilter)
+    {
+      matches &= MatchWord(filter.m_compare_type, current.data(), references.data(), count);
+    }
+
+    context.bitmap[word] = matches;
+    for (u64 bits = matches; bits != 0; bits &= bits - 1)
+    {
+      const int bit = std::countr_zero(bits);
+      values.push_back(((unreadable >> bit) & 1) != 0 ? T{} : current[bit]);
     }
   }
-  return results;
 }
 
 template <typename T>
-auto Cheats::NextSearch(
-    const Core::CPUThreadGuard& guard, std::span<const Cheats::SearchResult<T>> previous_results,
-    PowerPC::RequestedAddressSpace address_space,
-    const std::function<bool(const T& new_value, const T& old_value)>& validator)
-    -> std::expected<std::vector<SearchResult<T>>, SearchErrorCode>
+std::vector<Chunk> MakeChunks(std::span<const Cheats::SearchSegment> segments,
+                              std::span<const PageMap> page_maps)
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return std::unexpected{Cheats::SearchErrorCode::DisabledInHardcoreMode};
-  auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState(system);
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return std::unexpected{Cheats::SearchErrorCode::NoEmulationActive};
+  std::vector<Chunk> chunks;
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    const Cheats::SearchSegment& segment = segments[i];
+    const size_t num_words = static_cast<size_t>((segment.m_count + WORD_BITS - 1) / WORD_BITS);
+    for (size_t word = 0; word < num_words; word += CHUNK_WORDS)
+    {
+      const size_t chunk_words = std::min(CHUNK_WORDS, num_words - word);
+      const u64 first_candidate = word * WORD_BITS;
+      const u64 last_candidate =
+          std::min<u64>(segment.m_count, (word + chunk_words) * WORD_BITS) - 1;
+      const u32 first_byte =
+          segment.m_start_address + static_cast<u32>(first_candidate * segment.m_stride);
+      const u32 last_byte = segment.m_start_address +
+                            static_cast<u32>(last_candidate * segment.m_stride + sizeof(T) - 1);
+      chunks.push_back({i, segment.m_first_word + word, chunk_words,
+                        page_maps[i].GetKind(first_byte, last_byte)});
+    }
+  }
+  return chunks;
+}
+
+// Searches all chunks and returns the values found in each of them.
+template <typename T>
+std::vector<std::vector<T>> SearchChunks(const SearchContext<T>& context,
+                                         std::span<const Chunk> chunks)
+{
+  std::vector<std::vector<T>> chunk_values(chunks.size());
+
+  std::vector<size_t> host_chunks;
+  std::vector<size_t> slow_chunks;
+  for (size_t i = 0; i < chunks.size(); ++i)
+    (chunks[i].kind == PageKind::Slow ? slow_chunks : host_chunks).push_back(i);
+
+  std::atomic<size_t> next_host_chunk = 0;
+  const auto search_host_chunks = [&] {
+    for (size_t i = next_host_chunk.fetch_add(1, std::memory_order_relaxed);
+         i < host_chunks.size(); i = next_host_chunk.fetch_add(1, std::memory_order_relaxed))
+    {
+      SearchChunk(context, chunks[host_chunks[i]], chunk_values[host_chunks[i]]);
+    }
+  };
+
+  const size_t max_threads =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_SEARCH_THREADS);
+  const size_t num_workers =
+      std::min(max_threads, host_chunks.size() / MIN_CHUNKS_PER_THREAD + 1) - 1;
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i)
+  {
+    workers.emplace_back([&search_host_chunks] {
+      Common::SetCurrentThreadName("Cheat Search");
+      search_host_chunks();
+    });
+  }
+
+  for (const size_t i : slow_chunks)
+    SearchChunk(context, chunks[i], chunk_values[i]);
+  search_host_chunks();
+
+  for (std::thread& worker : workers)
+    worker.join();
 
-  const auto& ppc_state = system.GetPPCState();
+  return chunk_values;
+}
+
+template <typename T>
+std::vector<T> ConcatenateValues(std::vector<std::vector<T>>&& chunk_values)
+{
+  size_t total = 0;
+  for (const std::vector<T>& values : chunk_values)
+    total += values.size();
+
+  std::vector<T> result;
+  result.reserve(total);
+  for (std::vector<T>& values : chunk_values)
+  {
+    result.insert(result.end(), values.begin(), values.end());
+    values = {};
+  }
+  return result;
+}
+
+bool IsTranslated(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace address_space)
+{
+  return address_space == PowerPC::RequestedAddressSpace::Virtual ||
+         (address_space == PowerPC::RequestedAddressSpace::Effective &&
+          guard.GetSystem().GetPPCState().msr.DR);
+}
+
+std::optional<Cheats::SearchErrorCode> CheckSearchPreconditions(
+    const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace address_space)
+{
+  const auto& ppc_state = guard.GetSystem().GetPPCState();
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return std::unexpected{Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible};
+    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
-  for (const auto& previous_result : previous_results)
+  return std::nullopt;
+}
+
+template <typename T>
+std::vector<PageMap> MakePageMaps(const Core::CPUThreadGuard& guard,
+                                  std::span<const Cheats::SearchSegment> segments,
+                                  PowerPC::RequestedAddressSpace address_space)
+{
+  const bool translate = IsTranslated(guard, address_space);
+  std::vector<PageMap> page_maps;
+  page_maps.reserve(segments.size());
+  for (const Cheats::SearchSegment& segment : segments)
+    page_maps.emplace_back(guard, segment, static_cast<u32>(sizeof(T)), translate);
+  return page_maps;
+}
+}  // namespace
+
+template <typename T>
+auto Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                       std::span<const Cheats::MemoryRange> memory_ranges,
+                       PowerPC::RequestedAddressSpace address_space, bool aligned,
+                       const SearchFilter<T>& filter)
+    -> std::expected<SearchResults<T>, SearchErrorCode>
+{
+  if (const auto error = CheckSearchPreconditions(guard, address_space))
+    return std::unexpected{*error};
+  if (filter.m_filter_type == FilterType::CompareAgainstLastValue)
+    return std::unexpected{Cheats::SearchErrorCode::InvalidParameters};
+
+  SearchResults<T> results;
+  size_t num_words = 0;
+  for (const Cheats::MemoryRange& range : memory_ranges)
   {
-    const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-    if (!current_value)
-    {
-      auto& r = results.emplace_back();
-      r.m_address = addr;
-      r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+    const u32 stride = aligned ? sizeof(T) : 1;
+    const u64 start_address =
+        aligned ? Common::AlignUp(u64(range.m_start), sizeof(T)) : range.m_start;
+    const u64 skipped = start_address - range.m_start;
+    if (range.m_length < skipped + sizeof(T))
       continue;
-    }
 
-    // if the previous state was invalid we always update the value to avoid getting stuck in an
-    // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+    // Don't wrap around the end of the address space.
+    const u64 length = std::min(range.m_length - skipped, 0x1'0000'0000 - start_address);
+    if (length < sizeof(T))
+      continue;
+
+    const u64 count = (length - sizeof(T)) / stride + 1;
+    results.m_segments.push_back({static_cast<u32>(start_address), stride, count, num_words});
+    num_words += static_cast<size_t>((count + WORD_BITS - 1) / WORD_BITS);
+  }
+
+  results.m_bitmap.resize(num_words);
+  results.m_inaccessible.resize(num_words);
+  results.m_valid_value_state = IsTranslated(guard, address_space) ?
+                                    Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                    Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+
+  const std::vector<PageMap> page_maps = MakePageMaps<T>(guard, results.m_segments, address_space);
+  const std::vector<Chunk> chunks = MakeChunks<T>(results.m_segments, page_maps);
+
+  SearchContext<T> context{};
+  context.guard = &guard;
+  context.address_space = address_space;
+  context.filter = filter;
+  context.segments = results.m_segments;
+  context.page_maps = page_maps;
+  context.has_previous = false;
+  context.bitmap = results.m_bitmap;
+  context.inaccessible = results.m_inaccessible;
+
+  results.m_values = ConcatenateValues(SearchChunks(context, chunks));
+  results.UpdateRanks();
+  return results;
+}
+
+template <typename T>
+auto Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                        const SearchResults<T>& previous_results,
+                        PowerPC::RequestedAddressSpace address_space,
+                        const SearchFilter<T>& filter)
+    -> std::expected<SearchResults<T>, SearchErrorCode>
+{
+  if (const auto error = CheckSearchPreconditions(guard, address_space))
+    return std::unexpected{*error};
+
+  SearchResults<T> results;
+  results.m_segments = previous_results.m_segments;
+  results.m_bitmap.resize(previous_results.m_bitmap.size());
+  results.m_inaccessible.resize(previous_results.m_inaccessible.size());
+  results.m_valid_value_state = IsTranslated(guard, address_space) ?
+                                    Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                    Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+
+  const std::vector<PageMap> page_maps = MakePageMaps<T>(guard, results.m_segments, address_space);
+  const std::vector<Chunk> chunks = MakeChunks<T>(results.m_segments, page_maps);
+
+  SearchContext<T> context{};
+  context.guard = &guard;
+  context.address_space = address_space;
+  context.filter = filter;
+  context.segments = results.m_segments;
+  context.page_maps = page_maps;
+  context.has_previous = true;
+  context.previous_bitmap = previous_results.m_bitmap;
+  context.previous_inaccessible = previous_results.m_inaccessible;
+  context.previous_word_ranks = previous_results.m_word_ranks;
+  context.previous_values = previous_results.m_values;
+  context.bitmap = results.m_bitmap;
+  context.inaccessible = results.m_inaccessible;
+
+  results.m_values = ConcatenateValues(SearchChunks(context, chunks));
+  results.UpdateRanks();
+  return results;
+}
+
+template <typename T>
+size_t Cheats::SearchResults<T>::GetValidValueCount() const
+{
+  size_t count = Size();
+  for (const u64 word : m_inaccessible)
+    count -= std::popcount(word);
+  return count;
+}
+
+template <typename T>
+size_t Cheats::SearchResults<T>::FindCandidate(size_t index) const
+{
+  // The last word whose rank is not greater than index is the one holding the result.
+  const auto it = std::upper_bound(m_word_ranks.begin(), m_word_ranks.end(), u64(index));
+  const size_t word = static_cast<size_t>(it - m_word_ranks.begin()) - 1;
+  u64 bits = m_bitmap[word];
+  for (u64 i = index - m_word_ranks[word]; i > 0; --i)
+    bits &= bits - 1;
+  return word * WORD_BITS + std::countr_zero(bits);
+}
+
+template <typename T>
+u32 Cheats::SearchResults<T>::GetCandidateAddress(size_t candidate) const
+{
+  const size_t word = candidate / WORD_BITS;
+  const auto it = std::upper_bound(
+      m_segments.begin(), m_segments.end(), word,
+      [](size_t w, const SearchSegment& segment) { return w < segment.m_first_word; });
+  const SearchSegment& segment = *(it - 1);
+  return segment.m_start_address +
+         static_cast<u32>((candidate - segment.m_first_word * WORD_BITS) * segment.m_stride);
+}
+
+template <typename T>
+u32 Cheats::SearchResults<T>::GetAddress(size_t index) const
+{
+  return GetCandidateAddress(FindCandidate(index));
+}
+
+template <typename T>
+Cheats::SearchResultValueState Cheats::SearchResults<T>::GetValueState(size_t index) const
+{
+  const size_t candidate = FindCandidate(index);
+  if (((m_inaccessible[candidate / WORD_BITS] >> (candidate % WORD_BITS)) & 1) != 0)
+    return Cheats::SearchResultValueState::AddressNotAccessible;
+  return m_valid_value_state;
+}
+
+template <typename T>
+void Cheats::SearchResults<T>::Remove(size_t index)
+{
+  const size_t candidate = FindCandidate(index);
+  const size_t word = candidate / WORD_BITS;
+  const u64 bit = u64(1) << (candidate % WORD_BITS);
+  m_bitmap[word] &= ~bit;
+  m_inaccessible[word] &= ~bit;
+  m_values.erase(m_values.begin() + index);
+  for (size_t i = word + 1; i < m_word_ranks.size(); ++i)
+    --m_word_ranks[i];
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchResults<T>::Slice(size_t begin, size_t end) const
+{
+  end = std::min(end, Size());
+
+  SearchResults result;
+  result.m_valid_value_state = m_valid_value_state;
+  if (begin < end)
+  {
+    // Only the bitmap words holding the sliced results are kept, along with the parts of the
+    // segments they cover, so that searching the slice doesn't touch the rest of memory.
+    const size_t first = FindCandidate(begin);
+    const size_t last = FindCandidate(end - 1);
+    const size_t first_word = first / WORD_BITS;
+    const size_t last_word = last / WORD_BITS;
+    for (const SearchSegment& segment : m_segments)
     {
-      auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-      r.m_address = addr;
+      const size_t num_words = static_cast<size_t>((segment.m_count + WORD_BITS - 1) / WORD_BITS);
+      const size_t begin_word = std::max(first_word, segment.m_first_word);
+      const size_t end_word = std::min(last_word + 1, segment.m_first_word + num_words);
+      if (begin_word >= end_word)
+        continue;
+
+      const u64 skipped = u64(begin_word - segment.m_first_word) * WORD_BITS;
+      const u64 count = std::min<u64>(segment.m_count - skipped, (end_word - begin_word) * WORD_BITS);
+      result.m_segments.push_back(
+          {segment.m_start_address + static_cast<u32>(skipped * segment.m_stride),
+           segment.m_stride, count, begin_word - first_word});
     }
+
+    const auto slice_words = [&](const std::vector<u64>& words) {
+      std::vector<u64> sliced(words.begin() + first_word, words.begin() + last_word + 1);
+      sliced.front() &= ~u64(0) << (first % WORD_BITS);
+      sliced.back() &= ~u64(0) >> (WORD_BITS - 1 - last % WORD_BITS);
+      return sliced;
+    };
+    result.m_bitmap = slice_words(m_bitmap);
+    result.m_inaccessible = slice_words(m_inaccessible);
+    result.m_values.assign(m_values.begin() + begin, m_values.begin() + end);
+  }
+  result.UpdateRanks();
+  return result;
+}
+
+template <typename T>
+void Cheats::SearchResults<T>::UpdateRanks()
+{
+  m_word_ranks.resize(m_bitmap.size());
+  u64 rank = 0;
+  for (size_t i = 0; i < m_bitmap.size(); ++i)
+  {
+    m_word_ranks[i] = rank;
+    rank += std::popcount(m_bitmap[i]);
   }
-  return results;
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -280,63 +836,15 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
+  m_search_results = {};
 }
 
 template <typename T>
 void Cheats::CheatSearchSession<T>::RemoveResult(size_t index)
 {
-  if (index < m_search_results.size())
+  if (index < m_search_results.Size())
   {
-    m_search_results.erase(m_search_results.begin() + index);
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return std::equal_to<T>();
-  case Cheats::CompareType::NotEqual:
-    return std::not_equal_to<T>();
-  case Cheats::CompareType::Less:
-    return std::less<T>();
-  case Cheats::CompareType::LessOrEqual:
-    return std::less_equal<T>();
-  case Cheats::CompareType::Greater:
-    return std::greater<T>();
-  case Cheats::CompareType::GreaterOrEqual:
-    return std::greater_equal<T>();
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
+    m_search_results.Remove(index);
   }
 }
 
@@ -345,47 +853,30 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  std::expected<std::vector<SearchResult<T>>, SearchErrorCode> result =
-      std::unexpected{Cheats::SearchErrorCode::InvalidParameters};
+  const Core::State core_state = Core::GetState(guard.GetSystem());
+  if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    return Cheats::SearchErrorCode::NoEmulationActive;
+
+  SearchFilter<T> filter;
+  filter.m_filter_type = m_filter_type;
+  filter.m_compare_type = m_compare_type;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
-
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    filter.m_value = *m_value;
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
-
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
-  }
-  else if (m_filter_type == FilterType::DoNotFilter)
-  {
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
   }
 
+  std::expected<SearchResults<T>, SearchErrorCode> result =
+      m_first_search_done ?
+          Cheats::NextSearch<T>(guard, m_search_results, m_address_space, filter) :
+          Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, filter);
+
   if (result.has_value())
   {
     m_search_results = std::move(*result);
@@ -441,38 +932,31 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.Size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_search_results.GetValidValueCount();
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.GetAddress(index);
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.GetValue(index);
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{m_search_results.GetValue(index)};
 }
 
 template <typename T>
@@ -481,32 +965,32 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
+  const T value = m_search_results.GetValue(index);
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
     {
-      return fmt::format("0x{0:08x}", std::bit_cast<s32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", std::bit_cast<s32>(value));
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-      return fmt::format("0x{0:016x}", std::bit_cast<s64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", std::bit_cast<s64>(value));
     }
     else
     {
-      return fmt::format("0x{0:0{1}x}",
-                         std::bit_cast<std::make_unsigned_t<T>>(m_search_results[index].m_value),
+      return fmt::format("0x{0:0{1}x}", std::bit_cast<std::make_unsigned_t<T>>(value),
                          sizeof(T) * 2);
     }
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.GetValueState(index);
 }
 
 template <typename T>
@@ -542,13 +1026,12 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= m_search_results.Size())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  c->m_search_results = m_search_results.Slice(begin_index, end_index);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -556,6 +1039,17 @@ Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size
   return c;
 }
 
+template class Cheats::SearchResults<u8>;
+template class Cheats::SearchResults<u16>;
+template class Cheats::SearchResults<u32>;
+template class Cheats::SearchResults<u64>;
+template class Cheats::SearchResults<s8>;
+template class Cheats::SearchResults<s16>;
+template class Cheats::SearchResults<s32>;
+template class Cheats::SearchResults<s64>;
+template class Cheats::SearchResults<float>;
+template class Cheats::SearchResults<double>;
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
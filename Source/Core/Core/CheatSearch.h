@@ -3,8 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
 #include <expected>
-#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
@@ -65,20 +65,6 @@ enum class SearchResultValueState : u8
   AddressNotAccessible,
 };
 
-template <typename T>
-struct SearchResult
-{
-  T m_value;
-  SearchResultValueState m_value_state;
-  u32 m_address;
-
-  bool IsValueValid() const
-  {
-    return m_value_state == SearchResultValueState::ValueFromPhysicalMemory ||
-           m_value_state == SearchResultValueState::ValueFromVirtualMemory;
-  }
-};
-
 struct MemoryRange
 {
   u32 m_start;
@@ -113,21 +99,87 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
+template <typename T>
+struct SearchFilter
+{
+  FilterType m_filter_type = FilterType::DoNotFilter;
+  CompareType m_compare_type = CompareType::Equal;
+  // Only used with FilterType::CompareAgainstSpecificValue.
+  T m_value{};
+};
+
+// A run of search candidates starting at m_start_address, spaced m_stride bytes apart.
+struct SearchSegment
+{
+  u32 m_start_address;
+  u32 m_stride;
+  u64 m_count;
+  // Index of the bitmap word holding the first candidate. Every segment starts on a new word.
+  size_t m_first_word;
+};
+
+template <typename T>
+class SearchResults;
+
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// that pass the given filter. FilterType::CompareAgainstLastValue is not valid for a new search.
+// Emulated memory must be initialized; CheatSearchSession also checks that emulation is active.
 template <typename T>
-std::expected<std::vector<SearchResult<T>>, SearchErrorCode>
+std::expected<SearchResults<T>, SearchErrorCode>
 NewSearch(const Core::CPUThreadGuard& guard, std::span<const MemoryRange> memory_ranges,
-          PowerPC::RequestedAddressSpace address_space, bool aligned,
-          const std::function<bool(const T& value)>& validator);
+          PowerPC::RequestedAddressSpace address_space, bool aligned, const SearchFilter<T>& filter);
 
-// Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
+// Refresh the values for the given results in the given address space, only keeping values that
+// pass the given filter.
+template <typename T>
+std::expected<SearchResults<T>, SearchErrorCode>
+NextSearch(const Core::CPUThreadGuard& guard, const SearchResults<T>& previous_results,
+           PowerPC::RequestedAddressSpace address_space, const SearchFilter<T>& filter);
+
+// Every address that a search looks at is a candidate, and each candidate gets one bit in a bitmap
+// telling whether it's part of the results. The values of the results are stored separately, in
+// address order. This takes far less memory than storing each result's address, which matters for
+// unfiltered searches over all of MEM1 and MEM2.
 template <typename T>
-std::expected<std::vector<SearchResult<T>>, SearchErrorCode>
-NextSearch(const Core::CPUThreadGuard& guard, std::span<const SearchResult<T>> previous_results,
-           PowerPC::RequestedAddressSpace address_space,
-           const std::function<bool(const T& new_value, const T& old_value)>& validator);
+class SearchResults
+{
+public:
+  size_t Size() const { return m_values.size(); }
+  size_t GetValidValueCount() const;
+  u32 GetAddress(size_t index) const;
+  T GetValue(size_t index) const { return m_values[index]; }
+  SearchResultValueState GetValueState(size_t index) const;
+
+  void Remove(size_t index);
+  // Returns a copy containing only the results with indices in [begin, end). It only covers the
+  // memory between the first and the last of these results.
+  SearchResults Slice(size_t begin, size_t end) const;
+  // Number of bitmap words, which the memory used by the results and the work done by a next search
+  // grow with.
+  size_t GetWordCount() const { return m_bitmap.size(); }
+
+private:
+  size_t FindCandidate(size_t index) const;
+  u32 GetCandidateAddress(size_t candidate) const;
+  void UpdateRanks();
+
+  std::vector<SearchSegment> m_segments;
+  std::vector<u64> m_bitmap;
+  // Set for results whose address couldn't be read by the last search. Same layout as m_bitmap.
+  std::vector<u64> m_inaccessible;
+  // Number of results in the bitmap words before each word.
+  std::vector<u64> m_word_ranks;
+  std::vector<T> m_values;
+  SearchResultValueState m_valid_value_state = SearchResultValueState::ValueFromPhysicalMemory;
+
+  friend std::expected<SearchResults, SearchErrorCode>
+  NewSearch<T>(const Core::CPUThreadGuard& guard, std::span<const MemoryRange> memory_ranges,
+               PowerPC::RequestedAddressSpace address_space, bool aligned,
+               const SearchFilter<T>& filter);
+  friend std::expected<SearchResults, SearchErrorCode>
+  NextSearch<T>(const Core::CPUThreadGuard& guard, const SearchResults& previous_results,
+                PowerPC::RequestedAddressSpace address_space, const SearchFilter<T>& filter);
+};
 
 class CheatSearchSessionBase
 {
@@ -226,7 +278,7 @@ public:
                                                        size_t end_index) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  SearchResults<T> m_search_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
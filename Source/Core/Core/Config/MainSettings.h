@@ -73,6 +73,7 @@ extern const Info<bool> MAIN_LOAD_GAME_INTO_MEMORY;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
+extern const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
 extern const Info<int> MAIN_GC_LANGUAGE;
 extern const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS;
 extern const Info<bool> MAIN_DPL2_DECODER;
@@ -124,6 +125,10 @@ extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
+extern const Info<bool> MAIN_ADAPTIVE_GPU_HANDOFF;
+extern const Info<int> MAIN_GPU_HANDOFF_MIN_SPIN_TIME;
+extern const Info<int> MAIN_GPU_HANDOFF_MAX_SPIN_TIME;
+extern const Info<int> MAIN_GPU_HANDOFF_MAX_BATCH_SIZE;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
@@ -172,8 +177,11 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_THREAD;
+extern const Info<bool> MAIN_DSP_HLE_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+// Experimental. Skips SR updates in the DSP JIT that the analyzer proves dead.
+extern const Info<bool> MAIN_DSP_JIT_SKIP_DEAD_FLAGS;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
@@ -335,6 +343,9 @@ extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
 extern const Info<bool> MAIN_MOVIE_SHOW_OSD;
+extern const Info<bool> MAIN_MOVIE_INDEXED_FORMAT;
+extern const Info<u32> MAIN_MOVIE_KEYFRAME_INTERVAL;
+extern const Info<bool> MAIN_MOVIE_KEYFRAME_SAVESTATES;
 
 // Main.Input
 
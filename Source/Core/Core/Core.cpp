@@ -100,6 +100,7 @@ static std::thread s_emu_thread;
 static Common::HookableEvent<Core::State> s_state_changed_event;
 
 static bool s_is_throttler_temp_disabled = false;
+static bool s_is_resimulating = false;
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
 
@@ -142,6 +143,16 @@ void SetIsThrottlerTempDisabled(bool disable)
   s_is_throttler_temp_disabled = disable;
 }
 
+bool GetIsResimulating()
+{
+  return s_is_resimulating;
+}
+
+void SetIsResimulating(bool resimulating)
+{
+  s_is_resimulating = resimulating;
+}
+
 void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
@@ -150,6 +161,9 @@ void FrameUpdateOnCPUThread()
 
 void OnFrameEnd(Core::System& system)
 {
+  if (NetPlay::IsNetPlayRunning())
+    NetPlay::OnFrameEnd();
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
   {
@@ -530,6 +544,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   DeclareAsCPUThread();
 
   s_frame_step = false;
+  s_is_resimulating = false;
 
   // If settings have changed since the previous run, notify callbacks.
   CPUThreadConfigCallback::CheckForConfigChanges();
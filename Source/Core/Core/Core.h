@@ -28,6 +28,11 @@ class System;
 bool GetIsThrottlerTempDisabled();
 void SetIsThrottlerTempDisabled(bool disable);
 
+// Set while NetPlay rollback runs frames again that were already shown. These frames are neither
+// throttled nor output.
+bool GetIsResimulating();
+void SetIsResimulating(bool resimulating);
+
 void Callback_NewField(Core::System& system);
 
 enum class State
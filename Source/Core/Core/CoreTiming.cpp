@@ -4,9 +4,11 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -16,6 +18,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/SPSCQueue.h"
 #include "Common/ScopeGuard.h"
+#include "Common/Tracing.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
@@ -129,6 +132,7 @@ void CoreTimingManager::Shutdown()
   std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
+  m_safe_point_callbacks.clear();
   UnregisterAllEvents();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
   m_frame_hook.reset();
@@ -186,6 +190,7 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  CompactEventQueue();
   p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -226,6 +231,13 @@ void CoreTimingManager::DoState(PointerWrap& p)
     // and library version specific.
     std::ranges::make_heap(m_event_queue, std::ranges::greater{});
 
+    ResetQueuedEventCounts();
+    for (Event& ev : m_event_queue)
+    {
+      ev.generation = ev.type->generation;
+      ++ev.type->num_queued;
+    }
+
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
     ResetThrottle(m_globals.global_timer);
@@ -253,6 +265,42 @@ u64 CoreTimingManager::GetIdleTicks() const
 void CoreTimingManager::ClearPendingEvents()
 {
   m_event_queue.clear();
+  m_num_cancelled_events = 0;
+  ResetQueuedEventCounts();
+}
+
+void CoreTimingManager::ResetQueuedEventCounts()
+{
+  for (auto& [name, event_type] : m_event_types)
+    event_type.num_queued = 0;
+}
+
+void CoreTimingManager::PushEvent(const Event& event)
+{
+  Event& ev = m_event_queue.emplace_back(event);
+  ev.generation = ev.type->generation;
+  ++ev.type->num_queued;
+  std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+}
+
+void CoreTimingManager::PopCancelledEvents()
+{
+  while (!m_event_queue.empty() && IsCancelled(m_event_queue.front()))
+  {
+    std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
+    m_event_queue.pop_back();
+    --m_num_cancelled_events;
+  }
+}
+
+void CoreTimingManager::CompactEventQueue()
+{
+  if (m_num_cancelled_events == 0)
+    return;
+
+  std::erase_if(m_event_queue, IsCancelled);
+  std::ranges::make_heap(m_event_queue, std::ranges::greater{});
+  m_num_cancelled_events = 0;
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -281,8 +329,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    PushEvent(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -301,14 +348,18 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  const size_t erased =
-      std::erase_if(m_event_queue, [&](const Event& e) { return e.type == event_type; });
+  if (event_type->num_queued == 0)
+    return;
 
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (erased != 0)
-  {
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
-  }
+  // Cancel every queued event of this type without touching the heap.
+  ++event_type->generation;
+  m_num_cancelled_events += event_type->num_queued;
+  event_type->num_queued = 0;
+
+  // Each compaction removes at least as many events as were cancelled since the last one, so the
+  // cost stays amortized O(1) per cancelled event.
+  if (m_num_cancelled_events > m_event_queue.size() / 2)
+    CompactEventQueue();
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -334,18 +385,25 @@ void CoreTimingManager::MoveEvents()
 {
   while (!m_ts_queue.Empty())
   {
-    auto& ev = m_event_queue.emplace_back(m_ts_queue.Front());
+    Event ev = m_ts_queue.Front();
     m_ts_queue.Pop();
 
     ev.fifo_order = m_event_fifo_id++;
     ev.time += m_globals.global_timer;
 
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    PushEvent(ev);
   }
 }
 
+void CoreTimingManager::RunAtSafePoint(std::function<void()> callback)
+{
+  m_safe_point_callbacks.push_back(std::move(callback));
+}
+
 void CoreTimingManager::Advance()
 {
+  TRACE_SCOPE("CoreTiming", "Advance");
+
   CPUThreadConfigCallback::CheckForConfigChanges();
 
   MoveEvents();
@@ -361,16 +419,29 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
+  PopCancelledEvents();
   while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
   {
     Event evt = m_event_queue.front();
     std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
     m_event_queue.pop_back();
+    --evt.type->num_queued;
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+    PopCancelledEvents();
   }
 
   m_is_global_timer_sane = false;
 
+  // Loading a state here replaces the event queue, so this has to happen before the next slice is
+  // set up from it.
+  if (!m_safe_point_callbacks.empty())
+  {
+    std::vector<std::function<void()>> callbacks;
+    std::swap(callbacks, m_safe_point_callbacks);
+    for (const auto& callback : callbacks)
+      callback();
+  }
+
   // Still events left (scheduled in the future)
   if (!m_event_queue.empty())
   {
@@ -396,7 +467,8 @@ TimePoint CoreTimingManager::CalculateTargetHostTimeInternal(s64 target_cycle)
 
 bool CoreTimingManager::IsSpeedUnlimited() const
 {
-  return m_throttle_adj_clock_per_sec == 0 || Core::GetIsThrottlerTempDisabled();
+  return m_throttle_adj_clock_per_sec == 0 || Core::GetIsThrottlerTempDisabled() ||
+         Core::GetIsResimulating();
 }
 
 TimePoint CoreTimingManager::GetTargetHostTime(s64 target_cycle)
@@ -547,6 +619,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 void CoreTimingManager::LogPendingEvents() const
 {
   auto clone = m_event_queue;
+  std::erase_if(clone, IsCancelled);
   std::ranges::sort(clone);
   for (const Event& ev : clone)
   {
@@ -593,6 +666,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   text.reserve(1000);
 
   auto clone = m_event_queue;
+  std::erase_if(clone, IsCancelled);
   std::ranges::sort(clone);
   for (const Event& ev : clone)
   {
@@ -16,6 +16,7 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
+#include <functional>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -55,6 +56,12 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+
+  // Incremented by RemoveEvent. Queued events that were scheduled with an older generation have
+  // been cancelled and are discarded when they reach the front of the queue.
+  u64 generation = 0;
+  // Number of queued events of this type that haven't been cancelled.
+  u32 num_queued = 0;
 };
 
 struct Event
@@ -63,6 +70,8 @@ struct Event
   u64 fifo_order;
   u64 userdata;
   EventType* type;
+  // Not saved. Assigned when the event enters m_event_queue.
+  u64 generation = 0;
 
   // Sort by time, unless the times are the same, in which case sort by the order added to the queue
   constexpr auto operator<=>(const Event& other) const
@@ -121,6 +130,7 @@ public:
                      FromThread from = FromThread::CPU);
 
   // We only permit one event of each type in the queue at a time.
+  // Cancelling is O(1): the events stay in the queue and are skipped when they are reached.
   void RemoveEvent(EventType* event_type);
   void RemoveAllEvents(EventType* event_type);
 
@@ -133,6 +143,11 @@ public:
   void Advance();
   void MoveEvents();
 
+  // Runs the callback at the end of the next Advance(), after the events that are due. Unlike
+  // during an event, the emulated machine is in a consistent state there, so states can be saved
+  // and loaded. CPU thread only.
+  void RunAtSafePoint(std::function<void()> callback);
+
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
 
@@ -184,10 +199,12 @@ private:
   // STATE_TO_SAVE
   // The queue is a min-heap using std::ranges::make_heap/push_heap/pop_heap.
   // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accommodated
-  // by the standard adaptor class.
+  // compact the queue regardless of its order. These aren't accommodated by the standard adaptor
+  // class. Events cancelled by RemoveEvent() stay in the heap until they are popped or the queue is
+  // compacted, and are never saved.
   std::vector<Event> m_event_queue;
   u64 m_event_fifo_id = 0;
+  size_t m_num_cancelled_events = 0;
   std::mutex m_ts_write_lock;
 
   // Event objects created from other threads.
@@ -203,6 +220,8 @@ private:
   // Are we in a function that has been called from Advance()
   bool m_is_global_timer_sane = false;
 
+  std::vector<std::function<void()>> m_safe_point_callbacks;
+
   EventType* m_ev_lost = nullptr;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
@@ -227,6 +246,15 @@ private:
   TimePoint CalculateTargetHostTimeInternal(s64 target_cycle);
   void UpdateVISkip(TimePoint current_time, TimePoint target_time);
 
+  static bool IsCancelled(const Event& event)
+  {
+    return event.generation != event.type->generation;
+  }
+  void PushEvent(const Event& event);
+  void PopCancelledEvents();
+  void CompactEventQueue();
+  void ResetQueuedEventCounts();
+
   int DowncountToCycles(int downcount) const;
   int CyclesToDowncount(int cycles) const;
 
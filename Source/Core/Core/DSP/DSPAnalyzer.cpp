@@ -3,8 +3,10 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <vector>
 
 #include "Common/Logging/Log.h"
 
@@ -60,43 +62,199 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Bits of SR that hold the results of arithmetic and logic instructions.
+constexpr u16 FLAGS_MASK = SR_CMP_MASK | SR_LOGIC_ZERO;
+
+// Instructions whose flag update can set SR_OVERFLOW_STICKY. Since that bit is only ever cleared by
+// writing SR directly, it has to be kept up to date even if all other flags end up being unused.
+constexpr std::array<u16, 20> sticky_overflow_opcodes = {
+    0x0200,  // ADDI
+    0x0280,  // CMPI
+    0x0400,  // ADDIS
+    0x0600,  // CMPIS
+    0x4000,  // ADDR
+    0x4800,  // ADDAX
+    0x4c00,  // ADD
+    0x4e00,  // ADDP
+    0x5000,  // SUBR
+    0x5800,  // SUBAX
+    0x5c00,  // SUB
+    0x5e00,  // SUBP
+    0x7000,  // ADDAXL
+    0x7400,  // INCM
+    0x7600,  // INC
+    0x7800,  // DECM
+    0x7a00,  // DEC
+    0x7c00,  // NEG
+    0x8200,  // CMP
+    0xc100,  // CMPAXH
+};
+
+struct FlagWrite
+{
+  u16 opcode;
+  u16 flags;
+};
+
+// The flags that each instruction always overwrites, as done by the interpreter. updates_sr in the
+// opcode table can't be used for this, since it is also set for instructions that don't write any
+// flags, like LRIS and the multiplications that leave the accumulators alone.
+// Instructions that aren't listed here are assumed to leave all flags as they are.
+constexpr std::array<FlagWrite, 67> flag_writes = {{
+    {0x0200, SR_CMP_MASK},    // ADDI
+    {0x0220, SR_CMP_MASK},    // XORI
+    {0x0240, SR_CMP_MASK},    // ANDI
+    {0x0260, SR_CMP_MASK},    // ORI
+    {0x0280, SR_CMP_MASK},    // CMPI
+    {0x02a0, SR_LOGIC_ZERO},  // ANDF
+    {0x02c0, SR_LOGIC_ZERO},  // ANDCF
+    {0x02ca, SR_CMP_MASK},    // LSRN
+    {0x02cb, SR_CMP_MASK},    // ASRN
+    {0x0400, SR_CMP_MASK},    // ADDIS
+    {0x0600, SR_CMP_MASK},    // CMPIS
+    {0x1400, SR_CMP_MASK},    // LSL
+    {0x1440, SR_CMP_MASK},    // LSR
+    {0x1480, SR_CMP_MASK},    // ASL
+    {0x14c0, SR_CMP_MASK},    // ASR
+    {0x3000, SR_CMP_MASK},    // XORR
+    {0x3080, SR_CMP_MASK},    // XORC
+    {0x3280, SR_CMP_MASK},    // NOT
+    {0x3400, SR_CMP_MASK},    // ANDR
+    {0x3480, SR_CMP_MASK},    // LSRNRX
+    {0x3800, SR_CMP_MASK},    // ORR
+    {0x3880, SR_CMP_MASK},    // ASRNRX
+    {0x3c00, SR_CMP_MASK},    // ANDC
+    {0x3c80, SR_CMP_MASK},    // LSRNR
+    {0x3e00, SR_CMP_MASK},    // ORC
+    {0x3e80, SR_CMP_MASK},    // ASRNR
+    {0x4000, SR_CMP_MASK},    // ADDR
+    {0x4800, SR_CMP_MASK},    // ADDAX
+    {0x4c00, SR_CMP_MASK},    // ADD
+    {0x4e00, SR_CMP_MASK},    // ADDP
+    {0x5000, SR_CMP_MASK},    // SUBR
+    {0x5800, SR_CMP_MASK},    // SUBAX
+    {0x5c00, SR_CMP_MASK},    // SUB
+    {0x5e00, SR_CMP_MASK},    // SUBP
+    {0x6000, SR_CMP_MASK},    // MOVR
+    {0x6800, SR_CMP_MASK},    // MOVAX
+    {0x6c00, SR_CMP_MASK},    // MOV
+    {0x6e00, SR_CMP_MASK},    // MOVP
+    {0x7000, SR_CMP_MASK},    // ADDAXL
+    {0x7400, SR_CMP_MASK},    // INCM
+    {0x7600, SR_CMP_MASK},    // INC
+    {0x7800, SR_CMP_MASK},    // DECM
+    {0x7a00, SR_CMP_MASK},    // DEC
+    {0x7c00, SR_CMP_MASK},    // NEG
+    {0x7e00, SR_CMP_MASK},    // MOVNP
+    {0x8100, SR_CMP_MASK},    // CLR
+    {0x8200, SR_CMP_MASK},    // CMP
+    {0x8500, SR_CMP_MASK},    // TSTPROD
+    {0x8600, SR_CMP_MASK},    // TSTAXH
+    {0x9100, SR_CMP_MASK},    // ASR16
+    {0x9200, SR_CMP_MASK},    // MULMVZ
+    {0x9400, SR_CMP_MASK},    // MULAC
+    {0x9600, SR_CMP_MASK},    // MULMV
+    {0xa100, SR_CMP_MASK},    // ABS
+    {0xa200, SR_CMP_MASK},    // MULXMVZ
+    {0xa400, SR_CMP_MASK},    // MULXAC
+    {0xa600, SR_CMP_MASK},    // MULXMV
+    {0xb100, SR_CMP_MASK},    // TST
+    {0xc100, SR_CMP_MASK},    // CMPAXH
+    {0xc200, SR_CMP_MASK},    // MULCMVZ
+    {0xc400, SR_CMP_MASK},    // MULCAC
+    {0xc600, SR_CMP_MASK},    // MULCMV
+    {0xf000, SR_CMP_MASK},    // LSL16
+    {0xf400, SR_CMP_MASK},    // LSR16
+    {0xf800, SR_CMP_MASK},    // ADDPAXZ
+    {0xfc00, SR_CMP_MASK},    // CLRL
+    {0xfe00, SR_CMP_MASK},    // MOVPZ
+}};
+
+// Returns the flags that an instruction always overwrites.
+static u16 GetWrittenFlags(const DSPOPCTemplate& opcode)
+{
+  const auto it = std::ranges::find(flag_writes, opcode.opcode, &FlagWrite::opcode);
+  return it != flag_writes.end() ? it->flags : 0;
+}
+
+static bool SetsStickyOverflow(const DSPOPCTemplate& opcode)
+{
+  return std::ranges::find(sticky_overflow_opcodes, opcode.opcode) !=
+         sticky_overflow_opcodes.end();
+}
+
+// Whether or not any register operand of the instruction refers to $sr.
+static bool AccessesSR(const DSPOPCTemplate& opcode, UDSPInstruction inst, u16 inst2)
+{
+  for (size_t i = 0; i < opcode.param_count; i++)
+  {
+    const param2_t& param = opcode.params[i];
+    if (param.type != P_REG)
+      continue;
+
+    u32 val = (param.loc >= 1 ? inst2 : inst) & param.mask;
+    if (param.lshift < 0)
+      val <<= -param.lshift;
+    else
+      val >>= param.lshift;
+
+    if (val == DSP_REG_SR)
+      return true;
+  }
+  return false;
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
 void Analyzer::Analyze(const SDSP& dsp)
 {
+  const auto read_imem = [&dsp](u16 address) { return dsp.ReadIMEM(address); };
+
+  Reset();
+  AnalyzeRange(read_imem, 0x0000, 0x1000);  // IRAM
+  AnalyzeRange(read_imem, 0x8000, 0x9000);  // IROM
+}
+
+void Analyzer::Analyze(std::span<const u16> code)
+{
+  const auto read_imem = [code](u16 address) -> u16 {
+    return address < code.size() ? code[address] : 0;
+  };
+
   Reset();
-  AnalyzeRange(dsp, 0x0000, 0x1000);  // IRAM
-  AnalyzeRange(dsp, 0x8000, 0x9000);  // IROM
+  AnalyzeRange(read_imem, 0x0000, static_cast<u16>(std::min<size_t>(code.size(), 0x1000)));
 }
 
 void Analyzer::Reset()
 {
   m_code_flags.fill(0);
+  m_analyzed_flags = m_skip_dead_flag_updates;
 }
 
-void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
+void Analyzer::AnalyzeRange(const IMEMReader& read_imem, u16 start_addr, u16 end_addr)
 {
   // First we run an extremely simplified version of a disassembler to find
   // where all instructions start.
-  FindInstructionStarts(dsp, start_addr, end_addr);
+  FindInstructionStarts(read_imem, start_addr, end_addr);
 
   // Next, we'll scan for potential idle skips.
-  FindIdleSkips(dsp, start_addr, end_addr);
+  FindIdleSkips(read_imem, start_addr, end_addr);
+
+  // Finally, figure out which flag updates can be skipped.
+  if (m_analyzed_flags)
+    FindLiveFlags(read_imem, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
 
-void Analyzer::FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_addr)
+void Analyzer::FindInstructionStarts(const IMEMReader& read_imem, u16 start_addr, u16 end_addr)
 {
   // This may not be 100% accurate in case of jump tables!
   // It could get desynced, which would be bad. We'll see if that's an issue.
-#ifndef DISABLE_UPDATE_SR_ANALYSIS
-  u16 last_arithmetic = 0;
-#endif
   for (u16 addr = start_addr; addr < end_addr;)
   {
-    const UDSPInstruction inst = dsp.ReadIMEM(addr);
+    const UDSPInstruction inst = read_imem(addr);
     const DSPOPCTemplate* opcode = GetOpTemplate(inst);
     if (!opcode)
     {
@@ -108,7 +266,7 @@ void Analyzer::FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_ad
     if ((inst & 0xffe0) == 0x0060 || (inst & 0xff00) == 0x1100)
     {
       // BLOOP, BLOOPI
-      const u16 loop_end = dsp.ReadIMEM(addr + 1);
+      const u16 loop_end = read_imem(addr + 1);
       m_code_flags[addr] |= CODE_LOOP_START;
       m_code_flags[loop_end] |= CODE_LOOP_END;
     }
@@ -119,20 +277,6 @@ void Analyzer::FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_ad
       m_code_flags[static_cast<u16>(addr + 1u)] |= CODE_LOOP_END;
     }
 
-#ifndef DISABLE_UPDATE_SR_ANALYSIS
-    // Mark the last arithmetic/multiplier instruction before a branch.
-    // We must update the SR reg at these instructions
-    if (opcode->updates_sr)
-    {
-      last_arithmetic = addr;
-    }
-
-    if (opcode->branch && !opcode->uncond_branch)
-    {
-      m_code_flags[last_arithmetic] |= CODE_UPDATE_SR;
-    }
-#endif
-
     // If an instruction potentially raises exceptions, mark the following
     // instruction as needing to check for exceptions
     if (opcode->opcode == 0x00c0 || opcode->opcode == 0x00e0 || opcode->opcode == 0x1600 ||
@@ -148,7 +292,7 @@ void Analyzer::FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_ad
   }
 }
 
-void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
+void Analyzer::FindIdleSkips(const IMEMReader& read_imem, u16 start_addr, u16 end_addr)
 {
   for (size_t s = 0; s < NUM_IDLE_SIGS; s++)
   {
@@ -161,7 +305,7 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
           found = true;
         if (idle_skip_sigs[s][i] == 0xFFFF)
           continue;
-        if (idle_skip_sigs[s][i] != dsp.ReadIMEM(static_cast<u16>(addr + i)))
+        if (idle_skip_sigs[s][i] != read_imem(static_cast<u16>(addr + i)))
           break;
       }
       if (found)
@@ -172,4 +316,47 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindLiveFlags(const IMEMReader& read_imem, u16 start_addr, u16 end_addr)
+{
+  std::vector<u16> instructions;
+  for (u16 addr = start_addr; addr < end_addr;)
+  {
+    instructions.push_back(addr);
+    const DSPOPCTemplate* opcode = GetOpTemplate(read_imem(addr));
+    addr += opcode ? opcode->size : 1;
+  }
+
+  // Walk backwards, keeping track of the flags that may still be read by the code that follows.
+  // Flags are only considered dead if they are overwritten on the fallthrough path before anything
+  // could read them. Anything that can go elsewhere (branches, ends of loops) or touches $sr as a
+  // register makes all flags live again.
+  u16 live_flags = FLAGS_MASK;
+  for (auto it = instructions.rbegin(); it != instructions.rend(); ++it)
+  {
+    const u16 addr = *it;
+    const UDSPInstruction inst = read_imem(addr);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+    if (!opcode || !IsStartOfInstruction(addr))
+    {
+      live_flags = FLAGS_MASK;
+      continue;
+    }
+
+    if (opcode->branch || IsLoopEnd(addr))
+      live_flags = FLAGS_MASK;
+
+    const u16 written_flags = GetWrittenFlags(*opcode);
+    if (written_flags == 0 || (live_flags & written_flags) != 0)
+      m_code_flags[addr] |= CODE_UPDATE_SR;
+    else if (SetsStickyOverflow(*opcode))
+      m_code_flags[addr] |= CODE_UPDATE_SR_STICKY;
+    live_flags &= ~written_flags;
+
+    const u16 inst2 = read_imem(addr + 1);
+    const DSPOPCTemplate* ext_opcode = opcode->extended ? GetExtOpTemplate(inst) : nullptr;
+    if (AccessesSR(*opcode, inst, inst2) || (ext_opcode && AccessesSR(*ext_opcode, inst, inst2)))
+      live_flags = FLAGS_MASK;
+  }
+}
 }  // namespace DSP
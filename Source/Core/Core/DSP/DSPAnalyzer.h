@@ -4,14 +4,10 @@
 #pragma once
 
 #include <array>
-#include "Common/CommonTypes.h"
+#include <functional>
+#include <span>
 
-// The update SR analysis is not perfect: it does not properly handle modified SR values if SR is
-// only read within a function call, and it's possible that a previous instruction sets SR (e.g. the
-// logical zero bit, or the sticky overflow bit) but is marked as not changing SR as a later
-// instruction sets it.  When this flag is set, we always treat instructions as updating SR, and
-// disable the analysis for if SR needs to be set.
-#define DISABLE_UPDATE_SR_ANALYSIS
+#include "Common/CommonTypes.h"
 
 namespace DSP
 {
@@ -43,6 +39,15 @@ public:
   // some pretty expensive analysis if necessary.
   void Analyze(const SDSP& dsp);
 
+  // Analyzes code that isn't loaded into a DSP. The code is treated as if it was located at
+  // address 0 in IRAM.
+  void Analyze(std::span<const u16> code);
+
+  // Lets IsUpdateSR report flag updates that are overwritten before anything can read them, so that
+  // the JIT can leave them out. Off by default, since a mistake in the analysis breaks games in
+  // ways that are hard to trace back to it. Takes effect on the next analysis.
+  void SetSkipDeadFlagUpdates(bool skip) { m_skip_dead_flag_updates = skip; }
+
   // Whether or not the given address indicates the start of an instruction.
   [[nodiscard]] bool IsStartOfInstruction(u16 address) const
   {
@@ -70,11 +75,17 @@ public:
   // Whether or not the address describes an instruction that requires updating the SR register.
   [[nodiscard]] bool IsUpdateSR(u16 address) const
   {
-#ifdef DISABLE_UPDATE_SR_ANALYSIS
-    return true;
-#else
-    return (GetCodeFlags(address) & CODE_UPDATE_SR) != 0;
-#endif
+    if (!m_analyzed_flags)
+      return true;
+    return (GetCodeFlags(address) & (CODE_UPDATE_SR | CODE_UPDATE_SR_STICKY)) != 0;
+  }
+
+  // Whether or not the address describes an instruction whose flags are all overwritten before
+  // they can be read, except for the sticky overflow bit, which nothing but SR writes can clear.
+  [[nodiscard]] bool IsUpdateSRStickyOnly(u16 address) const
+  {
+    return (GetCodeFlags(address) & (CODE_UPDATE_SR | CODE_UPDATE_SR_STICKY)) ==
+           CODE_UPDATE_SR_STICKY;
   }
 
   // Whether or not the address describes instructions that potentially raise exceptions.
@@ -93,27 +104,38 @@ private:
     CODE_LOOP_END = 8,
     CODE_UPDATE_SR = 16,
     CODE_CHECK_EXC = 32,
+    CODE_UPDATE_SR_STICKY = 64,
   };
 
+  using IMEMReader = std::function<u16(u16 address)>;
+
   // Flushes all analyzed state.
   void Reset();
 
   // Analyzes a region of DSP memory.
   // Note: start is inclusive, end is exclusive.
-  void AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr);
+  void AnalyzeRange(const IMEMReader& read_imem, u16 start_addr, u16 end_addr);
 
   // Finds addresses in the range [start_addr, end_addr) that are the start of an
   // instruction. During this process other attributes may be detected as well
   // for relevant instructions (loop start/end, etc).
-  void FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_addr);
+  void FindInstructionStarts(const IMEMReader& read_imem, u16 start_addr, u16 end_addr);
 
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
-  void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
+  void FindIdleSkips(const IMEMReader& read_imem, u16 start_addr, u16 end_addr);
+
+  // Finds instructions within the range [start_addr, end_addr) whose SR flags may be read before
+  // they are overwritten. Must be run after FindInstructionStarts.
+  void FindLiveFlags(const IMEMReader& read_imem, u16 start_addr, u16 end_addr);
 
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
   // Holds data about all instructions in RAM.
   std::array<u8, 65536> m_code_flags{};
+
+  bool m_skip_dead_flag_updates = false;
+  // Whether the flags of the current analysis come from FindLiveFlags.
+  bool m_analyzed_flags = false;
 };
 }  // namespace DSP
@@ -145,6 +145,8 @@ bool SDSP::Initialize(const DSPInitOptions& opts)
   std::memcpy(irom, opts.irom_contents.data(), DSP_IROM_BYTE_SIZE);
   std::memcpy(coef, opts.coef_contents.data(), DSP_COEF_BYTE_SIZE);
 
+  m_analyzer.SetSkipDeadFlagUpdates(opts.skip_dead_flag_updates);
+
   // Try to load real ROM contents.
   if (!VerifyRoms(*this))
   {
@@ -301,6 +301,11 @@ struct DSPInitOptions
   };
   CoreType core_type = CoreType::JIT64;
 
+  // Whether the JIT may leave out flag updates that the analyzer finds to be overwritten before
+  // they are read.
+  // Default: false.
+  bool skip_dead_flag_updates = false;
+
   // Optional capture logger used to log internal DSP data transfers.
   // Default: dummy implementation, does nothing.
   DSPCaptureLogger* capture_logger;
@@ -12,6 +12,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Tracing.h"
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
@@ -27,7 +28,6 @@ namespace DSP::JIT::x64
 {
 constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
-constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
 DSPEmitter::DSPEmitter(DSPCore& dsp)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
@@ -56,10 +56,31 @@ u16 DSPEmitter::RunCycles(u16 cycles)
     m_dsp_core.CheckExceptions();
   }
 
-  m_cycles_left = cycles;
+  // Blocks always run to completion, so the previous slice may have used more cycles than it was
+  // given. Charge those to this slice so that the DSP doesn't drift ahead of the CPU.
+  if (cycles <= m_cycles_overrun)
+  {
+    m_cycles_overrun -= cycles;
+    return 0;
+  }
+
+  const u16 budget = cycles - m_cycles_overrun;
+  m_cycles_left = budget;
   auto exec_addr = (DSPCompiledCode)m_enter_dispatcher;
   exec_addr();
 
+  // The dispatcher stops once the cycle count reaches zero or wraps around. A block is at most a
+  // few hundred cycles long, so a count above the budget can only be the result of wrapping.
+  if (m_cycles_left > budget)
+  {
+    m_cycles_overrun = static_cast<u16>(0x10000 - m_cycles_left);
+    m_cycles_left = 0;
+  }
+  else
+  {
+    m_cycles_overrun = 0;
+  }
+
   if (m_dsp_core.DSPState().reset_dspjit_codespace)
     ClearIRAMandDSPJITCodespaceReset();
 
@@ -69,6 +90,7 @@ u16 DSPEmitter::RunCycles(u16 cycles)
 void DSPEmitter::DoState(PointerWrap& p)
 {
   p.Do(m_cycles_left);
+  p.Do(m_cycles_overrun);
 }
 
 void DSPEmitter::ClearIRAM()
@@ -134,6 +156,14 @@ bool DSPEmitter::FlagsNeeded() const
   return !analyzer.IsStartOfInstruction(m_compile_pc) || analyzer.IsUpdateSR(m_compile_pc);
 }
 
+bool DSPEmitter::StickyOverflowOnly() const
+{
+  const auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+
+  return analyzer.IsStartOfInstruction(m_compile_pc) &&
+         analyzer.IsUpdateSRStickyOnly(m_compile_pc);
+}
+
 static void FallbackThunk(Interpreter::Interpreter& interpreter, UDSPInstruction inst)
 {
   (interpreter.*Interpreter::GetOp(inst))(inst);
@@ -229,6 +259,8 @@ void DSPEmitter::EmitInstruction(UDSPInstruction inst)
 
 void DSPEmitter::Compile(u16 start_addr)
 {
+  TRACE_SCOPE("DSP", "Compile block");
+
   // Remember the current block address for later
   m_start_address = start_addr;
   m_unresolved_jumps[start_addr].clear();
@@ -285,14 +317,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      WriteBlockExitCycles();
       JMP(m_return_dispatcher);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -321,14 +346,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        WriteBlockExitCycles();
         JMP(m_return_dispatcher);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -384,14 +402,7 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-  {
-    MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-  }
+  WriteBlockExitCycles();
   JMP(m_return_dispatcher);
 }
 
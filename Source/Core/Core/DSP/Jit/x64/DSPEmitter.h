@@ -208,11 +208,13 @@ private:
   void Compile(u16 start_addr);
 
   bool FlagsNeeded() const;
+  bool StickyOverflowOnly() const;
 
   void FallBackToInterpreter(UDSPInstruction inst);
 
+  void WriteBlockExitCycles();
   void WriteBranchExit();
-  void WriteBlockLink(u16 dest);
+  void WriteBlockLink(u16 dest, bool conditional);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -324,6 +326,8 @@ private:
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
   u16 m_cycles_left = 0;
+  // Cycles used beyond the end of the previous time slice
+  u16 m_cycles_overrun = 0;
 
   // The index of the last stored ext value (compile time).
   int m_store_index = -1;
@@ -7,6 +7,7 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPTables.h"
 
 using namespace Gen;
@@ -97,24 +98,32 @@ void DSPEmitter::ReJitConditional(const UDSPInstruction opc,
   SetJumpTarget(skip_code);
 }
 
-void DSPEmitter::WriteBranchExit()
+void DSPEmitter::WriteBlockExitCycles()
 {
-  DSPJitRegCache c(m_gpr);
-  m_gpr.SaveRegs();
-  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+  if (!Host::OnThread() && m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
   {
-    MOV(16, R(EAX), Imm16(0x1000));
+    // This block polls a mailbox, which can only change once the CPU has run again, so the DSP
+    // would spin here for the rest of its time slice. Skip ahead to the end of the slice.
+    MOV(64, R(RCX), ImmPtr(&m_cycles_left));
+    MOVZX(32, 16, EAX, MatR(RCX));
   }
   else
   {
     MOV(16, R(EAX), Imm16(m_block_size[m_start_address]));
   }
+}
+
+void DSPEmitter::WriteBranchExit()
+{
+  DSPJitRegCache c(m_gpr);
+  m_gpr.SaveRegs();
+  WriteBlockExitCycles();
   JMP(m_return_dispatcher);
   m_gpr.LoadRegs(false);
   m_gpr.FlushRegs(c, false);
 }
 
-void DSPEmitter::WriteBlockLink(u16 dest)
+void DSPEmitter::WriteBlockLink(u16 dest, bool conditional)
 {
   // Jump directly to the called block if it has already been compiled.
   if (!(dest >= m_start_address && dest <= m_compile_pc))
@@ -133,10 +142,12 @@ void DSPEmitter::WriteBlockLink(u16 dest)
       JMP(m_block_links[dest]);
       SetJumpTarget(notEnoughCycles);
     }
-    else
+    else if (!conditional)
     {
       // The destination has not been compiled yet.  Add it to the list
       // of blocks that this block is waiting on.
+      // Conditional branches only link to blocks that already exist, since waiting on them would
+      // make loops spanning several blocks wait on each other forever.
       m_unresolved_jumps[m_start_address].push_back(dest);
     }
   }
@@ -147,9 +158,7 @@ void DSPEmitter::r_jcc(const UDSPInstruction opc)
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -194,9 +203,7 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -71,22 +71,28 @@ void DSPEmitter::Update_SR_Register64(Gen::X64Reg val, Gen::X64Reg scratch)
 void DSPEmitter::UpdateSR64AddSub(Gen::X64Reg val1, Gen::X64Reg val2, Gen::X64Reg result,
                                   Gen::X64Reg scratch, bool subtract)
 {
-  const OpArg sr_reg = m_gpr.GetReg(DSP_REG_SR);
-  // g_dsp.r[DSP_REG_SR] &= ~SR_CMP_MASK;
-  AND(16, sr_reg, Imm16(~SR_CMP_MASK));
+  // If the other flags are overwritten before they're used, only the sticky overflow bit matters.
+  const bool sticky_only = StickyOverflowOnly();
 
-  CMP(64, R(val1), R(result));
-  // x86 ZF set if val1 == result
-  // x86 CF set if val1 < result
-  // Note that x86 uses a different definition of carry than the DSP
-
-  // 0x01
-  // g_dsp.r[DSP_REG_SR] |= SR_CARRY;
-  // isCarryAdd = (val1 > result) => skip setting if (val <= result) => jump if ZF or CF => use JBE
-  // isCarrySubtract = (val1 >= result) => skip setting if (val < result) => jump if CF => use JB
-  FixupBranch noCarry = J_CC(subtract ? CC_B : CC_BE);
-  OR(16, sr_reg, Imm16(SR_CARRY));
-  SetJumpTarget(noCarry);
+  const OpArg sr_reg = m_gpr.GetReg(DSP_REG_SR);
+  if (!sticky_only)
+  {
+    // g_dsp.r[DSP_REG_SR] &= ~SR_CMP_MASK;
+    AND(16, sr_reg, Imm16(~SR_CMP_MASK));
+
+    CMP(64, R(val1), R(result));
+    // x86 ZF set if val1 == result
+    // x86 CF set if val1 < result
+    // Note that x86 uses a different definition of carry than the DSP
+
+    // 0x01
+    // g_dsp.r[DSP_REG_SR] |= SR_CARRY;
+    // isCarryAdd = (val1 > result) => skip setting if (val <= result) => jump if ZF or CF => use JBE
+    // isCarrySubtract = (val1 >= result) => skip setting if (val < result) => jump if CF => use JB
+    FixupBranch noCarry = J_CC(subtract ? CC_B : CC_BE);
+    OR(16, sr_reg, Imm16(SR_CARRY));
+    SetJumpTarget(noCarry);
+  }
 
   // 0x02 and 0x80
   // g_dsp.r[DSP_REG_SR] |= SR_OVERFLOW;
@@ -102,7 +108,7 @@ void DSPEmitter::UpdateSR64AddSub(Gen::X64Reg val1, Gen::X64Reg val2, Gen::X64Re
 
   TEST(64, R(scratch), R(result));  // Test scratch & value
   FixupBranch noOverflow = J_CC(CC_GE);
-  OR(16, sr_reg, Imm16(SR_OVERFLOW | SR_OVERFLOW_STICKY));
+  OR(16, sr_reg, Imm16(sticky_only ? SR_OVERFLOW_STICKY : SR_OVERFLOW | SR_OVERFLOW_STICKY));
   SetJumpTarget(noOverflow);
 
   // Restore result and val2 -- TODO: does this really matter?
@@ -111,7 +117,8 @@ void DSPEmitter::UpdateSR64AddSub(Gen::X64Reg val1, Gen::X64Reg val2, Gen::X64Re
     NEG(64, R(val2));
 
   m_gpr.PutReg(DSP_REG_SR);
-  Update_SR_Register(result, scratch);
+  if (!sticky_only)
+    Update_SR_Register(result, scratch);
 }
 
 // In: RAX: s16 _Value (middle)
@@ -35,6 +35,9 @@ public:
   virtual void DSP_StopSoundStream() = 0;
   virtual u32 DSP_UpdateRate() = 0;
 
+  // Waits for DSP work that runs off the CPU thread and accesses guest memory or ARAM.
+  virtual void WaitForPendingWork() {}
+
 protected:
   bool m_wii = false;
 };
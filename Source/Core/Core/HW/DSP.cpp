@@ -31,6 +31,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
 
+#include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
 #include "Core/HW/HSP/HSP.h"
@@ -424,14 +425,19 @@ void DSPManager::UpdateDSPSlice(int cycles)
 void DSPManager::UpdateAudioDMA()
 {
   static short zero_samples[8 * 2] = {0};
+
+  // NetPlay rollback simulates frames again that were already heard, so the DMA still runs, but its
+  // samples are dropped instead of being played twice.
+  const bool output_audio = !Core::GetIsResimulating();
   if (m_audio_dma.AudioDMAControl.Enable)
   {
     // Read audio at g_audioDMA.current_source_address in RAM and push onto an
     // external audio fifo in the emulator, to be mixed with the disc
     // streaming output.
     auto& memory = m_system.GetMemory();
-    void* address = memory.GetPointerForRange(m_audio_dma.current_source_address, 32);
-    AudioCommon::SendAIBuffer(m_system, static_cast<short*>(address), 8);
+    const u8* address = memory.GetReadPointerForRange(m_audio_dma.current_source_address, 32);
+    if (output_audio)
+      AudioCommon::SendAIBuffer(m_system, reinterpret_cast<const short*>(address), 8);
 
     if (m_audio_dma.remaining_blocks_count != 0)
     {
@@ -447,7 +453,7 @@ void DSPManager::UpdateAudioDMA()
       GenerateDSPInterrupt(DSP::INT_AID, 0);
     }
   }
-  else
+  else if (output_audio)
   {
     AudioCommon::SendAIBuffer(m_system, &zero_samples[0], 8);
   }
@@ -458,6 +464,9 @@ void DSPManager::Do_ARAM_DMA()
   auto& core_timing = m_system.GetCoreTiming();
   auto& memory = m_system.GetMemory();
 
+  // The DSP emulator may still be reading ARAM or writing to the DMA's memory range.
+  m_dsp_emulator->WaitForPendingWork();
+
   m_dsp_control.DMAState = 1;
 
   // ARAM DMA transfer rate has been measured on real hw
@@ -558,6 +567,10 @@ void DSPManager::Do_ARAM_DMA()
               Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
         }
 
+        // On Wii, ARAM is backed by MEM2.
+        if (m_aram.wii_mode)
+          memory.MarkDirty(0x10000000 | (m_aram_dma.ARAddr & m_aram.mask), 8);
+
         m_aram_dma.MMAddr += 8;
         m_aram_dma.ARAddr += 8;
         m_aram_dma.Cnt.count -= 8;
@@ -565,7 +578,7 @@ void DSPManager::Do_ARAM_DMA()
     }
     else if (!m_aram.wii_mode)
     {
-      auto* mm_ptr = memory.GetPointerForRange(m_aram_dma.MMAddr, m_aram_dma.Cnt.count);
+      const u8* mm_ptr = memory.GetReadPointerForRange(m_aram_dma.MMAddr, m_aram_dma.Cnt.count);
       if (mm_ptr != nullptr)
       {
         auto& hsp = m_system.GetHSP();
@@ -611,6 +624,8 @@ void DSPManager::WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
   m_aram.ptr[address & m_aram.mask] = value;
+  if (m_aram.wii_mode)
+    m_system.GetMemory().MarkDirty(0x10000000 | (address & m_aram.mask), 1);
 }
 
 u8* DSPManager::GetARAMPtr() const
@@ -3,9 +3,13 @@
 
 #include "Core/HW/DSPHLE/DSPHLE.h"
 
+#include <utility>
+
+#include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -14,7 +18,8 @@
 
 namespace DSP::HLE
 {
-DSPHLE::DSPHLE(Core::System& system) : m_mail_handler(system.GetDSP()), m_system(system)
+DSPHLE::DSPHLE(Core::System& system)
+    : m_mail_handler(system.GetDSP()), m_render_memory(system.GetMemory()), m_system(system)
 {
 }
 
@@ -22,6 +27,8 @@ DSPHLE::~DSPHLE() = default;
 
 bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 {
+  StopRenderThread();
+
   m_wii = wii;
   m_ucode = nullptr;
   m_last_ucode = nullptr;
@@ -35,6 +42,12 @@ bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 
   m_dsp_state.Reset();
 
+  // The render thread still reads sample data from ARAM and, on Wii, from guest memory while the
+  // CPU thread runs, so keep it off when the results must be reproducible.
+  m_render_on_thread = Config::Get(Config::MAIN_DSP_HLE_THREAD) && !Core::WantsDeterminism();
+  if (m_render_on_thread)
+    m_render_thread.Reset("DSP HLE Render");
+
   return true;
 }
 
@@ -44,15 +57,49 @@ void DSPHLE::DSP_StopSoundStream()
 
 void DSPHLE::Shutdown()
 {
+  StopRenderThread();
   m_ucode = nullptr;
 }
 
 void DSPHLE::DSP_Update(int cycles)
 {
+  WaitForRender();
+
+  if (m_render_on_thread && Core::WantsDeterminism())
+    StopRenderThread();
+
   if (m_ucode != nullptr)
     m_ucode->Update();
 }
 
+void DSPHLE::QueueRender(std::function<void()> render, std::function<void()> complete)
+{
+  ASSERT(m_render_on_thread);
+  m_render_pending = true;
+  m_render_complete = std::move(complete);
+  m_render_thread.Push(std::move(render));
+}
+
+void DSPHLE::WaitForRender()
+{
+  if (!m_render_pending)
+    return;
+
+  m_render_thread.WaitForCompletion();
+  m_render_pending = false;
+
+  // The game must not see the completion mail before the results are in guest memory.
+  m_render_memory.ApplyDeferredWrites();
+  std::exchange(m_render_complete, nullptr)();
+}
+
+void DSPHLE::StopRenderThread()
+{
+  WaitForRender();
+  m_render_thread.Shutdown();
+  m_render_on_thread = false;
+}
+
 u32 DSPHLE::DSP_UpdateRate()
 {
   // AX HLE uses 3ms (Wii) or 5ms (GC) timing period
@@ -62,6 +109,8 @@ u32 DSPHLE::DSP_UpdateRate()
 
 void DSPHLE::SendMailToDSP(u32 mail)
 {
+  WaitForRender();
+
   if (m_ucode != nullptr)
   {
     DEBUG_LOG_FMT(DSP_MAIL, "CPU writes {:#010x}", mail);
@@ -98,6 +147,8 @@ void DSPHLE::SwapUCode(u32 crc)
 
 void DSPHLE::DoState(PointerWrap& p)
 {
+  WaitForRender();
+
   bool is_hle = true;
   p.Do(is_hle);
   if (!is_hle && p.IsReadMode())
@@ -148,6 +199,7 @@ u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
   }
   else
   {
+    WaitForRender();
     return AccessMailHandler().ReadDSPMailboxHigh();
   }
 }
@@ -160,6 +212,7 @@ u16 DSPHLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
   }
   else
   {
+    WaitForRender();
     return AccessMailHandler().ReadDSPMailboxLow();
   }
 }
@@ -194,6 +247,8 @@ void DSPHLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
 // Other DSP functions
 u16 DSPHLE::DSP_WriteControlRegister(u16 value)
 {
+  WaitForRender();
+
   DSP::UDSPControl temp(value);
 
   if (m_dsp_control.DSPHalt != temp.DSPHalt)
@@ -232,6 +287,10 @@ u16 DSPHLE::DSP_WriteControlRegister(u16 value)
 
 u16 DSPHLE::DSP_ReadControlRegister()
 {
+  // The game may poll the control register for the interrupt that ends a command list, which is
+  // only raised once the render thread has finished.
+  WaitForRender();
+
   if (m_dsp_control.DSPInitCode != 0)
   {
     if (m_system.GetSystemTimers().GetFakeTimeBase() >= m_control_reg_init_code_clear_time)
@@ -244,6 +303,7 @@ u16 DSPHLE::DSP_ReadControlRegister()
 
 void DSPHLE::PauseAndLock()
 {
+  WaitForRender();
 }
 
 void DSPHLE::UnpauseAndUnlock()
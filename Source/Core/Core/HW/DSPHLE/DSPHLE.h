@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/DSPEmulator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
+#include "Core/HW/DSPHLE/RenderMemory.h"
 
 namespace Core
 {
@@ -46,6 +49,7 @@ public:
   void DSP_Update(int cycles) override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
+  void WaitForPendingWork() override { WaitForRender(); }
 
   CMailHandler& AccessMailHandler() { return m_mail_handler; }
   void SetUCode(u32 crc);
@@ -53,8 +57,21 @@ public:
 
   Core::System& GetSystem() const { return m_system; }
 
+  // Guest memory accesses made while rendering audio must go through this, see RenderMemory.
+  RenderMemory& GetRenderMemory() { return m_render_memory; }
+
+  // uCodes which support it can render audio on a separate thread instead of the CPU thread.
+  // While rendering is queued, the render function owns the uCode state. It may only access guest
+  // memory through the deferred RenderMemory, and must not send mail. The CPU thread waits for it
+  // the next time it interacts with the DSP or starts an ARAM DMA, applies the buffered writes,
+  // and then calls the complete function, which sends the mail.
+  bool IsRenderThreadEnabled() const { return m_render_on_thread; }
+  void QueueRender(std::function<void()> render, std::function<void()> complete);
+  void WaitForRender();
+
 private:
   void SendMailToDSP(u32 mail);
+  void StopRenderThread();
 
   // Fake mailbox utility
   struct DSPState
@@ -79,6 +96,12 @@ private:
   u64 m_control_reg_init_code_clear_time = 0;
   CMailHandler m_mail_handler;
 
+  RenderMemory m_render_memory;
+  Common::AsyncWorkThreadSP m_render_thread;
+  std::function<void()> m_render_complete;
+  bool m_render_on_thread = false;
+  bool m_render_pending = false;
+
   Core::System& m_system;
 };
 }  // namespace DSP::HLE
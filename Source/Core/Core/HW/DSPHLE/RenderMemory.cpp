@@ -0,0 +1,137 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/RenderMemory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Core/HW/Memmap.h"
+
+namespace DSP::HLE
+{
+RenderMemory::RenderMemory(Memory::MemoryManager& memory) : m_memory(memory)
+{
+}
+
+RenderMemory::~RenderMemory() = default;
+
+void RenderMemory::BeginDeferred()
+{
+  m_captures.clear();
+  m_capture_data.clear();
+  m_writes.clear();
+  m_write_data.clear();
+  m_deferred = true;
+}
+
+void RenderMemory::Capture(u32 address, u32 size)
+{
+  if (!m_deferred || size == 0 || IsCaptured(address, size))
+    return;
+
+  // Ranges are captured generously, so only keep the part that is actually backed by memory.
+  const std::span<u8> span = m_memory.GetSpanForAddress(address);
+  if (span.empty())
+    return;
+  size = static_cast<u32>(std::min<size_t>(size, span.size()));
+
+  m_captures.push_back({address, size, m_capture_data.size()});
+  m_capture_data.insert(m_capture_data.end(), span.begin(), span.begin() + size);
+}
+
+bool RenderMemory::IsCaptured(u32 address, u32 size) const
+{
+  return std::ranges::any_of(m_captures, [&](const Range& capture) {
+    return address >= capture.address && u64(address) + size <= u64(capture.address) + capture.size;
+  });
+}
+
+void RenderMemory::ApplyDeferredWrites()
+{
+  m_deferred = false;
+
+  for (const Range& write : m_writes)
+    m_memory.CopyToEmu(write.address, m_write_data.data() + write.offset, write.size);
+
+  m_captures.clear();
+  m_capture_data.clear();
+  m_writes.clear();
+  m_write_data.clear();
+}
+
+void RenderMemory::CopyFromEmu(void* data, u32 address, size_t size) const
+{
+  if (!m_deferred)
+  {
+    m_memory.CopyFromEmu(data, address, size);
+    return;
+  }
+
+  if (size == 0)
+    return;
+
+  const auto capture = std::ranges::find_if(m_captures, [&](const Range& range) {
+    return address >= range.address && u64(address) + size <= u64(range.address) + range.size;
+  });
+  if (capture != m_captures.end())
+  {
+    std::memcpy(data, m_capture_data.data() + capture->offset + (address - capture->address),
+                size);
+  }
+  else
+  {
+    ERROR_LOG_FMT(DSPHLE, "Uncaptured read of {:#x} bytes from {:#010x} while rendering", size,
+                  address);
+    std::memset(data, 0, size);
+  }
+
+  // Later writes take precedence over earlier ones, as they would in guest memory.
+  u8* const dest = static_cast<u8*>(data);
+  for (const Range& write : m_writes)
+  {
+    const u64 begin = std::max<u64>(address, write.address);
+    const u64 end = std::min<u64>(u64(address) + size, u64(write.address) + write.size);
+    if (begin >= end)
+      continue;
+
+    const u8* src = m_write_data.data() + write.offset + (begin - write.address);
+    std::memcpy(dest + (begin - address), src, end - begin);
+  }
+}
+
+void RenderMemory::CopyToEmu(u32 address, const void* data, size_t size)
+{
+  u8* dest = BeginWrite(address, size);
+  if (dest == nullptr)
+    return;
+
+  std::memcpy(dest, data, size);
+  EndWrite(address, size);
+}
+
+u8* RenderMemory::BeginWrite(u32 address, size_t size)
+{
+  if (size == 0)
+    return nullptr;
+
+  if (!m_deferred)
+  {
+    // GetPointerForRange raises a panic alert for invalid ranges.
+    return m_memory.GetPointerForRange(address, size);
+  }
+
+  m_writes.push_back({address, static_cast<u32>(size), m_write_data.size()});
+  m_write_data.resize(m_write_data.size() + size);
+  return m_write_data.data() + m_writes.back().offset;
+}
+
+void RenderMemory::EndWrite(u32 address, size_t size)
+{
+  if (!m_deferred)
+    m_memory.MarkDirty(address, size);
+}
+}  // namespace DSP::HLE
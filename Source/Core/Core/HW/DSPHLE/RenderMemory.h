@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+namespace Memory
+{
+class MemoryManager;
+}
+
+namespace DSP::HLE
+{
+// Guest memory as seen by HLE uCodes while they render a command list.
+//
+// Normally every access goes straight to guest memory. When a command list is rendered on the
+// DSPHLE render thread, the CPU thread keeps running game code in the meantime, so the render
+// thread must not touch guest memory at all. Instead, the CPU thread captures every range the
+// command list reads before queueing it, and the writes made while rendering are buffered until
+// the CPU thread applies them once rendering is done. Reads see the buffered writes that precede
+// them, so rendering from the captured ranges gives the same results as rendering directly.
+class RenderMemory
+{
+public:
+  explicit RenderMemory(Memory::MemoryManager& memory);
+  RenderMemory(const RenderMemory&) = delete;
+  RenderMemory(RenderMemory&&) = delete;
+  RenderMemory& operator=(const RenderMemory&) = delete;
+  RenderMemory& operator=(RenderMemory&&) = delete;
+  ~RenderMemory();
+
+  // Switches to deferred mode. Must be called on the CPU thread, before the ranges are captured.
+  void BeginDeferred();
+  // Copies a range of guest memory for reads made while deferred. Must be called on the CPU thread.
+  void Capture(u32 address, u32 size);
+  bool IsCaptured(u32 address, u32 size) const;
+  // Writes the buffered writes to guest memory in order and goes back to direct mode. Must be
+  // called on the CPU thread, after rendering is done.
+  void ApplyDeferredWrites();
+  bool IsDeferred() const { return m_deferred; }
+
+  void CopyFromEmu(void* data, u32 address, size_t size) const;
+  void CopyToEmu(u32 address, const void* data, size_t size);
+
+  template <typename T>
+  void CopyFromEmuSwapped(T* data, u32 address, size_t size) const
+  {
+    CopyFromEmu(data, address, size);
+    for (size_t i = 0; i < size / sizeof(T); i++)
+      data[i] = Common::FromBigEndian(data[i]);
+  }
+
+  template <typename T>
+  void CopyToEmuSwapped(u32 address, const T* data, size_t size)
+  {
+    u8* dest = BeginWrite(address, size);
+    if (dest == nullptr)
+      return;
+
+    for (size_t i = 0; i < size / sizeof(T); i++)
+    {
+      const T value = Common::FromBigEndian(data[i]);
+      std::memcpy(dest + i * sizeof(T), &value, sizeof(T));
+    }
+
+    EndWrite(address, size);
+  }
+
+private:
+  struct Range
+  {
+    u32 address;
+    u32 size;
+    size_t offset;
+  };
+
+  // Returns where the data for a write should be stored. EndWrite must be called once it is.
+  u8* BeginWrite(u32 address, size_t size);
+  void EndWrite(u32 address, size_t size);
+
+  Memory::MemoryManager& m_memory;
+  bool m_deferred = false;
+
+  std::vector<Range> m_captures;
+  std::vector<u8> m_capture_data;
+  std::vector<Range> m_writes;
+  std::vector<u8> m_write_data;
+};
+}  // namespace DSP::HLE
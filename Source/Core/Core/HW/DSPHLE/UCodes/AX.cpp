@@ -3,6 +3,7 @@
 
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <iterator>
@@ -14,6 +15,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -27,6 +29,9 @@
 
 namespace DSP::HLE
 {
+// The compressor table starts with the attack ramps, followed by the release ramps.
+constexpr u32 COMPRESSOR_ATTACK_ENTRY_COUNT = 11;
+
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc, bool dummy) : UCodeInterface(dsphle, crc)
 {
 }
@@ -110,47 +115,146 @@ void AXUCode::SignalWorkEnd()
   m_mail_handler.PushMail(DSP_YIELD, true, AX_EMPTY_COMMAND_LIST_CYCLES);
 }
 
+void AXUCode::PushRenderMail(u32 mail)
+{
+  if (m_dsphle->GetRenderMemory().IsDeferred())
+    m_render_mails.push_back(mail);
+  else
+    m_mail_handler.PushMail(mail, true);
+}
+
+void AXUCode::CompleteRender()
+{
+  for (u32 mail : m_render_mails)
+    m_mail_handler.PushMail(mail, true);
+  m_render_mails.clear();
+
+  SignalWorkEnd();
+}
+
 void AXUCode::HandleCommandList()
 {
-  // Temp variables for addresses computation
-  u16 addr_hi, addr_lo;
-  u16 addr2_hi, addr2_lo;
-  u16 size;
+  DecodeCommandList();
+  RunCommandList();
+}
 
-  u32 pb_addr = 0;
+void AXUCode::DecodeCommandList()
+{
+  m_commands.clear();
 
   u32 curr_idx = 0;
-  bool end = false;
-  while (!end)
+  const auto next = [&]() -> u16 {
+    return curr_idx < std::size(m_cmdlist) ? m_cmdlist[curr_idx++] : 0;
+  };
+  const auto next_addr = [&] {
+    const u32 hi = next();
+    return (hi << 16) | next();
+  };
+
+  while (curr_idx < std::size(m_cmdlist))
   {
-    u16 cmd = m_cmdlist[curr_idx++];
+    Command command{static_cast<CmdType>(next()), {}};
+    auto& args = command.args;
 
-    switch (cmd)
+    switch (command.type)
     {
       // Some of these commands are unknown, or unused in this AX HLE.
       // We still need to skip their arguments using "curr_idx += N".
 
     case CMD_SETUP:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      SetupProcessing(HILO_TO_32(addr));
+    case CMD_PB_ADDR:
+    case CMD_UPLOAD_LRS:
+    case CMD_SET_LR:
+    case CMD_MIX_AUXB_NOWRITE:
+    case CMD_SET_OPPOSITE_LR:
+      args[0] = next_addr();
       break;
 
     case CMD_DL_AND_VOL_MIX:
+      args[0] = next_addr();
+      // Volumes for the main, AUXA and AUXB buffers.
+      for (size_t i = 1; i < 4; ++i)
+        args[i] = next();
+      break;
+
+    case CMD_PROCESS:
+    case CMD_UNK_0A:
+    case CMD_UNK_0B:
+    case CMD_UNK_0C:
+      break;
+
+    case CMD_MIX_AUXA:
+    case CMD_MIX_AUXB:
+    case CMD_OUTPUT:
+    case CMD_MIX_AUXB_LR:
+      args[0] = next_addr();
+      args[1] = next_addr();
+      break;
+
+    case CMD_UNK_08:
+      curr_idx += 10;
+      break;  // TODO: check
+
+    case CMD_MORE:
     {
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      u16 vol_main = m_cmdlist[curr_idx++];
-      u16 vol_auxa = m_cmdlist[curr_idx++];
-      u16 vol_auxb = m_cmdlist[curr_idx++];
-      DownloadAndMixWithVolume(HILO_TO_32(addr), vol_main, vol_auxa, vol_auxb);
+      const u32 addr = next_addr();
+      const u16 size = next();
+      CopyCmdList(addr, size);
+      curr_idx = 0;
+      continue;
+    }
+
+    case CMD_END:
+      return;
+
+    case CMD_COMPRESSOR:
+      // Threshold, release frames and table address.
+      args[0] = next();
+      args[1] = next();
+      args[2] = next_addr();
+      break;
+
+    case CMD_SEND_AUX_AND_MIX:
+      // Upload addresses for AUXA LRS and AUXB S, then download addresses for Main L, Main R,
+      // AUXB L and AUXB R.
+      for (size_t i = 0; i < 6; ++i)
+        args[i] = next_addr();
       break;
+
+    default:
+      ERROR_LOG_FMT(DSPHLE, "Unknown command in AX command list: {:04x}",
+                    static_cast<u16>(command.type));
+      return;
     }
 
+    m_commands.push_back(command);
+  }
+}
+
+void AXUCode::RunCommandList()
+{
+  // Runs on the render thread if it is enabled, and on the CPU thread otherwise.
+  TRACE_SCOPE("DSP", "AX command list");
+
+  u32 pb_addr = 0;
+
+  for (const Command& command : m_commands)
+  {
+    const auto& args = command.args;
+
+    switch (command.type)
+    {
+    case CMD_SETUP:
+      SetupProcessing(args[0]);
+      break;
+
+    case CMD_DL_AND_VOL_MIX:
+      DownloadAndMixWithVolume(args[0], static_cast<u16>(args[1]), static_cast<u16>(args[2]),
+                               static_cast<u16>(args[3]));
+      break;
+
     case CMD_PB_ADDR:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      pb_addr = HILO_TO_32(addr);
+      pb_addr = args[0];
       break;
 
     case CMD_PROCESS:
@@ -160,131 +264,140 @@ void AXUCode::HandleCommandList()
     case CMD_MIX_AUXA:
     case CMD_MIX_AUXB:
       // These two commands are handled almost the same internally.
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      addr2_hi = m_cmdlist[curr_idx++];
-      addr2_lo = m_cmdlist[curr_idx++];
-      MixAUXSamples(cmd - CMD_MIX_AUXA, HILO_TO_32(addr), HILO_TO_32(addr2));
+      MixAUXSamples(command.type - CMD_MIX_AUXA, args[0], args[1]);
       break;
 
     case CMD_UPLOAD_LRS:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      UploadLRS(HILO_TO_32(addr));
+      UploadLRS(args[0]);
       break;
 
     case CMD_SET_LR:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      SetMainLR(HILO_TO_32(addr));
+      SetMainLR(args[0]);
       break;
 
     case CMD_UNK_08:
       DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::UsesUnimplementedAXCommand);
-      curr_idx += 10;
-      break;  // TODO: check
-
-    case CMD_MIX_AUXB_NOWRITE:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      MixAUXSamples(1, 0, HILO_TO_32(addr));
       break;
 
-    case CMD_UNK_0A:
-    case CMD_UNK_0B:
-    case CMD_UNK_0C:
-      // nop in all 6 known ucodes we handle here
-      break;
-
-    case CMD_MORE:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      size = m_cmdlist[curr_idx++];
-
-      CopyCmdList(HILO_TO_32(addr), size);
-      curr_idx = 0;
+    case CMD_MIX_AUXB_NOWRITE:
+      MixAUXSamples(1, 0, args[0]);
       break;
 
     case CMD_OUTPUT:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      addr2_hi = m_cmdlist[curr_idx++];
-      addr2_lo = m_cmdlist[curr_idx++];
-      OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr));
-      break;
-
-    case CMD_END:
-      end = true;
+      OutputSamples(args[1], args[0]);
       break;
 
     case CMD_MIX_AUXB_LR:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      addr2_hi = m_cmdlist[curr_idx++];
-      addr2_lo = m_cmdlist[curr_idx++];
-      MixAUXBLR(HILO_TO_32(addr), HILO_TO_32(addr2));
+      MixAUXBLR(args[0], args[1]);
       break;
 
     case CMD_SET_OPPOSITE_LR:
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      SetOppositeLR(HILO_TO_32(addr));
+      SetOppositeLR(args[0]);
       break;
 
     case CMD_COMPRESSOR:
-    {
       // 0x4e8a8b21 doesn't have this command, but it doesn't range-check
       // the value properly and ends up jumping into a mixer function
       ASSERT(m_crc != 0x4e8a8b21);
-      u16 threshold = m_cmdlist[curr_idx++];
-      u16 frames = m_cmdlist[curr_idx++];
-      addr_hi = m_cmdlist[curr_idx++];
-      addr_lo = m_cmdlist[curr_idx++];
-      RunCompressor(threshold, frames, HILO_TO_32(addr), 5);
+      RunCompressor(static_cast<u16>(args[0]), static_cast<u16>(args[1]), args[2], 5);
       break;
-    }
 
     // Send the contents of AUXA LRS and AUXB S to RAM, and
     // mix data to MAIN LR and AUXB LR.
     case CMD_SEND_AUX_AND_MIX:
+      SendAUXAndMix(args[0], args[1], args[2], args[3], args[4], args[5]);
+      break;
+
+    default:
+      // nop in all 6 known ucodes we handle here
+      break;
+    }
+  }
+}
+
+void AXUCode::CaptureCommandListInputs()
+{
+  auto& memory = m_dsphle->GetRenderMemory();
+
+  u32 pb_addr = 0;
+  u16 max_release_frames = m_compressor_pos;
+
+  for (const Command& command : m_commands)
+  {
+    const auto& args = command.args;
+
+    switch (command.type)
     {
-      // Address for AUXA LRS upload
-      u16 auxa_lrs_up_hi = m_cmdlist[curr_idx++];
-      u16 auxa_lrs_up_lo = m_cmdlist[curr_idx++];
+    case CMD_SETUP:
+      memory.Capture(args[0], 3 * 9 * sizeof(u16));
+      break;
 
-      // Address for AUXB S upload
-      u16 auxb_s_up_hi = m_cmdlist[curr_idx++];
-      u16 auxb_s_up_lo = m_cmdlist[curr_idx++];
+    case CMD_DL_AND_VOL_MIX:
+    case CMD_MIX_AUXB_NOWRITE:
+      memory.Capture(args[0], 3 * 5 * 32 * sizeof(int));
+      break;
 
-      // Address to read data for Main L
-      u16 main_l_dl_hi = m_cmdlist[curr_idx++];
-      u16 main_l_dl_lo = m_cmdlist[curr_idx++];
+    case CMD_PB_ADDR:
+      pb_addr = args[0];
+      break;
+
+    case CMD_PROCESS:
+      CapturePBList(pb_addr);
+      break;
+
+    case CMD_MIX_AUXA:
+    case CMD_MIX_AUXB:
+      memory.Capture(args[1], 3 * 5 * 32 * sizeof(int));
+      break;
 
-      // Address to read data for Main R
-      u16 main_r_dl_hi = m_cmdlist[curr_idx++];
-      u16 main_r_dl_lo = m_cmdlist[curr_idx++];
+    case CMD_SET_LR:
+    case CMD_SET_OPPOSITE_LR:
+      memory.Capture(args[0], 5 * 32 * sizeof(int));
+      break;
 
-      // Address to read data for AUXB L
-      u16 auxb_l_dl_hi = m_cmdlist[curr_idx++];
-      u16 auxb_l_dl_lo = m_cmdlist[curr_idx++];
+    case CMD_MIX_AUXB_LR:
+      memory.Capture(args[1], 2 * 5 * 32 * sizeof(int));
+      break;
 
-      // Address to read data for AUXB R
-      u16 auxb_r_dl_hi = m_cmdlist[curr_idx++];
-      u16 auxb_r_dl_lo = m_cmdlist[curr_idx++];
+    case CMD_COMPRESSOR:
+      CaptureCompressorTable(args[2], static_cast<u16>(args[1]), 5, &max_release_frames);
+      break;
 
-      SendAUXAndMix(HILO_TO_32(auxa_lrs_up), HILO_TO_32(auxb_s_up), HILO_TO_32(main_l_dl),
-                    HILO_TO_32(main_r_dl), HILO_TO_32(auxb_l_dl), HILO_TO_32(auxb_r_dl));
+    case CMD_SEND_AUX_AND_MIX:
+      for (size_t i = 2; i < 6; ++i)
+        memory.Capture(args[i], 5 * 32 * sizeof(int));
       break;
-    }
 
     default:
-      ERROR_LOG_FMT(DSPHLE, "Unknown command in AX command list: {:04x}", cmd);
-      end = true;
+      // The other commands don't read guest memory.
       break;
     }
   }
 }
 
+void AXUCode::CapturePBList(u32 pb_addr)
+{
+  auto& memory = m_dsphle->GetRenderMemory();
+
+  AXPB pb;
+  while (pb_addr && !memory.IsCaptured(pb_addr, sizeof(pb)))
+  {
+    memory.Capture(pb_addr, sizeof(pb));
+    ReadPB(memory, pb_addr, pb);
+    memory.Capture(HILO_TO_32(pb.updates.data), sizeof(PBUpdateData));
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+}
+
+void AXUCode::CaptureCompressorTable(u32 table_addr, u16 release_frames, u32 millis,
+                                     u16* max_release_frames)
+{
+  // Which ramp is used depends on the samples, so capture every ramp the command can select.
+  *max_release_frames = std::max(*max_release_frames, release_frames);
+  const u32 ramp_count = COMPRESSOR_ATTACK_ENTRY_COUNT + *max_release_frames;
+  m_dsphle->GetRenderMemory().Capture(table_addr, ramp_count * 32 * millis * sizeof(u16));
+}
+
 AXMixControl AXUCode::ConvertMixerControl(u32 mixer_control)
 {
   u32 ret = 0;
@@ -387,17 +500,18 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
   int** buffers[3] = {buffers_main, buffers_auxa, buffers_auxb};
   u16 volumes[3] = {vol_main, vol_auxa, vol_auxb};
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  std::array<int, 3 * 5 * 32> samples;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(samples.data(), addr, sizeof(samples));
   for (u32 i = 0; i < 3; ++i)
   {
-    int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(addr, 3 * 5 * 32 * sizeof(int)));
+    const int* ptr = samples.data();
     u16 volume = volumes[i];
     for (u32 j = 0; j < 3; ++j)
     {
       int* buffer = buffers[i][j];
       for (u32 k = 0; k < 5 * 32; ++k)
       {
-        s64 sample = (s64)(s32)Common::swap32(*ptr++);
+        s64 sample = (s64)(s32)*ptr++;
         sample *= volume;
         buffer[k] += (s32)(sample >> 15);
       }
@@ -412,7 +526,7 @@ static bool HasLpf(u32 crc)
 }
 
 // Read a PB from MRAM/ARAM
-void AXUCode::ReadPB(Memory::MemoryManager& memory, u32 addr, AXPB& pb)
+void AXUCode::ReadPB(RenderMemory& memory, u32 addr, AXPB& pb)
 {
   if (HasLpf(m_crc))
   {
@@ -435,7 +549,7 @@ void AXUCode::ReadPB(Memory::MemoryManager& memory, u32 addr, AXPB& pb)
 }
 
 // Write a PB back to MRAM/ARAM
-void AXUCode::WritePB(Memory::MemoryManager& memory, u32 addr, const AXPB& pb)
+void AXUCode::WritePB(RenderMemory& memory, u32 addr, const AXPB& pb)
 {
   if (HasLpf(m_crc))
   {
@@ -463,7 +577,7 @@ void AXUCode::ProcessPBList(u32 pb_addr)
 
   AXPB pb;
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   while (pb_addr)
   {
     AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
@@ -512,7 +626,7 @@ void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
   }
 
   // First, we need to send the contents of our AUX buffers to the CPU.
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   if (write_addr)
   {
     for (auto& buffer : buffers)
@@ -524,21 +638,21 @@ void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
 
   // Then, we read the new temp from the CPU and add to our current
   // temp.
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(
-      read_addr, sizeof(m_samples_main_left) + sizeof(m_samples_main_right) +
-                     sizeof(m_samples_main_surround)));
+  std::array<int, 3 * 5 * 32> samples;
+  memory.CopyFromEmuSwapped(samples.data(), read_addr, sizeof(samples));
+  const int* ptr = samples.data();
 
   for (auto& sample : m_samples_main_left)
-    sample += (int)Common::swap32(*ptr++);
+    sample += *ptr++;
   for (auto& sample : m_samples_main_right)
-    sample += (int)Common::swap32(*ptr++);
+    sample += *ptr++;
   for (auto& sample : m_samples_main_surround)
-    sample += (int)Common::swap32(*ptr++);
+    sample += *ptr++;
 }
 
 void AXUCode::UploadLRS(u32 dst_addr)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
 
   for (const auto& samples : {m_samples_main_left, m_samples_main_right, m_samples_main_surround})
   {
@@ -549,11 +663,11 @@ void AXUCode::UploadLRS(u32 dst_addr)
 
 void AXUCode::SetMainLR(u32 src_addr)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(src_addr, 5 * 32 * sizeof(int)));
+  std::array<int, 5 * 32> samples;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(samples.data(), src_addr, sizeof(samples));
   for (u32 i = 0; i < 5 * 32; ++i)
   {
-    int samp = (int)Common::swap32(*ptr++);
+    int samp = samples[i];
     m_samples_main_left[i] = samp;
     m_samples_main_right[i] = samp;
     m_samples_main_surround[i] = 0;
@@ -588,8 +702,7 @@ void AXUCode::RunCompressor(u16 threshold, u16 release_frames, u32 table_addr, u
     // release
     --m_compressor_pos;
     // the release ramps are located after the attack ramps
-    constexpr u32 ATTACK_ENTRY_COUNT = 11;
-    table_offset = (ATTACK_ENTRY_COUNT + m_compressor_pos) * frame_byte_size;
+    table_offset = (COMPRESSOR_ATTACK_ENTRY_COUNT + m_compressor_pos) * frame_byte_size;
   }
   else
   {
@@ -597,12 +710,12 @@ void AXUCode::RunCompressor(u16 threshold, u16 release_frames, u32 table_addr, u
   }
 
   // apply the selected ramp
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  u16* ramp = reinterpret_cast<u16*>(
-      memory.GetPointerForRange(table_addr + table_offset, 32 * millis * sizeof(u16)));
+  std::array<u16, 32 * 5> ramp;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(ramp.data(), table_addr + table_offset,
+                                                 32 * millis * sizeof(u16));
   for (u32 i = 0; i < 32 * millis; ++i)
   {
-    u16 coef = Common::swap16(*ramp++);
+    u16 coef = ramp[i];
     m_samples_main_left[i] = (s64(m_samples_main_left[i]) * coef) >> 15;
     m_samples_main_right[i] = (s64(m_samples_main_right[i]) * coef) >> 15;
   }
@@ -610,7 +723,7 @@ void AXUCode::RunCompressor(u16 threshold, u16 release_frames, u32 table_addr, u
 
 void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   memory.CopyToEmuSwapped(surround_addr, m_samples_main_surround, 5 * 32 * sizeof(int));
 
   // 32 samples per ms, 5 ms, 2 channels
@@ -632,22 +745,24 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
 void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
 {
   // Upload AUXB L/R
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   memory.CopyToEmuSwapped(ul_addr, m_samples_auxB_left, sizeof(m_samples_auxB_left));
   memory.CopyToEmuSwapped(ul_addr + sizeof(m_samples_auxB_left), m_samples_auxB_right,
                           sizeof(m_samples_auxB_right));
 
   // Mix AUXB L/R to MAIN L/R, and replace AUXB L/R
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(dl_addr, 2 * 5 * 32 * sizeof(int)));
+  std::array<int, 2 * 5 * 32> samples;
+  memory.CopyFromEmuSwapped(samples.data(), dl_addr, sizeof(samples));
+  const int* ptr = samples.data();
   for (u32 i = 0; i < 5 * 32; ++i)
   {
-    int samp = Common::swap32(*ptr++);
+    int samp = *ptr++;
     m_samples_auxB_left[i] = samp;
     m_samples_main_left[i] += samp;
   }
   for (u32 i = 0; i < 5 * 32; ++i)
   {
-    int samp = Common::swap32(*ptr++);
+    int samp = *ptr++;
     m_samples_auxB_right[i] = samp;
     m_samples_main_right[i] += samp;
   }
@@ -655,11 +770,11 @@ void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
 
 void AXUCode::SetOppositeLR(u32 src_addr)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(src_addr, 5 * 32 * sizeof(int)));
+  std::array<int, 5 * 32> samples;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(samples.data(), src_addr, sizeof(samples));
   for (u32 i = 0; i < 5 * 32; ++i)
   {
-    int inp = Common::swap32(*ptr++);
+    int inp = samples[i];
     m_samples_main_left[i] = -inp;
     m_samples_main_right[i] = inp;
     m_samples_main_surround[i] = 0;
@@ -670,7 +785,7 @@ void AXUCode::SendAUXAndMix(u32 auxa_lrs_up, u32 auxb_s_up, u32 main_l_dl, u32 m
                             u32 auxb_l_dl, u32 auxb_r_dl)
 {
   // Upload AUXA LRS
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   memory.CopyToEmuSwapped(auxa_lrs_up, m_samples_auxA_left, 32 * 5 * sizeof(int));
   memory.CopyToEmuSwapped(auxa_lrs_up + 32 * 5 * sizeof(int), m_samples_auxA_right,
                           32 * 5 * sizeof(int));
@@ -695,12 +810,12 @@ void AXUCode::SendAUXAndMix(u32 auxa_lrs_up, u32 auxb_s_up, u32 main_l_dl, u32 m
   };
 
   // Download and mix
+  std::array<int, 32 * 5> dl_src;
   for (size_t i = 0; i < dl_buffers.size(); ++i)
   {
-    const int* dl_src =
-        reinterpret_cast<int*>(memory.GetPointerForRange(dl_addrs[i], 32 * 5 * sizeof(int)));
+    memory.CopyFromEmuSwapped(dl_src.data(), dl_addrs[i], sizeof(dl_src));
     for (size_t j = 0; j < 32 * 5; ++j)
-      dl_buffers[i][j] += (int)Common::swap32(*dl_src++);
+      dl_buffers[i][j] += dl_src[j];
   }
 }
 
@@ -730,10 +845,23 @@ void AXUCode::HandleMail(u32 mail)
 
   case MailState::WaitingForCmdListAddress:
     CopyCmdList(mail, m_cmdlist_size);
-    HandleCommandList();
     m_cmdlist_size = 0;
-    SignalWorkEnd();
     m_mail_state = MailState::WaitingForNextTask;
+    if (m_dsphle->IsRenderThreadEnabled() && CanRenderOnThread())
+    {
+      // The command list is decoded here, so that CMD_MORE lists are read on the CPU thread. The
+      // render thread only reads the ranges captured from it. Its writes and mail reach the game
+      // on the CPU thread, once it has finished.
+      DecodeCommandList();
+      m_dsphle->GetRenderMemory().BeginDeferred();
+      CaptureCommandListInputs();
+      m_dsphle->QueueRender([this] { RunCommandList(); }, [this] { CompleteRender(); });
+    }
+    else
+    {
+      HandleCommandList();
+      CompleteRender();
+    }
     break;
 
   case MailState::WaitingForNextTask:
@@ -786,8 +914,7 @@ void AXUCode::CopyCmdList(u32 addr, u16 size)
     return;
   }
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  memory.CopyFromEmuSwapped(m_cmdlist, addr, size * sizeof(u16));
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(m_cmdlist, addr, size * sizeof(u16));
 }
 
 void AXUCode::Update()
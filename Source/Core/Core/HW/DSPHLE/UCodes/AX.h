@@ -14,6 +14,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
@@ -111,6 +112,9 @@ protected:
 
   std::unique_ptr<Accelerator> m_accelerator;
 
+  // Mail sent while rendering a command list on the render thread, see PushRenderMail.
+  std::vector<u32> m_render_mails;
+
   // Constructs without any GC-specific state, so it can be used by the deriving AXWii.
   AXUCode(DSPHLE* dsphle, u32 crc, bool dummy);
 
@@ -127,7 +131,15 @@ protected:
   AXMixControl ConvertMixerControl(u32 mixer_control);
 
   virtual void HandleCommandList();
+  // Whether command lists may be rendered on the DSPHLE render thread, see DSPHLE::QueueRender.
+  virtual bool CanRenderOnThread() const { return true; }
+  void CaptureCompressorTable(u32 table_addr, u16 release_frames, u32 millis,
+                              u16* max_release_frames);
   void SignalWorkEnd();
+  // Sends mail with an interrupt from within a command list. While rendering on the render
+  // thread, the mail is held back until the CPU thread has written the results to guest memory.
+  void PushRenderMail(u32 mail);
+  void CompleteRender();
 
   struct BufferDesc
   {
@@ -138,10 +150,9 @@ protected:
   template <int Millis, size_t BufCount>
   void InitMixingBuffers(u32 init_addr, const std::array<BufferDesc, BufCount>& buffers)
   {
-    auto& system = m_dsphle->GetSystem();
-    auto& memory = system.GetMemory();
     std::array<u16, 3 * BufCount> init_array;
-    memory.CopyFromEmuSwapped(init_array.data(), init_addr, sizeof(init_array));
+    m_dsphle->GetRenderMemory().CopyFromEmuSwapped(init_array.data(), init_addr,
+                                                   sizeof(init_array));
     for (size_t i = 0; i < BufCount; ++i)
     {
       const BufferDesc& buf = buffers[i];
@@ -175,8 +186,17 @@ protected:
   void DoAXState(PointerWrap& p);
 
 private:
-  void ReadPB(Memory::MemoryManager& memory, u32 addr, AXPB& pb);
-  void WritePB(Memory::MemoryManager& memory, u32 addr, const AXPB& pb);
+  void ReadPB(RenderMemory& memory, u32 addr, AXPB& pb);
+  void WritePB(RenderMemory& memory, u32 addr, const AXPB& pb);
+  void CapturePBList(u32 pb_addr);
+
+  // Decodes the command list in m_cmdlist and the CMD_MORE lists it continues with into
+  // m_commands. Must be called on the CPU thread.
+  void DecodeCommandList();
+  void RunCommandList();
+  // Captures the guest memory the commands in m_commands read, so that they can be rendered on the
+  // render thread.
+  void CaptureCommandListInputs();
 
   enum CmdType
   {
@@ -202,6 +222,15 @@ private:
     CMD_SEND_AUX_AND_MIX = 0x13,
   };
 
+  // A decoded command, with the addresses among its arguments joined from their two halves.
+  struct Command
+  {
+    CmdType type;
+    std::array<u32, 6> args;
+  };
+
+  std::vector<Command> m_commands;
+
   enum class MailState
   {
     WaitingForCmdListSize,
@@ -0,0 +1,109 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXKernels.h"
+
+#include <algorithm>
+
+#ifdef _M_X86_64
+#include <emmintrin.h>
+#endif
+
+namespace DSP::HLE::AXKernels
+{
+static s16 ClampS16(s32 sample)
+{
+  return static_cast<s16>(std::clamp<s32>(sample, -0x8000, 0x7FFF));
+}
+
+#ifdef _M_X86_64
+// Returns the volumes used for the next 8 samples: volume + i * volume_delta for i in [0, 8).
+static __m128i GetVolumeRamp(u16 volume, u16 volume_delta)
+{
+  const __m128i index = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                       _mm_mullo_epi16(index, _mm_set1_epi16(static_cast<s16>(volume_delta))));
+}
+
+// Computes (sample * volume) >> 15 for 8 samples, saturated to s16.
+static __m128i ScaleSamples(__m128i samples, __m128i volumes, bool unsigned_volume)
+{
+  const __m128i lo = _mm_mullo_epi16(samples, volumes);
+  __m128i hi = _mm_mulhi_epi16(samples, volumes);
+
+  // The high half of a signed * unsigned product differs from the signed * signed one by the
+  // sample wherever the volume has its top bit set.
+  if (unsigned_volume)
+    hi = _mm_add_epi16(hi, _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+
+  const __m128i product_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+  const __m128i product_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+  return _mm_packs_epi32(product_lo, product_hi);
+}
+#endif
+
+s16 ApplyVolumeEnvelope(s16* samples, u32 count, s16 volume, s16 volume_delta,
+                        bool unsigned_volume)
+{
+  u32 i = 0;
+
+#ifdef _M_X86_64
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i volumes = GetVolumeRamp(volume, volume_delta);
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i),
+                     ScaleSamples(input, volumes, unsigned_volume));
+    volume = static_cast<s16>(volume + volume_delta * 8);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 sample_volume = unsigned_volume ? s32(u16(volume)) : s32(volume);
+    samples[i] = ClampS16((s32(samples[i]) * sample_volume) >> 15);
+    volume = static_cast<s16>(volume + volume_delta);
+  }
+
+  return volume;
+}
+
+u16 MixAdd(int* out, const s16* input, u32 count, u16 volume, u16 volume_delta, s16* dpop)
+{
+  u32 i = 0;
+
+#ifdef _M_X86_64
+  if (count >= 8)
+  {
+    __m128i last = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8)
+    {
+      const __m128i volumes = GetVolumeRamp(volume, volume_delta);
+      const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      last = ScaleSamples(samples, volumes, true);
+
+      // Sign-extend to 32 bits and accumulate.
+      const __m128i last_lo = _mm_srai_epi32(_mm_unpacklo_epi16(last, last), 16);
+      const __m128i last_hi = _mm_srai_epi32(_mm_unpackhi_epi16(last, last), 16);
+      __m128i* const out_lo = reinterpret_cast<__m128i*>(out + i);
+      __m128i* const out_hi = reinterpret_cast<__m128i*>(out + i + 4);
+      _mm_storeu_si128(out_lo, _mm_add_epi32(_mm_loadu_si128(out_lo), last_lo));
+      _mm_storeu_si128(out_hi, _mm_add_epi32(_mm_loadu_si128(out_hi), last_hi));
+
+      volume = static_cast<u16>(volume + volume_delta * 8);
+    }
+    *dpop = static_cast<s16>(_mm_extract_epi16(last, 7));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16 sample = ClampS16((s32(input[i]) * s32(volume)) >> 15);
+    out[i] += sample;
+    volume = static_cast<u16>(volume + volume_delta);
+    *dpop = sample;
+  }
+
+  return volume;
+}
+}  // namespace DSP::HLE::AXKernels
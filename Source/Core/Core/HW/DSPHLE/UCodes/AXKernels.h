@@ -0,0 +1,22 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Sample processing loops shared by AX GC and AX Wii. These run for every active voice and every
+// mixing bus each audio frame, so they have vectorized implementations where available. All of
+// them must produce bit-exact results compared to the straightforward scalar loops.
+namespace DSP::HLE::AXKernels
+{
+// Applies a volume envelope to count samples. The volume is interpreted as signed on GameCube
+// and as unsigned on Wii. Returns the volume after processing all samples.
+s16 ApplyVolumeEnvelope(s16* samples, u32 count, s16 volume, s16 volume_delta,
+                        bool unsigned_volume);
+
+// Adds count samples multiplied by volume to out, adding volume_delta to the volume after every
+// sample. The last mixed sample is stored to *dpop. Returns the volume after processing all
+// samples.
+u16 MixAdd(int* out, const s16* input, u32 count, u16 volume, u16 volume_delta, s16* dpop);
+}  // namespace DSP::HLE::AXKernels
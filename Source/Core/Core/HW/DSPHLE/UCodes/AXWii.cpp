@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
@@ -41,6 +42,8 @@ void AXWiiUCode::Initialize()
 
 void AXWiiUCode::HandleCommandList()
 {
+  TRACE_SCOPE("DSP", "AX command list");
+
   // Temp variables for addresses computation
   u16 addr_hi, addr_lo;
   u16 addr2_hi, addr2_lo;
@@ -273,11 +276,11 @@ void AXWiiUCode::SetupProcessing(u32 init_addr)
 
 void AXWiiUCode::AddToLR(u32 val_addr, bool neg)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(val_addr, 32 * 3 * sizeof(int)));
+  std::array<int, 32 * 3> samples;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(samples.data(), val_addr, sizeof(samples));
   for (int i = 0; i < 32 * 3; ++i)
   {
-    int val = (int)Common::swap32(*ptr++);
+    int val = samples[i];
     if (neg)
       val = -val;
 
@@ -288,16 +291,17 @@ void AXWiiUCode::AddToLR(u32 val_addr, bool neg)
 
 void AXWiiUCode::AddSubToLR(u32 val_addr)
 {
-  auto& memory = m_dsphle->GetSystem().GetMemory();
-  int* ptr = reinterpret_cast<int*>(memory.GetPointerForRange(val_addr, 2 * 32 * 3 * sizeof(int)));
+  std::array<int, 2 * 32 * 3> samples;
+  m_dsphle->GetRenderMemory().CopyFromEmuSwapped(samples.data(), val_addr, sizeof(samples));
+  const int* ptr = samples.data();
   for (int i = 0; i < 32 * 3; ++i)
   {
-    int val = (int)Common::swap32(*ptr++);
+    int val = *ptr++;
     m_samples_main_left[i] += val;
   }
   for (int i = 0; i < 32 * 3; ++i)
   {
-    int val = (int)Common::swap32(*ptr++);
+    int val = *ptr++;
     m_samples_main_right[i] -= val;
   }
 }
@@ -360,7 +364,7 @@ void AXWiiUCode::GenerateVolumeRamp(u16* output, u16 vol1, u16 vol2, size_t nval
   }
 }
 
-void AXWiiUCode::ReadPB(Memory::MemoryManager& memory, u32 addr, AXPBWii& pb)
+void AXWiiUCode::ReadPB(RenderMemory& memory, u32 addr, AXPBWii& pb)
 {
   // The Wii PB memory layout changed twice.
   // For HLE, we use the largest struct version.
@@ -399,7 +403,7 @@ void AXWiiUCode::ReadPB(Memory::MemoryManager& memory, u32 addr, AXPBWii& pb)
   }
 }
 
-void AXWiiUCode::WritePB(Memory::MemoryManager& memory, u32 addr, const AXPBWii& pb)
+void AXWiiUCode::WritePB(RenderMemory& memory, u32 addr, const AXPBWii& pb)
 {
   const char* src = (const char*)&pb;
   constexpr size_t updates_begin = offsetof(AXPBWii, updates);
@@ -439,7 +443,7 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
 
   AXPBWii pb;
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   while (pb_addr)
   {
     AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
@@ -523,7 +527,7 @@ void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 vo
   }
 
   // Send the content of AUX buffers to the CPU
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   if (write_addr)
   {
     for (const auto& buffer : buffers)
@@ -534,13 +538,14 @@ void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 vo
   }
 
   // Then read the buffers from the CPU and add to our main buffers.
-  const int* ptr = reinterpret_cast<int*>(
-      memory.GetPointerForRange(read_addr, main_buffers.size() * 3 * 32 * sizeof(int)));
+  std::array<int, 3 * 3 * 32> samples;
+  memory.CopyFromEmuSwapped(samples.data(), read_addr, sizeof(samples));
+  const int* ptr = samples.data();
   for (auto& main_buffer : main_buffers)
   {
     for (u32 j = 0; j < 3 * 32; ++j)
     {
-      s64 sample = (s64)(s32)Common::swap32(*ptr++);
+      s64 sample = (s64)(s32)*ptr++;
       sample *= volume_ramp[j];
       main_buffer[j] += (s32)(sample >> 15);
     }
@@ -554,7 +559,7 @@ void AXWiiUCode::UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume)
   int* aux_surround = aux_id ? m_samples_auxB_surround : m_samples_auxA_surround;
   int* auxc_buffer = aux_id ? m_samples_auxC_surround : m_samples_auxC_right;
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   memory.CopyToEmuSwapped(addresses[0], aux_left, 96 * sizeof(int));
   memory.CopyToEmuSwapped(addresses[0] + 96 * sizeof(int), aux_right, 96 * sizeof(int));
   memory.CopyToEmuSwapped(addresses[0] + 2 * 96 * sizeof(int), aux_surround, 96 * sizeof(int));
@@ -586,7 +591,7 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
   GenerateVolumeRamp(volume_ramp.data(), m_last_main_volume, volume, volume_ramp.size());
   m_last_main_volume = volume;
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   memory.CopyToEmuSwapped(surround_addr, m_samples_main_surround, 3 * 32 * sizeof(int));
 
   if (upload_auxc)
@@ -618,23 +623,21 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
   }
 
   memory.CopyToEmu(lr_addr, buffer.data(), sizeof(buffer));
-  m_mail_handler.PushMail(DSP_SYNC, true);
+  PushRenderMail(DSP_SYNC);
 }
 
 void AXWiiUCode::OutputWMSamples(u32* addresses)
 {
   int* buffers[] = {m_samples_wm0, m_samples_wm1, m_samples_wm2, m_samples_wm3};
 
-  auto& memory = m_dsphle->GetSystem().GetMemory();
+  auto& memory = m_dsphle->GetRenderMemory();
   for (u32 i = 0; i < 4; ++i)
   {
     int* in = buffers[i];
-    u16* out = reinterpret_cast<u16*>(memory.GetPointerForRange(addresses[i], 3 * 6 * sizeof(s16)));
+    std::array<s16, 3 * 6> out;
     for (u32 j = 0; j < 3 * 6; ++j)
-    {
-      s16 sample = ClampS16(in[j]);
-      out[j] = Common::swap16((u16)sample);
-    }
+      out[j] = ClampS16(in[j]);
+    memory.CopyToEmuSwapped(addresses[i], out.data(), sizeof(out));
   }
 }
 
@@ -57,6 +57,9 @@ protected:
   static void GenerateVolumeRamp(u16* output, u16 vol1, u16 vol2, size_t nvals);
 
   void HandleCommandList() override;
+  // The accelerator reads sample data straight from MEM1 and MEM2 on Wii, which game code may
+  // write to at any time, so command lists are always rendered on the CPU thread.
+  bool CanRenderOnThread() const override { return false; }
 
   void SetupProcessing(u32 init_addr);
   void AddToLR(u32 val_addr, bool neg);
@@ -68,8 +71,8 @@ protected:
   void OutputWMSamples(u32* addresses);  // 4 addresses
 
 private:
-  void ReadPB(Memory::MemoryManager& memory, u32 addr, AXPBWii& pb);
-  void WritePB(Memory::MemoryManager& memory, u32 addr, const AXPBWii& pb);
+  void ReadPB(RenderMemory& memory, u32 addr, AXPBWii& pb);
+  void WritePB(RenderMemory& memory, u32 addr, const AXPBWii& pb);
 
   enum CmdType
   {
@@ -96,7 +96,7 @@ void ROMUCode::BootUCode()
 {
   auto& memory = m_dsphle->GetSystem().GetMemory();
   const u8* pointer =
-      memory.GetPointerForRange(m_current_ucode.m_ram_address, m_current_ucode.m_length);
+      memory.GetReadPointerForRange(m_current_ucode.m_ram_address, m_current_ucode.m_length);
   const u32 ector_crc = Common::HashEctor(pointer, m_current_ucode.m_length);
 
   if (Config::Get(Config::MAIN_DUMP_UCODE))
@@ -95,7 +95,7 @@ void UCodeInterface::PrepareBootUCode(u32 mail)
 
     auto& memory = m_dsphle->GetSystem().GetMemory();
     const u8* pointer =
-        memory.GetPointerForRange(m_next_ucode.iram_mram_addr, m_next_ucode.iram_size);
+        memory.GetReadPointerForRange(m_next_ucode.iram_mram_addr, m_next_ucode.iram_size);
     const u32 ector_crc = Common::HashEctor(pointer, m_next_ucode.iram_size);
 
     if (Config::Get(Config::MAIN_DUMP_UCODE))
@@ -14,6 +14,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/Tracing.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -63,6 +64,7 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
       std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
       if (dsp_thread_lock)
       {
+        TRACE_SCOPE("DSP", "Run cycles");
         if (dsp_lle->m_dsp_core.IsJITCreated())
         {
           dsp_lle->m_dsp_core.RunCycles(cycles);
@@ -121,6 +123,7 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
   if (Config::Get(Config::MAIN_DSP_JIT))
     opts->core_type = DSPInitOptions::CoreType::JIT64;
 #endif
+  opts->skip_dead_flag_updates = Config::Get(Config::MAIN_DSP_JIT_SKIP_DEAD_FLAGS);
 
   if (Config::Get(Config::MAIN_DSP_CAPTURE_LOG))
   {
@@ -1365,6 +1365,7 @@ static void FileReadData(Memory::MemoryManager& memory, File::IOFile* file, u32
   {
     file->Seek(seek_pos, File::SeekOrigin::Begin);
     file->ReadBytes(span.data(), length);
+    memory.MarkDirty(address, length);
   }
   else
   {
@@ -1850,6 +1851,7 @@ u32 ExecuteCommand(std::array<u32, 3>& dicmd_buf, u32* diimm_buf, u32 address, u
     }
     else if (s_dimm_disc->Read(offset, length, span.data()))
     {
+      memory.MarkDirty(address, length);
       return 0;
     }
 
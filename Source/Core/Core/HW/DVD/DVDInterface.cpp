@@ -219,9 +219,13 @@ void DVDInterface::DTKStreamingCallback(DIInterruptType interrupt_type,
     const u32 pending_blocks = std::min(m_pending_blocks, MAX_POSSIBLE_BLOCKS);
     ProcessDTKSamples(temp_pcm.data(), pending_blocks, audio_data);
 
-    SoundStream* sound_stream = m_system.GetSoundStream();
-    sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(),
-                                                   pending_blocks * StreamADPCM::SAMPLES_PER_BLOCK);
+    // Frames that NetPlay rollback simulates again were already heard.
+    if (!Core::GetIsResimulating())
+    {
+      SoundStream* sound_stream = m_system.GetSoundStream();
+      sound_stream->GetMixer()->PushStreamingSamples(
+          temp_pcm.data(), pending_blocks * StreamADPCM::SAMPLES_PER_BLOCK);
+    }
 
     if (m_stream && ai.IsPlaying())
     {
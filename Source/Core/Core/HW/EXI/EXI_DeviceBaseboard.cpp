@@ -159,6 +159,7 @@ void CEXIBaseboard::DMARead(u32 addr, u32 size)
 
   m_backup.Seek(m_backup_offset, File::SeekOrigin::Begin);
   m_backup.ReadBytes(span.data(), size);
+  memory.MarkDirty(addr, size);
 }
 
 void CEXIBaseboard::TransferByte(u8& byte)
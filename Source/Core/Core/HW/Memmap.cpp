@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <cstring>
 #include <map>
@@ -17,6 +18,9 @@
 #include <set>
 #include <span>
 #include <tuple>
+#include <vector>
+
+#include <xxhash.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -38,6 +42,7 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -174,6 +179,9 @@ void MemoryManager::Init()
   m_physical_page_mappings_base = reinterpret_cast<u8*>(m_physical_page_mappings.data());
   m_logical_page_mappings_base = reinterpret_cast<u8*>(m_logical_page_mappings.data());
 
+  const u32 tracked_size = GetRamSize() + (wii ? GetExRamSize() : 0);
+  m_dirty_pages = std::vector<std::atomic<u64>>((tracked_size >> DIRTY_PAGE_SHIFT) / 64);
+
   Clear();
 
   INFO_LOG_FMT(MEMMAP, "Memory system initialized. RAM at {}", fmt::ptr(m_ram));
@@ -548,6 +556,9 @@ void MemoryManager::DoState(PointerWrap& p)
   if (current_have_exram)
     p.DoArray(m_exram, current_exram_size);
   p.DoMarker("Memory EXRAM");
+
+  if (p.IsReadMode())
+    MarkAllDirty();
 }
 
 void MemoryManager::Shutdown()
@@ -565,6 +576,8 @@ void MemoryManager::Shutdown()
   }
   m_arena.ReleaseSHMSegment();
   m_mmio_mapping.reset();
+  m_dirty_page_tracking_enabled = false;
+  m_dirty_pages.clear();
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
@@ -617,9 +630,18 @@ void MemoryManager::Clear()
     memset(m_fake_vmem, 0, GetFakeVMemSize());
   if (m_exram)
     memset(m_exram, 0, GetExRamSize());
+  MarkAllDirty();
 }
 
 u8* MemoryManager::GetPointerForRange(u32 address, size_t size) const
+{
+  const u8* pointer = GetReadPointerForRange(address, size);
+  if (pointer)
+    MarkDirty(address, size);
+  return const_cast<u8*>(pointer);
+}
+
+const u8* MemoryManager::GetReadPointerForRange(u32 address, size_t size) const
 {
   std::span<u8> span = GetSpanForAddress(address);
 
@@ -645,7 +667,7 @@ void MemoryManager::CopyFromEmu(void* data, u32 address, size_t size) const
   if (size == 0)
     return;
 
-  void* pointer = GetPointerForRange(address, size);
+  const void* pointer = GetReadPointerForRange(address, size);
   if (!pointer)
   {
     PanicAlertFmt("Invalid range in CopyFromEmu. {:x} bytes from {:#010x}", size, address);
@@ -800,4 +822,92 @@ void MemoryManager::Write_U64_Swap(u64 value, u32 address)
   CopyToEmu(address, &value, sizeof(value));
 }
 
+void MemoryManager::SetDirtyPageTrackingEnabled(const Core::CPUThreadGuard& guard, bool enabled)
+{
+  if (IsDirtyPageTrackingEnabled() == enabled)
+    return;
+
+  for (std::atomic<u64>& word : m_dirty_pages)
+    word.store(0, std::memory_order_relaxed);
+  m_dirty_page_tracking_enabled = enabled;
+
+  // The JIT reads this flag when it refreshes its config, and only emits stores that bypass
+  // MarkDirty when tracking is off.
+  m_system.GetJitInterface().ClearCache(guard);
+}
+
+void MemoryManager::MarkDirtyRange(u32 address, size_t size) const
+{
+  if (size == 0)
+    return;
+
+  // Map the address onto the bitmap the same way GetSpanForAddress maps it onto host memory.
+  address &= 0x3FFFFFFF;
+  u32 offset;
+  u32 region_end;
+  if (address < GetRamSize())
+  {
+    offset = address;
+    region_end = GetRamSize();
+  }
+  else if (m_exram && (address >> 28) == 0x1 && (address & 0x0FFFFFFF) < GetExRamSize())
+  {
+    offset = GetRamSize() + (address & 0x0FFFFFFF);
+    region_end = GetRamSize() + GetExRamSize();
+  }
+  else
+  {
+    return;
+  }
+
+  const u32 first_page = offset >> DIRTY_PAGE_SHIFT;
+  const u32 last_page =
+      static_cast<u32>(std::min<u64>(u64(offset) + size, region_end) - 1) >> DIRTY_PAGE_SHIFT;
+  for (u32 page = first_page; page <= last_page; ++page)
+    m_dirty_pages[page / 64].fetch_or(u64(1) << (page % 64), std::memory_order_relaxed);
+}
+
+void MemoryManager::MarkAllDirty()
+{
+  if (!IsDirtyPageTrackingEnabled())
+    return;
+
+  for (std::atomic<u64>& word : m_dirty_pages)
+    word.store(~u64(0), std::memory_order_relaxed);
+}
+
+void MemoryManager::CollectDirtyPages(std::vector<u32>& pages)
+{
+  pages.clear();
+
+  const u32 mem1_pages = GetRamSize() >> DIRTY_PAGE_SHIFT;
+  for (size_t i = 0; i < m_dirty_pages.size(); ++i)
+  {
+    // Most words are clean, so avoid dirtying their cache lines with an exchange.
+    if (m_dirty_pages[i].load(std::memory_order_relaxed) == 0)
+      continue;
+
+    u64 bits = m_dirty_pages[i].exchange(0, std::memory_order_relaxed);
+    while (bits != 0)
+    {
+      const u32 page = static_cast<u32>(i * 64) + std::countr_zero(bits);
+      bits &= bits - 1;
+      if (page < mem1_pages)
+        pages.push_back(page << DIRTY_PAGE_SHIFT);
+      else
+        pages.push_back(0x10000000 | ((page - mem1_pages) << DIRTY_PAGE_SHIFT));
+    }
+  }
+}
+
+u64 MemoryManager::ComputeHash() const
+{
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_64bits_reset(&state);
+  XXH3_64bits_update(&state, m_ram, GetRamSizeReal());
+  if (m_exram)
+    XXH3_64bits_update(&state, m_exram, GetExRamSizeReal());
+  return XXH3_64bits_digest(&state);
+}
 }  // namespace Memory
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -21,6 +22,7 @@
 class PointerWrap;
 namespace Core
 {
+class CPUThreadGuard;
 class System;
 }
 namespace MMIO
@@ -124,7 +126,10 @@ public:
 
   // If the specified range is within a single valid memory region, returns a pointer to the start
   // of the corresponding range in host memory. Otherwise, returns nullptr.
+  // Since the caller may write through the pointer, the range is marked as dirty.
   u8* GetPointerForRange(u32 address, size_t size) const;
+  // Same as GetPointerForRange, for callers that only read.
+  const u8* GetReadPointerForRange(u32 address, size_t size) const;
   void CopyFromEmu(void* data, u32 address, size_t size) const;
   void CopyToEmu(u32 address, const void* data, size_t size);
   void Memset(u32 address, u8 value, size_t size);
@@ -144,7 +149,7 @@ public:
   template <typename T>
   void CopyFromEmuSwapped(T* data, u32 address, size_t size) const
   {
-    const T* src = reinterpret_cast<T*>(GetPointerForRange(address, size));
+    const T* src = reinterpret_cast<const T*>(GetReadPointerForRange(address, size));
 
     if (src == nullptr)
       return;
@@ -165,6 +170,33 @@ public:
       dest[i] = Common::FromBigEndian(data[i]);
   }
 
+  // Dirty page tracking for MEM1 and MEM2. While enabled, writes performed by the CPU and by the
+  // write functions above mark the containing DIRTY_PAGE_SIZE pages as dirty, and so does
+  // GetPointerForRange. GetSpanForAddress doesn't know how much of its span will be written, so
+  // code that writes to it must call MarkDirty itself, as must code that writes through a pointer
+  // after the pages may have been collected, e.g. on another thread.
+  // Toggling tracking clears the JIT cache, since JIT stores must then take the slow path.
+  static constexpr u32 DIRTY_PAGE_SHIFT = 12;
+  static constexpr u32 DIRTY_PAGE_SIZE = 1 << DIRTY_PAGE_SHIFT;
+
+  void SetDirtyPageTrackingEnabled(const Core::CPUThreadGuard& guard, bool enabled);
+  bool IsDirtyPageTrackingEnabled() const
+  {
+    return m_dirty_page_tracking_enabled.load(std::memory_order_relaxed);
+  }
+  void MarkDirty(u32 address, size_t size) const
+  {
+    if (IsDirtyPageTrackingEnabled()) [[unlikely]]
+      MarkDirtyRange(address, size);
+  }
+  void MarkAllDirty();
+  // Replaces the contents of pages with the physical addresses of all pages written to since the
+  // last call, and marks those pages as clean again.
+  void CollectDirtyPages(std::vector<u32>& pages);
+
+  // Returns a 64-bit hash of the contents of MEM1 and MEM2.
+  u64 ComputeHash() const;
+
 private:
   enum class HostPageType
   {
@@ -284,6 +316,11 @@ private:
   std::map<u32, std::vector<u32>> m_large_readable_pages;
   std::map<u32, std::vector<u32>> m_large_writeable_pages;
 
+  // One bit per DIRTY_PAGE_SIZE page. MEM1 pages come first, followed by MEM2 pages.
+  std::atomic<bool> m_dirty_page_tracking_enabled = false;
+  // Mutable so that GetPointerForRange can mark the pages it hands out.
+  mutable std::vector<std::atomic<u64>> m_dirty_pages;
+
   Core::System& m_system;
 
   static HostPageType GetHostPageTypeForPageSize(u32 page_size);
@@ -297,5 +334,7 @@ private:
   void RemoveLargePageTableMapping(u32 logical_address);
   void RemoveLargePageTableMapping(u32 logical_address, std::map<u32, std::vector<u32>>& map);
   void RemoveHostPageTableMapping(u32 logical_address);
+
+  void MarkDirtyRange(u32 address, size_t size) const;
 };
 }  // namespace Memory
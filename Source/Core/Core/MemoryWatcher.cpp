@@ -3,22 +3,41 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <unistd.h>
+#include <utility>
 
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/MemoryWatcherRing.h"
 #include "Core/PowerPC/MMU.h"
 
+// Ranges are diffed in blocks of this many bytes, and consecutive changed blocks are published as
+// a single entry. This keeps the per-entry overhead low without sending much unchanged data.
+constexpr u32 DIFF_BLOCK_SIZE = 32;
+// Watches are copied and compared every frame, so they can't cover more than this.
+constexpr u32 MAX_WATCH_LENGTH = 0x100000;
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY))
+  {
+    if (!OpenRing(File::GetUserPath(F_MEMORYWATCHERRING_IDX)))
+      return;
+  }
+  else if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
     return;
+  }
   m_running = true;
 }
 
@@ -28,7 +47,8 @@ MemoryWatcher::~MemoryWatcher()
     return;
 
   m_running = false;
-  close(m_fd);
+  if (m_fd >= 0)
+    close(m_fd);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -40,21 +60,44 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
 
   std::string line;
   while (std::getline(locations, line))
-    ParseLine(line);
+  {
+    if (!line.empty())
+      m_watches.push_back(ParseLine(line));
+  }
 
-  return !m_values.empty();
+  return std::ranges::any_of(m_watches, [](const Watch& watch) { return !watch.IsIgnored(); });
 }
 
-void MemoryWatcher::ParseLine(const std::string& line)
+MemoryWatcher::Watch MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch watch;
+  watch.line = line;
+
+  const size_t colon = line.find(':');
+  if (colon != std::string::npos)
+  {
+    std::istringstream length(line.substr(colon + 1));
+    length >> std::hex >> watch.length;
+    if (!length)
+      watch.length = 0;
+
+    // The watch is kept, so that the indices of the following ones still match their lines.
+    if (watch.length > MAX_WATCH_LENGTH)
+    {
+      ERROR_LOG_FMT(CORE, "Ignoring memory watch {}: length is larger than {:#x}", line,
+                    MAX_WATCH_LENGTH);
+      return watch;
+    }
+  }
 
-  std::istringstream offsets(line);
+  std::istringstream offsets(line.substr(0, colon));
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  watch.value.resize(watch.length != 0 ? watch.length : sizeof(u32));
+  return watch;
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -66,10 +109,32 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenRing(const std::string& path)
+{
+  // Make sure that even a snapshot of every watch fits into the ring a few times over.
+  u64 snapshot_size = sizeof(MemoryWatcherRing::BatchHeader);
+  for (const Watch& watch : m_watches)
+  {
+    const u64 max_entries = (watch.value.size() + DIFF_BLOCK_SIZE - 1) / DIFF_BLOCK_SIZE;
+    snapshot_size += watch.value.size() +
+                     max_entries * (sizeof(MemoryWatcherRing::EntryHeader) +
+                                    MemoryWatcherRing::RECORD_ALIGNMENT);
+  }
+
+  m_ring = std::make_unique<MemoryWatcherRing::Writer>();
+  if (!m_ring->Open(path, std::max<u64>(snapshot_size * 4, 1 << 20)))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to create memory watcher ring buffer at {}", path);
+    m_ring.reset();
+    return false;
+  }
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::MMU::HostRead<u32>(guard, value + offset);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
@@ -78,33 +143,138 @@ u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::st
   return value;
 }
 
+// Reads the current contents of the watch into value, and returns the address they were read from.
+u32 MemoryWatcher::ReadWatch(const Core::CPUThreadGuard& guard, const Watch& watch,
+                             std::span<u8> value)
+{
+  if (watch.length == 0)
+  {
+    Common::WriteSwap32(value.data(), ChasePointer(guard, watch));
+    return 0;
+  }
+
+  u32 address = 0;
+  for (size_t i = 0; i < watch.offsets.size(); ++i)
+  {
+    address += watch.offsets[i];
+    if (i + 1 == watch.offsets.size())
+      break;
+
+    address = PowerPC::MMU::HostRead<u32>(guard, address);
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
+    {
+      std::ranges::fill(value, 0);
+      return address;
+    }
+  }
+
+  // Unmapped bytes read as zero.
+  for (size_t i = 0; i < value.size();)
+  {
+    const u32 current = address + static_cast<u32>(i);
+    if (current % sizeof(u32) == 0 && value.size() - i >= sizeof(u32))
+    {
+      const auto result = PowerPC::MMU::HostTryRead<u32>(guard, current);
+      Common::WriteSwap32(value.data() + i, result ? result->value : 0);
+      i += sizeof(u32);
+    }
+    else
+    {
+      const auto result = PowerPC::MMU::HostTryRead<u8>(guard, current);
+      value[i] = result ? result->value : 0;
+      ++i;
+    }
+  }
+  return address;
+}
+
 std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
 {
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  for (Watch& watch : m_watches)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    if (watch.IsIgnored())
+      continue;
+
+    m_new_value.resize(watch.value.size());
+    ReadWatch(guard, watch, m_new_value);
+    if (m_new_value == watch.value)
+      continue;
 
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+    // Update the value
+    watch.value = m_new_value;
+    message_stream << watch.line << '\n';
+    if (watch.length == 0)
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      message_stream << Common::swap32(watch.value.data()) << '\n';
+    }
+    else
+    {
+      for (const u8 byte : watch.value)
+        message_stream << (byte >> 4) << (byte & 0xf);
+      message_stream << '\n';
     }
   }
 
   return message_stream.str();
 }
 
+void MemoryWatcher::PublishChanges(const Core::CPUThreadGuard& guard)
+{
+  // The first batch is always a snapshot, so readers that are already waiting get every value.
+  const bool snapshot = m_ring->TakeSnapshotRequest() || m_frame == 0;
+  m_ring->BeginBatch(m_frame, snapshot ? MemoryWatcherRing::BATCH_FLAG_SNAPSHOT : 0);
+
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    Watch& watch = m_watches[i];
+    if (watch.IsIgnored())
+      continue;
+
+    m_new_value.resize(watch.value.size());
+    const u32 address = ReadWatch(guard, watch, m_new_value);
+
+    const u32 size = static_cast<u32>(m_new_value.size());
+    u32 changed_start = size;
+    for (u32 block = 0; block < size; block += DIFF_BLOCK_SIZE)
+    {
+      const u32 block_size = std::min(DIFF_BLOCK_SIZE, size - block);
+      const bool changed = snapshot || std::memcmp(m_new_value.data() + block,
+                                                   watch.value.data() + block, block_size) != 0;
+      if (changed && changed_start == size)
+        changed_start = block;
+
+      const u32 block_end = block + block_size;
+      if (changed_start != size && (!changed || block_end == size))
+      {
+        const u32 changed_end = changed ? block_end : block;
+        m_ring->AddEntry(static_cast<u32>(i), changed_start, address + changed_start,
+                         std::span(m_new_value).subspan(changed_start, changed_end - changed_start));
+        changed_start = size;
+      }
+    }
+
+    std::ranges::copy(m_new_value, watch.value.begin());
+  }
+
+  if (!m_ring->EndBatch())
+    WARN_LOG_FMT(CORE, "Memory watcher batch for frame {} doesn't fit into the ring", m_frame);
+  ++m_frame;
+}
+
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
 {
   if (!m_running)
     return;
 
+  if (m_ring)
+  {
+    PublishChanges(guard);
+    return;
+  }
+
   std::string message = ComposeMessages(guard);
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
@@ -5,7 +5,8 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -16,6 +17,11 @@ namespace Core
 class CPUThreadGuard;
 }
 
+namespace MemoryWatcherRing
+{
+class Writer;
+}
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -24,6 +30,15 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// A line can end with a colon and a hex byte count to watch a range of memory
+// instead of a single u32. For example, "ABCD EF:40" watches the 0x40 bytes
+// starting at (*0xABCD) + 0xEF. On the socket, the new contents of a range are
+// sent as a hex string.
+//
+// If MAIN_MEMORY_WATCHER_SHARED_MEMORY is enabled, changes are published to a
+// shared memory ring buffer instead of the socket. See MemoryWatcherRing.h for
+// the format.
 class MemoryWatcher final
 {
 public:
@@ -31,21 +46,41 @@ public:
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
+  struct Watch
+  {
+    // The line from the input file.
+    std::string line;
+    std::vector<u32> offsets;
+    // Number of bytes watched at the end of the pointer chain, or 0 to watch the u32 the
+    // pointer chain ends on.
+    u32 length = 0;
+    // Current contents, in guest byte order. Empty if the watch was rejected, in which case it
+    // is never read but still takes up its index.
+    std::vector<u8> value;
+
+    bool IsIgnored() const { return value.empty(); }
+  };
+
+  static Watch ParseLine(const std::string& line);
+
 private:
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenRing(const std::string& path);
 
-  void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch);
+  u32 ReadWatch(const Core::CPUThreadGuard& guard, const Watch& watch, std::span<u8> value);
   std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void PublishChanges(const Core::CPUThreadGuard& guard);
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::unique_ptr<MemoryWatcherRing::Writer> m_ring;
+  u64 m_frame = 0;
+
+  std::vector<Watch> m_watches;
+  std::vector<u8> m_new_value;
 };
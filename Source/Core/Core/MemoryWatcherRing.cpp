@@ -0,0 +1,305 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MemoryWatcherRing.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MemoryWatcherRing
+{
+static constexpr u64 AlignRecord(u64 size)
+{
+  return (size + RECORD_ALIGNMENT - 1) & ~u64(RECORD_ALIGNMENT - 1);
+}
+
+// Positions only ever increase, so the distance also works after they wrap around.
+static u64 Distance(u64 from, u64 to)
+{
+  return to - from;
+}
+
+Writer::Writer() = default;
+
+Writer::~Writer()
+{
+  Close();
+}
+
+bool Writer::Open(const std::string& path, u64 capacity)
+{
+  Close();
+
+  capacity = std::bit_ceil(std::max<u64>(capacity, 4096));
+
+  // Unlink any old file first, so readers that still have it mapped don't get their mapping
+  // truncated from under them.
+  unlink(path.c_str());
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (m_fd < 0)
+    return false;
+
+  m_mapping_size = DATA_OFFSET + capacity;
+  if (ftruncate(m_fd, static_cast<off_t>(m_mapping_size)) != 0)
+  {
+    Close();
+    return false;
+  }
+
+  m_mapping = mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (m_mapping == MAP_FAILED)
+  {
+    m_mapping = nullptr;
+    Close();
+    return false;
+  }
+
+  Header* header = new (m_mapping) Header{};
+  header->version = VERSION;
+  header->data_offset = DATA_OFFSET;
+  header->capacity = capacity;
+  std::atomic_ref<u32>(header->magic).store(MAGIC, std::memory_order_release);
+
+  m_header = header;
+  m_data = static_cast<u8*>(m_mapping) + DATA_OFFSET;
+  m_capacity = capacity;
+  return true;
+}
+
+void Writer::Close()
+{
+  if (m_mapping)
+    munmap(m_mapping, m_mapping_size);
+  if (m_fd >= 0)
+    close(m_fd);
+
+  m_fd = -1;
+  m_mapping = nullptr;
+  m_mapping_size = 0;
+  m_header = nullptr;
+  m_data = nullptr;
+  m_capacity = 0;
+}
+
+bool Writer::TakeSnapshotRequest()
+{
+  return m_header->snapshot_requested.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+void Writer::BeginBatch(u64 frame, u32 flags)
+{
+  BatchHeader header{};
+  header.flags = flags;
+  header.frame = frame;
+
+  m_batch.resize(sizeof(BatchHeader));
+  std::memcpy(m_batch.data(), &header, sizeof(header));
+  m_batch_entries = 0;
+}
+
+void Writer::AddEntry(u32 watch, u32 offset, u32 address, std::span<const u8> data)
+{
+  const EntryHeader header{watch, offset, address, static_cast<u32>(data.size())};
+
+  const size_t start = m_batch.size();
+  m_batch.resize(start + AlignRecord(sizeof(header) + data.size()));
+  std::memcpy(m_batch.data() + start, &header, sizeof(header));
+  std::memcpy(m_batch.data() + start + sizeof(header), data.data(), data.size());
+  ++m_batch_entries;
+}
+
+bool Writer::EndBatch()
+{
+  BatchHeader header;
+  std::memcpy(&header, m_batch.data(), sizeof(header));
+  if (m_batch_entries == 0 && (header.flags & BATCH_FLAG_SNAPSHOT) == 0)
+    return true;
+
+  if (m_batch.size() > m_capacity)
+    return false;
+
+  header.size = static_cast<u32>(m_batch.size());
+  header.num_entries = m_batch_entries;
+  std::memcpy(m_batch.data(), &header, sizeof(header));
+
+  u64 position = m_header->write_position.load(std::memory_order_relaxed);
+  const u64 offset = position % m_capacity;
+  const u64 padding = offset + m_batch.size() > m_capacity ? m_capacity - offset : 0;
+  const u64 end = position + padding + m_batch.size();
+
+  // Tell readers which data is about to be overwritten before touching it. Together with the
+  // release store to write_position below, this works like a sequence lock.
+  m_header->reserve_position.store(end, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (padding != 0)
+  {
+    BatchHeader padding_header{};
+    padding_header.size = static_cast<u32>(padding);
+    padding_header.flags = BATCH_FLAG_PADDING;
+    std::memcpy(m_data + offset, &padding_header, sizeof(u32) * 2);
+    position += padding;
+  }
+  WriteRecord(position, m_batch);
+
+  m_header->write_position.store(end, std::memory_order_release);
+  return true;
+}
+
+void Writer::WriteRecord(u64 position, std::span<const u8> record)
+{
+  std::memcpy(m_data + position % m_capacity, record.data(), record.size());
+}
+
+Reader::Reader() = default;
+
+Reader::~Reader()
+{
+  Close();
+}
+
+bool Reader::Open(const std::string& path)
+{
+  Close();
+
+  m_fd = open(path.c_str(), O_RDWR);
+  if (m_fd < 0)
+    return false;
+
+  struct stat file_info;
+  if (fstat(m_fd, &file_info) != 0 || static_cast<u64>(file_info.st_size) <= DATA_OFFSET)
+  {
+    Close();
+    return false;
+  }
+
+  m_mapping_size = static_cast<size_t>(file_info.st_size);
+  m_mapping = mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (m_mapping == MAP_FAILED)
+  {
+    m_mapping = nullptr;
+    Close();
+    return false;
+  }
+
+  Header* header = static_cast<Header*>(m_mapping);
+  if (std::atomic_ref<u32>(header->magic).load(std::memory_order_acquire) != MAGIC ||
+      header->version != VERSION || header->data_offset != DATA_OFFSET ||
+      !std::has_single_bit(header->capacity) ||
+      header->capacity != m_mapping_size - DATA_OFFSET)
+  {
+    Close();
+    return false;
+  }
+
+  m_header = header;
+  m_data = static_cast<const u8*>(m_mapping) + DATA_OFFSET;
+  m_capacity = header->capacity;
+  m_position = m_header->write_position.load(std::memory_order_acquire);
+  RequestSnapshot();
+  return true;
+}
+
+void Reader::Close()
+{
+  if (m_mapping)
+    munmap(m_mapping, m_mapping_size);
+  if (m_fd >= 0)
+    close(m_fd);
+
+  m_fd = -1;
+  m_mapping = nullptr;
+  m_mapping_size = 0;
+  m_header = nullptr;
+  m_data = nullptr;
+  m_capacity = 0;
+  m_position = 0;
+}
+
+void Reader::RequestSnapshot()
+{
+  m_header->snapshot_requested.store(1, std::memory_order_relaxed);
+}
+
+Reader::ReadStatus Reader::Read(Batch* batch)
+{
+  while (true)
+  {
+    const u64 write_position = m_header->write_position.load(std::memory_order_acquire);
+    if (m_position == write_position)
+      return ReadStatus::Empty;
+    if (Distance(m_position, write_position) > m_capacity)
+      return Resynchronize();
+
+    const u64 offset = m_position % m_capacity;
+    BatchHeader header;
+    std::memcpy(&header, m_data + offset, sizeof(u32) * 2);
+    if (WasOverwritten())
+      return Resynchronize();
+
+    if (header.size < sizeof(u32) * 2 || header.size % RECORD_ALIGNMENT != 0 ||
+        header.size > m_capacity - offset || header.size > Distance(m_position, write_position))
+    {
+      return Resynchronize();
+    }
+
+    if (header.flags & BATCH_FLAG_PADDING)
+    {
+      m_position += header.size;
+      continue;
+    }
+
+    if (header.size < sizeof(BatchHeader))
+      return Resynchronize();
+
+    batch->storage.resize(header.size);
+    std::memcpy(batch->storage.data(), m_data + offset, header.size);
+    if (WasOverwritten())
+      return Resynchronize();
+    std::memcpy(&header, batch->storage.data(), sizeof(header));
+
+    batch->frame = header.frame;
+    batch->flags = header.flags;
+    batch->entries.clear();
+    batch->entries.reserve(header.num_entries);
+
+    size_t entry_offset = sizeof(BatchHeader);
+    for (u32 i = 0; i < header.num_entries; ++i)
+    {
+      EntryHeader entry;
+      if (header.size - entry_offset < sizeof(entry))
+        return Resynchronize();
+      std::memcpy(&entry, batch->storage.data() + entry_offset, sizeof(entry));
+      if (header.size - entry_offset - sizeof(entry) < entry.length)
+        return Resynchronize();
+
+      const u8* data = batch->storage.data() + entry_offset + sizeof(entry);
+      batch->entries.push_back({entry.watch, entry.offset, entry.address, {data, entry.length}});
+      entry_offset += AlignRecord(sizeof(entry) + entry.length);
+    }
+
+    m_position += header.size;
+    return ReadStatus::Success;
+  }
+}
+
+bool Reader::WasOverwritten() const
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const u64 reserve_position = m_header->reserve_position.load(std::memory_order_relaxed);
+  return Distance(m_position, reserve_position) > m_capacity;
+}
+
+Reader::ReadStatus Reader::Resynchronize()
+{
+  m_position = m_header->write_position.load(std::memory_order_acquire);
+  RequestSnapshot();
+  return ReadStatus::Overrun;
+}
+}  // namespace MemoryWatcherRing
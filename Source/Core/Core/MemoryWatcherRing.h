@@ -0,0 +1,184 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A shared memory transport for MemoryWatcher. Dolphin publishes one batch of changes per frame to
+// a ring buffer in a memory mapped file, which any number of other processes can read without
+// syscalls and without slowing down emulation. The writer never waits for readers; a reader that
+// falls more than a ring's worth of data behind is told so and has to resynchronize.
+//
+// Besides the standard library and POSIX, this file only depends on the header-only
+// Common/CommonTypes.h, so tools can build the Reader without the rest of Dolphin.
+//
+// File layout, in host byte order:
+//
+//   0x00  u32 magic               MAGIC, written last once the file is ready
+//   0x04  u32 version             VERSION
+//   0x08  u32 data_offset         DATA_OFFSET
+//   0x0c  u32 reserved
+//   0x10  u64 capacity            Size of the data area in bytes, a power of two
+//   0x40  u64 reserve_position    End of the batch currently being written
+//   0x48  u64 write_position      End of the last batch that was completely written
+//   0x80  u32 snapshot_requested  Set by readers to get a full snapshot in the next batch
+//   0x100 data area
+//
+// Positions count bytes written since the file was created; the data for a position is at
+// data_offset + (position % capacity). Every record starts on an 8 byte boundary. A batch starts
+// with a BatchHeader, followed by num_entries entries. Each entry is an EntryHeader followed by
+// length bytes of guest memory, padded to 8 bytes. Guest memory is copied as is, so multi-byte
+// values are big endian. A batch never wraps around the end of the data area; if it doesn't fit,
+// the writer fills the rest with a record that only has the BATCH_FLAG_PADDING flag set.
+namespace MemoryWatcherRing
+{
+constexpr u32 MAGIC = 0x52574D44;  // "DMWR"
+constexpr u32 VERSION = 1;
+constexpr u32 DATA_OFFSET = 0x100;
+constexpr u32 RECORD_ALIGNMENT = 8;
+
+// The batch contains the full value of every watch rather than only what changed.
+constexpr u32 BATCH_FLAG_SNAPSHOT = 1 << 0;
+// The record only skips to the start of the data area and has no entries.
+constexpr u32 BATCH_FLAG_PADDING = 1 << 1;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 data_offset;
+  u32 reserved;
+  u64 capacity;
+  alignas(64) std::atomic<u64> reserve_position;
+  std::atomic<u64> write_position;
+  alignas(64) std::atomic<u32> snapshot_requested;
+};
+static_assert(sizeof(Header) <= DATA_OFFSET);
+static_assert(std::atomic<u64>::is_always_lock_free);
+
+struct BatchHeader
+{
+  // Size of the whole record including this header.
+  u32 size;
+  u32 flags;
+  u32 num_entries;
+  u32 reserved;
+  // Number of frames MemoryWatcher has seen since it was started.
+  u64 frame;
+};
+static_assert(sizeof(BatchHeader) % RECORD_ALIGNMENT == 0);
+
+struct EntryHeader
+{
+  // Index of the watch in the locations file, not counting empty lines.
+  u32 watch;
+  // Offset of the data within the watched range.
+  u32 offset;
+  // Effective address of the first byte of data. Always 0 for watches of a single u32, where the
+  // last step of the pointer chain is the read itself.
+  u32 address;
+  u32 length;
+};
+static_assert(sizeof(EntryHeader) % RECORD_ALIGNMENT == 0);
+
+class Writer final
+{
+public:
+  Writer();
+  ~Writer();
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  // Creates a new ring at the given path. Readers that still have an older file open at the same
+  // path keep it, but it won't receive any more data. The capacity is rounded up to a power of two.
+  bool Open(const std::string& path, u64 capacity);
+  void Close();
+  bool IsOpen() const { return m_header != nullptr; }
+
+  // Returns whether a reader asked for a snapshot since the last call.
+  bool TakeSnapshotRequest();
+
+  void BeginBatch(u64 frame, u32 flags = 0);
+  void AddEntry(u32 watch, u32 offset, u32 address, std::span<const u8> data);
+  // Publishes the batch, unless it has no entries and isn't a snapshot. Returns false if the batch
+  // doesn't fit into the ring and had to be dropped.
+  bool EndBatch();
+
+private:
+  void WriteRecord(u64 position, std::span<const u8> record);
+
+  int m_fd = -1;
+  void* m_mapping = nullptr;
+  size_t m_mapping_size = 0;
+  Header* m_header = nullptr;
+  u8* m_data = nullptr;
+  u64 m_capacity = 0;
+
+  std::vector<u8> m_batch;
+  u32 m_batch_entries = 0;
+};
+
+class Reader final
+{
+public:
+  struct Entry
+  {
+    u32 watch;
+    u32 offset;
+    u32 address;
+    std::span<const u8> data;
+  };
+
+  struct Batch
+  {
+    u64 frame = 0;
+    u32 flags = 0;
+    std::vector<Entry> entries;
+    // Backing storage for the entries' data.
+    std::vector<u8> storage;
+  };
+
+  enum class ReadStatus
+  {
+    // A batch was read.
+    Success,
+    // No new batch has been published.
+    Empty,
+    // Data was overwritten before it could be read. The reader has skipped ahead to the newest data
+    // and requested a snapshot, which will arrive in a later batch.
+    Overrun,
+  };
+
+  Reader();
+  ~Reader();
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  // Opens an existing ring and requests a snapshot, so the first batch that is read contains the
+  // full value of every watch.
+  bool Open(const std::string& path);
+  void Close();
+  bool IsOpen() const { return m_header != nullptr; }
+
+  void RequestSnapshot();
+  ReadStatus Read(Batch* batch);
+
+private:
+  ReadStatus Resynchronize();
+  bool WasOverwritten() const;
+
+  int m_fd = -1;
+  void* m_mapping = nullptr;
+  size_t m_mapping_size = 0;
+  Header* m_header = nullptr;
+  const u8* m_data = nullptr;
+  u64 m_capacity = 0;
+  u64 m_position = 0;
+};
+}  // namespace MemoryWatcherRing
@@ -10,6 +10,7 @@
 #include <locale>
 #include <mbedtls/md.h>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <utility>
 #include <variant>
@@ -47,6 +48,7 @@
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
@@ -71,11 +73,6 @@ namespace Movie
 using namespace WiimoteCommon;
 using namespace WiimoteEmu;
 
-static bool IsMovieHeader(const std::array<u8, 4>& magic)
-{
-  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
-}
-
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
 {
   std::array<u8, 20> revision_bytes{};
@@ -180,11 +177,114 @@ void MovieManager::FrameUpdate()
   {
     m_total_frames = m_current_frame;
     m_total_lag_count = m_current_lag_count;
+    UpdateKeyframes();
+  }
+  else if (m_verifier && IsPlayingInput())
+  {
+    m_verifier->FrameUpdate(m_system, m_current_frame);
   }
 
   m_polled = false;
 }
 
+// NOTE: CPU Thread
+void MovieManager::UpdateKeyframes()
+{
+  // Keyframes after the current frame belong to input that is being recorded over.
+  while (!m_keyframes.empty() && m_keyframes.back().frame >= m_current_frame)
+    m_keyframes.pop_back();
+
+  if (!m_indexed_format || m_keyframe_pending)
+    return;
+
+  const u32 interval = Config::Get(Config::MAIN_MOVIE_KEYFRAME_INTERVAL);
+  if (interval == 0 || m_current_frame % interval != 0)
+    return;
+
+  AddKeyframe(false);
+  if (!Config::Get(Config::MAIN_MOVIE_KEYFRAME_SAVESTATES))
+    return;
+
+  // We're inside the VI event here, where a savestate would miss the VI's next event. So take it
+  // as soon as the CPU thread can be paused instead, as a second keyframe that records the frame
+  // it was actually taken on. The first one keeps a memory hash from the start of the frame, which
+  // playback can reproduce.
+  m_keyframe_pending = true;
+  Core::QueueHostJob([](Core::System& system) {
+    Core::RunOnCPUThread(system, [&system] { system.GetMovie().AddKeyframe(true); });
+  });
+}
+
+// NOTE: CPU Thread
+void MovieManager::AddKeyframe(bool with_state)
+{
+  if (with_state)
+  {
+    m_keyframe_pending = false;
+    if (!IsRecordingInput())
+      return;
+
+    // A savestate loaded in the meantime can have moved us back.
+    while (!m_keyframes.empty() && m_keyframes.back().frame > m_current_frame)
+      m_keyframes.pop_back();
+  }
+
+  MovieKeyframe keyframe;
+  keyframe.frame = m_current_frame;
+  keyframe.input_byte = m_current_byte;
+  keyframe.input_count = m_current_input_count;
+  keyframe.lag_count = m_current_lag_count;
+  keyframe.tick_count = m_system.GetCoreTiming().GetTicks();
+  keyframe.memory_hash = m_system.GetMemory().ComputeHash();
+
+  if (with_state)
+  {
+    Common::UniqueBuffer<u8> buffer;
+    const size_t state_size = State::SaveToBuffer(m_system, buffer);
+    if (state_size != 0)
+    {
+      // The state is spilled to a file, so that recording a long movie doesn't keep every
+      // keyframe's state in memory.
+      m_keyframe_states.AddState(std::span(buffer.data(), state_size), m_keyframes, &keyframe);
+    }
+  }
+
+  m_keyframes.push_back(std::move(keyframe));
+}
+
+// NOTE: Host Thread
+void MovieManager::SetVerifier(std::unique_ptr<MovieVerifier> verifier)
+{
+  m_verifier = std::move(verifier);
+}
+
+// NOTE: Host Thread
+bool MovieManager::SeekToKeyframe(u64 frame)
+{
+  if (!IsMovieActive() || NetPlay::IsNetPlayRunning())
+    return false;
+
+  std::vector<u8> state;
+  {
+    const Core::CPUThreadGuard guard(m_system);
+    if (!LoadSeekState(m_keyframes, m_keyframe_states, frame, &state))
+      return false;
+  }
+
+  Core::RunOnCPUThread(m_system, [this, state = std::move(state)]() mutable {
+    if (!State::LoadFromBuffer(m_system, state))
+    {
+      Core::DisplayMessage("Failed to load the keyframe's savestate", 2000);
+      return;
+    }
+
+    if (IsRecordingInput())
+      m_rerecords++;
+    Core::DisplayMessage(fmt::format("Seeked to frame {}", m_current_frame), 2000);
+  });
+  return true;
+}
+
 // called when game is booting up, even if no movie is active,
 // but potentially after BeginRecordingInput or PlayInput has been called.
 // NOTE: EmuThread
@@ -507,6 +607,9 @@ bool MovieManager::BeginRecordingInput(const ControllerTypeArray& controllers,
   m_play_mode = PlayMode::Recording;
   m_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
   m_temp_input.clear();
+  m_keyframes.clear();
+  m_keyframe_states.Close();
+  m_indexed_format = Config::Get(Config::MAIN_MOVIE_INDEXED_FORMAT);
 
   m_current_byte = 0;
 
@@ -863,15 +966,20 @@ bool MovieManager::PlayInput(const std::string& movie_path,
     return false;
 
   File::IOFile recording_file(movie_path, "rb");
-  if (!recording_file.ReadArray(&m_temp_header, 1))
+  if (!recording_file)
     return false;
 
-  if (!IsMovieHeader(m_temp_header.filetype))
+  std::vector<u8> input;
+  std::vector<MovieKeyframe> keyframes;
+  if (!ReadMovieFile(recording_file, &m_temp_header, &input, &keyframes))
   {
     PanicAlertFmtT("Invalid recording file");
     return false;
   }
 
+  if (m_verifier && !m_verifier->Start(keyframes))
+    return false;
+
   ReadHeader();
 
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
@@ -892,10 +1000,12 @@ bool MovieManager::PlayInput(const std::string& movie_path,
 
   Core::UpdateWantDeterminism(m_system);
 
-  m_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(m_temp_input.data(), m_temp_input.size());
+  m_temp_input = std::move(input);
+  m_keyframes = std::move(keyframes);
+  // Keyframe states are only read from the movie file when seeking to them.
+  m_keyframe_states.SetMovieFile(std::move(recording_file), movie_path);
+  m_indexed_format = IsIndexedMovieHeader(m_temp_header.filetype);
   m_current_byte = 0;
-  recording_file.Close();
 
   // Load savestate (and skip to frame data)
   if (m_temp_header.bFromSaveState && savestate_path)
@@ -941,6 +1051,10 @@ void MovieManager::DoState(PointerWrap& p)
 // NOTE: Host Thread
 void MovieManager::LoadInput(const std::string& movie_path)
 {
+  // The header of the movie file is rewritten below.
+  if (m_keyframe_states.GetMoviePath() == movie_path)
+    m_keyframe_states.MoveToTemporaryFile(m_keyframes);
+
   File::IOFile t_record;
   if (!t_record.Open(movie_path, "r+b"))
   {
@@ -949,9 +1063,9 @@ void MovieManager::LoadInput(const std::string& movie_path)
     return;
   }
 
-  t_record.ReadArray(&m_temp_header, 1);
-
-  if (!IsMovieHeader(m_temp_header.filetype))
+  std::vector<u8> movie_input;
+  std::vector<MovieKeyframe> keyframes;
+  if (!ReadMovieFile(t_record, &m_temp_header, &movie_input, &keyframes))
   {
     PanicAlertFmtT("Savestate movie {0} is corrupted, movie recording stopping...", movie_path);
     EndPlayInput(false);
@@ -970,7 +1084,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
   if (m_system.IsWii())
     ChangeWiiPads();
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  u64 totalSavedBytes = movie_input.size();
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -990,8 +1104,13 @@ void MovieManager::LoadInput(const std::string& movie_path)
     m_total_input_count = m_temp_header.inputCount;
     m_total_tick_count = m_tick_count_at_last_input = m_temp_header.tickCount;
 
-    m_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(m_temp_input.data(), m_temp_input.size());
+    m_temp_input = std::move(movie_input);
+    m_keyframes = std::move(keyframes);
+    // The movie of a savestate is moved away or overwritten by the next savestate, so its keyframe
+    // states are copied out of it right away.
+    m_keyframe_states.SetMovieFile(std::move(t_record), movie_path);
+    m_keyframe_states.MoveToTemporaryFile(m_keyframes);
+    m_indexed_format = IsIndexedMovieHeader(m_temp_header.filetype);
   }
   else if (m_current_byte > 0)
   {
@@ -1011,8 +1130,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
     else if (m_current_byte > 0 && !m_temp_input.empty())
     {
       // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(m_current_byte);
-      t_record.ReadArray(movInput.data(), movInput.size());
+      const std::span<const u8> movInput(movie_input.data(), m_current_byte);
 
       const auto mismatch_result = std::ranges::mismatch(movInput, m_temp_input);
 
@@ -1264,6 +1382,9 @@ bool MovieManager::PlayWiimote(int wiimote, DesiredWiimoteState* desired_state)
 // NOTE: Host / EmuThread / CPU Thread
 void MovieManager::EndPlayInput(bool cont)
 {
+  if (m_verifier && IsPlayingInput())
+    m_verifier->Finish(m_current_frame);
+
   if (cont)
   {
     // If !IsMovieActive(), changing m_play_mode requires calling UpdateWantDeterminism
@@ -1298,6 +1419,10 @@ void MovieManager::EndPlayInput(bool cont)
 // NOTE: Save State + Host Thread
 void MovieManager::SaveRecording(const std::string& filename)
 {
+  // The keyframe states of a movie that is played are read from its file.
+  if (m_keyframe_states.GetMoviePath() == filename)
+    m_keyframe_states.MoveToTemporaryFile(m_keyframes);
+
   File::IOFile save_record(filename, "wb");
   // Create the real header now and write it
   DTMHeader header;
@@ -1346,9 +1471,17 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
-
-  bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
+  bool success;
+  if (m_indexed_format)
+  {
+    success = WriteIndexedMovieFile(save_record, header, m_temp_input, m_keyframes,
+                                    m_keyframe_states);
+  }
+  else
+  {
+    save_record.WriteArray(&header, 1);
+    success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
+  }
 
   if (success && m_recording_from_save_state)
   {
@@ -1479,5 +1612,8 @@ void MovieManager::Shutdown()
 {
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
   m_temp_input.clear();
+  m_keyframes.clear();
+  m_keyframe_states.Close();
+  m_keyframe_pending = false;
 }
 }  // namespace Movie
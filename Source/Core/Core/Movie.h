@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -12,6 +13,8 @@
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/WiimoteEmu/DesiredWiimoteState.h"
+#include "Core/MovieFormat.h"
+#include "Core/MovieVerifier.h"
 
 struct BootParameters;
 
@@ -83,7 +86,7 @@ struct DTMHeader
     return {gameID.data(), strnlen(gameID.data(), gameID.size())};
   }
 
-  std::array<u8, 4> filetype;  // Unique Identifier (always "DTM"0x1A)
+  std::array<u8, 4> filetype;  // Unique Identifier ("DTM"0x1A, or "DTM"0x1B for indexed DTMs)
 
   std::array<char, 6> gameID;  // The Game ID
   bool bWii;                   // Wii game
@@ -215,6 +218,13 @@ public:
   void EndPlayInput(bool cont);
   void SaveRecording(const std::string& filename);
   void DoState(PointerWrap& p);
+
+  // Schedules loading the savestate of the last keyframe at or before the given frame on the CPU
+  // thread. Returns false if there is no such keyframe.
+  bool SeekToKeyframe(u64 frame);
+
+  // Verifies the playback of the next movie that is played. See MovieVerifier.
+  void SetVerifier(std::unique_ptr<MovieVerifier> verifier);
   void Shutdown();
   void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
   void CheckWiimoteStatus(int wiimote, const WiimoteEmu::DesiredWiimoteState& desired_state);
@@ -226,6 +236,8 @@ public:
 private:
   void GetSettings();
   void CheckInputEnd();
+  void UpdateKeyframes();
+  void AddKeyframe(bool with_state);
 
   void CheckMD5();
   void GetMD5();
@@ -239,6 +251,11 @@ private:
   ControllerState m_pad_state{};
   DTMHeader m_temp_header{};
   std::vector<u8> m_temp_input;
+  std::vector<MovieKeyframe> m_keyframes;
+  KeyframeStateFile m_keyframe_states;
+  bool m_indexed_format = false;
+  bool m_keyframe_pending = false;
+  std::unique_ptr<MovieVerifier> m_verifier;
   u64 m_current_byte = 0;
   u64 m_current_frame = 0;
   u64 m_total_frames = 0;  // VI
@@ -0,0 +1,430 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <lz4.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+static constexpr u64 INDEXED_HEADER_OFFSET = sizeof(DTMHeader);
+static constexpr u64 INDEXED_DATA_OFFSET = INDEXED_HEADER_OFFSET + sizeof(DTMIndexedHeader);
+// LZ4 can't expand data by more than this.
+static constexpr u64 LZ4_MAX_RATIO = 255;
+
+static bool Compress(std::span<const u8> data, std::vector<u8>* compressed)
+{
+  if (data.size() > LZ4_MAX_INPUT_SIZE)
+    return false;
+
+  compressed->resize(LZ4_compressBound(static_cast<int>(data.size())));
+  const int compressed_size = LZ4_compress_default(
+      reinterpret_cast<const char*>(data.data()), reinterpret_cast<char*>(compressed->data()),
+      static_cast<int>(data.size()), static_cast<int>(compressed->size()));
+  if (compressed_size <= 0)
+    return false;
+
+  compressed->resize(compressed_size);
+  return true;
+}
+
+static bool Decompress(std::span<const u8> compressed, std::span<u8> data)
+{
+  if (compressed.size() > LZ4_MAX_INPUT_SIZE || data.size() > LZ4_MAX_INPUT_SIZE)
+    return false;
+
+  const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+                                       reinterpret_cast<char*>(data.data()),
+                                       static_cast<int>(compressed.size()),
+                                       static_cast<int>(data.size()));
+  return size >= 0 && static_cast<size_t>(size) == data.size();
+}
+
+static bool IsInFile(u64 offset, u64 size, u64 file_size)
+{
+  return offset <= file_size && size <= file_size - offset;
+}
+
+bool IsMovieHeader(const std::array<u8, 4>& magic)
+{
+  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
+}
+
+bool IsIndexedMovieHeader(const std::array<u8, 4>& magic)
+{
+  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1B;
+}
+
+static bool ReadIndexedMovie(File::IOFile& file, std::vector<u8>* input,
+                             std::vector<MovieKeyframe>* keyframes)
+{
+  const u64 file_size = file.GetSize();
+
+  DTMIndexedHeader header;
+  if (!file.ReadArray(&header, 1))
+    return false;
+
+  if (header.version != DTM_INDEXED_VERSION || header.block_size == 0 ||
+      header.input_size > std::numeric_limits<size_t>::max() ||
+      !IsInFile(header.index_offset,
+                u64(header.block_count) * sizeof(DTMBlock) +
+                    u64(header.keyframe_count) * sizeof(DTMKeyframe),
+                file_size))
+  {
+    ERROR_LOG_FMT(CORE, "Indexed DTM has an invalid header");
+    return false;
+  }
+
+  std::vector<DTMBlock> blocks(header.block_count);
+  std::vector<DTMKeyframe> keyframe_entries(header.keyframe_count);
+  if (!file.Seek(header.index_offset, File::SeekOrigin::Begin) ||
+      !file.ReadArray(blocks.data(), blocks.size()) ||
+      !file.ReadArray(keyframe_entries.data(), keyframe_entries.size()))
+  {
+    return false;
+  }
+
+  input->resize(static_cast<size_t>(header.input_size));
+  u64 position = 0;
+  std::vector<u8> compressed;
+  for (const DTMBlock& block : blocks)
+  {
+    if (block.uncompressed_size > header.block_size ||
+        block.uncompressed_size > header.input_size - position ||
+        !IsInFile(block.offset, block.compressed_size, file_size))
+    {
+      ERROR_LOG_FMT(CORE, "Indexed DTM has an invalid input block at {:#x}", block.offset);
+      return false;
+    }
+
+    compressed.resize(block.compressed_size);
+    if (!file.Seek(block.offset, File::SeekOrigin::Begin) ||
+        !file.ReadBytes(compressed.data(), compressed.size()) ||
+        !Decompress(compressed, std::span(*input).subspan(position, block.uncompressed_size)))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress the input block at {:#x}", block.offset);
+      return false;
+    }
+    position += block.uncompressed_size;
+  }
+
+  if (position != header.input_size)
+  {
+    ERROR_LOG_FMT(CORE, "Indexed DTM input blocks only cover {} of {} bytes", position,
+                  header.input_size);
+    return false;
+  }
+
+  keyframes->clear();
+  keyframes->reserve(keyframe_entries.size());
+  for (const DTMKeyframe& entry : keyframe_entries)
+  {
+    if (entry.input_byte > header.input_size ||
+        (!keyframes->empty() && entry.frame < keyframes->back().frame))
+    {
+      ERROR_LOG_FMT(CORE, "Indexed DTM has an invalid keyframe for frame {}", entry.frame);
+      return false;
+    }
+
+    MovieKeyframe& keyframe = keyframes->emplace_back();
+    keyframe.frame = entry.frame;
+    keyframe.input_byte = entry.input_byte;
+    keyframe.input_count = entry.input_count;
+    keyframe.lag_count = entry.lag_count;
+    keyframe.tick_count = entry.tick_count;
+    keyframe.memory_hash = entry.memory_hash;
+
+    if (entry.state_offset == 0)
+      continue;
+
+    if (!IsInFile(entry.state_offset, entry.state_compressed_size, file_size) ||
+        entry.state_size > MAX_KEYFRAME_STATE_SIZE)
+    {
+      ERROR_LOG_FMT(CORE, "Indexed DTM has an invalid savestate for frame {}", entry.frame);
+      return false;
+    }
+
+    keyframe.state_offset = entry.state_offset;
+    keyframe.state_compressed_size = entry.state_compressed_size;
+    keyframe.state_size = entry.state_size;
+  }
+
+  return true;
+}
+
+bool ReadMovieFile(File::IOFile& file, DTMHeader* header, std::vector<u8>* input,
+                   std::vector<MovieKeyframe>* keyframes)
+{
+  if (!file.ReadArray(header, 1))
+    return false;
+
+  if (IsIndexedMovieHeader(header->filetype))
+    return ReadIndexedMovie(file, input, keyframes);
+
+  if (!IsMovieHeader(header->filetype))
+    return false;
+
+  input->resize(static_cast<size_t>(file.GetSize() - sizeof(DTMHeader)));
+  keyframes->clear();
+  return file.ReadBytes(input->data(), input->size());
+}
+
+bool WriteIndexedMovieFile(File::IOFile& file, const DTMHeader& header, std::span<const u8> input,
+                           std::span<const MovieKeyframe> keyframes, KeyframeStateFile& states)
+{
+  DTMHeader movie_header = header;
+  movie_header.filetype = {'D', 'T', 'M', 0x1B};
+
+  DTMIndexedHeader indexed_header{};
+  indexed_header.version = DTM_INDEXED_VERSION;
+  indexed_header.block_size = DTM_INPUT_BLOCK_SIZE;
+  indexed_header.input_size = input.size();
+
+  // The indexed header is written again once the index offset is known.
+  if (!file.WriteArray(&movie_header, 1) || !file.WriteArray(&indexed_header, 1))
+    return false;
+
+  std::vector<DTMBlock> blocks;
+  blocks.reserve((input.size() + DTM_INPUT_BLOCK_SIZE - 1) / DTM_INPUT_BLOCK_SIZE);
+  u64 offset = INDEXED_DATA_OFFSET;
+  std::vector<u8> compressed;
+  for (size_t position = 0; position < input.size(); position += DTM_INPUT_BLOCK_SIZE)
+  {
+    const auto block = input.subspan(position, std::min<size_t>(DTM_INPUT_BLOCK_SIZE,
+                                                                input.size() - position));
+    if (!Compress(block, &compressed) || !file.WriteBytes(compressed.data(), compressed.size()))
+      return false;
+
+    blocks.push_back({offset, static_cast<u32>(compressed.size()), static_cast<u32>(block.size())});
+    offset += compressed.size();
+  }
+
+  std::vector<DTMKeyframe> keyframe_entries;
+  keyframe_entries.reserve(keyframes.size());
+  for (const MovieKeyframe& keyframe : keyframes)
+  {
+    DTMKeyframe& entry = keyframe_entries.emplace_back();
+    entry.frame = keyframe.frame;
+    entry.input_byte = keyframe.input_byte;
+    entry.input_count = keyframe.input_count;
+    entry.lag_count = keyframe.lag_count;
+    entry.tick_count = keyframe.tick_count;
+    entry.memory_hash = keyframe.memory_hash;
+
+    if (!keyframe.HasState())
+      continue;
+
+    if (!states.ReadCompressedState(keyframe, &compressed) ||
+        !file.WriteBytes(compressed.data(), compressed.size()))
+    {
+      return false;
+    }
+
+    entry.state_offset = offset;
+    entry.state_compressed_size = keyframe.state_compressed_size;
+    entry.state_size = keyframe.state_size;
+    offset += compressed.size();
+  }
+
+  indexed_header.index_offset = offset;
+  indexed_header.block_count = static_cast<u32>(blocks.size());
+  indexed_header.keyframe_count = static_cast<u32>(keyframe_entries.size());
+
+  return file.WriteArray(blocks.data(), blocks.size()) &&
+         file.WriteArray(keyframe_entries.data(), keyframe_entries.size()) &&
+         file.Seek(INDEXED_HEADER_OFFSET, File::SeekOrigin::Begin) &&
+         file.WriteArray(&indexed_header, 1);
+}
+
+const MovieKeyframe* FindKeyframe(std::span<const MovieKeyframe> keyframes, u64 frame,
+                                  bool with_state)
+{
+  auto it = std::ranges::upper_bound(keyframes, frame, {}, &MovieKeyframe::frame);
+  while (it != keyframes.begin())
+  {
+    --it;
+    if (!with_state || it->HasState())
+      return &*it;
+  }
+  return nullptr;
+}
+
+std::vector<u8> CompressKeyframeState(std::span<const u8> state)
+{
+  std::vector<u8> compressed;
+  if (!Compress(state, &compressed))
+    compressed.clear();
+  return compressed;
+}
+
+bool DecompressKeyframeState(std::span<const u8> compressed, u32 state_size,
+                             std::vector<u8>* state)
+{
+  if (compressed.empty() || state_size > MAX_KEYFRAME_STATE_SIZE ||
+      state_size / LZ4_MAX_RATIO > compressed.size())
+  {
+    return false;
+  }
+
+  state->resize(state_size);
+  return Decompress(compressed, *state);
+}
+
+const MovieKeyframe* LoadSeekState(std::span<const MovieKeyframe> keyframes,
+                                   KeyframeStateFile& states, u64 frame, std::vector<u8>* state)
+{
+  const MovieKeyframe* keyframe = FindKeyframe(keyframes, frame, true);
+  if (!keyframe || !states.ReadState(*keyframe, state))
+    return nullptr;
+  return keyframe;
+}
+
+KeyframeStateFile::KeyframeStateFile() = default;
+
+KeyframeStateFile::~KeyframeStateFile() = default;
+
+void KeyframeStateFile::SetMovieFile(File::IOFile file, std::string path)
+{
+  std::lock_guard lk(m_mutex);
+  m_file = std::move(file);
+  m_movie_path = std::move(path);
+}
+
+void KeyframeStateFile::Close()
+{
+  std::lock_guard lk(m_mutex);
+  m_file.Close();
+  m_movie_path.clear();
+}
+
+std::string KeyframeStateFile::GetMoviePath() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_movie_path;
+}
+
+bool KeyframeStateFile::MoveToTemporaryFile(std::span<MovieKeyframe> keyframes)
+{
+  std::lock_guard lk(m_mutex);
+  return MoveToTemporaryFileLocked(keyframes);
+}
+
+bool KeyframeStateFile::MoveToTemporaryFileLocked(std::span<MovieKeyframe> keyframes)
+{
+  // The temporary file is deleted once it's closed.
+  File::IOFile temporary_file(std::tmpfile());
+  bool success = temporary_file.IsOpen();
+
+  std::vector<u64> offsets;
+  u64 offset = 0;
+  std::vector<u8> compressed;
+  for (const MovieKeyframe& keyframe : keyframes)
+  {
+    if (!success || !keyframe.HasState())
+      continue;
+
+    success = ReadCompressedStateLocked(keyframe, &compressed) &&
+              temporary_file.WriteBytes(compressed.data(), compressed.size());
+    offsets.push_back(offset);
+    offset += compressed.size();
+  }
+
+  if (!success)
+    ERROR_LOG_FMT(CORE, "Failed to copy the keyframe savestates to a temporary file");
+
+  auto next_offset = offsets.begin();
+  for (MovieKeyframe& keyframe : keyframes)
+  {
+    if (!keyframe.HasState())
+      continue;
+    if (success)
+    {
+      keyframe.state_offset = *next_offset++;
+    }
+    else
+    {
+      keyframe.state_compressed_size = 0;
+      keyframe.state_size = 0;
+    }
+  }
+
+  m_file = std::move(temporary_file);
+  m_movie_path.clear();
+  return success;
+}
+
+bool KeyframeStateFile::AddState(std::span<const u8> state, std::span<MovieKeyframe> keyframes,
+                                 MovieKeyframe* keyframe)
+{
+  std::lock_guard lk(m_mutex);
+  if ((!m_file.IsOpen() || !m_movie_path.empty()) && !MoveToTemporaryFileLocked(keyframes))
+    return false;
+
+  const std::vector<u8> compressed = CompressKeyframeState(state);
+  if (compressed.empty())
+    return false;
+
+  // The states in the temporary file are in the same order as the keyframes.
+  u64 offset = 0;
+  const auto last = std::ranges::find_if(keyframes.rbegin(), keyframes.rend(),
+                                         &MovieKeyframe::HasState);
+  if (last != keyframes.rend())
+    offset = last->state_offset + last->state_compressed_size;
+
+  if (!m_file.Seek(offset, File::SeekOrigin::Begin) ||
+      !m_file.WriteBytes(compressed.data(), compressed.size()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write a keyframe savestate to the temporary file");
+    m_file.ClearError();
+    return false;
+  }
+
+  keyframe->state_offset = offset;
+  keyframe->state_compressed_size = static_cast<u32>(compressed.size());
+  keyframe->state_size = static_cast<u32>(state.size());
+  return true;
+}
+
+bool KeyframeStateFile::ReadCompressedState(const MovieKeyframe& keyframe,
+                                            std::vector<u8>* compressed)
+{
+  std::lock_guard lk(m_mutex);
+  return ReadCompressedStateLocked(keyframe, compressed);
+}
+
+bool KeyframeStateFile::ReadCompressedStateLocked(const MovieKeyframe& keyframe,
+                                                  std::vector<u8>* compressed)
+{
+  if (!keyframe.HasState())
+    return false;
+
+  compressed->resize(keyframe.state_compressed_size);
+  if (!m_file.Seek(keyframe.state_offset, File::SeekOrigin::Begin) ||
+      !m_file.ReadBytes(compressed->data(), compressed->size()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to read the savestate of the keyframe for frame {}",
+                  keyframe.frame);
+    m_file.ClearError();
+    return false;
+  }
+  return true;
+}
+
+bool KeyframeStateFile::ReadState(const MovieKeyframe& keyframe, std::vector<u8>* state)
+{
+  std::vector<u8> compressed;
+  return ReadCompressedState(keyframe, &compressed) &&
+         DecompressKeyframeState(compressed, keyframe.state_size, state);
+}
+}  // namespace Movie
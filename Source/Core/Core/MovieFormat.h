@@ -0,0 +1,165 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+// Reading and writing of indexed (version 2) DTM files.
+//
+// A version 1 DTM is a DTMHeader followed by the raw input stream. That is fine for short movies,
+// but for long ones the files get large, and getting to a point late in the movie means emulating
+// everything before it. A version 2 DTM stores the same DTMHeader, with "DTM"0x1B as the filetype
+// so that tools which only know version 1 reject the file instead of misreading it, followed by:
+//
+//   0x100  DTMIndexedHeader
+//   0x140  the input stream, split into blocks of block_size bytes that are LZ4 compressed
+//          separately, followed by the LZ4 compressed savestates of keyframes that have one
+//   index  block_count DTMBlock entries, followed by keyframe_count DTMKeyframe entries
+//
+// Keyframes are taken periodically while recording and are sorted by frame. Each one records
+// where playback was at that point, a hash of emulated memory which can be used to check that a
+// playback is still in sync, and optionally a savestate which allows seeking to it directly.
+namespace Movie
+{
+struct DTMHeader;
+
+#pragma pack(push, 1)
+struct DTMIndexedHeader
+{
+  u32 version;
+  // Uncompressed size of every input block but the last one.
+  u32 block_size;
+  u64 input_size;
+  u64 index_offset;
+  u32 block_count;
+  u32 keyframe_count;
+  std::array<u8, 32> reserved;
+};
+static_assert(sizeof(DTMIndexedHeader) == 64, "DTMIndexedHeader should be 64 bytes");
+
+struct DTMBlock
+{
+  u64 offset;
+  u32 compressed_size;
+  u32 uncompressed_size;
+};
+static_assert(sizeof(DTMBlock) == 16, "DTMBlock should be 16 bytes");
+
+struct DTMKeyframe
+{
+  u64 frame;
+  u64 input_byte;
+  u64 input_count;
+  u64 lag_count;
+  u64 tick_count;
+  u64 memory_hash;
+  // Zero if the keyframe has no savestate.
+  u64 state_offset;
+  u32 state_compressed_size;
+  u32 state_size;
+};
+static_assert(sizeof(DTMKeyframe) == 64, "DTMKeyframe should be 64 bytes");
+#pragma pack(pop)
+
+constexpr u32 DTM_INDEXED_VERSION = 2;
+constexpr u32 DTM_INPUT_BLOCK_SIZE = 0x10000;
+// Keyframe savestates claiming to be larger than this are treated as corrupt.
+constexpr u32 MAX_KEYFRAME_STATE_SIZE = 0x20000000;
+
+struct MovieKeyframe
+{
+  u64 frame = 0;
+  u64 input_byte = 0;
+  u64 input_count = 0;
+  u64 lag_count = 0;
+  u64 tick_count = 0;
+  u64 memory_hash = 0;
+  // Where the LZ4 compressed savestate is in the KeyframeStateFile. The compressed size is zero if
+  // the keyframe has no savestate.
+  u64 state_offset = 0;
+  u32 state_compressed_size = 0;
+  u32 state_size = 0;
+
+  bool HasState() const { return state_compressed_size != 0; }
+};
+
+// Holds the compressed savestates of keyframes in a file rather than in memory, as a long movie
+// has a lot of them. The states of a movie that is played are read from the movie file when they
+// are needed. New states are appended to a temporary file, to which the states of the movie file
+// are copied first. All functions are thread safe.
+class KeyframeStateFile
+{
+public:
+  KeyframeStateFile();
+  ~KeyframeStateFile();
+
+  KeyframeStateFile(const KeyframeStateFile&) = delete;
+  KeyframeStateFile& operator=(const KeyframeStateFile&) = delete;
+
+  // Reads the states of the keyframes of a movie from its file, which is kept open.
+  void SetMovieFile(File::IOFile file, std::string path);
+  void Close();
+  // Returns the path of the movie file the states are read from, or an empty string if they are in
+  // a temporary file.
+  std::string GetMoviePath() const;
+
+  // Copies the states of the given keyframes to a new temporary file and updates their offsets, so
+  // that the movie file they were read from is no longer needed. If that fails, the keyframes lose
+  // their states.
+  bool MoveToTemporaryFile(std::span<MovieKeyframe> keyframes);
+
+  // Compresses the given savestate and stores it after the states of the given keyframes, which
+  // must be sorted by frame. States of keyframes that were removed from them are overwritten.
+  bool AddState(std::span<const u8> state, std::span<MovieKeyframe> keyframes,
+                MovieKeyframe* keyframe);
+
+  bool ReadCompressedState(const MovieKeyframe& keyframe, std::vector<u8>* compressed);
+  bool ReadState(const MovieKeyframe& keyframe, std::vector<u8>* state);
+
+private:
+  bool ReadCompressedStateLocked(const MovieKeyframe& keyframe, std::vector<u8>* compressed);
+  bool MoveToTemporaryFileLocked(std::span<MovieKeyframe> keyframes);
+
+  mutable std::mutex m_mutex;
+  File::IOFile m_file;
+  std::string m_movie_path;
+};
+
+bool IsMovieHeader(const std::array<u8, 4>& magic);
+bool IsIndexedMovieHeader(const std::array<u8, 4>& magic);
+
+// Reads a version 1 or version 2 DTM. Version 1 files have no keyframes. The file position must be
+// at the start of the file. The savestates of the keyframes are not read, see KeyframeStateFile.
+bool ReadMovieFile(File::IOFile& file, DTMHeader* header, std::vector<u8>* input,
+                   std::vector<MovieKeyframe>* keyframes);
+
+// Writes a version 2 DTM, copying the savestates of the keyframes from the given states. The
+// filetype of the given header is ignored.
+bool WriteIndexedMovieFile(File::IOFile& file, const DTMHeader& header, std::span<const u8> input,
+                           std::span<const MovieKeyframe> keyframes, KeyframeStateFile& states);
+
+// Returns the last keyframe at or before the given frame, or nullptr if there is none. If
+// with_state is true, keyframes without a savestate are skipped.
+const MovieKeyframe* FindKeyframe(std::span<const MovieKeyframe> keyframes, u64 frame,
+                                  bool with_state = false);
+
+std::vector<u8> CompressKeyframeState(std::span<const u8> state);
+// Fails without allocating anything if state_size is larger than MAX_KEYFRAME_STATE_SIZE or than
+// the compressed data can expand to.
+bool DecompressKeyframeState(std::span<const u8> compressed, u32 state_size,
+                             std::vector<u8>* state);
+
+// Reads and decompresses the savestate of the keyframe that a seek to the given frame resumes
+// from, which is the last one with a savestate at or before it. Returns that keyframe, or nullptr
+// if there is none or its savestate is corrupt.
+const MovieKeyframe* LoadSeekState(std::span<const MovieKeyframe> keyframes,
+                                   KeyframeStateFile& states, u64 frame, std::vector<u8>* state);
+}  // namespace Movie
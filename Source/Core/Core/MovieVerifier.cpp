@@ -0,0 +1,190 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieVerifier.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MovieFormat.h"
+#include "Core/System.h"
+
+namespace Movie
+{
+static std::string GetDifferingRegions(const Core::StateHashes& a,
+                                       const Core::StateHashes& b)
+{
+  std::vector<std::string_view> regions;
+  if (a.mem1 != b.mem1)
+    regions.push_back("MEM1");
+  if (a.mem2 != b.mem2)
+    regions.push_back("MEM2");
+  if (a.aram != b.aram)
+    regions.push_back("ARAM");
+  if (a.cpu != b.cpu)
+    regions.push_back("CPU");
+  return fmt::format("{}", fmt::join(regions, ", "));
+}
+
+MovieVerifier::MovieVerifier(Mode mode, std::string hashes_path, u32 interval,
+                             FinishedCallback callback)
+    : m_mode(mode), m_hashes_path(std::move(hashes_path)), m_interval(std::max(interval, 1u)),
+      m_callback(std::move(callback))
+{
+}
+
+bool MovieVerifier::Start(std::span<const MovieKeyframe> keyframes)
+{
+  m_expected.clear();
+  m_next_expected = 0;
+  m_recorded.clear();
+  m_frames_checked = 0;
+  m_finished = false;
+
+  if (m_mode == Mode::Record)
+    return true;
+
+  if (File::Exists(m_hashes_path))
+    return LoadHashesFile();
+
+  // Keyframes with a savestate are taken between frames, and each of them has a hash-only twin
+  // taken at the start of the same frame.
+  for (const MovieKeyframe& keyframe : keyframes)
+  {
+    if (!keyframe.HasState())
+      m_expected.push_back({keyframe.frame, {}, true, keyframe.memory_hash});
+  }
+
+  if (m_expected.empty())
+  {
+    ERROR_LOG_FMT(CORE, "Neither {} nor the movie's keyframes have hashes to verify against",
+                  m_hashes_path);
+    return false;
+  }
+
+  INFO_LOG_FMT(CORE, "Verifying movie playback against {} keyframes", m_expected.size());
+  return true;
+}
+
+bool MovieVerifier::LoadHashesFile()
+{
+  std::string contents;
+  if (!File::ReadFileToString(m_hashes_path, contents))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to read {}", m_hashes_path);
+    return false;
+  }
+
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    const std::string trimmed{StripWhitespace(line)};
+    if (trimmed.empty() || trimmed[0] == '#')
+      continue;
+
+    const std::vector<std::string> fields = SplitString(trimmed, ' ');
+    ExpectedHashes expected{};
+    if (fields.size() != 5 || !TryParse(fields[0], &expected.frame, 10) ||
+        !TryParse(fields[1], &expected.hashes.mem1, 16) ||
+        !TryParse(fields[2], &expected.hashes.mem2, 16) ||
+        !TryParse(fields[3], &expected.hashes.aram, 16) ||
+        !TryParse(fields[4], &expected.hashes.cpu, 16) ||
+        (!m_expected.empty() && expected.frame <= m_expected.back().frame))
+    {
+      ERROR_LOG_FMT(CORE, "Invalid line in {}: {}", m_hashes_path, trimmed);
+      return false;
+    }
+    m_expected.push_back(expected);
+  }
+
+  INFO_LOG_FMT(CORE, "Verifying movie playback against {} frames from {}", m_expected.size(),
+               m_hashes_path);
+  return !m_expected.empty();
+}
+
+void MovieVerifier::FrameUpdate(Core::System& system, u64 frame)
+{
+  if (m_finished)
+    return;
+
+  if (m_mode == Mode::Record)
+  {
+    if (frame % m_interval == 0)
+      m_recorded.emplace_back(frame, Core::ComputeStateHashes(system));
+    return;
+  }
+
+  while (m_next_expected < m_expected.size() && m_expected[m_next_expected].frame < frame)
+    ++m_next_expected;
+  if (m_next_expected == m_expected.size() || m_expected[m_next_expected].frame != frame)
+    return;
+
+  const ExpectedHashes& expected = m_expected[m_next_expected++];
+  ++m_frames_checked;
+
+  std::string regions;
+  if (expected.memory_only)
+  {
+    if (system.GetMemory().ComputeHash() != expected.memory_hash)
+      regions = "MEM1/MEM2";
+  }
+  else
+  {
+    const Core::StateHashes hashes = Core::ComputeStateHashes(system);
+    if (hashes != expected.hashes)
+      regions = GetDifferingRegions(hashes, expected.hashes);
+  }
+
+  if (!regions.empty())
+  {
+    Report({.diverged = true,
+            .frame = frame,
+            .frames_checked = m_frames_checked,
+            .regions = std::move(regions)});
+  }
+}
+
+void MovieVerifier::Finish(u64 frame)
+{
+  if (m_finished)
+    return;
+
+  if (m_mode == Mode::Record)
+  {
+    File::IOFile file(m_hashes_path, "w");
+    bool success = file.WriteString("# frame mem1 mem2 aram cpu\n");
+    for (const auto& [recorded_frame, hashes] : m_recorded)
+    {
+      success &= file.WriteString(fmt::format("{} {:016x} {:016x} {:016x} {:016x}\n",
+                                              recorded_frame, hashes.mem1, hashes.mem2,
+                                              hashes.aram, hashes.cpu));
+    }
+    if (!success)
+      ERROR_LOG_FMT(CORE, "Failed to write {}", m_hashes_path);
+    m_frames_checked = m_recorded.size();
+  }
+
+  Report({.diverged = false, .frame = frame, .frames_checked = m_frames_checked});
+}
+
+void MovieVerifier::Report(Result result)
+{
+  m_finished = true;
+
+  if (result.diverged)
+  {
+    ERROR_LOG_FMT(CORE, "Movie playback diverged on frame {} in {}", result.frame,
+                  result.regions);
+  }
+
+  if (m_callback)
+    m_callback(result);
+}
+}  // namespace Movie
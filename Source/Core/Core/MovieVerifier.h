@@ -0,0 +1,90 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/StateHash.h"
+
+namespace Core
+{
+class System;
+}
+
+// Checks that a movie plays back the same way it did on an earlier run, which makes movies usable
+// as determinism tests across builds.
+//
+// At the start of some frames of the playback, the verifier hashes parts of the emulated state and
+// compares them with expected hashes. These come from a hashes file written by an earlier run in
+// record mode, or else from the keyframes of an indexed DTM. Keyframes only have a single hash of
+// MEM1 and MEM2, so a hashes file gives a more precise report of what diverged.
+//
+// Hashes files are text files with one line per checked frame:
+//   <frame> <MEM1 hash> <MEM2 hash> <ARAM hash> <CPU hash>
+// with the hashes in hexadecimal. Lines starting with # are ignored.
+namespace Movie
+{
+struct MovieKeyframe;
+
+class MovieVerifier final
+{
+public:
+  enum class Mode
+  {
+    Record,
+    Verify,
+  };
+
+  struct Result
+  {
+    bool diverged = false;
+    // The last frame that was reached, or the first one that diverged.
+    u64 frame = 0;
+    u64 frames_checked = 0;
+    // Comma separated names of the parts of the state that differ.
+    std::string regions;
+  };
+
+  // Called on the CPU thread when playback diverges or the movie ends.
+  using FinishedCallback = std::function<void(const Result& result)>;
+
+  // In record mode, the hashes of every interval-th frame are written to hashes_path when the movie
+  // ends. In verify mode, interval is unused.
+  MovieVerifier(Mode mode, std::string hashes_path, u32 interval, FinishedCallback callback);
+
+  // Loads the expected hashes. Returns false if verifying and there is nothing to verify against.
+  bool Start(std::span<const MovieKeyframe> keyframes);
+  void FrameUpdate(Core::System& system, u64 frame);
+  void Finish(u64 frame);
+
+private:
+  struct ExpectedHashes
+  {
+    u64 frame;
+    Core::StateHashes hashes;
+    // Keyframes only have a combined hash of MEM1 and MEM2.
+    bool memory_only;
+    u64 memory_hash;
+  };
+
+  bool LoadHashesFile();
+  void Report(Result result);
+
+  Mode m_mode;
+  std::string m_hashes_path;
+  u32 m_interval;
+  FinishedCallback m_callback;
+
+  std::vector<ExpectedHashes> m_expected;
+  size_t m_next_expected = 0;
+  std::vector<std::pair<u64, Core::StateHashes>> m_recorded;
+  u64 m_frames_checked = 0;
+  bool m_finished = false;
+};
+}  // namespace Movie
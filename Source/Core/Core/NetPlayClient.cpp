@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <thread>
 #include <tuple>
@@ -41,6 +42,8 @@
 #include "Core/Config/NetplaySettings.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -64,6 +67,10 @@
 #include "Core/IOS/Uids.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
+#include "Core/NetPlayRollback.h"
+#include "Core/NetPlayStateHash.h"
+#include "Core/State.h"
+#include "Core/StateHash.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -71,6 +78,7 @@
 #include "InputCommon/GCAdapter.h"
 #include "UICommon/GameFile.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/VideoState.h"
 
 namespace NetPlay
 {
@@ -444,6 +452,18 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnDesyncDetected(packet);
     break;
 
+  case MessageID::StateHashRequest:
+    OnStateHashRequest(packet);
+    break;
+
+  case MessageID::StatePageHashes:
+    OnStatePageHashes(packet);
+    break;
+
+  case MessageID::DesyncRegion:
+    OnDesyncRegion(packet);
+    break;
+
   case MessageID::SyncSaveData:
     OnSyncSaveData(packet);
     break;
@@ -685,7 +705,13 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
 
     if (static_cast<size_t>(map) < m_pad_buffer.size())
     {
-      m_pad_buffer.at(map).Push(pad);
+      {
+        std::lock_guard lk(m_rollback_lock);
+        if (m_rollback)
+          m_rollback->AddRemoteInput(map, pad);
+        else
+          m_pad_buffer.at(map).Push(pad);
+      }
       m_gc_pad_event.Set();
     }
   }
@@ -930,6 +956,8 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.golf_mode;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
+    packet >> m_net_settings.rollback_frames;
+    packet >> m_net_settings.state_hash_interval;
 
     for (size_t i = 0; i < sizeof(m_net_settings.sram); ++i)
       packet >> m_net_settings.sram[i];
@@ -1001,6 +1029,83 @@ void NetPlayClient::OnDesyncDetected(sf::Packet& packet)
   m_dialog->OnDesync(frame, player);
 }
 
+void NetPlayClient::OnStateHashRequest(sf::Packet& packet)
+{
+  u32 index;
+  packet >> index;
+
+  std::lock_guard lk(m_state_hasher_lock);
+  const StateHasher::Window* window = m_state_hasher ? m_state_hasher->GetWindow(index) : nullptr;
+  if (!window)
+  {
+    WARN_LOG_FMT(NETPLAY, "The state hashes of window {} are no longer available", index);
+    return;
+  }
+
+  sf::Packet response_packet;
+  response_packet << MessageID::StatePageHashes;
+  response_packet << index;
+  response_packet << window->cpu_hash;
+  response_packet << window->hardware_hash;
+  response_packet << static_cast<u32>(window->page_hashes.size());
+  for (const u64 hash : window->page_hashes)
+    response_packet << hash;
+
+  SendAsync(std::move(response_packet));
+}
+
+void NetPlayClient::OnStatePageHashes(sf::Packet& packet)
+{
+  StateHasher::Window remote_window;
+  u32 num_pages;
+  packet >> remote_window.index;
+  remote_window.cpu_hash = Common::PacketReadU64(packet);
+  remote_window.hardware_hash = Common::PacketReadU64(packet);
+  packet >> num_pages;
+  // MEM1, MEM2 and ARAM are a few thousand pages at most.
+  if (num_pages > 0x10000)
+    return;
+  remote_window.page_hashes.resize(num_pages);
+  for (u64& hash : remote_window.page_hashes)
+    hash = Common::PacketReadU64(packet);
+
+  std::lock_guard lk(m_state_hasher_lock);
+  const StateHasher::Window* window =
+      m_state_hasher ? m_state_hasher->GetWindow(remote_window.index) : nullptr;
+  if (!window)
+    return;
+
+  const std::vector<HashedRegion> regions = GetHashedRegions(Core::System::GetInstance());
+  const std::string region = StateHasher::DescribeDifference(regions, *window, remote_window);
+  INFO_LOG_FMT(NETPLAY, "State of frame {} differs in: {}", window->last_frame, region);
+
+  sf::Packet response_packet;
+  response_packet << MessageID::DesyncRegion;
+  response_packet << static_cast<u32>(window->last_frame);
+  response_packet << region;
+  SendAsync(std::move(response_packet));
+}
+
+void NetPlayClient::OnDesyncRegion(sf::Packet& packet)
+{
+  PlayerId pid;
+  u32 frame;
+  std::string region;
+  packet >> pid;
+  packet >> frame;
+  packet >> region;
+
+  std::string player = "??";
+  {
+    std::lock_guard lkp(m_crit.players);
+    const auto it = m_players.find(pid);
+    if (it != m_players.end())
+      player = it->second.name;
+  }
+
+  m_dialog->OnDesyncRegion(frame, player, region);
+}
+
 void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
 {
   SyncSaveDataID sub_id;
@@ -1760,6 +1865,31 @@ bool NetPlayClient::StartGame(const std::string& path)
 
   ClearBuffers();
 
+  {
+    std::lock_guard lk(m_rollback_lock);
+    if (m_net_settings.rollback_frames != 0)
+      m_rollback = std::make_unique<RollbackController>(m_net_settings.rollback_frames,
+                                                        static_cast<RollbackHost&>(*this));
+    else
+      m_rollback.reset();
+  }
+
+  {
+    std::lock_guard lk(m_state_hasher_lock);
+    if (m_net_settings.state_hash_interval != 0)
+    {
+      // Windows must only be compared once no rollback can change their frames anymore.
+      const u32 commit_delay =
+          m_net_settings.rollback_frames != 0 ? m_net_settings.rollback_frames + 2 : 0;
+      m_state_hasher =
+          std::make_unique<StateHasher>(m_net_settings.state_hash_interval, commit_delay);
+    }
+    else
+    {
+      m_state_hasher.reset();
+    }
+  }
+
   m_first_pad_status_received.fill(false);
 
   if (m_dialog->IsRecording())
@@ -1990,6 +2120,9 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackPad(pad_nb, pad_status);
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -2123,25 +2256,22 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
   return true;
 }
 
+GCPadStatus NetPlayClient::GetLocalPadStatus(const int local_pad) const
+{
+  if (m_net_settings.gba_config[LocalPadToInGamePad(local_pad)].enabled)
+    return Pad::GetGBAStatus(local_pad);
+
+  if (Config::Get(Config::GetInfoForSIDevice(local_pad)) == SerialInterface::SIDEVICE_WIIU_ADAPTER)
+    return GCAdapter::Input(local_pad);
+
+  return Pad::GetStatus(local_pad);
+}
+
 bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
 {
   const int ingame_pad = LocalPadToInGamePad(local_pad);
   bool data_added = false;
-  GCPadStatus pad_status;
-
-  if (m_net_settings.gba_config[ingame_pad].enabled)
-  {
-    pad_status = Pad::GetGBAStatus(local_pad);
-  }
-  else if (Config::Get(Config::GetInfoForSIDevice(local_pad)) ==
-           SerialInterface::SIDEVICE_WIIU_ADAPTER)
-  {
-    pad_status = GCAdapter::Input(local_pad);
-  }
-  else
-  {
-    pad_status = Pad::GetStatus(local_pad);
-  }
+  const GCPadStatus pad_status = GetLocalPadStatus(local_pad);
 
   if (m_host_input_authority)
   {
@@ -2176,6 +2306,109 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   return data_added;
 }
 
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPad(const int pad_nb, GCPadStatus* pad_status)
+{
+  std::optional<GCPadStatus> status;
+  while (!(status = m_rollback->TryGetInput(pad_nb)))
+  {
+    if (!m_is_running.IsSet())
+      return false;
+
+    m_gc_pad_event.Wait();
+  }
+  *pad_status = *status;
+
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (movie.IsRecordingInput())
+  {
+    movie.RecordInput(pad_status, pad_nb);
+    movie.InputUpdate();
+  }
+  else
+  {
+    movie.CheckPadStatus(pad_status, pad_nb);
+  }
+
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::OnRollbackSafePoint()
+{
+  while (m_rollback->TryRunSafePoint() == RollbackController::SafePointResult::Wait)
+  {
+    if (!m_is_running.IsSet())
+      return;
+
+    m_gc_pad_event.Wait();
+  }
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::IsLocalPad(size_t pad) const
+{
+  return InGamePadToLocalPad(static_cast<int>(pad)) < 4;
+}
+
+// called from ---CPU--- thread
+GCPadStatus NetPlayClient::PollLocalInput(size_t pad)
+{
+  const int ingame_pad = static_cast<int>(pad);
+  const GCPadStatus status = GetLocalPadStatus(InGamePadToLocalPad(ingame_pad));
+
+  sf::Packet packet;
+  packet << MessageID::PadData;
+  AddPadStateToPacket(ingame_pad, status, packet);
+  SendAsync(std::move(packet));
+  return status;
+}
+
+// called from ---CPU--- thread
+size_t NetPlayClient::SaveState(Common::UniqueBuffer<u8>& buffer)
+{
+  // The host GPU's copy of the EFB and the texture cache are left out, since reading them back
+  // every frame would cost more than the frame itself.
+  return State::SaveToBuffer(Core::System::GetInstance(), buffer, VideoStateScope::EmulatedOnly);
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::LoadState(std::span<u8> state)
+{
+  return State::LoadFromBuffer(Core::System::GetInstance(), state, VideoStateScope::EmulatedOnly);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SetResimulating(bool resimulating)
+{
+  Core::SetIsResimulating(resimulating);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::HashState(Core::System& system)
+{
+  std::lock_guard lk(m_state_hasher_lock);
+  if (!m_state_hasher)
+    return;
+
+  const std::vector<HashedRegion> regions = GetHashedRegions(system);
+  m_state_hasher->HashFrame(system.GetMovie().GetCurrentFrame(), regions,
+                            Core::ComputeCPUStateHash(system.GetPPCState()),
+                            ComputeHardwareHash(system));
+
+  while (const std::optional<u32> index = m_state_hasher->PopCompletedWindow())
+  {
+    const StateHasher::Window* window = m_state_hasher->GetWindow(*index);
+
+    sf::Packet packet;
+    packet << MessageID::StateHash;
+    packet << window->index;
+    packet << window->last_frame;
+    packet << window->GetDigest();
+    SendAsync(std::move(packet));
+  }
+}
+
 bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
                                             const WiimoteEmu::SerializedWiimoteState& state,
                                             sf::Packet& packet)
@@ -2464,6 +2697,14 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
+  // Frames that are run on predicted inputs are expected to differ between players. State hashes
+  // are checked instead, which also cover the time base.
+  if (netplay_client->IsRollbackEnabled() ||
+      netplay_client->m_net_settings.state_hash_interval != 0)
+  {
+    return;
+  }
+
   if (netplay_client->m_timebase_frame % 60 == 0)
   {
     const u64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
@@ -2637,6 +2878,27 @@ void SendPowerButtonEvent()
   netplay_client->SendPowerButtonEvent();
 }
 
+// called from ---CPU--- thread
+void OnFrameEnd()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client)
+    return;
+
+  auto& system = Core::System::GetInstance();
+  netplay_client->HashState(system);
+
+  if (!netplay_client->IsRollbackEnabled())
+    return;
+
+  // This is called from the VI event that ends the field, where states can't be saved or loaded.
+  system.GetCoreTiming().RunAtSafePoint([] {
+    std::lock_guard safe_point_lk(crit_netplay_client);
+    if (netplay_client)
+      netplay_client->OnRollbackSafePoint();
+  });
+}
+
 std::string GetGBASavePath(int pad_num)
 {
   std::lock_guard lk(crit_netplay_client);
@@ -20,11 +20,17 @@
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
 class BootSessionData;
 
+namespace Core
+{
+class System;
+}
+
 namespace IOS::HLE::FS
 {
 class FileSystem;
@@ -42,6 +48,8 @@ struct SerializedWiimoteState;
 
 namespace NetPlay
 {
+class StateHasher;
+
 class NetPlayUI
 {
 public:
@@ -65,6 +73,7 @@ public:
   virtual void OnPadBufferChanged(u32 buffer) = 0;
   virtual void OnHostInputAuthorityChanged(bool enabled) = 0;
   virtual void OnDesync(u32 frame, const std::string& player) = 0;
+  virtual void OnDesyncRegion(u32 frame, const std::string& player, const std::string& region) = 0;
   virtual void OnConnectionLost() = 0;
   virtual void OnConnectionError(const std::string& message) = 0;
   virtual void OnTraversalError(Common::TraversalClient::FailureReason error) = 0;
@@ -107,7 +116,7 @@ public:
   bool IsHost() const { return pid == 1; }
 };
 
-class NetPlayClient : public Common::TraversalClientClient
+class NetPlayClient : public Common::TraversalClientClient, private RollbackHost
 {
 public:
   void ThreadFunc();
@@ -143,6 +152,12 @@ public:
   bool WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entries);
   bool GetNetPads(int pad_nb, bool from_vi, GCPadStatus* pad_status);
 
+  // Rollback mode
+  bool IsRollbackEnabled() const { return m_rollback != nullptr; }
+  void OnRollbackSafePoint();
+
+  void HashState(Core::System& system);
+
   u64 GetInitialRTCValue() const;
 
   void OnTraversalStateChanged() override;
@@ -198,6 +213,14 @@ protected:
   Common::SPSCQueue<AsyncQueueEntry> m_async_queue;
 
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
+
+  // Replaces m_pad_buffer in rollback mode.
+  std::unique_ptr<RollbackController> m_rollback;
+  std::mutex m_rollback_lock;
+
+  // Hashes of the emulated state that are compared with the other players to detect desyncs.
+  std::unique_ptr<StateHasher> m_state_hasher;
+  std::mutex m_state_hasher_lock;
   std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
 
   std::array<GCPadStatus, 4> m_last_pad_status{};
@@ -251,7 +274,17 @@ private:
   void SyncSaveDataResponse(bool success);
   void SyncCodeResponse(bool success);
 
+  GCPadStatus GetLocalPadStatus(int local_pad) const;
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool GetRollbackPad(int pad_nb, GCPadStatus* pad_status);
+
+  // RollbackHost
+  bool IsLocalPad(size_t pad) const override;
+  GCPadStatus PollLocalInput(size_t pad) override;
+  size_t SaveState(Common::UniqueBuffer<u8>& buffer) override;
+  bool LoadState(std::span<u8> state) override;
+  void SetResimulating(bool resimulating) override;
+
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
@@ -294,6 +327,9 @@ private:
   void OnPing(sf::Packet& packet);
   void OnPlayerPingData(sf::Packet& packet);
   void OnDesyncDetected(sf::Packet& packet);
+  void OnStateHashRequest(sf::Packet& packet);
+  void OnStatePageHashes(sf::Packet& packet);
+  void OnDesyncRegion(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
@@ -122,6 +122,10 @@ struct NetSettings
   bool golf_mode = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
+  // Non-zero if inputs are predicted and rolled back instead of buffered.
+  u32 rollback_frames = 0;
+  // How many frames each state hash covers, or zero to not compare state hashes.
+  u32 state_hash_interval = 0;
 
   Sram sram;
 
@@ -194,6 +198,10 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
+  StateHash = 0xB2,
+  StateHashRequest = 0xB3,
+  StatePageHashes = 0xB4,
+  DesyncRegion = 0xB5,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -268,6 +276,7 @@ std::string GetPlayerMappingString(PlayerId pid, const PadMappingArray& pad_map,
 bool IsNetPlayRunning();
 void SetSIPollBatching(bool state);
 void SendPowerButtonEvent();
+void OnFrameEnd();
 std::string GetGBASavePath(int pad_num);
 PadDetails GetPadDetails(int pad_num);
 int NumLocalWiimotes();
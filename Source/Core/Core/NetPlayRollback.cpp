@@ -0,0 +1,289 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+
+namespace NetPlay
+{
+// About ten seconds of frames.
+static constexpr u64 SNAPSHOT_STATS_INTERVAL = 600;
+
+static bool IsSameInput(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.switches == b.switches &&
+         a.isConnected == b.isConnected;
+}
+
+RollbackSession::RollbackSession(u32 max_frames)
+    : m_max_frames(std::max(max_frames, 1u)), m_saved_frames(m_max_frames + 1)
+{
+}
+
+RollbackSession::Input& RollbackSession::GetOrAddInput(PadInputs& pad, u64 index)
+{
+  ASSERT(index >= pad.base_index);
+  while (pad.base_index + pad.inputs.size() <= index)
+    pad.inputs.emplace_back();
+  return pad.inputs[index - pad.base_index];
+}
+
+void RollbackSession::AddInput(size_t pad, const GCPadStatus& status)
+{
+  PadInputs& pad_inputs = m_pads[pad];
+  const u64 index = pad_inputs.num_confirmed++;
+  Input& input = GetOrAddInput(pad_inputs, index);
+
+  if (input.predicted && !IsSameInput(input.status, status))
+  {
+    // CanPredict and CanAdvanceFrame make sure that this frame is still around.
+    const SavedFrame* saved = FindFrameForInput(pad, index);
+    ASSERT(saved);
+    if (saved && (!m_rollback_frame || saved->frame < *m_rollback_frame))
+      m_rollback_frame = saved->frame;
+  }
+
+  input.status = status;
+  input.confirmed = true;
+  input.predicted = false;
+  pad_inputs.last_confirmed = status;
+}
+
+bool RollbackSession::HasInput(size_t pad) const
+{
+  return m_pads[pad].next_index < m_pads[pad].num_confirmed;
+}
+
+bool RollbackSession::CanPredict(size_t pad) const
+{
+  // Inputs that are used before the first frame starts can't be rolled back.
+  if (!m_started)
+    return false;
+
+  const PadInputs& pad_inputs = m_pads[pad];
+  const u64 oldest_unconfirmed = std::min(pad_inputs.num_confirmed, pad_inputs.next_index);
+  const SavedFrame* saved = FindFrameForInput(pad, oldest_unconfirmed);
+  return saved && m_frame - saved->frame < m_max_frames;
+}
+
+GCPadStatus RollbackSession::GetInput(size_t pad)
+{
+  PadInputs& pad_inputs = m_pads[pad];
+  Input& input = GetOrAddInput(pad_inputs, pad_inputs.next_index++);
+  if (!input.confirmed)
+  {
+    input.status = pad_inputs.last_confirmed;
+    input.predicted = true;
+  }
+  return input.status;
+}
+
+bool RollbackSession::CanAdvanceFrame() const
+{
+  // Advancing drops the frame that is max_frames + 1 frames old.
+  if (!m_started || m_frame < m_max_frames)
+    return true;
+  return !IsOldestUnconfirmedInputBefore(m_frame + 1 - m_max_frames);
+}
+
+RollbackSession::SavedFrame& RollbackSession::AdvanceFrame()
+{
+  if (m_started)
+    ++m_frame;
+  m_started = true;
+
+  SavedFrame& saved = m_saved_frames[m_frame % m_saved_frames.size()];
+  saved.frame = m_frame;
+  saved.valid = true;
+  saved.state_size = 0;
+  for (size_t i = 0; i < NUM_PADS; ++i)
+    saved.input_index[i] = m_pads[i].next_index;
+
+  PruneInputs();
+  return saved;
+}
+
+RollbackSession::SavedFrame& RollbackSession::RollBack(u64 frame)
+{
+  SavedFrame& saved = m_saved_frames[frame % m_saved_frames.size()];
+  ASSERT(FindSavedFrame(frame) == &saved);
+
+  m_resimulate_until = std::max(m_resimulate_until, m_frame + 1);
+  m_frame = frame;
+  m_rollback_frame.reset();
+
+  for (size_t i = 0; i < NUM_PADS; ++i)
+  {
+    PadInputs& pad_inputs = m_pads[i];
+    pad_inputs.next_index = saved.input_index[i];
+    for (u64 index = pad_inputs.next_index;
+         index < pad_inputs.base_index + pad_inputs.inputs.size(); ++index)
+    {
+      pad_inputs.inputs[index - pad_inputs.base_index].predicted = false;
+    }
+  }
+
+  return saved;
+}
+
+const RollbackSession::SavedFrame* RollbackSession::FindSavedFrame(u64 frame) const
+{
+  const SavedFrame& saved = m_saved_frames[frame % m_saved_frames.size()];
+  if (!saved.valid || saved.frame != frame || frame > m_frame)
+    return nullptr;
+  return &saved;
+}
+
+const RollbackSession::SavedFrame* RollbackSession::FindFrameForInput(size_t pad, u64 index) const
+{
+  // The input was used during the last frame that started before it.
+  const u64 oldest_frame = m_frame > m_max_frames ? m_frame - m_max_frames : 0;
+  for (u64 frame = m_frame + 1; frame-- > oldest_frame;)
+  {
+    const SavedFrame* saved = FindSavedFrame(frame);
+    if (saved && saved->input_index[pad] <= index)
+      return saved;
+  }
+  return nullptr;
+}
+
+bool RollbackSession::IsOldestUnconfirmedInputBefore(u64 frame) const
+{
+  for (size_t i = 0; i < NUM_PADS; ++i)
+  {
+    const PadInputs& pad_inputs = m_pads[i];
+    if (pad_inputs.num_confirmed >= pad_inputs.next_index)
+      continue;
+
+    const SavedFrame* saved = FindFrameForInput(i, pad_inputs.num_confirmed);
+    if (!saved || saved->frame < frame)
+      return true;
+  }
+  return false;
+}
+
+void RollbackSession::PruneInputs()
+{
+  // Nothing before the oldest saved frame can be used again.
+  const u64 oldest_frame = m_frame > m_max_frames ? m_frame - m_max_frames : 0;
+  const SavedFrame* oldest = FindSavedFrame(oldest_frame);
+  if (!oldest)
+    return;
+
+  for (size_t i = 0; i < NUM_PADS; ++i)
+  {
+    PadInputs& pad_inputs = m_pads[i];
+    const u64 end = std::min(oldest->input_index[i], pad_inputs.num_confirmed);
+    while (pad_inputs.base_index < end && !pad_inputs.inputs.empty())
+    {
+      pad_inputs.inputs.pop_front();
+      ++pad_inputs.base_index;
+    }
+  }
+}
+
+RollbackController::RollbackController(u32 max_frames, RollbackHost& host)
+    : m_host(host), m_session(max_frames)
+{
+}
+
+void RollbackController::AddRemoteInput(size_t pad, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_lock);
+  m_session.AddInput(pad, status);
+}
+
+std::optional<GCPadStatus> RollbackController::TryGetInput(size_t pad)
+{
+  std::lock_guard lk(m_lock);
+
+  // Local pads are polled one at a time, when the game first asks for each input. When simulating
+  // frames again after a rollback, the inputs that were polled the first time are used instead.
+  if (m_host.IsLocalPad(pad) && !m_session.HasInput(pad))
+    m_session.AddInput(pad, m_host.PollLocalInput(pad));
+
+  // Remote inputs that haven't arrived yet are predicted, unless that would get further ahead of
+  // them than we can roll back.
+  if (!m_session.HasInput(pad) && !m_session.CanPredict(pad))
+    return std::nullopt;
+
+  return m_session.GetInput(pad);
+}
+
+RollbackController::SafePointResult RollbackController::TryRunSafePoint()
+{
+  std::unique_lock lk(m_lock);
+  if (const std::optional<u64> frame = m_session.GetRollbackFrame())
+  {
+    RollbackSession::SavedFrame& saved = m_session.RollBack(*frame);
+    lk.unlock();
+
+    DEBUG_LOG_FMT(NETPLAY, "Rolling back to frame {}", *frame);
+    m_host.SetResimulating(true);
+    const TimePoint start = Clock::now();
+    if (!m_host.LoadState(std::span(saved.state.data(), saved.state_size)))
+      PanicAlertFmt("Failed to load the NetPlay rollback state of frame {}", *frame);
+
+    const DT load_time = Clock::now() - start;
+    ++m_stats.states_loaded;
+    m_stats.total_load_time += load_time;
+    m_stats.max_load_time = std::max(m_stats.max_load_time, load_time);
+    return SafePointResult::RolledBack;
+  }
+
+  // Some inputs that were predicted in the oldest frame may still be missing.
+  if (!m_session.CanAdvanceFrame())
+    return SafePointResult::Wait;
+
+  RollbackSession::SavedFrame& saved = m_session.AdvanceFrame();
+  const bool resimulating = m_session.IsResimulating();
+  lk.unlock();
+
+  // The saved frames' buffers are only touched here, so inputs can keep arriving while saving. They
+  // are reused, so after the first few frames this doesn't allocate.
+  m_host.SetResimulating(resimulating);
+  const TimePoint start = Clock::now();
+  saved.state_size = m_host.SaveState(saved.state);
+  if (saved.state_size == 0)
+    PanicAlertFmt("Failed to save the NetPlay rollback state of frame {}", saved.frame);
+
+  const DT save_time = Clock::now() - start;
+  ++m_stats.states_saved;
+  m_stats.total_save_time += save_time;
+  m_stats.max_save_time = std::max(m_stats.max_save_time, save_time);
+  m_stats.state_size = saved.state_size;
+  if (m_stats.states_saved == SNAPSHOT_STATS_INTERVAL)
+    LogSnapshotStats();
+
+  return SafePointResult::Saved;
+}
+
+void RollbackController::LogSnapshotStats()
+{
+  const SnapshotStats& stats = m_stats;
+  const double avg_load_ms =
+      stats.states_loaded == 0 ? 0.0 : DT_ms(stats.total_load_time).count() / stats.states_loaded;
+  INFO_LOG_FMT(NETPLAY,
+               "Rollback snapshots: {} KiB, saved {} in {:.3f} ms avg / {:.3f} ms max, "
+               "loaded {} in {:.3f} ms avg / {:.3f} ms max",
+               stats.state_size / 1024, stats.states_saved,
+               DT_ms(stats.total_save_time).count() / stats.states_saved,
+               DT_ms(stats.max_save_time).count(), stats.states_loaded, avg_load_ms,
+               DT_ms(stats.max_load_time).count());
+  m_stats = {};
+}
+
+std::optional<u64> RollbackController::GetRollbackFrame() const
+{
+  std::lock_guard lk(m_lock);
+  return m_session.GetRollbackFrame();
+}
+}  // namespace NetPlay
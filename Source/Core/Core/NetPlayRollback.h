@@ -0,0 +1,190 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+// Input prediction and rollback for NetPlay.
+//
+// Instead of delaying every input by the pad buffer size, the game keeps running with predicted
+// inputs for the players whose inputs haven't arrived yet. A state is saved at the start of every
+// frame. When an input arrives that differs from what was predicted for it, the last state from
+// before the input was used is loaded, and the frames from there on are simulated again with the
+// correct inputs.
+//
+// Inputs of each pad are identified by the order they are polled in, which is the same for all
+// players as long as the emulation is deterministic. Loading a state rewinds that order.
+//
+// RollbackSession only does the bookkeeping. RollbackController uses it to drive the emulation on
+// the CPU thread, and leaves the work that needs the emulator to a RollbackHost.
+namespace NetPlay
+{
+class RollbackSession final
+{
+public:
+  static constexpr size_t NUM_PADS = 4;
+
+  struct SavedFrame
+  {
+    u64 frame = 0;
+    // The index of the next input of each pad at the start of the frame.
+    std::array<u64, NUM_PADS> input_index{};
+    Common::UniqueBuffer<u8> state;
+    size_t state_size = 0;
+    bool valid = false;
+  };
+
+  // max_frames is the number of frames that the emulation may run ahead of the last confirmed
+  // input, and so also the largest number of frames that a rollback has to simulate again.
+  explicit RollbackSession(u32 max_frames);
+
+  u32 GetMaxFrames() const { return m_max_frames; }
+  u64 GetFrame() const { return m_frame; }
+
+  // Adds the next input of a pad, whether it was polled locally or received from another player.
+  void AddInput(size_t pad, const GCPadStatus& status);
+  // Whether the next input of the pad that the game will use has been added yet.
+  bool HasInput(size_t pad) const;
+  // Whether the next input of the pad can be predicted without getting further ahead of the
+  // confirmed inputs than a rollback could fix.
+  bool CanPredict(size_t pad) const;
+  // Returns the next input of the pad for the game to use. If it hasn't been added yet, the last
+  // added input of the pad is used as the prediction.
+  GCPadStatus GetInput(size_t pad);
+
+  // Whether the oldest saved frame can be dropped to start a new one. If it can't, some inputs that
+  // were predicted in that frame are still missing.
+  bool CanAdvanceFrame() const;
+  // Starts a new frame. The state of the emulation at the start of it should be saved to the
+  // returned frame's buffer, followed by setting its state_size.
+  SavedFrame& AdvanceFrame();
+
+  // The frame to roll back to because an input was mispredicted, if any.
+  std::optional<u64> GetRollbackFrame() const { return m_rollback_frame; }
+  // Rewinds to the start of the given frame. The state in the returned frame should be loaded.
+  SavedFrame& RollBack(u64 frame);
+  // Whether the current frame was already run once before the last rollback.
+  bool IsResimulating() const { return m_frame < m_resimulate_until; }
+
+private:
+  struct Input
+  {
+    GCPadStatus status;
+    bool confirmed = false;
+    // The input was used by the game before it was confirmed.
+    bool predicted = false;
+  };
+
+  struct PadInputs
+  {
+    // Inputs from base_index on that may still be needed.
+    std::deque<Input> inputs;
+    u64 base_index = 0;
+    u64 num_confirmed = 0;
+    u64 next_index = 0;
+    GCPadStatus last_confirmed;
+  };
+
+  Input& GetOrAddInput(PadInputs& pad, u64 index);
+  const SavedFrame* FindSavedFrame(u64 frame) const;
+  const SavedFrame* FindFrameForInput(size_t pad, u64 index) const;
+  bool IsOldestUnconfirmedInputBefore(u64 frame) const;
+  void PruneInputs();
+
+  u32 m_max_frames;
+  std::array<PadInputs, NUM_PADS> m_pads;
+  // A ring buffer of the last max_frames + 1 frames.
+  std::vector<SavedFrame> m_saved_frames;
+  u64 m_frame = 0;
+  bool m_started = false;
+  std::optional<u64> m_rollback_frame;
+  u64 m_resimulate_until = 0;
+};
+
+// What RollbackController needs from the emulator. Called on the CPU thread.
+class RollbackHost
+{
+public:
+  virtual ~RollbackHost() = default;
+
+  // Whether the in-game pad is controlled by this player.
+  virtual bool IsLocalPad(size_t pad) const = 0;
+  // Polls the local controller of the in-game pad, and sends the input to the other players.
+  virtual GCPadStatus PollLocalInput(size_t pad) = 0;
+
+  // Saves the emulated state to the buffer, growing it if needed. Returns the size of the state, or
+  // 0 on failure.
+  virtual size_t SaveState(Common::UniqueBuffer<u8>& buffer) = 0;
+  virtual bool LoadState(std::span<u8> state) = 0;
+  // Frames that are simulated again have already been shown and heard.
+  virtual void SetResimulating(bool resimulating) = 0;
+};
+
+// Provides the inputs that the game polls and saves or loads the state at the start of every frame.
+// Inputs from other players may be added from any thread, everything else is CPU thread only.
+class RollbackController final
+{
+public:
+  enum class SafePointResult
+  {
+    // The state at the start of a new frame was saved.
+    Saved,
+    // A state was loaded to simulate the frames after a mispredicted input again.
+    RolledBack,
+    // Neither is possible until more inputs from other players arrive.
+    Wait,
+  };
+
+  // What saving a state every frame costs, which adds to the time of every frame, and what loading
+  // one costs, which adds to a frame that rolls back.
+  struct SnapshotStats
+  {
+    u64 states_saved = 0;
+    DT total_save_time{};
+    DT max_save_time{};
+    u64 states_loaded = 0;
+    DT total_load_time{};
+    DT max_load_time{};
+    size_t state_size = 0;
+  };
+
+  RollbackController(u32 max_frames, RollbackHost& host);
+
+  // Adds an input that was received from another player.
+  void AddRemoteInput(size_t pad, const GCPadStatus& status);
+
+  // Returns the input of the pad for the game to use, or nothing if the game has to wait for an
+  // input from another player first.
+  std::optional<GCPadStatus> TryGetInput(size_t pad);
+
+  // Called at the start of every frame, where the state can be saved and loaded.
+  SafePointResult TryRunSafePoint();
+
+  u32 GetMaxFrames() const { return m_session.GetMaxFrames(); }
+  std::optional<u64> GetRollbackFrame() const;
+
+  // Since the stats were last logged, which happens every few hundred saved states.
+  const SnapshotStats& GetSnapshotStats() const { return m_stats; }
+
+private:
+  void LogSnapshotStats();
+
+  RollbackHost& m_host;
+  mutable std::mutex m_lock;
+  RollbackSession m_session;
+
+  // Only touched on the CPU thread.
+  SnapshotStats m_stats;
+};
+}  // namespace NetPlay
@@ -431,6 +431,30 @@ static void SendSyncIdentifier(sf::Packet& spac, const SyncIdentifier& sync_iden
     spac << x;
 }
 
+// Returns nothing if all players reported the same value, the player to blame if it is the only
+// outlier, or 0 if it can't be told who desynced.
+static std::optional<int> FindDesyncedPlayer(const std::vector<std::pair<PlayerId, u64>>& values)
+{
+  if (std::ranges::all_of(values, [&](std::pair<PlayerId, u64> pair) {
+        return pair.second == values[0].second;
+      }))
+  {
+    return std::nullopt;
+  }
+
+  for (auto pair : values)
+  {
+    if (std::ranges::all_of(values, [&](std::pair<PlayerId, u64> other) {
+          return other.first == pair.first || other.second != pair.second;
+        }))
+    {
+      // we are the only outlier
+      return pair.first;
+    }
+  }
+  return 0;
+}
+
 // called from ---NETPLAY--- thread
 ConnectionError NetPlayServer::OnConnect(ENetPeer* incoming_connection, sf::Packet& received_packet)
 {
@@ -1081,26 +1105,11 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     {
       // we have all records for this frame
 
-      if (!std::ranges::all_of(timebases, [&](std::pair<PlayerId, u64> pair) {
-            return pair.second == timebases[0].second;
-          }))
+      if (const std::optional<int> pid_to_blame = FindDesyncedPlayer(timebases))
       {
-        int pid_to_blame = 0;
-        for (auto pair : timebases)
-        {
-          if (std::ranges::all_of(timebases, [&](std::pair<PlayerId, u64> other) {
-                return other.first == pair.first || other.second != pair.second;
-              }))
-          {
-            // we are the only outlier
-            pid_to_blame = pair.first;
-            break;
-          }
-        }
-
         sf::Packet spac;
         spac << MessageID::DesyncDetected;
-        spac << pid_to_blame;
+        spac << *pid_to_blame;
         spac << frame;
         SendToClients(spac);
 
@@ -1111,6 +1120,95 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::StateHash:
+  {
+    u32 window;
+    packet >> window;
+    const u64 frame = Common::PacketReadU64(packet);
+    const u64 digest = Common::PacketReadU64(packet);
+
+    if (m_desync_detected)
+      break;
+
+    std::vector<std::pair<PlayerId, u64>>& digests = m_state_hash_by_window[window];
+    digests.emplace_back(player.pid, digest);
+    if (digests.size() >= m_players.size())
+    {
+      if (const std::optional<int> pid_to_blame = FindDesyncedPlayer(digests))
+      {
+        sf::Packet spac;
+        spac << MessageID::DesyncDetected;
+        spac << *pid_to_blame;
+        spac << static_cast<u32>(frame);
+        SendToClients(spac);
+
+        m_desync_detected = true;
+
+        // Have the desynced player compare its page hashes with those of a player it differs from,
+        // to find out where the state diverged.
+        const auto desynced =
+            *pid_to_blame != 0 ? std::ranges::find(digests, PlayerId(*pid_to_blame),
+                                                   &std::pair<PlayerId, u64>::first) :
+                                 digests.begin();
+        const auto reference = std::ranges::find_if(
+            digests, [&](const auto& pair) { return pair.second != desynced->second; });
+        m_desync_region_player = desynced->first;
+
+        sf::Packet request;
+        request << MessageID::StateHashRequest;
+        request << window;
+        SendAsync(std::move(request), reference->first);
+      }
+      m_state_hash_by_window.erase(window);
+    }
+  }
+  break;
+
+  case MessageID::StatePageHashes:
+  {
+    if (m_desync_region_player == 0 || m_desync_region_player == player.pid)
+      break;
+
+    u32 window;
+    u32 num_pages;
+    packet >> window;
+    const u64 cpu_hash = Common::PacketReadU64(packet);
+    const u64 hardware_hash = Common::PacketReadU64(packet);
+    packet >> num_pages;
+
+    sf::Packet spac;
+    spac << MessageID::StatePageHashes;
+    spac << window;
+    spac << cpu_hash;
+    spac << hardware_hash;
+    spac << num_pages;
+    for (u32 i = 0; i < num_pages && !packet.endOfPacket(); ++i)
+      spac << Common::PacketReadU64(packet);
+
+    SendAsync(std::move(spac), m_desync_region_player);
+  }
+  break;
+
+  case MessageID::DesyncRegion:
+  {
+    if (player.pid != m_desync_region_player)
+      break;
+
+    u32 frame;
+    std::string region;
+    packet >> frame;
+    packet >> region;
+    m_desync_region_player = 0;
+
+    sf::Packet spac;
+    spac << MessageID::DesyncRegion;
+    spac << player.pid;
+    spac << frame;
+    spac << region;
+    SendToClients(spac);
+  }
+  break;
+
   case MessageID::GameDigestProgress:
   {
     int progress;
@@ -1480,6 +1578,21 @@ bool NetPlayServer::SetupNetSettings()
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
 
+  // Rollback only covers GameCube controllers. Wii Remote inputs and GBAs, which run on their own
+  // threads, can't be rewound along with the emulated state.
+  if (Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback")
+  {
+    const bool has_other_inputs =
+        std::ranges::any_of(m_wiimote_map, [](PlayerId pid) { return pid != 0; }) ||
+        std::ranges::any_of(m_gba_config, &GBAConfig::enabled);
+    if (has_other_inputs)
+      WARN_LOG_FMT(NETPLAY, "Rollback is only supported with GameCube controllers");
+    else
+      settings.rollback_frames = std::max(Config::Get(Config::NETPLAY_ROLLBACK_FRAMES), 1u);
+  }
+
+  settings.state_hash_interval = Config::Get(Config::NETPLAY_STATE_HASH_INTERVAL);
+
   // Unload GameINI to restore things to normal
   Config::RemoveLayer(Config::LayerType::GlobalGame);
   Config::RemoveLayer(Config::LayerType::LocalGame);
@@ -1582,7 +1695,9 @@ bool NetPlayServer::StartGame()
   INFO_LOG_FMT(NETPLAY, "Starting game.");
 
   m_timebase_by_frame.clear();
+  m_state_hash_by_window.clear();
   m_desync_detected = false;
+  m_desync_region_player = 0;
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1687,6 +1802,8 @@ bool NetPlayServer::StartGame()
   spac << m_settings.golf_mode;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
+  spac << m_settings.rollback_frames;
+  spac << m_settings.state_hash_interval;
 
   for (size_t i = 0; i < sizeof(m_settings.sram); ++i)
     spac << m_settings.sram[i];
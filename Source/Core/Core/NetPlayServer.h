@@ -182,7 +182,10 @@ private:
   std::map<PlayerId, Client> m_players;
 
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_state_hash_by_window;
   bool m_desync_detected = false;
+  // The player that compares its page hashes with another player's after a desync.
+  PlayerId m_desync_region_player = 0;
 
   struct
   {
@@ -0,0 +1,203 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayStateHash.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <xxhash.h>
+
+#include "Core/CoreTiming.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/ProcessorInterface.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/System.h"
+
+namespace NetPlay
+{
+static size_t GetNumPages(const HashedRegion& region)
+{
+  return (region.data.size() + StateHasher::PAGE_SIZE - 1) / StateHasher::PAGE_SIZE;
+}
+
+static size_t GetNumPages(std::span<const HashedRegion> regions)
+{
+  size_t pages = 0;
+  for (const HashedRegion& region : regions)
+    pages += GetNumPages(region);
+  return pages;
+}
+
+std::vector<HashedRegion> GetHashedRegions(Core::System& system)
+{
+  auto& memory = system.GetMemory();
+  auto& dsp = system.GetDSP();
+
+  std::vector<HashedRegion> regions;
+  regions.push_back({"MEM1", 0x80000000, {memory.GetRAM(), memory.GetRamSizeReal()}});
+  if (memory.GetEXRAM())
+    regions.push_back({"MEM2", 0x90000000, {memory.GetEXRAM(), memory.GetExRamSizeReal()}});
+  // On the Wii, ARAM is a part of MEM2.
+  if (dsp.GetARAMPtr() && dsp.GetARAMPtr() != memory.GetEXRAM())
+    regions.push_back({"ARAM", 0, {dsp.GetARAMPtr(), dsp.GetARAMSize()}});
+  return regions;
+}
+
+u64 ComputeHardwareHash(Core::System& system)
+{
+  auto& processor_interface = system.GetProcessorInterface();
+  const u64 values[] = {system.GetCoreTiming().GetTicks(),
+                        system.GetSystemTimers().GetFakeTimeBase(), processor_interface.GetCause(),
+                        processor_interface.GetMask()};
+  return XXH3_64bits(values, sizeof(values));
+}
+
+u64 StateHasher::Window::GetDigest() const
+{
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_64bits_reset(&state);
+  XXH3_64bits_update(&state, page_hashes.data(), page_hashes.size() * sizeof(u64));
+  XXH3_64bits_update(&state, &cpu_hash, sizeof(cpu_hash));
+  XXH3_64bits_update(&state, &hardware_hash, sizeof(hardware_hash));
+  return XXH3_64bits_digest(&state);
+}
+
+StateHasher::StateHasher(u32 frames_per_window, u32 commit_delay)
+    : m_frames_per_window(std::max(frames_per_window, 1u)), m_commit_delay(commit_delay)
+{
+}
+
+StateHasher::Window* StateHasher::GetOrAddWindow(u32 index)
+{
+  const auto it = std::ranges::lower_bound(m_windows, index, {}, &Window::index);
+  if (it != m_windows.end() && it->index == index)
+    return &*it;
+  // Older windows were already dropped.
+  if (it == m_windows.begin() && !m_windows.empty())
+    return nullptr;
+
+  Window& window = *m_windows.insert(it, Window{});
+  window.index = index;
+  return &window;
+}
+
+void StateHasher::HashFrame(u64 frame, std::span<const HashedRegion> regions, u64 cpu_hash,
+                            u64 hardware_hash)
+{
+  const u32 index = static_cast<u32>(frame / m_frames_per_window);
+  const u32 offset = static_cast<u32>(frame % m_frames_per_window);
+
+  Window* window = index >= m_first_incomplete_window ? GetOrAddWindow(index) : nullptr;
+  if (window)
+  {
+    const size_t num_pages = GetNumPages(regions);
+    window->page_hashes.resize(num_pages);
+
+    // Each frame of the window hashes its share of the pages.
+    const size_t first_page = num_pages * offset / m_frames_per_window;
+    const size_t end_page = num_pages * (offset + 1) / m_frames_per_window;
+    size_t region_first_page = 0;
+    for (const HashedRegion& region : regions)
+    {
+      const size_t region_end_page = region_first_page + GetNumPages(region);
+      for (size_t page = std::max(first_page, region_first_page);
+           page < std::min(end_page, region_end_page); ++page)
+      {
+        const size_t page_offset = (page - region_first_page) * PAGE_SIZE;
+        const std::span<const u8> data = region.data.subspan(
+            page_offset, std::min<size_t>(PAGE_SIZE, region.data.size() - page_offset));
+        window->page_hashes[page] = XXH3_64bits(data.data(), data.size());
+      }
+      region_first_page = region_end_page;
+    }
+
+    if (offset == m_frames_per_window - 1)
+    {
+      window->last_frame = frame;
+      window->cpu_hash = cpu_hash;
+      window->hardware_hash = hardware_hash;
+    }
+  }
+
+  while (frame >= (u64(m_first_incomplete_window) + 1) * m_frames_per_window - 1 + m_commit_delay)
+  {
+    if (GetWindow(m_first_incomplete_window))
+      m_completed.push_back(m_first_incomplete_window);
+    ++m_first_incomplete_window;
+  }
+
+  while (!m_windows.empty() &&
+         m_windows.front().index + NUM_KEPT_WINDOWS < m_first_incomplete_window)
+  {
+    m_windows.pop_front();
+  }
+}
+
+std::optional<u32> StateHasher::PopCompletedWindow()
+{
+  if (m_completed.empty())
+    return std::nullopt;
+  const u32 index = m_completed.front();
+  m_completed.pop_front();
+  return index;
+}
+
+const StateHasher::Window* StateHasher::GetWindow(u32 index) const
+{
+  const auto it = std::ranges::lower_bound(m_windows, index, {}, &Window::index);
+  if (it == m_windows.end() || it->index != index)
+    return nullptr;
+  return &*it;
+}
+
+std::string StateHasher::DescribeDifference(std::span<const HashedRegion> regions,
+                                            const Window& a, const Window& b)
+{
+  std::vector<std::string> differences;
+
+  const size_t num_pages = std::min(a.page_hashes.size(), b.page_hashes.size());
+  std::optional<size_t> first_page;
+  size_t num_differing_pages = 0;
+  for (size_t page = 0; page < num_pages; ++page)
+  {
+    if (a.page_hashes[page] == b.page_hashes[page])
+      continue;
+    if (!first_page)
+      first_page = page;
+    ++num_differing_pages;
+  }
+
+  if (first_page)
+  {
+    size_t region_first_page = 0;
+    for (const HashedRegion& region : regions)
+    {
+      const size_t region_end_page = region_first_page + GetNumPages(region);
+      if (*first_page < region_end_page)
+      {
+        const u32 start = region.address + u32(*first_page - region_first_page) * PAGE_SIZE;
+        const u32 end =
+            region.address + std::min<u32>(u32(*first_page - region_first_page + 1) * PAGE_SIZE,
+                                           u32(region.data.size()));
+        differences.push_back(fmt::format("{} 0x{:08x}-0x{:08x}", region.name, start, end - 1));
+        break;
+      }
+      region_first_page = region_end_page;
+    }
+    if (num_differing_pages > 1)
+      differences.push_back(fmt::format("{} more pages", num_differing_pages - 1));
+  }
+  if (a.page_hashes.size() != b.page_hashes.size())
+    differences.emplace_back("memory size");
+  if (a.cpu_hash != b.cpu_hash)
+    differences.emplace_back("CPU registers");
+  if (a.hardware_hash != b.hardware_hash)
+    differences.emplace_back("hardware state");
+
+  return fmt::format("{}", fmt::join(differences, ", "));
+}
+}  // namespace NetPlay
@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+// Desync detection for NetPlay using hashes of the emulated state.
+//
+// Frames are grouped into windows of a fixed number of frames. Over the course of a window, every
+// page of MEM1, MEM2 and ARAM is hashed once, a few pages per frame so that the cost is spread out.
+// The CPU registers and some hardware state are hashed on the last frame of the window. Players
+// only exchange a single digest per window. When the digests differ, the page hashes of the window
+// are compared to find where the state diverged.
+namespace NetPlay
+{
+struct HashedRegion
+{
+  std::string_view name;
+  u32 address;
+  std::span<const u8> data;
+};
+
+std::vector<HashedRegion> GetHashedRegions(Core::System& system);
+u64 ComputeHardwareHash(Core::System& system);
+
+class StateHasher final
+{
+public:
+  static constexpr u32 PAGE_SIZE = 0x10000;
+  // How many completed windows are kept for comparisons with other players.
+  static constexpr size_t NUM_KEPT_WINDOWS = 8;
+
+  struct Window
+  {
+    u32 index = 0;
+    u64 last_frame = 0;
+    std::vector<u64> page_hashes;
+    u64 cpu_hash = 0;
+    u64 hardware_hash = 0;
+
+    u64 GetDigest() const;
+  };
+
+  // A window is only complete commit_delay frames after its last frame, so that the frames that
+  // NetPlay rollback simulates again can still replace its hashes.
+  StateHasher(u32 frames_per_window, u32 commit_delay);
+
+  u32 GetFramesPerWindow() const { return m_frames_per_window; }
+
+  void HashFrame(u64 frame, std::span<const HashedRegion> regions, u64 cpu_hash,
+                 u64 hardware_hash);
+
+  // Returns the index of a window that was completed since the last call.
+  std::optional<u32> PopCompletedWindow();
+  const Window* GetWindow(u32 index) const;
+
+  // Describes the first part of the state that differs between two versions of a window, or
+  // returns an empty string if they are identical.
+  static std::string DescribeDifference(std::span<const HashedRegion> regions, const Window& a,
+                                        const Window& b);
+
+private:
+  Window* GetOrAddWindow(u32 index);
+
+  u32 m_frames_per_window;
+  u32 m_commit_delay;
+  // Windows that are in progress or completed, in order.
+  std::deque<Window> m_windows;
+  // Windows before this one are complete and no longer change.
+  u32 m_first_incomplete_window = 0;
+  std::deque<u32> m_completed;
+};
+}  // namespace NetPlay
@@ -12,6 +12,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/Logging/Log.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -278,6 +279,7 @@ void CachedInterpreter::ResetFreeMemoryRanges()
 
 void CachedInterpreter::Jit(u32 em_address)
 {
+  TRACE_SCOPE("JIT", "Compile block");
   Jit(em_address, true);
 }
 
@@ -23,6 +23,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Common/x64ABI.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -781,6 +782,7 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  TRACE_SCOPE("JIT", "Compile block");
   Jit(em_address, true);
 }
 
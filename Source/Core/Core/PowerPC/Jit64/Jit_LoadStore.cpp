@@ -448,7 +448,8 @@ void Jit64::dcbz(UGeckoInstruction inst)
   }
 
   bool emit_fast_path = (m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR) &&
-                        m_jit.jo.fastmem_arena && !m_accurate_cpu_cache_enabled;
+                        m_jit.jo.fastmem_arena && !m_accurate_cpu_cache_enabled &&
+                        !m_jit.jo.dirty_page_tracking;
 
   if (emit_fast_path)
   {
@@ -20,6 +20,7 @@
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -973,6 +974,7 @@ void JitArm64::Trace()
 
 void JitArm64::Jit(u32 em_address)
 {
+  TRACE_SCOPE("JIT", "Compile block");
   Jit(em_address, true);
 }
 
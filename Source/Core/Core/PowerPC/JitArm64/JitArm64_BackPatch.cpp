@@ -62,6 +62,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, MemAccessMode mode, ARM64Reg RS,
 
   if (m_accurate_cpu_cache_enabled)
     mode = MemAccessMode::AlwaysSlowAccess;
+  if (jo.dirty_page_tracking &&
+      (flags & (BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_ZERO_256)) != 0)
+    mode = MemAccessMode::AlwaysSlowAccess;
 
   const bool emit_fast_access = mode != MemAccessMode::AlwaysSlowAccess;
   const bool emit_slow_access = mode != MemAccessMode::AlwaysFastAccess;
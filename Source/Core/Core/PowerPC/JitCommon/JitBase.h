@@ -87,6 +87,8 @@ protected:
     bool accurateSinglePrecision;
     bool fastmem;
     bool fastmem_arena;
+    // Stores must go through the slow path so that MemoryManager can track dirty pages.
+    bool dirty_page_tracking;
     bool memcheck;
     bool fp_exceptions;
     bool div_by_zero_exceptions;
@@ -69,6 +69,8 @@ MMU::~MMU() = default;
 void MMU::Reset()
 {
   ClearPageTable();
+  ClearTranslationCache();
+  m_translation_cache_stats = {};
 }
 
 void MMU::DoState(PointerWrap& p, bool sr_changed)
@@ -78,6 +80,9 @@ void MMU::DoState(PointerWrap& p, bool sr_changed)
   // than we had when the savestate was created, which could be a problem for TAS determinism.
   if (p.IsReadMode())
   {
+    // The TLB has been replaced, so none of the cached translations can be trusted.
+    ClearTranslationCache();
+
     if (!m_system.GetJitInterface().WantsPageTableMappings())
     {
       // Clear page table mappings if we have any.
@@ -469,7 +474,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
       m_ppc_state.dCache.Write(m_memory, em_address, &swapped_data, size, HID0(m_ppc_state).DLOCK);
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetRAM()[em_address], &swapped_data, size);
+      m_memory.MarkDirty(em_address, size);
+    }
 
     return;
   }
@@ -486,7 +494,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetEXRAM()[em_address], &swapped_data, size);
+      m_memory.MarkDirty(em_address + 0x10000000, size);
+    }
 
     return;
   }
@@ -1281,6 +1292,9 @@ void MMU::SDRUpdated()
 
 void MMU::SRUpdated()
 {
+  // The translation cache is indexed by effective address, so it doesn't know about VSIDs.
+  ClearTranslationCache();
+
   // Our incremental handling of page table updates can't handle SR changing, so throw away all
   // existing mappings and then reparse the whole page table.
   m_memory.RemoveAllPageTableMappings();
@@ -1296,7 +1310,7 @@ enum class TLBLookupResult
 
 static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
                                             const XCheckTLBFlag flag, const u32 vpa, const u32 vsid,
-                                            u32* paddr, bool* wi)
+                                            u32* paddr, bool* wi, u32* way)
 {
   const u32 tag = vpa >> HW_PAGE_INDEX_SHIFT;
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
@@ -1305,6 +1319,7 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
   if (tlbe.tag[0] == tag && tlbe.vsid[0] == vsid)
   {
     UPTE_Hi pte2(tlbe.pte[0]);
+    *way = 0;
 
     // Check if C bit requires updating
     if (flag == XCheckTLBFlag::Write)
@@ -1328,6 +1343,7 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
   if (tlbe.tag[1] == tag && tlbe.vsid[1] == vsid)
   {
     UPTE_Hi pte2(tlbe.pte[1]);
+    *way = 1;
 
     // Check if C bit requires updating
     if (flag == XCheckTLBFlag::Write)
@@ -1351,21 +1367,74 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
   return TLBLookupResult::NotFound;
 }
 
-static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag flag, UPTE_Hi pte2,
-                           const u32 address, const u32 vsid)
+// Returns the way that was replaced. The tag it previously held is stored in evicted_tag.
+static u32 UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag flag, UPTE_Hi pte2,
+                          const u32 address, const u32 vsid, u32* evicted_tag)
 {
-  if (IsNoExceptionFlag(flag))
-    return;
-
   const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
   TLBEntry& tlbe = ppc_state.tlb[tlb_index][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  *evicted_tag = tlbe.tag[index];
   tlbe.recent = index;
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
   tlbe.tag[index] = tag;
   tlbe.vsid[index] = vsid;
+  return index;
+}
+
+constexpr MMU::TranslationCacheIndex MMU::GetTranslationCacheIndex(XCheckTLBFlag flag)
+{
+  if (IsOpcodeFlag(flag))
+    return TRANSLATION_CACHE_OPCODE;
+  if (flag == XCheckTLBFlag::Write)
+    return TRANSLATION_CACHE_WRITE;
+  return TRANSLATION_CACHE_READ;
+}
+
+template <const XCheckTLBFlag flag>
+void MMU::AddTranslationCacheEntry(u32 address, u32 way, u32 physical_page, bool wi)
+{
+  const u32 page = address >> HW_PAGE_INDEX_SHIFT;
+  TranslationCacheEntry& entry =
+      m_translation_caches[GetTranslationCacheIndex(flag)][page & (TRANSLATION_CACHE_SIZE - 1)];
+  entry.tag = page;
+  entry.data = physical_page | (way << TranslationCacheEntry::WAY_SHIFT) |
+               (wi ? TranslationCacheEntry::WI_BIT : 0);
+}
+
+void MMU::InvalidateTranslationCachePage(bool instruction, u32 page)
+{
+  const size_t index = page & (TRANSLATION_CACHE_SIZE - 1);
+  if (instruction)
+  {
+    m_translation_caches[TRANSLATION_CACHE_OPCODE][index] = {};
+  }
+  else
+  {
+    m_translation_caches[TRANSLATION_CACHE_READ][index] = {};
+    m_translation_caches[TRANSLATION_CACHE_WRITE][index] = {};
+  }
+  ++m_translation_cache_stats.invalidations;
+}
+
+void MMU::InvalidateTranslationCacheSet(u32 tlb_set)
+{
+  // Every cache slot whose index maps to this TLB set may hold one of its translations.
+  for (TranslationCache& cache : m_translation_caches)
+  {
+    for (size_t i = tlb_set; i < TRANSLATION_CACHE_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+      cache[i] = {};
+  }
+  ++m_translation_cache_stats.invalidations;
+}
+
+void MMU::ClearTranslationCache()
+{
+  for (TranslationCache& cache : m_translation_caches)
+    cache.fill({});
+  ++m_translation_cache_stats.invalidations;
 }
 
 void MMU::InvalidateTLBEntry(u32 address)
@@ -1374,6 +1443,7 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+  InvalidateTranslationCacheSet(entry_index);
 
   if (m_ppc_state.msr.DR)
     PageTableUpdated();
@@ -1771,6 +1841,28 @@ void MMU::PageTableUpdatedFromJit(MMU* mmu)
 template <const XCheckTLBFlag flag>
 MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress address, bool* wi)
 {
+  const u32 page = address.Hex >> HW_PAGE_INDEX_SHIFT;
+  const TranslationCacheEntry& cache_entry =
+      m_translation_caches[GetTranslationCacheIndex(flag)][page & (TRANSLATION_CACHE_SIZE - 1)];
+  if (cache_entry.tag == page)
+  {
+    ++m_translation_cache_stats.hits;
+
+    // Keep the TLB's replacement state the same as if it had been looked up directly.
+    if (!IsNoExceptionFlag(flag))
+    {
+      const size_t tlb_index =
+          IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
+      m_ppc_state.tlb[tlb_index][page & HW_PAGE_INDEX_MASK].recent =
+          (cache_entry.data >> TranslationCacheEntry::WAY_SHIFT) & 1;
+    }
+
+    *wi = (cache_entry.data & TranslationCacheEntry::WI_BIT) != 0;
+    return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                  (cache_entry.data & ~static_cast<u32>(HW_PAGE_MASK)) |
+                                      address.offset};
+  }
+
   const auto sr = UReg_SR{m_ppc_state.sr[address.SR]};
   const u32 VSID = sr.VSID;  // 24 bit
 
@@ -1778,10 +1870,13 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
   // This catches 99%+ of lookups in practice, so the actual page table entry code below doesn't
   // benefit much from optimization.
   u32 translated_address = 0;
-  const TLBLookupResult res =
-      LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID, &translated_address, wi);
+  u32 tlb_way = 0;
+  const TLBLookupResult res = LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID,
+                                                   &translated_address, wi, &tlb_way);
   if (res == TLBLookupResult::Found)
   {
+    AddTranslationCacheEntry<flag>(address.Hex, tlb_way,
+                                   translated_address & ~static_cast<u32>(HW_PAGE_MASK), *wi);
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                   translated_address};
   }
@@ -1797,6 +1892,8 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
   }
 
+  ++m_translation_cache_stats.table_walks;
+
   const u32 offset = address.offset;          // 12 bit
   const u32 page_index = address.page_index;  // 16 bit
   const u32 api = address.API;                //  6 bit (part of page_index)
@@ -1874,11 +1971,19 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
           }
         }
 
+        *wi = (pte2.WIMG & 0b1100) != 0;
+
         // We already updated the TLB entry if this was caused by a C bit.
-        if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex, VSID);
+        if (!IsNoExceptionFlag(flag) && res != TLBLookupResult::UpdateC)
+        {
+          u32 evicted_tag;
+          tlb_way = UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex, VSID, &evicted_tag);
+          if (evicted_tag != TLBEntry::INVALID_TAG)
+            InvalidateTranslationCachePage(IsOpcodeFlag(flag), evicted_tag);
 
-        *wi = (pte2.WIMG & 0b1100) != 0;
+          AddTranslationCacheEntry<flag>(address.Hex, tlb_way, pte2.RPN << HW_PAGE_INDEX_SHIFT,
+                                         *wi);
+        }
 
         return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                       (pte2.RPN << 12) | offset};
@@ -79,6 +79,20 @@ constexpr size_t HW_PAGE_MASK = HW_PAGE_SIZE - 1;
 constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
 constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
 
+// Number of entries in each of the MMU's translation caches. Must be a power of two and a multiple
+// of the number of TLB sets.
+constexpr size_t TRANSLATION_CACHE_SIZE = 1024;
+
+struct TranslationCacheStats
+{
+  // Translations that were answered by the translation cache
+  u64 hits = 0;
+  // Translations that had to walk the page table
+  u64 table_walks = 0;
+  // Translation cache entries that were dropped (tlbie, TLB replacement, segment register changes)
+  u64 invalidations = 0;
+};
+
 constexpr u32 PAGE_TABLE_MIN_SIZE = 0x10000;
 
 // Return value of MMU::TryReadInstruction().
@@ -167,7 +181,7 @@ public:
       requires(!std::unsigned_integral<T>)
   {
     using U = Common::MakeUnsignedSameSize<T>;
-    std::optional<ReadResult<U>> result = HostTryRead<U>(guard, address);
+    std::optional<ReadResult<U>> result = HostTryRead<U>(guard, address, space);
     return std::bit_cast<std::optional<ReadResult<T>>>(result);
   }
   static std::optional<ReadResult<u32>>
@@ -269,6 +283,11 @@ public:
   BatTable& GetIBATTable() { return m_ibat_table; }
   BatTable& GetDBATTable() { return m_dbat_table; }
 
+  const TranslationCacheStats& GetTranslationCacheStats() const
+  {
+    return m_translation_cache_stats;
+  }
+
 private:
   enum class TranslateAddressResultEnum : u8
   {
@@ -327,9 +346,42 @@ private:
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslateAddress(u32 address);
 
+  // A direct-mapped cache in front of the emulated TLB, indexed by effective page number. An entry
+  // only exists while the TLB holds the same translation, so it never changes the result of a
+  // translation; it only saves the segment register and TLB way lookups.
+  struct TranslationCacheEntry
+  {
+    static constexpr u32 INVALID_TAG = 0xffffffff;
+
+    static constexpr u32 WI_BIT = 1 << 0;
+    static constexpr u32 WAY_SHIFT = 1;
+
+    // Effective page number
+    u32 tag = INVALID_TAG;
+    // Physical page address, plus the WI bit and the TLB way this entry mirrors
+    u32 data = 0;
+  };
+
+  using TranslationCache = std::array<TranslationCacheEntry, TRANSLATION_CACHE_SIZE>;
+
+  enum TranslationCacheIndex
+  {
+    TRANSLATION_CACHE_READ,
+    TRANSLATION_CACHE_WRITE,
+    TRANSLATION_CACHE_OPCODE,
+    NUM_TRANSLATION_CACHES,
+  };
+
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslatePageAddress(const EffectiveAddress address, bool* wi);
 
+  static constexpr TranslationCacheIndex GetTranslationCacheIndex(XCheckTLBFlag flag);
+  template <const XCheckTLBFlag flag>
+  void AddTranslationCacheEntry(u32 address, u32 way, u32 physical_page, bool wi);
+  void InvalidateTranslationCachePage(bool instruction, u32 page);
+  void InvalidateTranslationCacheSet(u32 tlb_set);
+  void ClearTranslationCache();
+
   void GenerateDSIException(u32 effective_address, bool write);
   void GenerateISIException(u32 effective_address);
 
@@ -371,6 +423,9 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  std::array<TranslationCache, NUM_TRANSLATION_CACHES> m_translation_caches;
+  TranslationCacheStats m_translation_cache_stats;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
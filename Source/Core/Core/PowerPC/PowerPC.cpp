@@ -313,6 +313,10 @@ void PowerPCManager::ScheduleInvalidateCacheThreadSafe(u32 address)
 
 void PowerPCManager::Shutdown()
 {
+  const TranslationCacheStats& stats = m_system.GetMMU().GetTranslationCacheStats();
+  INFO_LOG_FMT(POWERPC, "Translation cache: {} hits, {} page table walks, {} invalidations",
+               stats.hits, stats.table_walks, stats.invalidations);
+
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
   InjectExternalCPUCore(nullptr);
   m_system.GetJitInterface().Shutdown();
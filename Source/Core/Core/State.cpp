@@ -31,6 +31,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
+#include "Common/Tracing.h"
 #include "Common/TransferableSharedMutex.h"
 #include "Common/Version.h"
 #include "Common/WorkQueueThread.h"
@@ -97,7 +98,7 @@ struct CompressAndDumpStateArgs
 static Common::WorkQueueThreadSP<CompressAndDumpStateArgs> s_compress_and_dump_thread;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 192;  // Last changed in PR 14646
+constexpr u32 STATE_VERSION = 193;  // Last changed for the DSP JIT cycle carry-over
 
 // Increase this if the StateExtendedHeader definition changes
 constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
@@ -135,7 +136,7 @@ static constexpr bool s_use_compression = true;
 
 static bool ReadHeader(const std::string& filename, StateHeader& header);
 
-static void DoState(Core::System& system, PointerWrap& p)
+static void DoState(Core::System& system, PointerWrap& p, VideoStateScope video_scope)
 {
   bool is_wii = system.IsWii() || system.IsMIOS();
   const bool is_wii_currently = is_wii;
@@ -175,7 +176,7 @@ static void DoState(Core::System& system, PointerWrap& p)
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
-  g_video_backend->DoState(p);
+  g_video_backend->DoState(p, video_scope);
   p.DoMarker("video_backend");
 
   // CoreTiming needs to be restored before restoring Hardware because
@@ -221,28 +222,31 @@ static bool CheckIfStateLoadIsAllowed(Core::System& system)
   return true;
 }
 
-static bool LoadFromBuffer(Core::System& system, std::span<u8> buffer)
+bool LoadFromBuffer(Core::System& system, std::span<u8> buffer, VideoStateScope video_scope)
 {
   u8* ptr = buffer.data();
   PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-  DoState(system, p);
+  DoState(system, p, video_scope);
   return p.IsReadMode();
 }
 
 // Returns the required size, or 0 on failure.
-static std::size_t SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer)
+std::size_t SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer,
+                         VideoStateScope video_scope)
 {
   // Attempt to save to our provided buffer as-is.
   // If buffer isn't large enough, PointerWrap transitions to MeasureMode,
   //  and then we have our measurement for a second attempt.
   u8* ptr = buffer.data();
   PointerWrap pointer_wrap(&ptr, buffer.size(), PointerWrap::Mode::Write);
-  DoState(system, pointer_wrap);
+  DoState(system, pointer_wrap, video_scope);
   const auto measured_size = pointer_wrap.GetOffsetFromPreviousPosition(buffer.data());
 
   if (pointer_wrap.IsWriteMode())
   {
-    s_last_state_size = measured_size;
+    // Only used to estimate the size of the next savestate.
+    if (video_scope == VideoStateScope::Full)
+      s_last_state_size = measured_size;
     return measured_size;
   }
 
@@ -251,7 +255,7 @@ static std::size_t SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>&
     DEBUG_LOG_FMT(CORE, "SaveToBuffer: Growing buffer from size {} to measured size {}",
                   buffer.size(), measured_size);
     buffer.reset(measured_size);
-    return SaveToBuffer(system, buffer);
+    return SaveToBuffer(system, buffer, video_scope);
   }
 
   // Buffer was large enough but we still failed for some other reason.
@@ -391,6 +395,8 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
 
 static void CompressAndDumpState(Core::System& system, const CompressAndDumpStateArgs& save_args)
 {
+  TRACE_SCOPE("State", "Compress and write");
+
   const auto& buffer = save_args.buffer;
   const std::string& filename = save_args.filename;
 
@@ -472,6 +478,8 @@ static void CompressAndDumpState(Core::System& system, const CompressAndDumpStat
 
 static void SaveAsFromCore(Core::System& system, std::string filename)
 {
+  TRACE_SCOPE("State", "Save");
+
   // Try with a buffer a bit larger than the previous state.
   // This will often avoid the "Measure" step.
   const auto buffer_size_estimate = static_cast<std::size_t>(s_last_state_size) * 110 / 100;
@@ -742,6 +750,8 @@ static bool ValidateHeaders(const StateHeader& header)
 
 static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<u8>& ret_data)
 {
+  TRACE_SCOPE("State", "Read and decompress");
+
   File::IOFile f;
   f.Open(filename, "rb");
 
@@ -809,6 +819,8 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
 
 static void LoadAsFromCore(Core::System& system, std::string filename)
 {
+  TRACE_SCOPE("State", "Load");
+
   // Ensure all data has reached the filesystem before trying to use it.
   s_compress_and_dump_thread.WaitForCompletion();
 
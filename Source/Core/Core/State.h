@@ -7,10 +7,13 @@
 
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <string>
 #include <type_traits>
 
+#include "Common/Buffer.h"
 #include "Common/CommonTypes.h"
+#include "VideoCommon/VideoState.h"
 
 namespace Core
 {
@@ -98,6 +101,14 @@ void Load(Core::System& system, u32 slot);
 void SaveAs(Core::System& system, std::string filename);
 void LoadAs(Core::System& system, std::string filename);
 
+// Saves to or loads from memory without touching any files. Must be called on the CPU thread.
+// SaveToBuffer grows the buffer if needed and returns the size of the state, or 0 on failure.
+// A state must be loaded with the video scope it was saved with.
+std::size_t SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer,
+                         VideoStateScope video_scope = VideoStateScope::Full);
+bool LoadFromBuffer(Core::System& system, std::span<u8> buffer,
+                    VideoStateScope video_scope = VideoStateScope::Full);
+
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
 void UndoSaveState(Core::System& system);
@@ -0,0 +1,44 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateHash.h"
+
+#include <xxhash.h>
+
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Core
+{
+u64 ComputeCPUStateHash(const PowerPC::PowerPCState& ppc_state)
+{
+  const u32 registers[] = {ppc_state.pc, ppc_state.cr.Get(), ppc_state.msr.Hex,
+                           ppc_state.fpscr.Hex, ppc_state.GetXER().Hex};
+
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_64bits_reset(&state);
+  XXH3_64bits_update(&state, registers, sizeof(registers));
+  XXH3_64bits_update(&state, ppc_state.gpr, sizeof(ppc_state.gpr));
+  XXH3_64bits_update(&state, ppc_state.ps, sizeof(ppc_state.ps));
+  XXH3_64bits_update(&state, ppc_state.sr.data(), sizeof(ppc_state.sr));
+  return XXH3_64bits_digest(&state);
+}
+
+StateHashes ComputeStateHashes(System& system)
+{
+  auto& memory = system.GetMemory();
+  auto& dsp = system.GetDSP();
+
+  StateHashes hashes;
+  hashes.mem1 = XXH3_64bits(memory.GetRAM(), memory.GetRamSizeReal());
+  if (memory.GetEXRAM())
+    hashes.mem2 = XXH3_64bits(memory.GetEXRAM(), memory.GetExRamSizeReal());
+  if (dsp.GetARAMPtr())
+    hashes.aram = XXH3_64bits(dsp.GetARAMPtr(), dsp.GetARAMSize());
+  hashes.cpu = ComputeCPUStateHash(system.GetPPCState());
+  return hashes;
+}
+}  // namespace Core
@@ -0,0 +1,32 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace PowerPC
+{
+struct PowerPCState;
+}
+
+// Hashes of the emulated state, for checking that two runs of the same game stay in sync. Used by
+// the movie verifier and NetPlay desync detection.
+namespace Core
+{
+class System;
+
+struct StateHashes
+{
+  u64 mem1 = 0;
+  u64 mem2 = 0;
+  u64 aram = 0;
+  // General purpose, floating point, condition, machine state and segment registers and the PC.
+  u64 cpu = 0;
+
+  bool operator==(const StateHashes&) const = default;
+};
+
+u64 ComputeCPUStateHash(const PowerPC::PowerPCState& ppc_state);
+StateHashes ComputeStateHashes(System& system);
+}  // namespace Core
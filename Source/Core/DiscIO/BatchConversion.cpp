@@ -0,0 +1,72 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/BatchConversion.h"
+
+#include <filesystem>
+#include <map>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "Common/StringUtil.h"
+
+namespace DiscIO
+{
+// Used to compare paths, so that different spellings of the same path are caught too.
+static std::string GetNormalizedPath(std::string_view path)
+{
+  std::error_code error;
+  std::filesystem::path absolute_path = std::filesystem::absolute(StringToPath(path), error);
+  if (error)
+    absolute_path = StringToPath(path);
+  return PathToString(absolute_path.lexically_normal());
+}
+
+std::expected<std::vector<BatchConversionJob>, std::string>
+PlanBatchConversion(std::span<const BatchConversionInput> inputs,
+                    std::string_view output_directory, std::string_view extension)
+{
+  std::vector<BatchConversionJob> jobs;
+  jobs.reserve(inputs.size());
+
+  // Normalized paths of the inputs and outputs, and the input of the job that they belong to.
+  std::map<std::string, std::string_view> input_paths;
+  std::map<std::string, std::string_view> output_paths;
+  for (const BatchConversionInput& input : inputs)
+    input_paths.emplace(GetNormalizedPath(input.path), input.path);
+
+  for (const BatchConversionInput& input : inputs)
+  {
+    const std::filesystem::path path = StringToPath(input.path);
+    std::filesystem::path relative_path =
+        input.search_directory.empty() ?
+            path.filename() :
+            path.lexically_relative(StringToPath(input.search_directory));
+    relative_path.replace_extension(StringToPath(extension));
+
+    BatchConversionJob& job = jobs.emplace_back(BatchConversionJob{
+        input.path, PathToString(StringToPath(output_directory) / relative_path)});
+    const std::string normalized_output_path = GetNormalizedPath(job.output_path);
+
+    if (const auto it = input_paths.find(normalized_output_path); it != input_paths.end())
+    {
+      if (it->second == input.path)
+        return std::unexpected(fmt::format("'{}' would be converted to itself", input.path));
+
+      return std::unexpected(
+          fmt::format("Converting '{}' would overwrite '{}', which is being converted too",
+                      input.path, it->second));
+    }
+
+    const auto [it, inserted] = output_paths.emplace(normalized_output_path, input.path);
+    if (!inserted)
+    {
+      return std::unexpected(fmt::format("Both '{}' and '{}' would be converted to '{}'",
+                                         it->second, input.path, job.output_path));
+    }
+  }
+
+  return jobs;
+}
+}  // namespace DiscIO
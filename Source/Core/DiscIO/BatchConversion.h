@@ -0,0 +1,35 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DiscIO
+{
+struct BatchConversionInput
+{
+  std::string path;
+  // The directory that was searched to find the file, or empty if the file was passed directly.
+  std::string search_directory;
+};
+
+struct BatchConversionJob
+{
+  std::string input_path;
+  std::string output_path;
+};
+
+// Picks the output path in output_directory for each input, with the extension replaced.
+// Files found by searching a directory keep their path relative to that directory, so that
+// images with the same name in different subdirectories don't overwrite each other.
+// Fails with an error message if two jobs would write the same file, or if a job would write a
+// file that is the input of any job.
+std::expected<std::vector<BatchConversionJob>, std::string>
+PlanBatchConversion(std::span<const BatchConversionInput> inputs,
+                    std::string_view output_directory, std::string_view extension);
+}  // namespace DiscIO
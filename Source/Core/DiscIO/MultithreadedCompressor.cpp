@@ -0,0 +1,51 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/MultithreadedCompressor.h"
+
+namespace DiscIO
+{
+CompressionThreadBudget& CompressionThreadBudget::GetInstance()
+{
+  static CompressionThreadBudget s_instance;
+  return s_instance;
+}
+
+void CompressionThreadBudget::SetLimit(unsigned int limit)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_limit = limit;
+  }
+  m_cv.notify_all();
+}
+
+unsigned int CompressionThreadBudget::GetLimit() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_limit;
+}
+
+unsigned int CompressionThreadBudget::GetThreadCount() const
+{
+  const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int limit = GetLimit();
+  return limit == 0 ? hardware_threads : std::min(hardware_threads, limit);
+}
+
+void CompressionThreadBudget::Acquire()
+{
+  std::unique_lock lk(m_mutex);
+  m_cv.wait(lk, [this] { return m_limit == 0 || m_in_use < m_limit; });
+  ++m_in_use;
+}
+
+void CompressionThreadBudget::Release()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    --m_in_use;
+  }
+  m_cv.notify_one();
+}
+}  // namespace DiscIO
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <expected>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 
@@ -27,6 +30,31 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = std::expected<T, ConversionResultCode>;
 
+// Limits how many compression jobs can run at the same time across all MultithreadedCompressor
+// instances in the process. This lets several conversions run in parallel (so that one image's
+// I/O overlaps with another image's compression) without each of them using every CPU core.
+// A limit of 0 means that there is no limit, which is the default.
+class CompressionThreadBudget
+{
+public:
+  static CompressionThreadBudget& GetInstance();
+
+  void SetLimit(unsigned int limit);
+  unsigned int GetLimit() const;
+
+  // Returns the number of compression threads a new MultithreadedCompressor should start.
+  unsigned int GetThreadCount() const;
+
+  void Acquire();
+  void Release();
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  unsigned int m_limit = 0;
+  unsigned int m_in_use = 0;
+};
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
@@ -46,7 +74,7 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(CompressionThreadBudget::GetInstance().GetThreadCount())
   {
     m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
 
@@ -154,8 +182,11 @@ private:
       state->compress_done_event.Reset();
       state->compress_ready_event.Set();
 
+      CompressionThreadBudget& budget = CompressionThreadBudget::GetInstance();
+      budget.Acquire();
       ConversionResult<OutputParameters> result =
           m_compress(&compress_thread_state, std::move(parameters));
+      budget.Release();
 
       if (result)
       {
@@ -4,8 +4,11 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <atomic>
 #include <csignal>
 #include <cstdio>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -15,12 +18,17 @@
 #include <windows.h>
 #endif
 
+#include "Common/Config/Config.h"
 #include "Common/ScopeGuard.h"
+#include "Common/Tracing.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/MovieVerifier.h"
 #include "Core/System.h"
 
 #include "UICommon/CommandLineParse.h"
@@ -30,6 +38,8 @@
 #include "UICommon/UICommon.h"
 
 static std::unique_ptr<Platform> s_platform;
+static std::atomic<int> s_exit_code = 0;
+static std::optional<u64> s_movie_seek_frame;
 
 static void signal_handler(int)
 {
@@ -155,6 +165,13 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
+  // Movie verification never needs a window.
+  if (platform_name.empty() &&
+      (options.is_set("verify_movie") || options.is_set("record_movie_hashes")))
+  {
+    platform_name = "headless";
+  }
+
 #if HAVE_X11
   if (platform_name == "x11" || platform_name.empty())
     return Platform::CreateX11Platform();
@@ -180,6 +197,98 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static void OnMovieVerified(const Movie::MovieVerifier::Result& result)
+{
+  if (result.diverged)
+  {
+    fprintf(stderr, "Movie playback diverged on frame %llu in %s (%llu frames matched before)\n",
+            static_cast<unsigned long long>(result.frame), result.regions.c_str(),
+            static_cast<unsigned long long>(result.frames_checked - 1));
+    s_exit_code = 1;
+  }
+  else
+  {
+    fprintf(stdout, "Movie playback ended on frame %llu, %llu frames checked\n",
+            static_cast<unsigned long long>(result.frame),
+            static_cast<unsigned long long>(result.frames_checked));
+  }
+
+  s_platform->Stop();
+}
+
+// Plays back the movie given on the command line. For verification, playback runs unthrottled
+// with the null video backend unless another one was asked for, and Dolphin exits once the movie
+// ends or diverges.
+static bool PlayMovie(const optparse::Values& options, BootParameters* boot)
+{
+  const std::string movie_path = static_cast<const char*>(options.get("movie"));
+  const bool record_hashes = options.is_set("record_movie_hashes");
+  const bool verify = options.is_set("verify_movie") || record_hashes;
+
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (verify)
+  {
+    const std::string hashes_path = options.is_set("movie_hashes") ?
+                                        static_cast<const char*>(options.get("movie_hashes")) :
+                                        movie_path + ".hashes";
+    const auto mode =
+        record_hashes ? Movie::MovieVerifier::Mode::Record : Movie::MovieVerifier::Mode::Verify;
+    const int interval = record_hashes ? static_cast<int>(options.get("record_movie_hashes")) : 0;
+    if (interval < 0)
+    {
+      fprintf(stderr, "Invalid hash interval\n");
+      return false;
+    }
+
+    movie.SetVerifier(std::make_unique<Movie::MovieVerifier>(
+        mode, hashes_path, static_cast<u32>(interval), OnMovieVerified));
+    movie.SetReadOnly(true);
+
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    // The movie's config would otherwise override the backend it was recorded with.
+    const std::string video_backend = static_cast<const char*>(options.get("video_backend"));
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, video_backend.empty() ? "Null" : video_backend);
+  }
+
+  std::optional<std::string> savestate_path;
+  if (!movie.PlayInput(movie_path, &savestate_path))
+  {
+    fprintf(stderr, "Could not play the movie %s\n", movie_path.c_str());
+    return false;
+  }
+
+  if (savestate_path)
+  {
+    boot->boot_session_data.SetSavestateData(std::move(savestate_path),
+                                             DeleteSavestateAfterBoot::No);
+  }
+
+  if (options.is_set("movie_seek"))
+  {
+    const int frame = static_cast<int>(options.get("movie_seek"));
+    if (frame < 0)
+    {
+      fprintf(stderr, "Invalid movie seek frame\n");
+      return false;
+    }
+    s_movie_seek_frame = static_cast<u64>(frame);
+  }
+  return true;
+}
+
+// The keyframe's savestate can only be loaded once the core runs, so the seek is queued from the
+// first state change to Running.
+static void SeekMovie(Core::System& system, u64 frame)
+{
+  if (!system.GetMovie().SeekToKeyframe(frame))
+  {
+    fprintf(stderr, "Could not seek to frame %llu: the movie has no keyframe at or before it\n",
+            static_cast<unsigned long long>(frame));
+  }
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -209,6 +318,32 @@ int main(const int argc, char* argv[])
                 "macos"
 #endif
       });
+  parser->add_option("--verify-movie")
+      .action("store_true")
+      .help("Play the movie given with --movie as fast as possible without a GPU, and exit with "
+            "status 1 at the first frame that doesn't match --movie-hashes or the movie's "
+            "keyframes");
+  parser->add_option("--record-movie-hashes")
+      .action("store")
+      .type("int")
+      .metavar("<frames>")
+      .help("Like --verify-movie, but write the state hashes of every <frames>th frame to "
+            "--movie-hashes instead of checking them");
+  parser->add_option("--movie-hashes")
+      .action("store")
+      .metavar("<file>")
+      .help("State hashes file for movie verification (default: the movie path + .hashes)");
+  parser->add_option("--movie-seek")
+      .action("store")
+      .type("int")
+      .metavar("<frame>")
+      .help("Once the movie given with --movie has started, skip ahead by loading the savestate of "
+            "its last keyframe at or before <frame>");
+  parser->add_option("--trace")
+      .action("store")
+      .metavar("<file>")
+      .help("Record a timeline of the emulation threads and write it to <file> on exit, in the "
+            "Chrome trace event format (viewable in ui.perfetto.dev)");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -283,9 +418,33 @@ int main(const int argc, char* argv[])
     return 1;
   }
 
+  if (options.is_set("movie"))
+  {
+    if (!PlayMovie(options, boot.get()))
+      return 1;
+  }
+  else if (options.is_set("verify_movie") || options.is_set("record_movie_hashes"))
+  {
+    fprintf(stderr, "Movie verification requires a movie to be specified with --movie.\n");
+    return 1;
+  }
+  else if (options.is_set("movie_seek"))
+  {
+    fprintf(stderr, "Seeking requires a movie to be specified with --movie.\n");
+    return 1;
+  }
+
   auto core_state_changed_hook = Core::AddOnStateChangedCallback([](const Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
+
+    if (state == Core::State::Running && s_movie_seek_frame)
+    {
+      Core::QueueHostJob([frame = *s_movie_seek_frame](Core::System& system) {
+        SeekMovie(system, frame);
+      });
+      s_movie_seek_frame.reset();
+    }
   });
 
 #ifdef _WIN32
@@ -303,6 +462,13 @@ int main(const int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  std::optional<std::string> trace_path;
+  if (options.is_set("trace"))
+  {
+    trace_path = static_cast<const char*>(options.get("trace"));
+    Common::Tracing::Start();
+  }
+
   if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -319,7 +485,10 @@ int main(const int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
-  return 0;
+  if (trace_path && !Common::Tracing::Stop(*trace_path))
+    fprintf(stderr, "Could not write the trace to %s\n", trace_path->c_str());
+
+  return s_exit_code;
 }
 
 #ifdef _WIN32
@@ -3,19 +3,32 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/BatchConversion.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
+#include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WIABlob.h"
@@ -54,6 +67,258 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+namespace
+{
+struct ConversionSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+};
+
+struct ConversionJob
+{
+  std::string input_path;
+  std::string output_path;
+
+  // Prepended to every message about this job. Empty when only one file is being converted.
+  std::string prefix;
+};
+
+// Serializes output from conversions that run on different threads
+class ConversionReporter
+{
+public:
+  explicit ConversionReporter(bool show_progress) : m_show_progress(show_progress) {}
+
+  template <typename... Args>
+  void Print(std::ostream& stream, std::string_view prefix, fmt::format_string<Args...> format,
+             Args&&... args)
+  {
+    std::lock_guard lk(m_mutex);
+    fmt::print(stream, "{}", prefix);
+    fmt::print(stream, format, std::forward<Args>(args)...);
+  }
+
+  DiscIO::CompressCB MakeProgressCallback(const ConversionJob& job)
+  {
+    if (!m_show_progress)
+      return [](const std::string& text, float percent) { return true; };
+
+    // Only print a line when the whole-number percentage changes
+    auto last_percent = std::make_shared<int>(-1);
+    return [this, &job, last_percent](const std::string& text, float percent) {
+      const int whole_percent = std::clamp(static_cast<int>(percent * 100), 0, 100);
+      if (whole_percent != *last_percent)
+      {
+        *last_percent = whole_percent;
+        Print(std::cout, job.prefix, "{:3}% {}\n", whole_percent, text);
+      }
+      return true;
+    };
+  }
+
+private:
+  std::mutex m_mutex;
+  bool m_show_progress;
+};
+}  // namespace
+
+static std::optional<std::string> GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+    return ".iso";
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return std::nullopt;
+  }
+}
+
+static std::vector<DiscIO::BatchConversionInput>
+FindInputFiles(const std::vector<std::string>& paths)
+{
+  constexpr auto search_extensions = std::to_array<std::string_view>(
+      {".gcm", ".tgc", ".bin", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"});
+
+  std::vector<DiscIO::BatchConversionInput> result;
+  for (const std::string& path : paths)
+  {
+    if (File::IsDirectory(path))
+    {
+      std::vector<std::string> found = Common::DoFileSearch(path, search_extensions, true);
+      std::ranges::sort(found);
+      for (std::string& found_path : found)
+        result.push_back({std::move(found_path), path});
+    }
+    else
+    {
+      result.push_back({path, ""});
+    }
+  }
+  return result;
+}
+
+static bool ConvertFile(const ConversionJob& job, const ConversionSettings& settings,
+                        ConversionReporter& reporter, u64* bytes_read)
+{
+  const std::string& input_file_path = job.input_path;
+  const std::string& output_file_path = job.output_path;
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    reporter.Print(std::cerr, job.prefix, "Error: The input file could not be opened.\n");
+    return false;
+  }
+
+  // Open the volume
+  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      reporter.Print(std::cerr, job.prefix,
+                     "Error: Scrubbing is only supported for GC/Wii disc images.\n");
+      return false;
+    }
+
+    reporter.Print(std::cerr, job.prefix,
+                   "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      reporter.Print(std::cerr, job.prefix, "Error: Scrubbing a Datel disc is not supported.\n");
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      reporter.Print(std::cerr, job.prefix,
+                     "Error: Unable to process disc image. Try again without --scrub.\n");
+      return false;
+    }
+  }
+
+  if (scrub && format == DiscIO::BlobType::RVZ)
+  {
+    reporter.Print(std::cerr, job.prefix,
+                   "Warning: Scrubbing an RVZ container does not offer significant space "
+                   "advantages. Continuing anyway.\n");
+  }
+
+  if (scrub && format == DiscIO::BlobType::PLAIN)
+  {
+    reporter.Print(std::cerr, job.prefix,
+                   "Warning: Scrubbing does not save space when converting to ISO unless "
+                   "using external compression. Continuing anyway.\n");
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    reporter.Print(std::cerr, job.prefix,
+                   "Warning: Converting Wii disc images to GCZ without scrubbing may not "
+                   "offer space advantages over ISO. Continuing anyway.\n");
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    reporter.Print(
+        std::cerr, job.prefix,
+        "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(),
+                                              volume->GetDataSize()))
+  {
+    reporter.Print(std::cerr, job.prefix,
+                   "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+                   "must be an integer multiple of the block size and must not be an integer "
+                   "multiple of the block size multiplied by 32. Continuing anyway.\n");
+  }
+
+  // Perform the conversion
+  const DiscIO::CompressCB status_callback = reporter.MakeProgressCallback(job);
+
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+                                     status_callback);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), status_callback);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), status_callback);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+  {
+    reporter.Print(std::cerr, job.prefix, "Error: Conversion failed\n");
+    return false;
+  }
+
+  *bytes_read = blob_reader->GetDataSize();
+  return true;
+}
+
+static double GetMiBPerSecond(u64 bytes, std::chrono::steady_clock::duration duration)
+{
+  const double seconds = std::chrono::duration<double>(duration).count();
+  if (seconds <= 0)
+    return 0;
+  return bytes / (1024.0 * 1024.0) / seconds;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -70,13 +335,15 @@ int ConvertCommand(const std::vector<std::string>& args)
   parser.add_option("-i", "--input")
       .type("string")
       .action("store")
-      .help("Path to disc image FILE.")
+      .help("Path to disc image FILE. Additional disc images or directories of disc images can "
+            "be passed as positional arguments to convert several files in one run.")
       .metavar("FILE");
 
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
-      .help("Path to the destination FILE.")
+      .help("Path to the destination FILE. When converting several files, this is the directory "
+            "that the converted files are written to, keeping the layout of input directories.")
       .metavar("FILE");
 
   parser.add_option("-f", "--format")
@@ -108,6 +375,20 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of files to convert at the same time when converting several files. "
+            "Default is 2.")
+      .set_default("2");
+
+  parser.add_option("-t", "--threads")
+      .type("int")
+      .action("store")
+      .help("Total number of compression threads shared by all files being converted. "
+            "Default is the number of CPU threads.")
+      .set_default("0");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -118,12 +399,25 @@ int ConvertCommand(const std::vector<std::string>& args)
   // Validate options
 
   // --input
-  if (!options.is_set("input"))
+  std::vector<std::string> input_args;
+  if (options.is_set("input"))
+    input_args.push_back(options["input"]);
+  input_args.insert(input_args.end(), parser.args().begin(), parser.args().end());
+  if (input_args.empty())
   {
     fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
-  const std::string& input_file_path = options["input"];
+
+  const bool batch = input_args.size() > 1 || File::IsDirectory(input_args.front());
+  const std::vector<DiscIO::BatchConversionInput> input_files =
+      batch ? FindInputFiles(input_args) :
+              std::vector<DiscIO::BatchConversionInput>{{input_args.front(), ""}};
+  if (input_files.empty())
+  {
+    fmt::print(std::cerr, "Error: No disc images found in the input\n");
+    return EXIT_FAILURE;
+  }
 
   // --output
   if (!options.is_set("output"))
@@ -131,7 +425,7 @@ int ConvertCommand(const std::vector<std::string>& args)
     fmt::print(std::cerr, "Error: No output set\n");
     return EXIT_FAILURE;
   }
-  const std::string& output_file_path = options["output"];
+  const std::string output_path = options["output"];
 
   // --format
   const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
@@ -142,73 +436,9 @@ int ConvertCommand(const std::vector<std::string>& args)
   }
   const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
-  }
-
   // --scrub
   const bool scrub = static_cast<bool>(options.get("scrub"));
 
-  // Open the volume
-  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
-  {
-    if (scrub)
-    {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
-    }
-
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
-    }
-  }
-
-  if (scrub && format == DiscIO::BlobType::RVZ)
-  {
-    fmt::print(std::cerr, "Warning: Scrubbing an RVZ container does not offer significant space "
-                          "advantages. Continuing anyway.\n");
-  }
-
-  if (scrub && format == DiscIO::BlobType::PLAIN)
-  {
-    fmt::print(std::cerr, "Warning: Scrubbing does not save space when converting to ISO unless "
-                          "using external compression. Continuing anyway.\n");
-  }
-
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
-
   // --block_size
   std::optional<int> block_size_o;
   if (options.is_set("block_size"))
@@ -235,15 +465,6 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
 
   // --compress, --compress_level
@@ -294,58 +515,118 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
-
-  switch (format)
+  // --jobs, --threads
+  const int jobs = static_cast<int>(options.get("jobs"));
+  const int threads = static_cast<int>(options.get("threads"));
+  if (jobs < 1)
   {
-  case DiscIO::BlobType::PLAIN:
+    fmt::print(std::cerr, "Error: Number of jobs must be at least 1\n");
+    return EXIT_FAILURE;
+  }
+  if (threads < 0)
   {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
+    fmt::print(std::cerr, "Error: Number of threads must not be negative\n");
+    return EXIT_FAILURE;
   }
 
-  case DiscIO::BlobType::GCZ:
+  // All conversions share one pool of compression threads, so running several jobs at once
+  // overlaps reading and writing with compression instead of oversubscribing the CPU
+  DiscIO::CompressionThreadBudget::GetInstance().SetLimit(static_cast<unsigned int>(threads));
+
+  // Set up the jobs
+  std::vector<ConversionJob> conversion_jobs;
+  if (!batch)
   {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
+    conversion_jobs.push_back(ConversionJob{input_files.front().path, output_path, ""});
+  }
+  else
+  {
+    // Check all output paths before converting anything, so that no job overwrites the output or
+    // the input of another one
+    auto planned_jobs = DiscIO::PlanBatchConversion(input_files, output_path,
+                                                    GetFormatExtension(format).value());
+    if (!planned_jobs)
     {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
+      fmt::print(std::cerr, "Error: {}\n", planned_jobs.error());
+      return EXIT_FAILURE;
     }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
-  }
 
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
+    for (size_t i = 0; i < planned_jobs->size(); ++i)
+    {
+      DiscIO::BatchConversionJob& planned_job = (*planned_jobs)[i];
+      if (!File::CreateFullPath(planned_job.output_path))
+      {
+        fmt::print(std::cerr, "Error: The output directory for '{}' could not be created\n",
+                   planned_job.output_path);
+        return EXIT_FAILURE;
+      }
 
-  default:
-  {
-    ASSERT(false);
-    break;
-  }
+      std::string name;
+      std::string extension;
+      SplitPath(planned_job.input_path, nullptr, &name, &extension);
+      conversion_jobs.push_back(ConversionJob{
+          std::move(planned_job.input_path), std::move(planned_job.output_path),
+          fmt::format("[{}/{}] {}{}: ", i + 1, planned_jobs->size(), name, extension)});
+    }
   }
 
-  if (!success)
+  const ConversionSettings settings{format, scrub, block_size_o, compression_o,
+                                    compression_level_o};
+  ConversionReporter reporter(batch);
+
+  std::atomic<size_t> next_job = 0;
+  std::atomic<size_t> failed_jobs = 0;
+  std::atomic<u64> total_bytes_read = 0;
+
+  const auto start_time = std::chrono::steady_clock::now();
+
+  const auto run_jobs = [&] {
+    for (size_t i = next_job++; i < conversion_jobs.size(); i = next_job++)
+    {
+      const ConversionJob& job = conversion_jobs[i];
+
+      if (WithUnifiedPathSeparators(job.output_path) ==
+          WithUnifiedPathSeparators(job.input_path))
+      {
+        reporter.Print(std::cerr, job.prefix,
+                       "Error: The output file is the same as the input file\n");
+        ++failed_jobs;
+        continue;
+      }
+
+      const auto job_start_time = std::chrono::steady_clock::now();
+      u64 bytes_read = 0;
+      if (!ConvertFile(job, settings, reporter, &bytes_read))
+      {
+        ++failed_jobs;
+        continue;
+      }
+
+      total_bytes_read += bytes_read;
+      if (batch)
+      {
+        reporter.Print(std::cout, job.prefix, "Done ({:.1f} MiB/s)\n",
+                       GetMiBPerSecond(bytes_read, std::chrono::steady_clock::now() -
+                                                       job_start_time));
+      }
+    }
+  };
+
+  const size_t worker_count = std::min<size_t>(jobs, conversion_jobs.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < worker_count; ++i)
+    workers.emplace_back(run_jobs);
+  run_jobs();
+  for (std::thread& worker : workers)
+    worker.join();
+
+  if (batch)
   {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
-    return EXIT_FAILURE;
+    fmt::print(std::cout, "Converted {} of {} files ({:.1f} MiB/s overall)\n",
+               conversion_jobs.size() - failed_jobs, conversion_jobs.size(),
+               GetMiBPerSecond(total_bytes_read, std::chrono::steady_clock::now() - start_time));
   }
 
-  return EXIT_SUCCESS;
+  return failed_jobs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 }  // namespace DolphinTool
@@ -0,0 +1,180 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TextureAssetUtils.h"
+#include "VideoCommon/Assets/TexturePack.h"
+#include "VideoCommon/TextureConfig.h"
+
+namespace DolphinTool
+{
+// Mipmaps are loaded with the texture they belong to, from files ending with _mip<level>.
+static bool IsMipmapFile(std::string_view filename)
+{
+  const size_t mip_index = filename.rfind("_mip");
+  if (mip_index == std::string_view::npos || mip_index + 4 == filename.size())
+    return false;
+
+  const std::string_view level = filename.substr(mip_index + 4);
+  return std::ranges::all_of(level, [](char c) { return c >= '0' && c <= '9'; });
+}
+
+static bool AddDDSTexture(VideoCommon::TexturePackWriter& writer, const std::string& id,
+                          bool has_arbitrary_mipmaps, const std::string& path)
+{
+  VideoCommon::CustomTextureData data;
+  if (!VideoCommon::LoadTextureDataFromFile(id, StringToPath(path),
+                                            AbstractTextureType::Texture_2D, &data))
+  {
+    return false;
+  }
+
+  if (data.m_slices.size() != 1)
+  {
+    fmt::println(std::cerr, "Error: '{}' has more than one slice", path);
+    return false;
+  }
+
+  return writer.AddTexture(id, has_arbitrary_mipmaps, data.m_slices[0]);
+}
+
+static bool AddPNGTexture(VideoCommon::TexturePackWriter& writer, const std::string& id,
+                          bool has_arbitrary_mipmaps, const std::string& path)
+{
+  std::string directory;
+  std::string filename;
+  std::string extension;
+  SplitPath(path, &directory, &filename, &extension);
+
+  std::vector<std::string> levels(1);
+  if (!File::ReadFileToString(path, levels[0]))
+  {
+    fmt::println(std::cerr, "Error: Unable to read '{}'", path);
+    return false;
+  }
+
+  for (u32 mip_level = 1;; mip_level++)
+  {
+    const std::string mip_path =
+        fmt::format("{}{}_mip{}{}", directory, filename, mip_level, extension);
+    if (!File::Exists(mip_path))
+      break;
+
+    if (!File::ReadFileToString(mip_path, levels.emplace_back()))
+    {
+      fmt::println(std::cerr, "Error: Unable to read '{}'", mip_path);
+      return false;
+    }
+  }
+
+  return writer.AddPNGTexture(id, has_arbitrary_mipmaps, levels);
+}
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texturepack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a custom texture DIRECTORY, like Load/Textures/<game ID>.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to create. Texture packs are loaded from the same "
+            "directories as the textures.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_directory = options["input"];
+  if (input_directory.empty())
+  {
+    fmt::println(std::cerr, "Error: No input set");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_file_path = options["output"];
+  if (output_file_path.empty())
+  {
+    fmt::println(std::cerr, "Error: No output set");
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::TexturePackWriter writer;
+  if (!writer.Open(output_file_path))
+  {
+    fmt::println(std::cerr, "Error: Unable to create '{}'", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  // The same naming rules as HiresTexture::Update.
+  constexpr std::string_view texture_prefix = "tex1_";
+  std::set<std::string> ids;
+  size_t failed_count = 0;
+  constexpr auto extensions = std::to_array<std::string_view>({".png", ".dds"});
+  const std::vector<std::string> texture_paths =
+      Common::DoFileSearch(input_directory, extensions, /*recursive*/ true);
+  for (const std::string& path : texture_paths)
+  {
+    std::string id;
+    std::string extension;
+    SplitPath(path, nullptr, &id, &extension);
+    Common::ToLower(&extension);
+    if (!id.starts_with(texture_prefix) || IsMipmapFile(id))
+      continue;
+
+    const size_t arb_index = id.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      id.erase(arb_index, 4);
+
+    if (!ids.insert(id).second)
+    {
+      fmt::println(std::cerr, "Warning: Skipping '{}', as '{}' was already added", path, id);
+      continue;
+    }
+
+    const bool added = extension == ".dds" ?
+                           AddDDSTexture(writer, id, has_arbitrary_mipmaps, path) :
+                           AddPNGTexture(writer, id, has_arbitrary_mipmaps, path);
+    if (!added)
+    {
+      fmt::println(std::cerr, "Warning: Unable to add '{}'", path);
+      failed_count++;
+    }
+  }
+
+  if (!writer.Finish())
+  {
+    fmt::println(std::cerr, "Error: Unable to write '{}'", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::println(std::cout, "Packed {} textures into '{}'", ids.size() - failed_count,
+               output_file_path);
+  return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -4,9 +4,15 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -16,6 +22,10 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -23,7 +33,92 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 27;  // Last changed in PR 13844
+static constexpr u32 CACHE_REVISION = 28;  // Last changed when entries got their own index
+
+// How many files are scanned at the same time. Scanning a file mostly waits for small reads, so
+// this is about how many reads in flight the storage handles well rather than the number of cores.
+static constexpr size_t MAX_CONCURRENT_SCANS = 8;
+
+// The cache file starts with a header and an index of the cached files, followed by the
+// serialized GameFiles. Each of them can be read separately, which lets Load read them in parallel.
+struct CacheHeader
+{
+  u32 revision;
+  u32 num_files;
+  u64 size;
+};
+
+struct CacheIndexEntry
+{
+  u64 offset;
+  u64 size;
+  u64 file_size;
+  s64 last_write_time;
+};
+
+// Calls work(i) for every i in [0, count) on worker threads, and done(i, result) on the calling
+// thread for the results as they come in.
+template <typename Work, typename Done>
+static void RunInParallel(size_t count, const std::atomic_bool& processing_halted, Work work,
+                          Done done)
+{
+  using Result = std::invoke_result_t<Work&, size_t>;
+
+  const size_t num_threads = std::min(count, MAX_CONCURRENT_SCANS);
+  if (num_threads <= 1)
+  {
+    for (size_t i = 0; i < count && !processing_halted; ++i)
+      done(i, work(i));
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable results_available;
+  std::vector<std::pair<size_t, Result>> results;
+  size_t num_finished_threads = 0;
+  std::atomic<size_t> next_index = 0;
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&] {
+      Common::SetCurrentThreadName("Game List Scan");
+
+      for (size_t index = next_index++; index < count && !processing_halted; index = next_index++)
+      {
+        Result result = work(index);
+        std::lock_guard lk(mutex);
+        results.emplace_back(index, std::move(result));
+        results_available.notify_one();
+      }
+
+      std::lock_guard lk(mutex);
+      ++num_finished_threads;
+      results_available.notify_one();
+    });
+  }
+
+  std::vector<std::pair<size_t, Result>> ready;
+  while (true)
+  {
+    {
+      std::unique_lock lk(mutex);
+      results_available.wait(
+          lk, [&] { return !results.empty() || num_finished_threads == num_threads; });
+      if (results.empty())
+        break;
+      std::swap(ready, results);
+    }
+
+    for (auto& [index, result] : ready)
+      done(index, std::move(result));
+    ready.clear();
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
 std::vector<std::string> FindAllGamePaths(std::span<const std::string_view> directories_to_scan,
                                           bool recursive_scan)
@@ -42,8 +137,8 @@ GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gameli
 
 void GameFileCache::ForEach(const ForEachFn& f) const
 {
-  for (const std::shared_ptr<GameFile>& item : m_cached_files)
-    f(item);
+  for (const CachedFile& item : m_cached_files)
+    f(item.game);
 }
 
 size_t GameFileCache::GetSize() const
@@ -59,19 +154,42 @@ void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
   m_cached_files.clear();
 }
 
+GameFileCache::CachedFile GameFileCache::ScanFile(const std::string& path)
+{
+  // The file is checked before it is read, so that changes made while reading it are picked up
+  // by the next scan.
+  CachedFile file;
+  file.file_size = File::GetSize(path);
+  file.last_write_time = File::GetLastWriteTime(path);
+  file.game = std::make_shared<GameFile>(path);
+  return file;
+}
+
+bool GameFileCache::IsUpToDate(const CachedFile& file)
+{
+  const std::string& path = file.game->GetFilePath();
+  return File::GetSize(path) == file.file_size &&
+         File::GetLastWriteTime(path) == file.last_write_time;
+}
+
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
                                                         bool* cache_changed)
 {
-  auto it = std::ranges::find(m_cached_files, path, &GameFile::GetFilePath);
-  const bool found = it != m_cached_files.cend();
+  auto it = std::ranges::find(m_cached_files, path, [](const CachedFile& file) -> const auto& {
+    return file.game->GetFilePath();
+  });
+  const bool found = it != m_cached_files.cend() && IsUpToDate(*it);
   if (!found)
   {
-    std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
-    if (!game->IsValid())
+    CachedFile file = ScanFile(path);
+    if (!file.game->IsValid())
       return nullptr;
-    m_cached_files.emplace_back(std::move(game));
+    if (it != m_cached_files.cend())
+      *it = std::move(file);
+    else
+      it = m_cached_files.insert(it, std::move(file));
   }
-  std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
+  std::shared_ptr<GameFile>& result = it->game;
   if (UpdateAdditionalMetadata(&result) || !found)
     *cache_changed = true;
 
@@ -83,6 +201,9 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
                            const GameRemovedFromCacheFn& game_removed_from_cache,
                            const std::atomic_bool& processing_halted)
 {
+  Common::Timer timer;
+  timer.Start();
+
   // Copy game paths into a set, except ones that match DiscIO::ShouldHideFromGameList.
   // TODO: Prevent DoFileSearch from looking inside /files/ directories of DirectoryBlobs at all?
   // TODO: Make DoFileSearch support filter predicates so we don't have remove things afterwards?
@@ -95,52 +216,73 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
   }
 
   bool cache_changed = false;
+  size_t num_removed = 0;
+
+  // Check which cached files have changed on disk since they were scanned.
+  std::vector<u8> up_to_date(m_cached_files.size());
+  RunInParallel(
+      m_cached_files.size(), processing_halted,
+      [&](size_t index) {
+        const CachedFile& file = m_cached_files[index];
+        return game_paths.contains(file.game->GetFilePath()) && IsUpToDate(file);
+      },
+      [&](size_t index, bool result) { up_to_date[index] = result; });
+  if (processing_halted)
+    return false;
 
-  // Delete paths that aren't in game_paths from m_cached_files,
-  // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Delete files that aren't in game_paths or have changed from m_cached_files, while
+  // simultaneously deleting the paths of the others from game_paths.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
-    auto it = m_cached_files.begin();
-    auto end = m_cached_files.end();
-    while (it != end)
+    size_t index = 0;
+    size_t end = m_cached_files.size();
+    while (index != end)
     {
-      if (processing_halted)
-        break;
-
-      if (game_paths.erase((*it)->GetFilePath()))
+      const std::string& path = m_cached_files[index].game->GetFilePath();
+      if (up_to_date[index])
       {
-        ++it;
+        game_paths.erase(path);
+        ++index;
       }
       else
       {
         if (game_removed_from_cache)
-          game_removed_from_cache((*it)->GetFilePath());
+          game_removed_from_cache(path);
 
         cache_changed = true;
+        ++num_removed;
         --end;
-        *it = std::move(*end);
+        m_cached_files[index] = std::move(m_cached_files[end]);
+        up_to_date[index] = up_to_date[end];
       }
     }
-    m_cached_files.erase(it, m_cached_files.end());
+    m_cached_files.erase(m_cached_files.begin() + end, m_cached_files.end());
   }
 
   // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
+  // aren't in m_cached_files, so we scan all of them and add them to m_cached_files.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  size_t num_added = 0;
+  RunInParallel(
+      new_paths.size(), processing_halted,
+      [&](size_t index) { return ScanFile(new_paths[index]); },
+      [&](size_t, CachedFile file) {
+        if (!file.game->IsValid())
+          return;
+
+        if (game_added_to_cache)
+          game_added_to_cache(file.game);
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+        cache_changed = true;
+        ++num_added;
+        m_cached_files.push_back(std::move(file));
+      });
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+  INFO_LOG_FMT(COMMON,
+               "Updated the game list in {} ms: {} files were cached, {} removed or changed, "
+               "{} scanned and {} of them added",
+               timer.ElapsedMs(), m_cached_files.size() - num_added, num_removed,
+               new_paths.size(), num_added);
 
   return cache_changed;
 }
@@ -150,15 +292,15 @@ bool GameFileCache::UpdateAdditionalMetadata(const GameUpdatedFn& game_updated,
 {
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
+  for (CachedFile& file : m_cached_files)
   {
     if (processing_halted)
       break;
 
-    const bool updated = UpdateAdditionalMetadata(&file);
+    const bool updated = UpdateAdditionalMetadata(&file.game);
     cache_changed |= updated;
     if (game_updated && updated)
-      game_updated(file);
+      game_updated(file.game);
   }
 
   return cache_changed;
@@ -203,79 +345,125 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
-}
+  Common::Timer timer;
+  timer.Start();
 
-bool GameFileCache::Save()
-{
-  return SyncCacheFile(true);
-}
-
-bool GameFileCache::SyncCacheFile(bool save)
-{
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
-    return false;
-  bool success = false;
-  if (save)
+  std::optional<std::vector<CachedFile>> files;
+  size_t cache_size = 0;
   {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
-  }
-  else
-  {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    const File::MappedFile cache_file(m_path);
+    if (cache_file)
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      cache_size = cache_file.GetSize();
+      files = ReadCacheFile(cache_file.GetData());
     }
   }
-  if (!success)
+
+  if (!files)
   {
     // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    File::Delete(m_path, File::IfAbsentBehavior::NoConsoleWarning);
+    return false;
   }
-  return success;
+
+  m_cached_files = std::move(*files);
+  INFO_LOG_FMT(COMMON, "Loaded {} games from the game list cache ({} KiB) in {} ms",
+               m_cached_files.size(), cache_size / 1024, timer.ElapsedMs());
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+std::optional<std::vector<GameFileCache::CachedFile>>
+GameFileCache::ReadCacheFile(std::span<const u8> data)
 {
-  struct
+  CacheHeader header;
+  if (data.size() < sizeof(header))
+    return std::nullopt;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.revision != CACHE_REVISION || header.size != data.size() ||
+      (data.size() - sizeof(header)) / sizeof(CacheIndexEntry) < header.num_files)
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+    return std::nullopt;
+  }
+
+  std::vector<CacheIndexEntry> index(header.num_files);
+  std::memcpy(index.data(), data.data() + sizeof(header), index.size() * sizeof(CacheIndexEntry));
+
+  const u64 index_end = sizeof(header) + index.size() * sizeof(CacheIndexEntry);
+  if (!std::ranges::all_of(index, [&](const CacheIndexEntry& entry) {
+        return entry.offset >= index_end && entry.offset <= data.size() &&
+               entry.size <= data.size() - entry.offset;
+      }))
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    return std::nullopt;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  std::vector<CachedFile> files(index.size());
+  const std::atomic_bool processing_halted = false;
+  RunInParallel(
+      index.size(), processing_halted,
+      [&](size_t i) {
+        const CacheIndexEntry& entry = index[i];
+        // In read mode, PointerWrap doesn't write to the buffer.
+        u8* ptr = const_cast<u8*>(data.data() + entry.offset);
+        PointerWrap p(&ptr, entry.size, PointerWrap::Mode::Read);
+
+        CachedFile file;
+        file.game = std::make_shared<GameFile>();
+        file.game->DoState(p);
+        if (!p.IsReadMode())
+          file.game.reset();
+        file.file_size = entry.file_size;
+        file.last_write_time = entry.last_write_time;
+        return file;
+      },
+      [&](size_t i, CachedFile file) { files[i] = std::move(file); });
+
+  if (std::ranges::any_of(files, [](const CachedFile& file) { return !file.game; }))
+    return std::nullopt;
+
+  return files;
+}
+
+bool GameFileCache::Save()
+{
+  std::vector<CacheIndexEntry> index(m_cached_files.size());
+  u64 size = sizeof(CacheHeader) + index.size() * sizeof(CacheIndexEntry);
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+  {
+    // Measure the size of the serialized file.
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_cached_files[i].game->DoState(p_measure);
+
+    index[i].offset = size;
+    index[i].size = reinterpret_cast<u64>(ptr);
+    index[i].file_size = m_cached_files[i].file_size;
+    index[i].last_write_time = m_cached_files[i].last_write_time;
+    size += index[i].size;
+  }
+
+  const CacheHeader header{CACHE_REVISION, static_cast<u32>(index.size()), size};
+  std::vector<u8> buffer(size);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  std::memcpy(buffer.data() + sizeof(header), index.data(),
+              index.size() * sizeof(CacheIndexEntry));
+
+  // Then actually do the write.
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+  {
+    u8* ptr = buffer.data() + index[i].offset;
+    PointerWrap p(&ptr, index[i].size, PointerWrap::Mode::Write);
+    m_cached_files[i].game->DoState(p);
+  }
+
+  File::IOFile f(m_path, "wb");
+  if (f && f.WriteBytes(buffer.data(), buffer.size()))
+    return true;
+
+  // If some file operation failed, try to delete the probably-corrupted cache
+  f.Close();
+  File::Delete(m_path);
+  return false;
 }
 
 }  // namespace UICommon
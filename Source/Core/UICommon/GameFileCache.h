@@ -7,14 +7,13 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -47,6 +46,7 @@ public:
   std::shared_ptr<const GameFile> AddOrGet(const std::string& path, bool* cache_changed);
 
   // These functions return true if the call modified the cache.
+  // Update scans the files that aren't cached yet or have changed on disk on several threads.
   bool Update(std::span<const std::string> all_game_paths,
               const GameAddedToCacheFn& game_added_to_cache = {},
               const GameRemovedFromCacheFn& game_removed_from_cache = {},
@@ -58,13 +58,23 @@ public:
   bool Save();
 
 private:
-  bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
+  struct CachedFile
+  {
+    std::shared_ptr<GameFile> game;
+    // The size and last write time of the file when it was scanned. The file is scanned again if
+    // either of them changes.
+    u64 file_size = 0;
+    s64 last_write_time = 0;
+  };
+
+  static CachedFile ScanFile(const std::string& path);
+  static bool IsUpToDate(const CachedFile& file);
+  static std::optional<std::vector<CachedFile>> ReadCacheFile(std::span<const u8> data);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
   std::string m_path;
-  std::vector<std::shared_ptr<GameFile>> m_cached_files;
+  std::vector<CachedFile> m_cached_files;
 };
 
 }  // namespace UICommon
@@ -186,14 +186,9 @@ static inline void AddInterpolatedVertex(float t, int out, int in, int* numVerti
     }                                                                                              \
   }
 
-static void ClipTriangle(int* indices, int* numIndices)
+// mask is the union of the clip masks of the vertices.
+static void ClipTriangle(int* indices, int* numIndices, int mask)
 {
-  int mask = 0;
-
-  mask |= CalcClipMask(Vertices[0]);
-  mask |= CalcClipMask(Vertices[1]);
-  mask |= CalcClipMask(Vertices[2]);
-
   if (mask != 0)
   {
     for (int i = 0; i < 3; i += 3)
@@ -289,7 +284,12 @@ void ProcessTriangle(OutputVertexData* v0, OutputVertexData* v1, OutputVertexDat
 {
   INCSTAT(g_stats.this_frame.num_triangles_in);
 
-  if (IsTriviallyRejected(v0, v1, v2))
+  // Triangles with all vertices outside the same clipping plane are trivially rejected, and those
+  // with all vertices inside all planes are trivially accepted.
+  const int clip_mask0 = CalcClipMask(v0);
+  const int clip_mask1 = CalcClipMask(v1);
+  const int clip_mask2 = CalcClipMask(v2);
+  if ((clip_mask0 & clip_mask1 & clip_mask2) != 0)
   {
     INCSTAT(g_stats.this_frame.num_triangles_rejected);
     // NOTE: The slope used by zfreeze shouldn't be updated if the triangle is
@@ -361,8 +361,9 @@ void ProcessTriangle(OutputVertexData* v0, OutputVertexData* v1, OutputVertexDat
       skip_clipping = true;
   }
 
-  if (!skip_clipping)
-    ClipTriangle(indices, &numIndices);
+  const int clip_mask = clip_mask0 | clip_mask1 | clip_mask2;
+  if (!skip_clipping && clip_mask != 0)
+    ClipTriangle(indices, &numIndices, clip_mask);
 
   for (int i = 0; i + 3 <= numIndices; i += 3)
   {
@@ -510,16 +511,6 @@ void ProcessPoint(OutputVertexData* center)
   Rasterizer::DrawTriangleFrontFace(&ur, &lr, &ul);
 }
 
-bool IsTriviallyRejected(const OutputVertexData* v0, const OutputVertexData* v1,
-                         const OutputVertexData* v2)
-{
-  int mask = CalcClipMask(v0);
-  mask &= CalcClipMask(v1);
-  mask &= CalcClipMask(v2);
-
-  return mask != 0;
-}
-
 bool IsBackface(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2)
 {
   float x0 = v0->projectedPosition.x;
@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Software/SWVertexLoader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 
@@ -65,42 +66,49 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
   m_setup_unit.Init(primitive_type);
   Rasterizer::SetTevKonstColors();
 
-  for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  const u32 num_vertices = m_index_generator.GetIndexLen();
+  for (u32 first = 0; first < num_vertices; first += TransformUnit::TRANSFORM_BATCH_SIZE)
   {
-    const u16 index = m_cpu_index_buffer[i];
-    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
+    const u32 count = std::min(num_vertices - first, TransformUnit::TRANSFORM_BATCH_SIZE);
+    for (u32 i = 0; i < count; i++)
+    {
+      InputVertexData* vertex = &m_vertices[i];
+      memset(static_cast<void*>(vertex), 0, sizeof(*vertex));
 
-    // parse the videocommon format to our own struct format (m_vertex)
-    SetFormat();
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
+      // parse the videocommon format to our own struct format (m_vertices)
+      SetFormat(vertex);
+      ParseVertex(vdec, m_cpu_index_buffer[first + i], vertex);
+    }
 
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_setup_unit.GetVertex();
-    TransformUnit::TransformPosition(&m_vertex, outVertex);
-    TransformUnit::TransformNormal(&m_vertex, outVertex);
-    TransformUnit::TransformColor(&m_vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_vertex, outVertex);
+    // transform these vertices so that they can be used for rasterization
+    TransformUnit::TransformBatch(m_vertices.data(), m_transformed_vertices.data(), count);
 
-    // assemble and rasterize the primitive
-    m_setup_unit.SetupVertex();
+    for (u32 i = 0; i < count; i++)
+    {
+      // assemble and rasterize the primitive
+      *m_setup_unit.GetVertex() = m_transformed_vertices[i];
+      m_setup_unit.SetupVertex();
 
-    INCSTAT(g_stats.this_frame.num_vertices_loaded);
+      INCSTAT(g_stats.this_frame.num_vertices_loaded);
+    }
   }
 
   INCSTAT(g_stats.this_frame.num_drawn_objects);
 }
 
-void SWVertexLoader::SetFormat()
+void SWVertexLoader::SetFormat(InputVertexData* vertex)
 {
-  m_vertex.posMtx = xfmem.MatrixIndexA.PosNormalMtxIdx;
-  m_vertex.texMtx[0] = xfmem.MatrixIndexA.Tex0MtxIdx;
-  m_vertex.texMtx[1] = xfmem.MatrixIndexA.Tex1MtxIdx;
-  m_vertex.texMtx[2] = xfmem.MatrixIndexA.Tex2MtxIdx;
-  m_vertex.texMtx[3] = xfmem.MatrixIndexA.Tex3MtxIdx;
-  m_vertex.texMtx[4] = xfmem.MatrixIndexB.Tex4MtxIdx;
-  m_vertex.texMtx[5] = xfmem.MatrixIndexB.Tex5MtxIdx;
-  m_vertex.texMtx[6] = xfmem.MatrixIndexB.Tex6MtxIdx;
-  m_vertex.texMtx[7] = xfmem.MatrixIndexB.Tex7MtxIdx;
+  vertex->posMtx = xfmem.MatrixIndexA.PosNormalMtxIdx;
+  vertex->texMtx[0] = xfmem.MatrixIndexA.Tex0MtxIdx;
+  vertex->texMtx[1] = xfmem.MatrixIndexA.Tex1MtxIdx;
+  vertex->texMtx[2] = xfmem.MatrixIndexA.Tex2MtxIdx;
+  vertex->texMtx[3] = xfmem.MatrixIndexA.Tex3MtxIdx;
+  vertex->texMtx[4] = xfmem.MatrixIndexB.Tex4MtxIdx;
+  vertex->texMtx[5] = xfmem.MatrixIndexB.Tex5MtxIdx;
+  vertex->texMtx[6] = xfmem.MatrixIndexB.Tex6MtxIdx;
+  vertex->texMtx[7] = xfmem.MatrixIndexB.Tex7MtxIdx;
 }
 
 template <typename T, typename I>
@@ -191,55 +199,56 @@ static void ParseColorAttributes(InputVertexData* dst, DataReader& src,
   }
 }
 
-void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index)
+void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index,
+                                 InputVertexData* vertex)
 {
   DataReader src(m_cpu_vertex_buffer.data(),
                  m_cpu_vertex_buffer.data() + m_cpu_vertex_buffer.size());
   src.Skip(index * vdec.stride);
 
-  ReadVertexAttribute<float>(&m_vertex.position.x, src, vdec.position, 0, 3, false);
+  ReadVertexAttribute<float>(&vertex->position.x, src, vdec.position, 0, 3, false);
 
-  for (std::size_t i = 0; i < m_vertex.normal.size(); i++)
+  for (std::size_t i = 0; i < vertex->normal.size(); i++)
   {
-    ReadVertexAttribute<float>(&m_vertex.normal[i].x, src, vdec.normals[i], 0, 3, false);
+    ReadVertexAttribute<float>(&vertex->normal[i].x, src, vdec.normals[i], 0, 3, false);
   }
   if (!vdec.normals[0].enable)
   {
     auto& system = Core::System::GetInstance();
     auto& vertex_shader_manager = system.GetVertexShaderManager();
-    m_vertex.normal[0].x = vertex_shader_manager.constants.cached_normal[0];
-    m_vertex.normal[0].y = vertex_shader_manager.constants.cached_normal[1];
-    m_vertex.normal[0].z = vertex_shader_manager.constants.cached_normal[2];
+    vertex->normal[0].x = vertex_shader_manager.constants.cached_normal[0];
+    vertex->normal[0].y = vertex_shader_manager.constants.cached_normal[1];
+    vertex->normal[0].z = vertex_shader_manager.constants.cached_normal[2];
   }
   if (!vdec.normals[1].enable)
   {
     auto& system = Core::System::GetInstance();
     auto& vertex_shader_manager = system.GetVertexShaderManager();
-    m_vertex.normal[1].x = vertex_shader_manager.constants.cached_tangent[0];
-    m_vertex.normal[1].y = vertex_shader_manager.constants.cached_tangent[1];
-    m_vertex.normal[1].z = vertex_shader_manager.constants.cached_tangent[2];
+    vertex->normal[1].x = vertex_shader_manager.constants.cached_tangent[0];
+    vertex->normal[1].y = vertex_shader_manager.constants.cached_tangent[1];
+    vertex->normal[1].z = vertex_shader_manager.constants.cached_tangent[2];
   }
   if (!vdec.normals[2].enable)
   {
     auto& system = Core::System::GetInstance();
     auto& vertex_shader_manager = system.GetVertexShaderManager();
-    m_vertex.normal[2].x = vertex_shader_manager.constants.cached_binormal[0];
-    m_vertex.normal[2].y = vertex_shader_manager.constants.cached_binormal[1];
-    m_vertex.normal[2].z = vertex_shader_manager.constants.cached_binormal[2];
+    vertex->normal[2].x = vertex_shader_manager.constants.cached_binormal[0];
+    vertex->normal[2].y = vertex_shader_manager.constants.cached_binormal[1];
+    vertex->normal[2].z = vertex_shader_manager.constants.cached_binormal[2];
   }
 
-  ParseColorAttributes(&m_vertex, src, vdec);
+  ParseColorAttributes(vertex, src, vdec);
 
-  for (std::size_t i = 0; i < m_vertex.texCoords.size(); i++)
+  for (std::size_t i = 0; i < vertex->texCoords.size(); i++)
   {
-    ReadVertexAttribute<float>(&m_vertex.texCoords[i].x, src, vdec.texcoords[i], 0, 2, false);
+    ReadVertexAttribute<float>(&vertex->texCoords[i].x, src, vdec.texcoords[i], 0, 2, false);
 
     // the texmtr is stored as third component of the texCoord
     if (vdec.texcoords[i].components >= 3)
     {
-      ReadVertexAttribute<u8>(&m_vertex.texMtx[i], src, vdec.texcoords[i], 2, 1, false);
+      ReadVertexAttribute<u8>(&vertex->texMtx[i], src, vdec.texcoords[i], 2, 1, false);
     }
   }
 
-  ReadVertexAttribute<u8>(&m_vertex.posMtx, src, vdec.posmtx, 0, 1, false);
+  ReadVertexAttribute<u8>(&vertex->posMtx, src, vdec.posmtx, 0, 1, false);
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -10,6 +11,7 @@
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/SetupUnit.h"
+#include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/VertexManagerBase.h"
 
@@ -25,9 +27,10 @@ public:
 protected:
   void DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex) override;
 
-  void SetFormat();
-  void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  void SetFormat(InputVertexData* vertex);
+  void ParseVertex(const PortableVertexDeclaration& vdec, int index, InputVertexData* vertex);
 
-  InputVertexData m_vertex{};
+  std::array<InputVertexData, TransformUnit::TRANSFORM_BATCH_SIZE> m_vertices{};
+  std::array<OutputVertexData, TransformUnit::TRANSFORM_BATCH_SIZE> m_transformed_vertices{};
   SetupUnit m_setup_unit;
 };
@@ -3,9 +3,14 @@
 
 #include "VideoBackends/Software/TextureEncoder.h"
 
+#include <cstring>
+#include <utility>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
@@ -16,6 +21,7 @@
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoCommon.h"
 
 namespace TextureEncoder
 {
@@ -1423,13 +1429,344 @@ static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
+#ifdef _M_X86_64
+// The vectorized encoders convert four pixels at once, with the channels of one pixel in each
+// 32-bit lane. They produce the same output as the encoders above, for all formats of at least
+// 8 bits per texel.
 namespace
 {
-void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
-                   u32 num_blocks_y, u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
-                   bool scale_by_half)
+struct ColorLanes
+{
+  __m128i r;
+  __m128i g;
+  __m128i b;
+  __m128i a;
+};
+
+// The pixels of the 2x2 boxes that are averaged for four half scale pixels.
+struct Boxes
+{
+  __m128i top_left;
+  __m128i top_right;
+  __m128i bottom_left;
+  __m128i bottom_right;
+};
+}  // namespace
+
+// Loads four consecutive 24-bit pixels, without reading past the last one.
+DOLPHIN_FORCE_INLINE static __m128i LoadPixels(const u8* src)
+{
+  u32 last_bytes;
+  std::memcpy(&last_bytes, src + 8, sizeof(last_bytes));
+  const __m128i bytes = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                                           _mm_cvtsi32_si128(last_bytes));
+  const __m128i pixels01 = _mm_unpacklo_epi32(bytes, _mm_srli_si128(bytes, 3));
+  const __m128i pixels23 = _mm_unpacklo_epi32(_mm_srli_si128(bytes, 6), _mm_srli_si128(bytes, 9));
+  return _mm_unpacklo_epi64(pixels01, pixels23);
+}
+
+// Splits eight consecutive pixels into the even and odd ones.
+DOLPHIN_FORCE_INLINE static void LoadPixelPairs(const u8* src, __m128i* even, __m128i* odd)
+{
+  const __m128 first = _mm_castsi128_ps(LoadPixels(src));
+  const __m128 second = _mm_castsi128_ps(LoadPixels(src + 12));
+  *even = _mm_castps_si128(_mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+  *odd = _mm_castps_si128(_mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+DOLPHIN_FORCE_INLINE static Boxes LoadBoxes(const u8* src)
+{
+  Boxes boxes;
+  LoadPixelPairs(src, &boxes.top_left, &boxes.top_right);
+  LoadPixelPairs(src + EFB_WIDTH * 3, &boxes.bottom_left, &boxes.bottom_right);
+  return boxes;
+}
+
+template <int shift, int bits>
+DOLPHIN_FORCE_INLINE static __m128i GetChannel(__m128i pixels)
+{
+  return _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32((1 << bits) - 1));
+}
+
+template <int shift, int bits>
+DOLPHIN_FORCE_INLINE static __m128i SumBoxes(const Boxes& boxes)
+{
+  const __m128i top = _mm_add_epi32(GetChannel<shift, bits>(boxes.top_left),
+                                    GetChannel<shift, bits>(boxes.top_right));
+  const __m128i bottom = _mm_add_epi32(GetChannel<shift, bits>(boxes.bottom_left),
+                                       GetChannel<shift, bits>(boxes.bottom_right));
+  return _mm_add_epi32(top, bottom);
+}
+
+// Convert6To8 and the scaling of BoxfilterRGBA_to_RGBA8
+DOLPHIN_FORCE_INLINE static __m128i Convert6To8(__m128i value)
+{
+  return _mm_or_si128(_mm_slli_epi32(value, 2), _mm_srli_epi32(value, 4));
+}
+
+DOLPHIN_FORCE_INLINE static __m128i ScaleBoxSum6To8(__m128i sum)
+{
+  return _mm_add_epi32(sum, _mm_srli_epi32(sum, 6));
+}
+
+template <bool half_scale>
+DOLPHIN_FORCE_INLINE static ColorLanes LoadRGBA6(const u8* src)
+{
+  if constexpr (half_scale)
+  {
+    const Boxes boxes = LoadBoxes(src);
+    return {ScaleBoxSum6To8(SumBoxes<18, 6>(boxes)), ScaleBoxSum6To8(SumBoxes<12, 6>(boxes)),
+            ScaleBoxSum6To8(SumBoxes<6, 6>(boxes)), ScaleBoxSum6To8(SumBoxes<0, 6>(boxes))};
+  }
+
+  const __m128i pixels = LoadPixels(src);
+  return {Convert6To8(GetChannel<18, 6>(pixels)), Convert6To8(GetChannel<12, 6>(pixels)),
+          Convert6To8(GetChannel<6, 6>(pixels)), Convert6To8(GetChannel<0, 6>(pixels))};
+}
+
+// Also used for depth, with the most significant byte in r.
+template <bool half_scale>
+DOLPHIN_FORCE_INLINE static ColorLanes LoadRGB8(const u8* src)
+{
+  const __m128i alpha = _mm_set1_epi32(0xff);
+  if constexpr (half_scale)
+  {
+    const Boxes boxes = LoadBoxes(src);
+    return {_mm_srli_epi32(SumBoxes<16, 8>(boxes), 2), _mm_srli_epi32(SumBoxes<8, 8>(boxes), 2),
+            _mm_srli_epi32(SumBoxes<0, 8>(boxes), 2), alpha};
+  }
+
+  const __m128i pixels = LoadPixels(src);
+  return {GetChannel<16, 8>(pixels), GetChannel<8, 8>(pixels), GetChannel<0, 8>(pixels), alpha};
+}
+
+// RGB8_to_I
+DOLPHIN_FORCE_INLINE static __m128i GetIntensity(const ColorLanes& color)
+{
+  // The products fit in 16 bits, and the upper halves of the lanes are zero.
+  __m128i value = _mm_set1_epi32(4096);
+  value = _mm_add_epi32(value, _mm_mullo_epi16(color.r, _mm_set1_epi32(66)));
+  value = _mm_add_epi32(value, _mm_mullo_epi16(color.g, _mm_set1_epi32(129)));
+  value = _mm_add_epi32(value, _mm_mullo_epi16(color.b, _mm_set1_epi32(25)));
+  return _mm_srli_epi32(value, 8);
+}
+
+DOLPHIN_FORCE_INLINE static __m128i Combine8(__m128i high, __m128i low)
 {
-  const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+  return _mm_or_si128(_mm_slli_epi32(high, 8), low);
+}
+
+// Stores the 16-bit values in the lanes in big endian.
+DOLPHIN_FORCE_INLINE static void Store16(u8* dst, __m128i values)
+{
+  // Sign extend the values, so that they aren't saturated by packing.
+  values = _mm_srai_epi32(_mm_slli_epi32(values, 16), 16);
+  values = _mm_packs_epi32(values, values);
+  values = _mm_or_si128(_mm_slli_epi16(values, 8), _mm_srli_epi16(values, 8));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), values);
+}
+
+// Stores the 8-bit values in the lanes of two groups of four pixels.
+DOLPHIN_FORCE_INLINE static void Store8(u8* dst, __m128i first, __m128i second)
+{
+  const __m128i values = _mm_packs_epi32(first, second);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(values, values));
+}
+
+DOLPHIN_FORCE_INLINE static __m128i EncodeRGB565(const ColorLanes& color)
+{
+  const __m128i r = _mm_and_si128(_mm_slli_epi32(color.r, 8), _mm_set1_epi32(0xf800));
+  const __m128i g = _mm_and_si128(_mm_slli_epi32(color.g, 3), _mm_set1_epi32(0x07e0));
+  const __m128i b = _mm_srli_epi32(color.b, 3);
+  return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+// Doesn't need to expand the channels to 8 bits first, like the generic encoder.
+DOLPHIN_FORCE_INLINE static __m128i EncodeRGB565FromRGBA6(__m128i pixels)
+{
+  const __m128i r = _mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xf800));
+  const __m128i gb = _mm_and_si128(_mm_srli_epi32(pixels, 7), _mm_set1_epi32(0x07ff));
+  return _mm_or_si128(r, gb);
+}
+
+DOLPHIN_FORCE_INLINE static __m128i EncodeRGB5A3(const ColorLanes& color)
+{
+  __m128i rgb5 = _mm_set1_epi32(0x8000);
+  rgb5 = _mm_or_si128(rgb5, _mm_and_si128(_mm_slli_epi32(color.r, 7), _mm_set1_epi32(0x7c00)));
+  rgb5 = _mm_or_si128(rgb5, _mm_and_si128(_mm_slli_epi32(color.g, 2), _mm_set1_epi32(0x03e0)));
+  rgb5 = _mm_or_si128(rgb5, _mm_srli_epi32(color.b, 3));
+
+  __m128i argb4 = _mm_and_si128(_mm_slli_epi32(color.a, 7), _mm_set1_epi32(0x7000));
+  argb4 = _mm_or_si128(argb4, _mm_and_si128(_mm_slli_epi32(color.r, 4), _mm_set1_epi32(0x0f00)));
+  argb4 = _mm_or_si128(argb4, _mm_and_si128(color.g, _mm_set1_epi32(0x00f0)));
+  argb4 = _mm_or_si128(argb4, _mm_srli_epi32(color.b, 4));
+
+  const __m128i opaque = _mm_cmpgt_epi32(color.a, _mm_set1_epi32(223));
+  return _mm_or_si128(_mm_and_si128(opaque, rgb5), _mm_andnot_si128(opaque, argb4));
+}
+
+// Calls encode_row for every row of every block, in the order of the loops above. Each row of a
+// block is 8 bytes, and block_bytes apart from the next block.
+template <u32 block_width, typename F>
+static void EncodeBlocks(u8* dst, const u8* src, u32 block_bytes, bool half_scale, F encode_row)
+{
+  const u32 width = bpmem.copyTexSrcWH.x >> bpmem.triggerEFBCopy.half_scale;
+  const u32 height = bpmem.copyTexSrcWH.y >> bpmem.triggerEFBCopy.half_scale;
+  const u32 s_blocks = width / block_width + 1;
+  const u32 t_blocks = height / 4 + 1;
+  const u32 write_stride = bpmem.copyDestStride << 5;
+  const u32 read_stride = half_scale ? 6 : 3;
+
+  for (u32 t_block = 0; t_block < t_blocks; t_block++)
+  {
+    u8* dst_row = dst + t_block * write_stride;
+    for (u32 s_block = 0; s_block < s_blocks; s_block++)
+    {
+      for (u32 t = 0; t < 4; t++)
+      {
+        const u32 offset = (t_block * 4 + t) * EFB_WIDTH + s_block * block_width;
+        encode_row(dst_row + s_block * block_bytes + t * 8, src + offset * read_stride);
+      }
+    }
+  }
+}
+
+// Returns false if the format has no vectorized encoder. load_color loads the colors of four
+// pixels, and swaps r and b for half scale depth copies.
+template <bool half_scale, typename LoadColor>
+static bool EncodeEfbCopySIMD(u8* dst, const u8* src, EFBCopyFormat format, bool yuv, bool depth,
+                              LoadColor load_color)
+{
+  // The half scale depth encoders swap the most and least significant bytes for the formats with
+  // more than one channel.
+  const bool swap_rb = depth && half_scale;
+
+  // Offset of the second group of four pixels in a row of eight.
+  constexpr u32 second_group = half_scale ? 24 : 12;
+  const auto encode8 = [&](auto get_value) {
+    EncodeBlocks<8>(dst, src, 32, half_scale, [&](u8* out, const u8* in) {
+      Store8(out, get_value(load_color(in)), get_value(load_color(in + second_group)));
+    });
+  };
+  const auto encode16 = [&](auto get_value) {
+    EncodeBlocks<4>(dst, src, 32, half_scale,
+                    [&](u8* out, const u8* in) { Store16(out, get_value(load_color(in))); });
+  };
+
+  switch (format)
+  {
+  case EFBCopyFormat::R8_0x1:
+  case EFBCopyFormat::R8:
+    // R8 isn't swapped in half scale depth copies.
+    if (swap_rb)
+      encode8([](const ColorLanes& color) { return color.b; });
+    else if (yuv)
+      encode8([](const ColorLanes& color) { return GetIntensity(color); });
+    else
+      encode8([](const ColorLanes& color) { return color.r; });
+    return true;
+  case EFBCopyFormat::G8:
+    encode8([](const ColorLanes& color) { return color.g; });
+    return true;
+  case EFBCopyFormat::B8:
+    // Neither is B8.
+    if (swap_rb)
+      encode8([](const ColorLanes& color) { return color.r; });
+    else
+      encode8([](const ColorLanes& color) { return color.b; });
+    return true;
+  case EFBCopyFormat::RG8:
+    encode16([](const ColorLanes& color) { return Combine8(color.g, color.r); });
+    return true;
+  case EFBCopyFormat::GB8:
+    encode16([](const ColorLanes& color) { return Combine8(color.b, color.g); });
+    return true;
+  case EFBCopyFormat::RGBA8:
+    EncodeBlocks<4>(dst, src, 64, half_scale, [&](u8* out, const u8* in) {
+      const ColorLanes color = load_color(in);
+      Store16(out, Combine8(color.a, color.r));
+      Store16(out + 32, Combine8(color.g, color.b));
+    });
+    return true;
+  default:
+    break;
+  }
+
+  if (depth)
+    return false;
+
+  switch (format)
+  {
+  case EFBCopyFormat::A8:
+    encode8([](const ColorLanes& color) { return color.a; });
+    return true;
+  case EFBCopyFormat::RA8:
+    if (yuv)
+      encode16([](const ColorLanes& color) { return Combine8(color.a, GetIntensity(color)); });
+    else
+      encode16([](const ColorLanes& color) { return Combine8(color.a, color.r); });
+    return true;
+  case EFBCopyFormat::RGB565:
+    encode16([](const ColorLanes& color) { return EncodeRGB565(color); });
+    return true;
+  case EFBCopyFormat::RGB5A3:
+    encode16([](const ColorLanes& color) { return EncodeRGB5A3(color); });
+    return true;
+  default:
+    return false;
+  }
+}
+
+template <bool half_scale>
+static bool EncodeEfbCopySIMD(u8* dst, const u8* src, PixelFormat efb_format, EFBCopyFormat format,
+                              bool yuv)
+{
+  switch (efb_format)
+  {
+  case PixelFormat::RGBA6_Z24:
+    if (!half_scale && format == EFBCopyFormat::RGB565)
+    {
+      EncodeBlocks<4>(dst, src, 32, half_scale, [](u8* out, const u8* in) {
+        Store16(out, EncodeRGB565FromRGBA6(LoadPixels(in)));
+      });
+      return true;
+    }
+    return EncodeEfbCopySIMD<half_scale>(dst, src, format, yuv, false, [](const u8* pixels) {
+      return LoadRGBA6<half_scale>(pixels);
+    });
+  case PixelFormat::RGB8_Z24:
+  case PixelFormat::RGB565_Z16:
+    return EncodeEfbCopySIMD<half_scale>(dst, src, format, yuv, false, [](const u8* pixels) {
+      return LoadRGB8<half_scale>(pixels);
+    });
+  case PixelFormat::Z24:
+    // The depth encoders ignore yuv.
+    return EncodeEfbCopySIMD<half_scale>(dst, src, format, false, true, [](const u8* pixels) {
+      ColorLanes color = LoadRGB8<half_scale>(pixels);
+      if (half_scale)
+        std::swap(color.r, color.b);
+      return color;
+    });
+  default:
+    return false;
+  }
+}
+#endif
+
+void EncodeEfbCopy(u8* dst, const u8* src, const EFBCopyParams& params, bool scale_by_half,
+                   bool use_simd)
+{
+#ifdef _M_X86_64
+  if (use_simd)
+  {
+    const bool encoded =
+        scale_by_half ?
+            EncodeEfbCopySIMD<true>(dst, src, params.efb_format, params.copy_format, params.yuv) :
+            EncodeEfbCopySIMD<false>(dst, src, params.efb_format, params.copy_format, params.yuv);
+    if (encoded)
+      return;
+  }
+#endif
 
   if (scale_by_half)
   {
@@ -1472,7 +1809,6 @@ void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 b
     }
   }
 }
-}  // namespace
 
 void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
@@ -1493,8 +1829,9 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
   }
   else
   {
-    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, native_width,
-                  bytes_per_row, num_blocks_y, memory_stride, src_rect, scale_by_half);
+    const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), src, params, scale_by_half,
+                  true);
   }
 }
 }  // namespace TextureEncoder
@@ -13,4 +13,9 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
             const MathUtil::Rectangle<int>& src_rect, bool scale_by_half, float y_scale,
             float gamma);
-}
+
+// Encodes an EFB copy from the EFB pixel at src, in the layout given by bpmem. The generic encoders
+// are used if use_simd is false, to compare them with the vectorized ones.
+void EncodeEfbCopy(u8* dst, const u8* src, const EFBCopyParams& params, bool scale_by_half,
+                   bool use_simd);
+}  // namespace TextureEncoder
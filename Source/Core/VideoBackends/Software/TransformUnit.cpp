@@ -10,6 +10,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Matrix.h"
 #include "Common/MsgHandler.h"
@@ -313,37 +314,83 @@ static void LightAlpha(const Vec3& pos, const Vec3& normal, u8 lightNum, const L
   }
 }
 
+static Vec3 GetAmbientColor(const InputVertexData* src, u32 chan)
+{
+  if (xfmem.color[chan].ambsource == AmbSource::Vertex)
+    return Vec3(src->color[chan][1], src->color[chan][2], src->color[chan][3]);
+
+  const u8* ambColor = reinterpret_cast<const u8*>(&xfmem.ambColor[chan]);
+  return Vec3(ambColor[1], ambColor[2], ambColor[3]);
+}
+
+static float GetAmbientAlpha(const InputVertexData* src, u32 chan)
+{
+  if (xfmem.alpha[chan].ambsource == AmbSource::Vertex)
+    return src->color[chan][0];
+  return static_cast<float>(xfmem.ambColor[chan] & 0xff);
+}
+
+// Modulates the material color of a channel with the accumulated light color and alpha. These are
+// only used if lighting is enabled for the color or alpha of the channel.
+static void SetChannelColor(const InputVertexData* src, u32 chan, const Vec3& lightCol,
+                            float lightAlpha, OutputVertexData* dst)
+{
+  // abgr
+  std::array<u8, 4> matcolor;
+  std::array<u8, 4> chancolor;
+
+  // color
+  const LitChannel& colorchan = xfmem.color[chan];
+  if (colorchan.matsource == MatSource::Vertex)
+    matcolor = src->color[chan];
+  else
+    std::memcpy(matcolor.data(), &xfmem.matColor[chan], sizeof(u32));
+
+  if (colorchan.enablelighting)
+  {
+    int light_x = std::clamp(static_cast<int>(lightCol.x), 0, 255);
+    int light_y = std::clamp(static_cast<int>(lightCol.y), 0, 255);
+    int light_z = std::clamp(static_cast<int>(lightCol.z), 0, 255);
+    chancolor[1] = (matcolor[1] * (light_x + (light_x >> 7))) >> 8;
+    chancolor[2] = (matcolor[2] * (light_y + (light_y >> 7))) >> 8;
+    chancolor[3] = (matcolor[3] * (light_z + (light_z >> 7))) >> 8;
+  }
+  else
+  {
+    chancolor = matcolor;
+  }
+
+  // alpha
+  const LitChannel& alphachan = xfmem.alpha[chan];
+  if (alphachan.matsource == MatSource::Vertex)
+    matcolor[0] = src->color[chan][0];
+  else
+    matcolor[0] = xfmem.matColor[chan] & 0xff;
+
+  if (alphachan.enablelighting)
+  {
+    int light_a = std::clamp(static_cast<int>(lightAlpha), 0, 255);
+    chancolor[0] = (matcolor[0] * (light_a + (light_a >> 7))) >> 8;
+  }
+  else
+  {
+    chancolor[0] = matcolor[0];
+  }
+
+  // abgr -> rgba
+  const u32 rgba_color = Common::swap32(chancolor.data());
+  std::memcpy(dst->color[chan].data(), &rgba_color, sizeof(u32));
+}
+
 void TransformColor(const InputVertexData* src, OutputVertexData* dst)
 {
   for (u32 chan = 0; chan < NUM_XF_COLOR_CHANNELS; chan++)
   {
-    // abgr
-    std::array<u8, 4> matcolor;
-    std::array<u8, 4> chancolor;
-
-    // color
+    Vec3 lightCol;
     const LitChannel& colorchan = xfmem.color[chan];
-    if (colorchan.matsource == MatSource::Vertex)
-      matcolor = src->color[chan];
-    else
-      std::memcpy(matcolor.data(), &xfmem.matColor[chan], sizeof(u32));
-
     if (colorchan.enablelighting)
     {
-      Vec3 lightCol;
-      if (colorchan.ambsource == AmbSource::Vertex)
-      {
-        lightCol.x = src->color[chan][1];
-        lightCol.y = src->color[chan][2];
-        lightCol.z = src->color[chan][3];
-      }
-      else
-      {
-        const u8* ambColor = reinterpret_cast<u8*>(&xfmem.ambColor[chan]);
-        lightCol.x = ambColor[1];
-        lightCol.y = ambColor[2];
-        lightCol.z = ambColor[3];
-      }
+      lightCol = GetAmbientColor(src, chan);
 
       u8 mask = colorchan.GetFullLightMask();
       for (int i = 0; i < 8; ++i)
@@ -351,52 +398,23 @@ void TransformColor(const InputVertexData* src, OutputVertexData* dst)
         if (mask & (1 << i))
           LightColor(dst->mvPosition, dst->normal[0], i, colorchan, lightCol);
       }
-
-      int light_x = std::clamp(static_cast<int>(lightCol.x), 0, 255);
-      int light_y = std::clamp(static_cast<int>(lightCol.y), 0, 255);
-      int light_z = std::clamp(static_cast<int>(lightCol.z), 0, 255);
-      chancolor[1] = (matcolor[1] * (light_x + (light_x >> 7))) >> 8;
-      chancolor[2] = (matcolor[2] * (light_y + (light_y >> 7))) >> 8;
-      chancolor[3] = (matcolor[3] * (light_z + (light_z >> 7))) >> 8;
-    }
-    else
-    {
-      chancolor = matcolor;
     }
 
-    // alpha
+    float lightAlpha = 0;
     const LitChannel& alphachan = xfmem.alpha[chan];
-    if (alphachan.matsource == MatSource::Vertex)
-      matcolor[0] = src->color[chan][0];
-    else
-      matcolor[0] = xfmem.matColor[chan] & 0xff;
-
-    if (xfmem.alpha[chan].enablelighting)
+    if (alphachan.enablelighting)
     {
-      float lightCol;
-      if (alphachan.ambsource == AmbSource::Vertex)
-        lightCol = src->color[chan][0];
-      else
-        lightCol = static_cast<float>(xfmem.ambColor[chan] & 0xff);
+      lightAlpha = GetAmbientAlpha(src, chan);
 
       u8 mask = alphachan.GetFullLightMask();
       for (int i = 0; i < 8; ++i)
       {
         if (mask & (1 << i))
-          LightAlpha(dst->mvPosition, dst->normal[0], i, alphachan, lightCol);
+          LightAlpha(dst->mvPosition, dst->normal[0], i, alphachan, lightAlpha);
       }
-
-      int light_a = std::clamp(static_cast<int>(lightCol), 0, 255);
-      chancolor[0] = (matcolor[0] * (light_a + (light_a >> 7))) >> 8;
-    }
-    else
-    {
-      chancolor[0] = matcolor[0];
     }
 
-    // abgr -> rgba
-    const u32 rgba_color = Common::swap32(chancolor.data());
-    std::memcpy(dst->color[chan].data(), &rgba_color, sizeof(u32));
+    SetChannelColor(src, chan, lightCol, lightAlpha, dst);
   }
 }
 
@@ -448,4 +466,356 @@ void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst)
     dst->texCoords[coordNum].y *= bpmem.texcoords[coordNum].t.scale_minus_1 + 1;
   }
 }
+
+#ifdef _M_X86_64
+// The batched transform keeps one vertex in each lane of the SSE registers. Every operation is done
+// in the same order as in the functions above, so that the results are identical.
+namespace
+{
+struct Vec3x4
+{
+  __m128 x;
+  __m128 y;
+  __m128 z;
+};
+
+// One matrix per lane. Most batches use a single matrix, which is then broadcast to all lanes.
+struct MatrixLanes
+{
+  __m128 Load(int i) const
+  {
+    if (uniform)
+      return _mm_set1_ps(matrices[0][i]);
+    return _mm_setr_ps(matrices[0][i], matrices[1][i], matrices[2][i], matrices[3][i]);
+  }
+
+  std::array<const float*, TRANSFORM_BATCH_SIZE> matrices;
+  bool uniform;
+};
+}  // namespace
+
+template <typename F>
+static Vec3x4 GatherVec3(F&& get)
+{
+  const Vec3 v0 = get(0), v1 = get(1), v2 = get(2), v3 = get(3);
+  return {_mm_setr_ps(v0.x, v1.x, v2.x, v3.x), _mm_setr_ps(v0.y, v1.y, v2.y, v3.y),
+          _mm_setr_ps(v0.z, v1.z, v2.z, v3.z)};
+}
+
+static Vec3x4 Broadcast(const Vec3& vec)
+{
+  return {_mm_set1_ps(vec.x), _mm_set1_ps(vec.y), _mm_set1_ps(vec.z)};
+}
+
+static std::array<float, TRANSFORM_BATCH_SIZE> Store(__m128 vec)
+{
+  std::array<float, TRANSFORM_BATCH_SIZE> result;
+  _mm_storeu_ps(result.data(), vec);
+  return result;
+}
+
+static std::array<Vec3, TRANSFORM_BATCH_SIZE> Store(const Vec3x4& vec)
+{
+  const auto x = Store(vec.x);
+  const auto y = Store(vec.y);
+  const auto z = Store(vec.z);
+  return {Vec3(x[0], y[0], z[0]), Vec3(x[1], y[1], z[1]), Vec3(x[2], y[2], z[2]),
+          Vec3(x[3], y[3], z[3])};
+}
+
+static __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static Vec3x4 Select(__m128 mask, const Vec3x4& a, const Vec3x4& b)
+{
+  return {Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z)};
+}
+
+// std::max(0.0f, vec)
+static __m128 Max0(__m128 vec)
+{
+  return _mm_max_ps(vec, _mm_setzero_ps());
+}
+
+static __m128 Dot(const Vec3x4& a, const Vec3x4& b)
+{
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+static Vec3x4 Subtract(const Vec3x4& a, const Vec3x4& b)
+{
+  return {_mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z)};
+}
+
+static Vec3x4 Divide(const Vec3x4& vec, __m128 d)
+{
+  return {_mm_div_ps(vec.x, d), _mm_div_ps(vec.y, d), _mm_div_ps(vec.z, d)};
+}
+
+static Vec3x4 Normalized(const Vec3x4& vec)
+{
+  return Divide(vec, _mm_sqrt_ps(Dot(vec, vec)));
+}
+
+static Vec3x4 MultiplyVec3Mat33(const Vec3x4& vec, const MatrixLanes& mat)
+{
+  const auto row = [&](int i) {
+    return Dot({mat.Load(i), mat.Load(i + 1), mat.Load(i + 2)}, vec);
+  };
+  return {row(0), row(3), row(6)};
+}
+
+static Vec3x4 MultiplyVec3Mat34(const Vec3x4& vec, const MatrixLanes& mat)
+{
+  const auto row = [&](int i) {
+    return _mm_add_ps(Dot({mat.Load(i), mat.Load(i + 1), mat.Load(i + 2)}, vec), mat.Load(i + 3));
+  };
+  return {row(0), row(4), row(8)};
+}
+
+static __m128 SafeDivide(__m128 n, __m128 d)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 sign = _mm_and_ps(_mm_cmpgt_ps(n, zero), _mm_set1_ps(1.0f));
+  return Select(_mm_cmpeq_ps(d, zero), sign, _mm_div_ps(n, d));
+}
+
+static __m128 CalculateLightAttn(const LightPointer* light, Vec3x4* _ldir, const Vec3x4& normal,
+                                 const LitChannel& chan)
+{
+  const __m128 zero = _mm_setzero_ps();
+  __m128 attn = _mm_set1_ps(1.0f);
+  Vec3x4& ldir = *_ldir;
+
+  switch (chan.attnfunc)
+  {
+  case AttenuationFunc::None:
+  case AttenuationFunc::Dir:
+  {
+    ldir = Normalized(ldir);
+    const __m128 is_zero = _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(ldir.x, zero),
+                                                 _mm_cmpeq_ps(ldir.y, zero)),
+                                      _mm_cmpeq_ps(ldir.z, zero));
+    ldir = Select(is_zero, normal, ldir);
+    break;
+  }
+  case AttenuationFunc::Spec:
+  {
+    ldir = Normalized(ldir);
+    attn = Select(_mm_cmpge_ps(Dot(ldir, normal), zero), Max0(Dot(Broadcast(light->dir), normal)),
+                  zero);
+    const Vec3x4 attLen = {_mm_set1_ps(1.0f), attn, _mm_mul_ps(attn, attn)};
+    Vec3 cosAttn = light->cosatt;
+    Vec3 distAttn = light->distatt;
+    if (chan.diffusefunc != DiffuseFunc::None)
+      distAttn = distAttn.Normalized();
+
+    attn = SafeDivide(Max0(Dot(attLen, Broadcast(cosAttn))), Dot(attLen, Broadcast(distAttn)));
+    break;
+  }
+  case AttenuationFunc::Spot:
+  {
+    const __m128 dist2 = Dot(ldir, ldir);
+    const __m128 dist = _mm_sqrt_ps(dist2);
+    ldir = Divide(ldir, dist);
+    attn = Max0(Dot(ldir, Broadcast(light->dir)));
+
+    const Vec3x4 cosatt = Broadcast(light->cosatt);
+    const Vec3x4 distatt = Broadcast(light->distatt);
+    const __m128 cosAtt = _mm_add_ps(_mm_add_ps(cosatt.x, _mm_mul_ps(cosatt.y, attn)),
+                                     _mm_mul_ps(_mm_mul_ps(cosatt.z, attn), attn));
+    const __m128 distAtt = _mm_add_ps(_mm_add_ps(distatt.x, _mm_mul_ps(distatt.y, dist)),
+                                      _mm_mul_ps(distatt.z, dist2));
+    attn = SafeDivide(Max0(cosAtt), distAtt);
+    break;
+  }
+  default:
+    PanicAlertFmt("Invalid attnfunc: {}", chan.attnfunc);
+  }
+
+  return attn;
+}
+
+static void AddScaledIntegerColor(const u8* src, __m128 scale, Vec3x4& dst)
+{
+  dst.x = _mm_add_ps(dst.x, _mm_mul_ps(_mm_set1_ps(src[1]), scale));
+  dst.y = _mm_add_ps(dst.y, _mm_mul_ps(_mm_set1_ps(src[2]), scale));
+  dst.z = _mm_add_ps(dst.z, _mm_mul_ps(_mm_set1_ps(src[3]), scale));
+}
+
+static void LightColor(const Vec3x4& pos, const Vec3x4& normal, u8 lightNum, const LitChannel& chan,
+                       Vec3x4& lightCol)
+{
+  const LightPointer* light = (const LightPointer*)&xfmem.lights[lightNum];
+
+  Vec3x4 ldir = Subtract(Broadcast(light->pos), pos);
+  const __m128 attn = CalculateLightAttn(light, &ldir, normal, chan);
+
+  const __m128 difAttn = Dot(ldir, normal);
+  switch (chan.diffusefunc)
+  {
+  case DiffuseFunc::None:
+    AddScaledIntegerColor(light->color, attn, lightCol);
+    break;
+  case DiffuseFunc::Sign:
+    AddScaledIntegerColor(light->color, _mm_mul_ps(attn, difAttn), lightCol);
+    break;
+  case DiffuseFunc::Clamp:
+    AddScaledIntegerColor(light->color, _mm_mul_ps(attn, Max0(difAttn)), lightCol);
+    break;
+  default:
+    PanicAlertFmt("Invalid diffusefunc: {}", chan.attnfunc);
+  }
+}
+
+static void LightAlpha(const Vec3x4& pos, const Vec3x4& normal, u8 lightNum, const LitChannel& chan,
+                       __m128& lightCol)
+{
+  const LightPointer* light = (const LightPointer*)&xfmem.lights[lightNum];
+
+  Vec3x4 ldir = Subtract(Broadcast(light->pos), pos);
+  const __m128 attn = CalculateLightAttn(light, &ldir, normal, chan);
+  const __m128 color = _mm_mul_ps(_mm_set1_ps(light->color[0]), attn);
+
+  const __m128 difAttn = Dot(ldir, normal);
+  switch (chan.diffusefunc)
+  {
+  case DiffuseFunc::None:
+    lightCol = _mm_add_ps(lightCol, color);
+    break;
+  case DiffuseFunc::Sign:
+    lightCol = _mm_add_ps(lightCol, _mm_mul_ps(color, difAttn));
+    break;
+  case DiffuseFunc::Clamp:
+    lightCol = _mm_add_ps(lightCol, _mm_mul_ps(color, Max0(difAttn)));
+    break;
+  default:
+    PanicAlertFmt("Invalid diffusefunc: {}", chan.attnfunc);
+  }
+}
+#endif
+
+void TransformBatch(const InputVertexData* src, OutputVertexData* dst, u32 count)
+{
+  ASSERT(count <= TRANSFORM_BATCH_SIZE);
+
+#ifdef _M_X86_64
+  // Unused lanes repeat the first vertex, their results are discarded.
+  std::array<const InputVertexData*, TRANSFORM_BATCH_SIZE> lanes;
+  for (u32 i = 0; i < TRANSFORM_BATCH_SIZE; i++)
+    lanes[i] = &src[i < count ? i : 0];
+
+  MatrixLanes pos_matrices;
+  MatrixLanes normal_matrices;
+  pos_matrices.uniform = true;
+  for (u32 i = 0; i < TRANSFORM_BATCH_SIZE; i++)
+  {
+    pos_matrices.matrices[i] = &xfmem.posMatrices[lanes[i]->posMtx * 4];
+    normal_matrices.matrices[i] = &xfmem.normalMatrices[(lanes[i]->posMtx & 31) * 3];
+    pos_matrices.uniform &= lanes[i]->posMtx == lanes[0]->posMtx;
+  }
+  normal_matrices.uniform = pos_matrices.uniform;
+
+  // position
+  const Vec3x4 mvPosition =
+      MultiplyVec3Mat34(GatherVec3([&](u32 i) { return lanes[i]->position; }), pos_matrices);
+
+  const Projection::Raw& proj = xfmem.projection.rawProjection;
+  const auto madd = [&](int i, __m128 vec, __m128 add) {
+    return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(proj[i]), vec), add);
+  };
+  std::array<__m128, 4> projected;
+  if (xfmem.projection.type == ProjectionType::Perspective)
+  {
+    projected[0] = madd(0, mvPosition.x, _mm_mul_ps(_mm_set1_ps(proj[1]), mvPosition.z));
+    projected[1] = madd(2, mvPosition.y, _mm_mul_ps(_mm_set1_ps(proj[3]), mvPosition.z));
+    projected[2] = _mm_mul_ps(madd(4, mvPosition.z, _mm_set1_ps(proj[5])),
+                              _mm_set1_ps(1.0f - (float)1e-7));
+    projected[3] = _mm_xor_ps(mvPosition.z, _mm_set1_ps(-0.0f));
+  }
+  else
+  {
+    projected[0] = madd(0, mvPosition.x, _mm_set1_ps(proj[1]));
+    projected[1] = madd(2, mvPosition.y, _mm_set1_ps(proj[3]));
+    projected[2] = madd(4, mvPosition.z, _mm_set1_ps(proj[5]));
+    projected[3] = _mm_set1_ps(1.0f);
+  }
+
+  // normals, see TransformNormal
+  std::array<Vec3x4, 3> normal;
+  for (u32 n = 0; n < normal.size(); n++)
+  {
+    normal[n] =
+        MultiplyVec3Mat33(GatherVec3([&](u32 i) { return lanes[i]->normal[n]; }), normal_matrices);
+  }
+  normal[0] = Normalized(normal[0]);
+
+  const auto mv_positions = Store(mvPosition);
+  const auto projected_x = Store(projected[0]);
+  const auto projected_y = Store(projected[1]);
+  const auto projected_z = Store(projected[2]);
+  const auto projected_w = Store(projected[3]);
+  const auto normals0 = Store(normal[0]);
+  const auto normals1 = Store(normal[1]);
+  const auto normals2 = Store(normal[2]);
+  for (u32 i = 0; i < count; i++)
+  {
+    dst[i].mvPosition = mv_positions[i];
+    dst[i].projectedPosition = Vec4(projected_x[i], projected_y[i], projected_z[i], projected_w[i]);
+    dst[i].normal = {normals0[i], normals1[i], normals2[i]};
+  }
+
+  // colors, see TransformColor
+  for (u32 chan = 0; chan < NUM_XF_COLOR_CHANNELS; chan++)
+  {
+    std::array<Vec3, TRANSFORM_BATCH_SIZE> lightCol{};
+    const LitChannel& colorchan = xfmem.color[chan];
+    if (colorchan.enablelighting)
+    {
+      Vec3x4 light = GatherVec3([&](u32 i) { return GetAmbientColor(lanes[i], chan); });
+
+      u8 mask = colorchan.GetFullLightMask();
+      for (int i = 0; i < 8; ++i)
+      {
+        if (mask & (1 << i))
+          LightColor(mvPosition, normal[0], i, colorchan, light);
+      }
+      lightCol = Store(light);
+    }
+
+    std::array<float, TRANSFORM_BATCH_SIZE> lightAlpha{};
+    const LitChannel& alphachan = xfmem.alpha[chan];
+    if (alphachan.enablelighting)
+    {
+      __m128 light =
+          _mm_setr_ps(GetAmbientAlpha(lanes[0], chan), GetAmbientAlpha(lanes[1], chan),
+                      GetAmbientAlpha(lanes[2], chan), GetAmbientAlpha(lanes[3], chan));
+
+      u8 mask = alphachan.GetFullLightMask();
+      for (int i = 0; i < 8; ++i)
+      {
+        if (mask & (1 << i))
+          LightAlpha(mvPosition, normal[0], i, alphachan, light);
+      }
+      lightAlpha = Store(light);
+    }
+
+    for (u32 i = 0; i < count; i++)
+      SetChannelColor(&src[i], chan, lightCol[i], lightAlpha[i], &dst[i]);
+  }
+
+  for (u32 i = 0; i < count; i++)
+    TransformTexCoord(&src[i], &dst[i]);
+#else
+  for (u32 i = 0; i < count; i++)
+  {
+    TransformPosition(&src[i], &dst[i]);
+    TransformNormal(&src[i], &dst[i]);
+    TransformColor(&src[i], &dst[i]);
+    TransformTexCoord(&src[i], &dst[i]);
+  }
+#endif
+}
 }  // namespace TransformUnit
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
+
 struct InputVertexData;
 struct OutputVertexData;
 
@@ -12,4 +14,9 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst);
 void TransformNormal(const InputVertexData* src, OutputVertexData* dst);
 void TransformColor(const InputVertexData* src, OutputVertexData* dst);
 void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst);
+
+constexpr u32 TRANSFORM_BATCH_SIZE = 4;
+
+// Does all of the above for up to TRANSFORM_BATCH_SIZE vertices at once, with the same results.
+void TransformBatch(const InputVertexData* src, OutputVertexData* dst, u32 count);
 }  // namespace TransformUnit
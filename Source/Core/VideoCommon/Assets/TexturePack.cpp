@@ -0,0 +1,250 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePack.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "Common/Align.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/TextureConfig.h"
+
+namespace VideoCommon
+{
+static_assert(sizeof(TexturePack::Header) == 24);
+static_assert(sizeof(TexturePack::TextureEntry) == 24);
+static_assert(sizeof(TexturePack::LevelEntry) == 40);
+
+// Level data is aligned, so that it can be copied out of the mapping efficiently.
+constexpr u64 LEVEL_ALIGNMENT = 16;
+
+// The format is cast to AbstractTextureFormat and the data uploaded as is, so both have to match
+// the size of the level.
+static bool IsValidRawLevel(const TexturePack::LevelEntry& level)
+{
+  if (level.format >= static_cast<u32>(AbstractTextureFormat::Undefined))
+    return false;
+  const auto format = static_cast<AbstractTextureFormat>(level.format);
+  if (AbstractTexture::IsDepthFormat(format) || level.width == 0 || level.height == 0 ||
+      level.row_length < level.width)
+  {
+    return false;
+  }
+
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+  const u64 rows = (u64{level.height} + block_size - 1) / block_size;
+  const u64 stride = AbstractTexture::CalculateStrideForFormat(format, level.row_length);
+  return level.data_size >= stride * rows;
+}
+
+bool TexturePack::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_names = {};
+  if (!m_file.Open(path))
+    return false;
+
+  const std::span<const u8> file = m_file.GetData();
+  Header header;
+  if (file.size() < sizeof(header))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' is too small", path);
+    return false;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != MAGIC || header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an unknown format or version", path);
+    return false;
+  }
+
+  const u64 textures_size = u64{header.texture_count} * sizeof(TextureEntry);
+  const u64 levels_size = u64{header.level_count} * sizeof(LevelEntry);
+  if (header.index_offset > file.size() ||
+      textures_size + levels_size > file.size() - header.index_offset)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' is truncated", path);
+    return false;
+  }
+
+  const u8* index = file.data() + header.index_offset;
+  m_textures.resize(header.texture_count);
+  std::memcpy(m_textures.data(), index, textures_size);
+  m_levels.resize(header.level_count);
+  std::memcpy(m_levels.data(), index + textures_size, levels_size);
+  const u8* names = index + textures_size + levels_size;
+  m_names = std::string_view(reinterpret_cast<const char*>(names),
+                             static_cast<std::size_t>(file.data() + file.size() - names));
+
+  const bool valid_textures = std::ranges::all_of(m_textures, [&](const TextureEntry& texture) {
+    return texture.level_count != 0 && texture.name_offset <= m_names.size() &&
+           texture.name_length <= m_names.size() - texture.name_offset &&
+           u64{texture.first_level} + texture.level_count <= m_levels.size();
+  });
+  const bool valid_levels = std::ranges::all_of(m_levels, [&](const LevelEntry& level) {
+    return level.data_offset <= file.size() && level.data_size <= file.size() - level.data_offset &&
+           (level.encoding == LevelEncoding::PNG ||
+            (level.encoding == LevelEncoding::Raw && IsValidRawLevel(level)));
+  });
+  if (!valid_textures || !valid_levels)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an invalid index", path);
+    m_textures.clear();
+    m_levels.clear();
+    return false;
+  }
+
+  return true;
+}
+
+std::string_view TexturePack::GetTextureName(std::size_t index) const
+{
+  const TextureEntry& texture = m_textures[index];
+  return m_names.substr(texture.name_offset, texture.name_length);
+}
+
+bool TexturePack::HasArbitraryMipmaps(std::size_t index) const
+{
+  return m_textures[index].has_arbitrary_mipmaps != 0;
+}
+
+bool TexturePack::LoadTexture(std::size_t index, CustomTextureData* data) const
+{
+  const TextureEntry& texture = m_textures[index];
+  data->m_slices.clear();
+  auto& slice = data->m_slices.emplace_back();
+  slice.m_levels.resize(texture.level_count);
+
+  for (u32 i = 0; i < texture.level_count; i++)
+  {
+    const LevelEntry& entry = m_levels[texture.first_level + i];
+    const std::span<const u8> level_data =
+        m_file.GetData().subspan(entry.data_offset, entry.data_size);
+    CustomTextureData::ArraySlice::Level& level = slice.m_levels[i];
+
+    if (entry.encoding == LevelEncoding::PNG)
+    {
+      if (!LoadPNGTexture(&level, level_data))
+      {
+        ERROR_LOG_FMT(VIDEO, "Level {} of packed texture '{}' failed to load", i,
+                      GetTextureName(index));
+        return false;
+      }
+      continue;
+    }
+
+    level.data.reset(level_data.size());
+    std::memcpy(level.data.data(), level_data.data(), level_data.size());
+    level.format = static_cast<AbstractTextureFormat>(entry.format);
+    level.width = entry.width;
+    level.height = entry.height;
+    level.row_length = entry.row_length;
+  }
+
+  return true;
+}
+
+bool TexturePackWriter::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_names.clear();
+
+  // The header is written again by Finish, once the index is known.
+  const TexturePack::Header header{};
+  return m_file.Open(path, "wb") && m_file.WriteArray(&header, 1);
+}
+
+bool TexturePackWriter::WriteLevel(std::span<const u8> data, TexturePack::LevelEntry level)
+{
+  static constexpr std::array<u8, LEVEL_ALIGNMENT> padding{};
+  const u64 position = m_file.Tell();
+  level.data_offset = Common::AlignUp(position, LEVEL_ALIGNMENT);
+  level.data_size = data.size();
+  if (!m_file.WriteBytes(padding.data(), level.data_offset - position) ||
+      !m_file.WriteBytes(data.data(), data.size()))
+  {
+    return false;
+  }
+
+  m_levels.push_back(level);
+  return true;
+}
+
+void TexturePackWriter::AddTextureEntry(std::string_view name, bool has_arbitrary_mipmaps,
+                                        u32 first_level)
+{
+  m_textures.push_back({
+      .name_offset = m_names.size(),
+      .name_length = static_cast<u32>(name.size()),
+      .first_level = first_level,
+      .level_count = static_cast<u32>(m_levels.size()) - first_level,
+      .has_arbitrary_mipmaps = has_arbitrary_mipmaps,
+  });
+  m_names.append(name);
+}
+
+bool TexturePackWriter::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                   const CustomTextureData::ArraySlice& slice)
+{
+  if (slice.m_levels.empty())
+    return false;
+
+  const u32 first_level = static_cast<u32>(m_levels.size());
+  for (const CustomTextureData::ArraySlice::Level& level : slice.m_levels)
+  {
+    const TexturePack::LevelEntry entry{
+        .width = level.width,
+        .height = level.height,
+        .row_length = level.row_length,
+        .format = static_cast<u32>(level.format),
+        .encoding = TexturePack::LevelEncoding::Raw,
+    };
+    if (!WriteLevel(std::span(level.data.data(), level.data.size()), entry))
+      return false;
+  }
+
+  AddTextureEntry(name, has_arbitrary_mipmaps, first_level);
+  return true;
+}
+
+bool TexturePackWriter::AddPNGTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                      std::span<const std::string> png_levels)
+{
+  if (png_levels.empty())
+    return false;
+
+  const u32 first_level = static_cast<u32>(m_levels.size());
+  for (const std::string& png : png_levels)
+  {
+    const std::span data(reinterpret_cast<const u8*>(png.data()), png.size());
+    if (!WriteLevel(data, {.encoding = TexturePack::LevelEncoding::PNG}))
+      return false;
+  }
+
+  AddTextureEntry(name, has_arbitrary_mipmaps, first_level);
+  return true;
+}
+
+bool TexturePackWriter::Finish()
+{
+  const TexturePack::Header header{
+      .magic = TexturePack::MAGIC,
+      .version = TexturePack::VERSION,
+      .index_offset = m_file.Tell(),
+      .texture_count = static_cast<u32>(m_textures.size()),
+      .level_count = static_cast<u32>(m_levels.size()),
+  };
+
+  m_file.WriteArray(m_textures.data(), m_textures.size());
+  m_file.WriteArray(m_levels.data(), m_levels.size());
+  m_file.WriteString(m_names);
+  m_file.Seek(0, File::SeekOrigin::Begin);
+  m_file.WriteArray(&header, 1);
+  return m_file.IsGood() && m_file.Close();
+}
+}  // namespace VideoCommon
@@ -0,0 +1,113 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// A texture pack holds the custom textures of a texture directory in a single file, which is
+// memory mapped, so that packs of many textures don't need a file to be opened for each texture.
+// The levels of DDS textures are stored ready to be uploaded, BCn compressed ones included.
+// PNG levels are stored as the PNG files, since they would be several times bigger decoded.
+//
+// The file starts with a Header, followed by the level data. The index of the textures is at the
+// end, so that a pack can be written without holding all of its textures in memory:
+// TextureEntry[texture_count], LevelEntry[level_count], then the texture names.
+class TexturePack
+{
+public:
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  enum class LevelEncoding : u8
+  {
+    Raw,
+    PNG,
+  };
+
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u64 index_offset;
+    u32 texture_count;
+    u32 level_count;
+  };
+
+  struct TextureEntry
+  {
+    // Relative to the start of the names.
+    u64 name_offset;
+    u32 name_length;
+    u32 first_level;
+    u32 level_count;
+    u32 has_arbitrary_mipmaps;
+  };
+
+  struct LevelEntry
+  {
+    u64 data_offset;
+    u64 data_size;
+    // Unused for PNG levels, which have their size in the PNG header.
+    u32 width;
+    u32 height;
+    u32 row_length;
+    u32 format;
+    LevelEncoding encoding;
+    u8 padding[7];
+  };
+
+  // Checks that the index and all of the data it points to are inside of the file.
+  bool Open(const std::string& path);
+
+  std::size_t GetTextureCount() const { return m_textures.size(); }
+  std::string_view GetTextureName(std::size_t index) const;
+  bool HasArbitraryMipmaps(std::size_t index) const;
+
+  // Copies the levels of a texture out of the pack into a single slice, decoding PNG levels.
+  bool LoadTexture(std::size_t index, CustomTextureData* data) const;
+
+private:
+  File::MappedFile m_file;
+  std::vector<TextureEntry> m_textures;
+  std::vector<LevelEntry> m_levels;
+  std::string_view m_names;
+};
+
+class TexturePackWriter
+{
+public:
+  bool Open(const std::string& path);
+
+  // Adds a texture with the levels of the slice, which are stored as they are.
+  bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                  const CustomTextureData::ArraySlice& slice);
+
+  // Adds a texture with one level for each of the PNG files.
+  bool AddPNGTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                     std::span<const std::string> png_levels);
+
+  // Writes the index. Packs can't be opened before this is done.
+  bool Finish();
+
+private:
+  bool WriteLevel(std::span<const u8> data, TexturePack::LevelEntry level);
+  void AddTextureEntry(std::string_view name, bool has_arbitrary_mipmaps, u32 first_level);
+
+  File::IOFile m_file;
+  std::vector<TexturePack::TextureEntry> m_textures;
+  std::vector<TexturePack::LevelEntry> m_levels;
+  std::string m_names;
+};
+}  // namespace VideoCommon
@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+
+#include <utility>
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TextureAssetUtils.h"
+#include "VideoCommon/Assets/TexturePack.h"
+
+namespace VideoCommon
+{
+namespace
+{
+std::size_t GetAssetSize(const CustomTextureData& data)
+{
+  std::size_t total = 0;
+  for (const auto& slice : data.m_slices)
+  {
+    for (const auto& level : slice.m_levels)
+      total += level.data.size();
+  }
+  return total;
+}
+}  // namespace
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  TextureAndSamplerData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs don't have samplers!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  CustomTextureData* data)
+{
+  PackedTexture texture;
+  {
+    std::lock_guard lk(m_textures_lock);
+    const auto iter = m_textures.find(asset_id);
+    if (iter == m_textures.end())
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in any texture pack!", asset_id);
+      return {};
+    }
+    texture = iter->second;
+  }
+
+  if (!texture.pack->LoadTexture(texture.index, data))
+    return {};
+  if (!PurgeInvalidMipsFromTextureData(asset_id, data))
+    return {};
+
+  return LoadInfo{GetAssetSize(*data)};
+}
+
+CustomAssetLibrary::LoadInfo
+TexturePackAssetLibrary::LoadRasterSurfaceShader(const AssetID& asset_id, RasterSurfaceShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                   MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMesh(const AssetID& asset_id, MeshData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+void TexturePackAssetLibrary::SetAssetIDTexture(const AssetID& asset_id,
+                                                std::shared_ptr<const TexturePack> pack,
+                                                std::size_t index)
+{
+  std::lock_guard lk(m_textures_lock);
+  m_textures.insert_or_assign(asset_id, PackedTexture{std::move(pack), index});
+}
+
+bool TexturePackAssetLibrary::HasAsset(const AssetID& asset_id) const
+{
+  std::lock_guard lk(m_textures_lock);
+  return m_textures.contains(asset_id);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+
+namespace VideoCommon
+{
+class TexturePack;
+
+// This class implements 'CustomAssetLibrary' and loads textures out of texture packs.
+// Other kinds of assets aren't supported.
+class TexturePackAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureAndSamplerData* data) override;
+  LoadInfo LoadTexture(const AssetID& asset_id, CustomTextureData* data) override;
+  LoadInfo LoadRasterSurfaceShader(const AssetID& asset_id, RasterSurfaceShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+  LoadInfo LoadMesh(const AssetID& asset_id, MeshData* data) override;
+
+  // Assigns the asset id to the texture at the index of the pack.
+  void SetAssetIDTexture(const AssetID& asset_id, std::shared_ptr<const TexturePack> pack,
+                         std::size_t index);
+  bool HasAsset(const AssetID& asset_id) const;
+
+private:
+  struct PackedTexture
+  {
+    std::shared_ptr<const TexturePack> pack;
+    std::size_t index = 0;
+  };
+
+  mutable std::mutex m_textures_lock;
+  std::map<AssetID, PackedTexture> m_textures;
+};
+}  // namespace VideoCommon
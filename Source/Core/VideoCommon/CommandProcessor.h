@@ -33,11 +33,13 @@ struct SCPFifoStruct
   u32 CPLoWatermark = 0;
   std::atomic<u32> CPReadWriteDistance = 0;
   std::atomic<u32> CPWritePointer = 0;
-  std::atomic<u32> CPReadPointer = 0;
+  // In dual core mode, the read pointers are written by the GPU thread while the CPU thread writes
+  // the write pointer, so they are kept on separate cache lines.
+  alignas(64) std::atomic<u32> CPReadPointer = 0;
   std::atomic<u32> CPBreakpoint = 0;
   std::atomic<u32> SafeCPReadPointer = 0;
 
-  std::atomic<u32> bFF_GPLinkEnable = 0;
+  alignas(64) std::atomic<u32> bFF_GPLinkEnable = 0;
   std::atomic<u32> bFF_GPReadEnable = 0;
   std::atomic<u32> bFF_BPEnable = 0;
   std::atomic<u32> bFF_BPInt = 0;
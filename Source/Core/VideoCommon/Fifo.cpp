@@ -3,7 +3,9 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -13,6 +15,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -28,6 +31,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -35,6 +39,9 @@
 namespace Fifo
 {
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
+// Half of the video buffer, so that a batch fits next to the unprocessed data of the previous one.
+static constexpr int MAX_GPU_HANDOFF_BATCH_SIZE = 1024 * 1024;
+static_assert(MAX_GPU_HANDOFF_BATCH_SIZE % GPFifo::GATHER_PIPE_SIZE == 0);
 
 FifoManager::FifoManager(Core::System& system) : m_system{system}
 {
@@ -48,6 +55,22 @@ void FifoManager::RefreshConfig()
   m_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   m_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   m_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  m_config_adaptive_gpu_handoff = Config::Get(Config::MAIN_ADAPTIVE_GPU_HANDOFF);
+  m_config_gpu_handoff_max_batch_size = static_cast<u32>(
+      std::clamp(Config::Get(Config::MAIN_GPU_HANDOFF_MAX_BATCH_SIZE), 0,
+                 MAX_GPU_HANDOFF_BATCH_SIZE));
+
+  if (m_config_adaptive_gpu_handoff)
+  {
+    m_gpu_mainloop.SetSpinTime(
+        std::chrono::microseconds(std::max(Config::Get(Config::MAIN_GPU_HANDOFF_MIN_SPIN_TIME), 0)),
+        std::chrono::microseconds(
+            std::max(Config::Get(Config::MAIN_GPU_HANDOFF_MAX_SPIN_TIME), 0)));
+  }
+  else
+  {
+    m_gpu_mainloop.SetSpinTime({}, {});
+  }
 }
 
 void FifoManager::DoState(PointerWrap& p)
@@ -148,7 +171,12 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (m_use_deterministic_gpu_thread)
   {
-    m_gpu_mainloop.Wait();
+    if (!m_gpu_mainloop.IsDone())
+    {
+      const auto stall_start = std::chrono::steady_clock::now();
+      m_gpu_mainloop.Wait();
+      AddSyncStall(std::chrono::steady_clock::now() - stall_start);
+    }
     if (!m_gpu_mainloop.IsRunning())
       return;
 
@@ -211,17 +239,39 @@ void* FifoManager::PopFifoAuxBuffer(size_t size)
   return ret;
 }
 
+// Returns how many bytes of the FIFO the GPU thread should read at once. With the adaptive
+// handoff, as many gather pipe bursts as are available are read together, so that the read
+// pointer, the distance and the CP status are updated once for all of them instead of once each.
+u32 FifoManager::GetGpuReadSize(u32 read_ptr) const
+{
+  // Breakpoints, the low watermark interrupt, which the CPU waits on to write more data, and the
+  // budget of SyncGPU need to be checked after every burst.
+  const auto& fifo = m_system.GetCommandProcessor().GetFifo();
+  if (!m_config_adaptive_gpu_handoff || m_config_sync_gpu ||
+      fifo.bFF_BPEnable.load(std::memory_order_relaxed) ||
+      fifo.bFF_LoWatermarkInt.load(std::memory_order_relaxed))
+  {
+    return GPFifo::GATHER_PIPE_SIZE;
+  }
+
+  // Don't read past the end of the FIFO, where the read pointer wraps around.
+  const u32 size_until_end =
+      fifo.CPEnd.load(std::memory_order_relaxed) - read_ptr + GPFifo::GATHER_PIPE_SIZE;
+  const u32 size = std::min({fifo.CPReadWriteDistance.load(std::memory_order_relaxed),
+                             size_until_end, m_config_gpu_handoff_max_batch_size});
+  return std::max<u32>(size - size % GPFifo::GATHER_PIPE_SIZE, GPFifo::GATHER_PIPE_SIZE);
+}
+
 // Description: RunGpuLoop() sends data through this function.
-void FifoManager::ReadDataFromFifo(u32 read_ptr)
+void FifoManager::ReadDataFromFifo(u32 read_ptr, u32 size)
 {
-  if (GPFifo::GATHER_PIPE_SIZE >
-      static_cast<size_t>(m_video_buffer + FIFO_SIZE - m_video_buffer_write_ptr))
+  if (size > static_cast<size_t>(m_video_buffer + FIFO_SIZE - m_video_buffer_write_ptr))
   {
     const size_t existing_len = m_video_buffer_write_ptr - m_video_buffer_read_ptr;
-    if (GPFifo::GATHER_PIPE_SIZE > static_cast<size_t>(FIFO_SIZE - existing_len))
+    if (size > static_cast<size_t>(FIFO_SIZE - existing_len))
     {
-      PanicAlertFmt("FIFO out of bounds (existing {} + new {} > {})", existing_len,
-                    GPFifo::GATHER_PIPE_SIZE, FIFO_SIZE);
+      PanicAlertFmt("FIFO out of bounds (existing {} + new {} > {})", existing_len, size,
+                    FIFO_SIZE);
       return;
     }
     memmove(m_video_buffer, m_video_buffer_read_ptr, existing_len);
@@ -230,8 +280,8 @@ void FifoManager::ReadDataFromFifo(u32 read_ptr)
   }
   // Copy new video instructions to m_video_buffer for future use in rendering the new picture
   auto& memory = m_system.GetMemory();
-  memory.CopyFromEmu(m_video_buffer_write_ptr, read_ptr, GPFifo::GATHER_PIPE_SIZE);
-  m_video_buffer_write_ptr += GPFifo::GATHER_PIPE_SIZE;
+  memory.CopyFromEmu(m_video_buffer_write_ptr, read_ptr, size);
+  m_video_buffer_write_ptr += size;
 }
 
 // The deterministic_gpu_thread version.
@@ -289,6 +339,7 @@ void FifoManager::RunGpuLoop()
       [this] {
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
+        UpdateHandoffStatistics();
 
         // Do nothing while paused
         if (!m_emu_running_state.IsSet())
@@ -302,6 +353,7 @@ void FifoManager::RunGpuLoop()
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
+            TRACE_SCOPE("GPU", "RunFifo");
             m_video_buffer_read_ptr =
                 OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr);
             m_video_buffer_seen_ptr = write_ptr;
@@ -324,8 +376,11 @@ void FifoManager::RunGpuLoop()
 
             u32 cyclesExecuted = 0;
             u32 readPtr = fifo.CPReadPointer.load(std::memory_order_relaxed);
-            ReadDataFromFifo(readPtr);
+            const u32 read_size = GetGpuReadSize(readPtr);
+            ReadDataFromFifo(readPtr, read_size);
 
+            // Move on from the last burst that was read.
+            readPtr += read_size - GPFifo::GATHER_PIPE_SIZE;
             if (readPtr == fifo.CPEnd.load(std::memory_order_relaxed))
               readPtr = fifo.CPBase.load(std::memory_order_relaxed);
             else
@@ -333,18 +388,21 @@ void FifoManager::RunGpuLoop()
 
             const s32 distance =
                 static_cast<s32>(fifo.CPReadWriteDistance.load(std::memory_order_relaxed)) -
-                GPFifo::GATHER_PIPE_SIZE;
+                static_cast<s32>(read_size);
             ASSERT_MSG(COMMANDPROCESSOR, distance >= 0,
                        "Negative fifo.CPReadWriteDistance = {} in FIFO Loop !\nThat can produce "
                        "instability in the game. Please report it.",
                        distance);
 
             u8* write_ptr = m_video_buffer_write_ptr;
-            m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            {
+              TRACE_SCOPE("GPU", "RunFifo");
+              m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+                  DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            }
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
-            fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
+            fifo.CPReadWriteDistance.fetch_sub(read_size, std::memory_order_seq_cst);
             if ((write_ptr - m_video_buffer_read_ptr) == 0)
             {
               fifo.SafeCPReadPointer.store(fifo.CPReadPointer.load(std::memory_order_relaxed),
@@ -455,7 +513,8 @@ int FifoManager::RunGpuOnCpu(int ticks)
         Common::FPU::LoadDefaultSIMDState();
         reset_simd_state = true;
       }
-      ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
+      ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed),
+                       GPFifo::GATHER_PIPE_SIZE);
       u32 cycles = 0;
       m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
           DataReader(m_video_buffer_read_ptr, m_video_buffer_write_ptr), &cycles);
@@ -551,11 +610,42 @@ int FifoManager::WaitForGpuThread(int ticks)
 
   // Wait for GPU
   if (now >= m_config_sync_gpu_max_distance)
+  {
+    const auto stall_start = std::chrono::steady_clock::now();
     m_sync_wakeup_event.Wait();
+    AddSyncStall(std::chrono::steady_clock::now() - stall_start);
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
 
+void FifoManager::AddSyncStall(std::chrono::steady_clock::duration duration)
+{
+  m_sync_stall_count.fetch_add(1, std::memory_order_relaxed);
+  m_sync_stall_time_us.fetch_add(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count(),
+      std::memory_order_relaxed);
+}
+
+// Adds the counters of the handoff between the CPU and GPU threads to the statistics of the
+// current frame. Called from the GPU thread.
+void FifoManager::UpdateHandoffStatistics()
+{
+  const Common::BlockingLoop::Statistics loop_statistics = m_gpu_mainloop.TakeStatistics();
+  ADDSTAT(g_stats.this_frame.num_gpu_sleep_wakeups, loop_statistics.sleep_wakeups);
+  ADDSTAT(g_stats.this_frame.num_gpu_spin_wakeups, loop_statistics.spin_wakeups);
+  ADDSTAT(g_stats.this_frame.gpu_idle_us,
+          std::chrono::duration_cast<std::chrono::microseconds>(loop_statistics.idle_time).count());
+
+  if (m_sync_stall_count.load(std::memory_order_relaxed) != 0)
+  {
+    ADDSTAT(g_stats.this_frame.num_sync_stalls,
+            m_sync_stall_count.exchange(0, std::memory_order_relaxed));
+    ADDSTAT(g_stats.this_frame.sync_stall_us,
+            m_sync_stall_time_us.exchange(0, std::memory_order_relaxed));
+  }
+}
+
 void FifoManager::SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate)
 {
   ticks += cyclesLate;
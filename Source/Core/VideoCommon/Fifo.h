@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -78,10 +79,13 @@ public:
 
 private:
   void RefreshConfig();
-  void ReadDataFromFifo(u32 read_ptr);
+  u32 GetGpuReadSize(u32 read_ptr) const;
+  void ReadDataFromFifo(u32 read_ptr, u32 size);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
   int RunGpuOnCpu(int ticks);
   int WaitForGpuThread(int ticks);
+  void AddSyncStall(std::chrono::steady_clock::duration duration);
+  void UpdateHandoffStatistics();
   static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate);
 
   static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
@@ -103,9 +107,11 @@ private:
 
   // STATE_TO_SAVE
   u8* m_video_buffer = nullptr;
-  u8* m_video_buffer_read_ptr = nullptr;
-  std::atomic<u8*> m_video_buffer_write_ptr = nullptr;
+  // The pointers written by the GPU thread and the ones written by the CPU thread in deterministic
+  // GPU thread mode are kept on separate cache lines.
+  alignas(64) u8* m_video_buffer_read_ptr = nullptr;
   std::atomic<u8*> m_video_buffer_seen_ptr = nullptr;
+  alignas(64) std::atomic<u8*> m_video_buffer_write_ptr = nullptr;
   u8* m_video_buffer_pp_read_ptr = nullptr;
   // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
   // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
@@ -119,15 +125,22 @@ private:
   // polls, it's just atomic.
   // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
-  std::atomic<int> m_sync_ticks = 0;
+  alignas(64) std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
   Common::Event m_sync_wakeup_event;
 
+  // Time the CPU thread spent waiting for the GPU thread, until it is added to the statistics by
+  // the GPU thread.
+  std::atomic<int> m_sync_stall_count = 0;
+  std::atomic<s64> m_sync_stall_time_us = 0;
+
   std::optional<Config::ConfigChangedCallbackID> m_config_callback_id = std::nullopt;
   bool m_config_sync_gpu = false;
   int m_config_sync_gpu_max_distance = 0;
   int m_config_sync_gpu_min_distance = 0;
   float m_config_sync_gpu_overclock = 0.0f;
+  bool m_config_adaptive_gpu_handoff = false;
+  u32 m_config_gpu_handoff_max_batch_size = 0;
 
   Core::System& m_system;
 };
@@ -0,0 +1,104 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameDumpImageEncoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Image.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/FrameDumpFFMpeg.h"
+
+// Frames that may wait for an encoder before adding a frame blocks, per encoder.
+static constexpr u32 FRAMES_IN_FLIGHT_PER_ENCODER = 2;
+
+FrameDumpImageEncoder::FrameDumpImageEncoder(u32 num_encoders, SaveFunction save)
+    : m_save(std::move(save)), m_max_frames_in_flight(num_encoders * FRAMES_IN_FLIGHT_PER_ENCODER)
+{
+  for (u32 i = 0; i < num_encoders; ++i)
+  {
+    m_encoders.push_back(std::make_unique<Common::WorkQueueThreadSP<Job>>(
+        fmt::format("Frame Dump Encoder {}", i),
+        std::bind_front(&FrameDumpImageEncoder::Encode, this)));
+  }
+}
+
+FrameDumpImageEncoder::~FrameDumpImageEncoder()
+{
+  // Shutting the encoders down waits for the frames that are still queued.
+  m_encoders.clear();
+}
+
+void FrameDumpImageEncoder::AddFrame(std::string file_name, const FrameData& frame)
+{
+  if (m_frames_in_flight.load() >= m_max_frames_in_flight)
+  {
+    ++m_frames_stalled;
+    while (m_frames_in_flight.load() >= m_max_frames_in_flight)
+      m_frame_encoded.Wait();
+  }
+
+  Job job{std::move(file_name), {}, static_cast<u32>(frame.width),
+          static_cast<u32>(frame.height)};
+  {
+    std::lock_guard lk(m_buffer_lock);
+    if (!m_free_buffers.empty())
+    {
+      job.rgb_data = std::move(m_free_buffers.back());
+      m_free_buffers.pop_back();
+    }
+    else
+    {
+      ++m_buffers_created;
+    }
+  }
+
+  job.rgb_data.resize(static_cast<size_t>(job.width) * job.height * 3);
+  Common::ConvertRGBAToRGB(job.rgb_data.data(), frame.data, job.width, job.height, frame.stride);
+
+  const u32 in_flight = ++m_frames_in_flight;
+  m_peak_frames_in_flight = std::max(m_peak_frames_in_flight.load(), in_flight);
+  ++m_frames_queued;
+
+  // Distributing the frames in turn keeps the encoders equally busy.
+  m_encoders[m_next_encoder]->Push(std::move(job));
+  m_next_encoder = (m_next_encoder + 1) % m_encoders.size();
+}
+
+void FrameDumpImageEncoder::WaitForIdle()
+{
+  while (m_frames_in_flight.load() != 0)
+    m_frame_encoded.Wait();
+}
+
+FrameDumpImageEncoder::Stats FrameDumpImageEncoder::GetStats() const
+{
+  return {
+      .frames_queued = m_frames_queued.load(),
+      .frames_failed = m_frames_failed.load(),
+      .frames_stalled = m_frames_stalled.load(),
+      .peak_frames_in_flight = m_peak_frames_in_flight.load(),
+      .max_frames_in_flight = m_max_frames_in_flight,
+      .buffers_created = m_buffers_created.load(),
+  };
+}
+
+void FrameDumpImageEncoder::Encode(Job job)
+{
+  if (!m_save(job.file_name, job.rgb_data, job.width, job.height))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Failed to save frame to {}", job.file_name);
+    ++m_frames_failed;
+  }
+
+  {
+    std::lock_guard lk(m_buffer_lock);
+    m_free_buffers.push_back(std::move(job.rgb_data));
+  }
+
+  --m_frames_in_flight;
+  m_frame_encoded.Set();
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/WorkQueueThread.h"
+
+struct FrameData;
+
+// PNG compression of a single frame can take longer than emulating it, so frames that are dumped
+// as images are encoded on several threads. Each frame has its own file, so the output stays in
+// order even though the frames finish out of order.
+//
+// Frames must be added from a single thread.
+class FrameDumpImageEncoder
+{
+public:
+  // Writes the RGB data of a frame to the given file. Called on the encoder threads.
+  using SaveFunction = std::function<bool(const std::string& file_name,
+                                          std::span<const u8> rgb_data, u32 width, u32 height)>;
+
+  struct Stats
+  {
+    u32 frames_queued = 0;
+    u32 frames_failed = 0;
+    // Frames that had to wait for an encoder, which blocks the emulation.
+    u32 frames_stalled = 0;
+    u32 peak_frames_in_flight = 0;
+    u32 max_frames_in_flight = 0;
+    // RGB buffers that had to be created because no encoded frame's buffer was free.
+    u32 buffers_created = 0;
+  };
+
+  FrameDumpImageEncoder(u32 num_encoders, SaveFunction save);
+  // Waits for the frames that are still queued.
+  ~FrameDumpImageEncoder();
+
+  // Copies the frame, so that its data can be reused as soon as this returns, and queues it to be
+  // saved to the given file. Only blocks when all encoders are busy.
+  void AddFrame(std::string file_name, const FrameData& frame);
+
+  // Waits until all added frames are saved.
+  void WaitForIdle();
+
+  Stats GetStats() const;
+
+private:
+  struct Job
+  {
+    std::string file_name;
+    std::vector<u8> rgb_data;
+    u32 width;
+    u32 height;
+  };
+
+  // Called on the encoder threads.
+  void Encode(Job job);
+
+  SaveFunction m_save;
+  std::vector<std::unique_ptr<Common::WorkQueueThreadSP<Job>>> m_encoders;
+  u32 m_next_encoder = 0;
+
+  const u32 m_max_frames_in_flight;
+  std::atomic<u32> m_frames_in_flight = 0;
+  Common::Event m_frame_encoded;
+
+  // RGB buffers of encoded frames, which are reused for the next frames.
+  std::mutex m_buffer_lock;
+  std::vector<std::vector<u8>> m_free_buffers;
+
+  std::atomic<u32> m_frames_queued = 0;
+  std::atomic<u32> m_frames_failed = 0;
+  std::atomic<u32> m_frames_stalled = 0;
+  std::atomic<u32> m_peak_frames_in_flight = 0;
+  std::atomic<u32> m_buffers_created = 0;
+};
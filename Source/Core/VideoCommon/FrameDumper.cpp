@@ -3,6 +3,12 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -20,6 +26,8 @@
 // The video encoder needs the image to be a multiple of x samples.
 static constexpr int VIDEO_ENCODER_LCM = 4;
 
+static constexpr u32 MAX_IMAGE_ENCODERS = 8;
+
 static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
 {
   return Common::ConvertRGBAToRGBAndSavePNG(file_name, frame.data, frame.width, frame.height,
@@ -263,9 +271,10 @@ void FrameDumper::FrameDumpThreadFunc()
 
   if (frame_dump_started)
   {
-    // No additional cleanup is needed when dumping to images.
     if (dump_to_ffmpeg)
       StopFrameDumpToFFMPEG();
+    else
+      StopFrameDumpToImage();
   }
 }
 
@@ -329,15 +338,44 @@ bool FrameDumper::StartFrameDumpToImage(const FrameData&)
     }
   }
 
+  const bool fast_filtering = Config::Get(Config::GFX_DUMP_FRAMES_FAST_PNG);
+  const int compression_level =
+      fast_filtering ? 1 : Config::Get(Config::GFX_PNG_COMPRESSION_LEVEL);
+  const u32 num_encoders = std::clamp(std::thread::hardware_concurrency() / 2, 1u,
+                                      MAX_IMAGE_ENCODERS);
+  m_image_encoder = std::make_unique<FrameDumpImageEncoder>(
+      num_encoders, [compression_level, fast_filtering](const std::string& file_name,
+                                                         std::span<const u8> rgb_data, u32 width,
+                                                         u32 height) {
+        return Common::SavePNG(file_name, rgb_data.data(), Common::ImageByteFormat::RGB, width,
+                               height, width * 3, compression_level, fast_filtering);
+      });
+
   return true;
 }
 
 void FrameDumper::DumpFrameToImage(const FrameData& frame)
 {
-  DumpFrameToPNG(frame, GetFrameDumpNextImageFileName());
+  m_image_encoder->AddFrame(GetFrameDumpNextImageFileName(), frame);
   m_frame_dump_image_counter++;
 }
 
+void FrameDumper::StopFrameDumpToImage()
+{
+  m_image_encoder->WaitForIdle();
+  const FrameDumpImageEncoder::Stats stats = m_image_encoder->GetStats();
+  m_image_encoder.reset();
+
+  INFO_LOG_FMT(FRAMEDUMP,
+               "Frame dump: {} frames queued, {} failed, {} waited for an encoder, "
+               "at most {} of {} in flight",
+               stats.frames_queued, stats.frames_failed, stats.frames_stalled,
+               stats.peak_frames_in_flight, stats.max_frames_in_flight);
+  if (stats.frames_failed != 0)
+    OSD::AddMessage(fmt::format("Frame dump: {} of {} frames could not be saved",
+                                stats.frames_failed, stats.frames_queued));
+}
+
 void FrameDumper::SaveScreenshot(std::string filename)
 {
   std::lock_guard<std::mutex> lk(m_screenshot_lock);
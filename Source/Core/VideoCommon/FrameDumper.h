@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
@@ -10,6 +14,7 @@
 #include "Common/Thread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
+#include "VideoCommon/FrameDumpImageEncoder.h"
 #include "VideoCommon/VideoEvents.h"
 
 class AbstractStagingTexture;
@@ -46,6 +51,7 @@ private:
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameData&);
   void DumpFrameToImage(const FrameData&);
+  void StopFrameDumpToImage();
 
   void ShutdownFrameDumping();
 
@@ -91,6 +97,8 @@ private:
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
+  std::unique_ptr<FrameDumpImageEncoder> m_image_encoder;
+
   FFMpegFrameDump m_ffmpeg_dump;
 
   // Screenshots
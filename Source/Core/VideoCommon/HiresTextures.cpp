@@ -19,6 +19,8 @@
 #include "Core/ConfigManager.h"
 #include "Core/System.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePack.h"
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/Resources/CustomResourceManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -29,9 +31,44 @@ static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_te
 static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+static auto s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 
 namespace
 {
+void PreloadTexture(bool has_arbitrary_mipmaps, std::string id)
+{
+  auto hires_texture = std::make_shared<HiresTexture>(has_arbitrary_mipmaps, std::move(id));
+  static_cast<void>(hires_texture->LoadTexture());
+  s_hires_texture_cache.try_emplace(hires_texture->GetId(), hires_texture);
+}
+
+// Textures of packs are added after loose files, so that a file can replace a packed texture.
+void AddTexturePacks(const std::string& texture_directory)
+{
+  for (const std::string& path : Common::DoFileSearch(
+           texture_directory, VideoCommon::TexturePack::EXTENSION, /*recursive*/ true))
+  {
+    auto pack = std::make_shared<VideoCommon::TexturePack>();
+    if (!pack->Open(path))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to open texture pack '{}'", path);
+      continue;
+    }
+
+    for (std::size_t i = 0; i < pack->GetTextureCount(); i++)
+    {
+      std::string id(pack->GetTextureName(i));
+      const bool has_arbitrary_mipmaps = pack->HasArbitraryMipmaps(i);
+      if (!s_hires_texture_id_to_arbmipmap.try_emplace(id, has_arbitrary_mipmaps).second)
+        continue;
+
+      s_pack_library->SetAssetIDTexture(id, pack, i);
+      if (g_ActiveConfig.bCacheHiresTextures)
+        PreloadTexture(has_arbitrary_mipmaps, std::move(id));
+    }
+  }
+}
+
 std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
 {
   if (s_hires_texture_id_to_arbmipmap.empty())
@@ -123,12 +160,7 @@ void HiresTexture::Update()
                                                           {"texture", StringToPath(path)}});
 
           if (g_ActiveConfig.bCacheHiresTextures)
-          {
-            auto hires_texture =
-                std::make_shared<HiresTexture>(has_arbitrary_mipmaps, std::move(filename));
-            static_cast<void>(hires_texture->LoadTexture());
-            s_hires_texture_cache.try_emplace(hires_texture->GetId(), hires_texture);
-          }
+            PreloadTexture(has_arbitrary_mipmaps, std::move(filename));
         }
       }
     }
@@ -140,6 +172,9 @@ void HiresTexture::Update()
     }
   }
 
+  for (const auto& texture_directory : texture_directories)
+    AddTexturePacks(texture_directory);
+
   const std::vector<std::string> game_ids_for_textures =
       SConfig::GetInstance().GetGameIDsForTextures();
   const std::string game_id_display = fmt::format("{}", fmt::join(game_ids_for_textures, "' or '"));
@@ -163,6 +198,7 @@ void HiresTexture::Clear()
   s_hires_texture_cache.clear();
   s_hires_texture_id_to_arbmipmap.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
@@ -195,6 +231,8 @@ VideoCommon::TextureDataResource* HiresTexture::LoadTexture() const
 {
   auto& system = Core::System::GetInstance();
   auto& custom_resource_manager = system.GetCustomResourceManager();
+  if (s_pack_library->HasAsset(m_id))
+    return custom_resource_manager.GetTextureDataFromAsset(m_id, s_pack_library);
   return custom_resource_manager.GetTextureDataFromAsset(m_id, s_file_library);
 }
 
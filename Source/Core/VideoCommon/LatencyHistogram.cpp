@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+static constexpr u64 HALF_SUB_BUCKETS = u64{1} << (LatencyHistogram::SUB_BUCKET_BITS - 1);
+
+size_t LatencyHistogram::GetBucketIndex(u64 value_us)
+{
+  if (value_us < 2 * HALF_SUB_BUCKETS)
+    return static_cast<size_t>(value_us);
+
+  // Values with the same magnitude share SUB_BUCKET_BITS - 1 buckets.
+  const u64 shift = std::bit_width(value_us) - SUB_BUCKET_BITS;
+  return static_cast<size_t>(shift * HALF_SUB_BUCKETS + (value_us >> shift));
+}
+
+u64 LatencyHistogram::GetBucketMaxValue(size_t index)
+{
+  if (index < 2 * HALF_SUB_BUCKETS)
+    return index;
+
+  const u64 shift = index / HALF_SUB_BUCKETS - 1;
+  const u64 mantissa = index - shift * HALF_SUB_BUCKETS;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(DT value)
+{
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+  const u64 value_us = static_cast<u64>(std::max<s64>(us, 0));
+
+  m_buckets[GetBucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+
+  u64 max = m_max_us.load(std::memory_order_relaxed);
+  while (value_us > max)
+  {
+    if (m_max_us.compare_exchange_weak(max, value_us, std::memory_order_relaxed))
+      break;
+  }
+}
+
+LatencyHistogram::Percentiles LatencyHistogram::TakePercentiles()
+{
+  std::array<u32, NUM_BUCKETS> counts;
+  u64 total = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+  {
+    counts[i] = m_buckets[i].exchange(0, std::memory_order_relaxed);
+    total += counts[i];
+  }
+  const u64 max_us = m_max_us.exchange(0, std::memory_order_relaxed);
+
+  Percentiles result;
+  result.count = total;
+  if (total == 0)
+    return result;
+
+  const auto to_dt = [](u64 us) {
+    return std::chrono::duration_cast<DT>(std::chrono::microseconds(us));
+  };
+
+  const auto value_at = [&](double percentile) {
+    const u64 rank = std::max<u64>(1, static_cast<u64>(std::ceil(percentile * total)));
+    u64 seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      seen += counts[i];
+      if (seen >= rank)
+        return to_dt(std::min(GetBucketMaxValue(i), max_us));
+    }
+    return to_dt(max_us);
+  };
+
+  result.p50 = value_at(0.50);
+  result.p95 = value_at(0.95);
+  result.p99 = value_at(0.99);
+  result.max = to_dt(max_us);
+  return result;
+}
+
+void LatencyHistogram::Reset()
+{
+  for (auto& bucket : m_buckets)
+    bucket.store(0, std::memory_order_relaxed);
+  m_max_us.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+// Counts durations in logarithmic buckets, like an HDR histogram, so that percentiles can be
+// reported without keeping every sample. Each bucket is at most 1/32 as wide as the values it
+// holds, so percentiles are accurate to about 3%, from 1 microsecond to hours.
+//
+// Record may be called from one thread while another one takes the percentiles.
+class LatencyHistogram
+{
+public:
+  struct Percentiles
+  {
+    u64 count = 0;
+    DT p50{};
+    DT p95{};
+    DT p99{};
+    DT max{};
+  };
+
+  void Record(DT value);
+
+  // Returns the percentiles of the values recorded since the previous call, and starts over.
+  Percentiles TakePercentiles();
+
+  void Reset();
+
+  static constexpr u32 SUB_BUCKET_BITS = 6;
+  static constexpr size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+  static size_t GetBucketIndex(u64 value_us);
+  // Returns the largest value that falls into the bucket.
+  static u64 GetBucketMaxValue(size_t index);
+
+private:
+  std::array<std::atomic<u32>, NUM_BUCKETS> m_buckets{};
+  std::atomic<u64> m_max_us = 0;
+};
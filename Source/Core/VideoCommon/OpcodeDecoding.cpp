@@ -157,7 +157,7 @@ public:
       if constexpr (is_preprocess)
       {
         auto& memory = system.GetMemory();
-        const u8* const start_address = memory.GetPointerForRange(address, size);
+        const u8* const start_address = memory.GetReadPointerForRange(address, size);
 
         system.GetFifo().PushFifoAuxBuffer(start_address, size);
 
@@ -178,10 +178,10 @@ public:
         else
         {
           auto& memory = system.GetMemory();
-          start_address = memory.GetPointerForRange(address, size);
+          start_address = memory.GetReadPointerForRange(address, size);
         }
 
-        // Avoid the crash if memory.GetPointerForRange failed ..
+        // Avoid the crash if memory.GetReadPointerForRange failed ..
         if (start_address != nullptr)
         {
           // temporarily swap dl and non-dl (small "hack" for the stats)
@@ -4,15 +4,22 @@
 #include "VideoCommon/PerformanceMetrics.h"
 
 #include <algorithm>
+#include <iomanip>
+#include <utility>
 
 #include <imgui.h>
 #include <implot.h>
 
+#include "Common/FileUtil.h"
 #include "Common/HookableEvent.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/Core.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
+// A frame that takes this many times longer than the average frame is logged as a stutter.
+static constexpr int STUTTER_FACTOR = 2;
+
 PerformanceMetrics::PerformanceMetrics()
 {
   const auto invalidate_counters_last_time = [this](Core::State) {
@@ -34,21 +41,40 @@ void PerformanceMetrics::Reset()
   m_max_speed = 0;
 
   m_frame_presentation_offset = DT{};
+
+  m_frame_time_histogram.Reset();
+  m_vblank_time_histogram.Reset();
+  m_present_latency_histogram.Reset();
+  m_throttle_sleep_histogram.Reset();
+
+  m_start_time = Clock::now();
+  m_last_report_time = m_start_time;
+  m_report_file.close();
+  m_stutter_file.close();
+  m_frame_time_avg = DT{};
 }
 
 void PerformanceMetrics::CountFrame()
 {
-  m_fps_counter.Count();
+  const std::optional<DT> frame_time = m_fps_counter.Count();
+  if (!frame_time)
+    return;
+
+  m_frame_time_histogram.Record(*frame_time);
+  if (g_ActiveConfig.iPerfReportInterval > 0)
+    CheckForStutter(*frame_time);
 }
 
 void PerformanceMetrics::CountVBlank()
 {
-  m_vps_counter.Count();
+  if (const std::optional<DT> vblank_time = m_vps_counter.Count())
+    m_vblank_time_histogram.Record(*vblank_time);
 }
 
 void PerformanceMetrics::CountThrottleSleep(DT sleep)
 {
   m_time_sleeping += sleep;
+  m_throttle_sleep_histogram.Record(sleep);
 }
 
 void PerformanceMetrics::AdjustClockSpeed(s64 ticks, u32 new_ppc_clock, u32 old_ppc_clock)
@@ -68,6 +94,13 @@ void PerformanceMetrics::CountPerformanceMarker(s64 core_ticks, u32 ticks_per_se
   m_samples.emplace_back(
       PerfSample{.clock_time = clock_time, .work_time = work_time, .core_ticks = core_ticks});
 
+  const int report_interval = g_ActiveConfig.iPerfReportInterval;
+  if (report_interval > 0 &&
+      clock_time - m_last_report_time >= std::chrono::seconds{report_interval})
+  {
+    WriteReport(clock_time);
+  }
+
   const auto sample_window = std::chrono::microseconds{g_ActiveConfig.iPerfSampleUSec};
   while (clock_time - m_samples.front().clock_time > sample_window)
     m_samples.pop_front();
@@ -106,6 +139,7 @@ double PerformanceMetrics::GetMaxSpeed() const
 void PerformanceMetrics::SetLatestFramePresentationOffset(DT offset)
 {
   m_frame_presentation_offset.store(offset, std::memory_order_relaxed);
+  m_present_latency_histogram.Record(std::max(offset, DT::zero()));
 }
 
 void PerformanceMetrics::SetLatestFrameBufferSize(u32 width, u32 height)
@@ -113,6 +147,78 @@ void PerformanceMetrics::SetLatestFrameBufferSize(u32 width, u32 height)
   m_frame_buffer_size.store(FrameBufferSize{width, height}, std::memory_order_relaxed);
 }
 
+void PerformanceMetrics::WriteReport(TimePoint now)
+{
+  m_last_report_time = now;
+
+  if (!m_report_file.is_open())
+  {
+    File::OpenFStream(m_report_file, File::GetUserPath(D_LOGS_IDX) + "perf_report.csv",
+                      std::ios_base::out);
+    m_report_file << "time_s,metric,count,p50_ms,p95_ms,p99_ms,max_ms\n";
+  }
+
+  const double time = DT_s(now - m_start_time).count();
+  const std::pair<const char*, LatencyHistogram*> histograms[] = {
+      {"frame_time", &m_frame_time_histogram},
+      {"vblank_time", &m_vblank_time_histogram},
+      {"present_latency", &m_present_latency_histogram},
+      {"throttle_sleep", &m_throttle_sleep_histogram},
+  };
+  for (const auto& [name, histogram] : histograms)
+  {
+    const LatencyHistogram::Percentiles percentiles = histogram->TakePercentiles();
+    m_report_file << std::fixed << std::setprecision(3) << time << ',' << name << ','
+                  << percentiles.count << ',' << DT_ms(percentiles.p50).count() << ','
+                  << DT_ms(percentiles.p95).count() << ',' << DT_ms(percentiles.p99).count()
+                  << ',' << DT_ms(percentiles.max).count() << '\n';
+  }
+  m_report_file.flush();
+}
+
+void PerformanceMetrics::CheckForStutter(DT frame_time)
+{
+  const int shaders_created =
+      g_stats.num_pixel_shaders_created + g_stats.num_vertex_shaders_created;
+  const int shaders_compiled = std::max(0, shaders_created - m_last_shaders_created);
+  const int textures_created = std::max(0, g_stats.num_textures_created - m_last_textures_created);
+  m_last_shaders_created = shaders_created;
+  m_last_textures_created = g_stats.num_textures_created;
+
+  // The average starts at the first frame time, rather than ramping up from zero and making the
+  // first frames look like stutters.
+  if (m_frame_time_avg == DT::zero())
+  {
+    m_frame_time_avg = frame_time;
+    return;
+  }
+
+  const DT average = m_frame_time_avg;
+  m_frame_time_avg += (frame_time - m_frame_time_avg) / 16;
+  if (frame_time < average * STUTTER_FACTOR)
+    return;
+
+  // Work done on the GPU thread during the frame is the most likely cause. Anything else happened
+  // on the CPU thread, which a trace (see Common/Tracing.h) can break down further.
+  const char* subsystem = "emulation";
+  if (shaders_compiled != 0)
+    subsystem = "shader_compilation";
+  else if (textures_created != 0)
+    subsystem = "texture_loading";
+
+  if (!m_stutter_file.is_open())
+  {
+    File::OpenFStream(m_stutter_file, File::GetUserPath(D_LOGS_IDX) + "stutter_events.csv",
+                      std::ios_base::out);
+    m_stutter_file << "time_s,frame_ms,average_ms,shaders_compiled,textures_created,subsystem\n";
+  }
+
+  m_stutter_file << std::fixed << std::setprecision(3) << DT_s(Clock::now() - m_start_time).count()
+                 << ',' << DT_ms(frame_time).count() << ',' << DT_ms(average).count() << ','
+                 << shaders_compiled << ',' << textures_created << ',' << subsystem << '\n';
+  m_stutter_file.flush();
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   m_vps_counter.UpdateStats();
@@ -5,9 +5,11 @@
 
 #include <atomic>
 #include <deque>
+#include <fstream>
 
 #include "Common/CommonTypes.h"
 #include "Common/HookableEvent.h"
+#include "VideoCommon/LatencyHistogram.h"
 #include "VideoCommon/PerformanceTracker.h"
 
 namespace Core
@@ -57,6 +59,11 @@ private:
     u32 height;
   };
 
+  // Call from CPU thread.
+  void WriteReport(TimePoint now);
+  // Call from GPU thread.
+  void CheckForStutter(DT frame_time);
+
   PerformanceTracker m_fps_counter{"render_times.txt"};
   PerformanceTracker m_vps_counter{"vblank_times.txt"};
 
@@ -78,5 +85,23 @@ private:
   std::deque<PerfSample> m_samples;
   DT m_time_sleeping{};
 
+  // Percentiles of these are written to the report every GFX_PERF_REPORT_INTERVAL seconds.
+  LatencyHistogram m_frame_time_histogram;
+  LatencyHistogram m_vblank_time_histogram;
+  LatencyHistogram m_present_latency_histogram;
+  LatencyHistogram m_throttle_sleep_histogram;
+
+  TimePoint m_start_time{};
+
+  // Used from the CPU thread.
+  std::ofstream m_report_file;
+  TimePoint m_last_report_time{};
+
+  // Used from the GPU thread.
+  std::ofstream m_stutter_file;
+  DT m_frame_time_avg{};
+  int m_last_shaders_created = 0;
+  int m_last_textures_created = 0;
+
   Common::EventHook m_state_change_hook;
 };
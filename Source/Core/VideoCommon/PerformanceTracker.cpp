@@ -40,7 +40,7 @@ void PerformanceTracker::Reset()
   m_is_last_time_sane = false;
 }
 
-void PerformanceTracker::Count()
+std::optional<DT> PerformanceTracker::Count()
 {
   const TimePoint current_time{Clock::now()};
 
@@ -50,11 +50,12 @@ void PerformanceTracker::Count()
   if (!m_is_last_time_sane)
   {
     m_is_last_time_sane = true;
-    return;
+    return std::nullopt;
   }
 
   m_last_raw_dt = diff;
   m_raw_dts.Push(diff);
+  return diff;
 }
 
 void PerformanceTracker::UpdateStats()
@@ -31,7 +31,8 @@ public:
   void ImPlotPlotLines(const char* label) const;
 
   // May call from any thread, but not concurrently, not that you'd want to..
-  void Count();
+  // Returns the time since the previous call, unless that time isn't meaningful.
+  std::optional<DT> Count();
 
   // May call from any thread.
   DT GetSampleWindow() const;
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/PixelShaderGen.h"
 
+#include <tuple>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
@@ -319,8 +321,8 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   uid_data->bounding_box &= host_config.bounding_box && host_config.backend_bbox;
 }
 
-void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box)
+static void WriteCommonHeader(ShaderCode& out, APIType api_type,
+                              const ShaderHostConfig& host_config, bool bounding_box)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -727,6 +729,18 @@ uint WrapCoord(int coord, uint wrap, int size) {{
   }
 }
 
+void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                  const ShaderHostConfig& host_config, bool bounding_box)
+{
+  // The header is shared by all pixel shaders and ubershaders with the same configuration.
+  static ShaderCodeFragmentCache<std::tuple<APIType, u32, bool, bool, bool>> s_headers;
+  const bool texture_query_levels = g_backend_info.bSupportsTextureQueryLevels;
+  const bool coarse_derivatives = g_backend_info.bSupportsCoarseDerivatives;
+  out.WriteRaw(s_headers.Get(
+      {api_type, host_config.bits, bounding_box, texture_query_levels, coarse_derivatives},
+      [&](ShaderCode& code) { WriteCommonHeader(code, api_type, host_config, bounding_box); }));
+}
+
 static void WriteStage(ShaderCode& out, const pixel_shader_uid_data* uid_data, int n,
                        APIType api_type, bool stereo);
 static void WriteTevRegular(ShaderCode& out, std::string_view components, TevBias bias, TevOp op,
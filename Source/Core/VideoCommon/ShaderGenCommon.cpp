@@ -10,6 +10,43 @@
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
+namespace
+{
+constexpr size_t SHADER_CODE_INITIAL_SIZE = 16384;
+// Ubershaders are the largest generated shaders, at around 100 KiB. Buffers that grew larger than
+// this limit, e.g. for a custom shader, aren't kept.
+constexpr size_t MAX_RECYCLED_SHADER_CODE_SIZE = 1024 * 1024;
+constexpr size_t MAX_RECYCLED_SHADER_CODE_BUFFERS = 4;
+
+thread_local std::vector<std::string> s_recycled_shader_code_buffers;
+}  // namespace
+
+ShaderCode::ShaderCode()
+{
+  if (s_recycled_shader_code_buffers.empty())
+  {
+    m_buffer.reserve(SHADER_CODE_INITIAL_SIZE);
+    return;
+  }
+
+  m_buffer = std::move(s_recycled_shader_code_buffers.back());
+  s_recycled_shader_code_buffers.pop_back();
+}
+
+ShaderCode::~ShaderCode()
+{
+  // Moved-from objects have no buffer left to recycle.
+  if (m_buffer.capacity() < SHADER_CODE_INITIAL_SIZE ||
+      m_buffer.capacity() > MAX_RECYCLED_SHADER_CODE_SIZE ||
+      s_recycled_shader_code_buffers.size() >= MAX_RECYCLED_SHADER_CODE_BUFFERS)
+  {
+    return;
+  }
+
+  m_buffer.clear();
+  s_recycled_shader_code_buffers.push_back(std::move(m_buffer));
+}
+
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
   ShaderHostConfig bits = {};
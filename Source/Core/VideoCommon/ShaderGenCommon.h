@@ -6,6 +6,8 @@
 #include <cstring>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -105,7 +107,16 @@ private:
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  // Buffers are taken from and returned to a per-thread pool, so that generating many shaders
+  // in a row doesn't allocate and grow a new buffer for each one.
+  ShaderCode();
+  ~ShaderCode();
+
+  ShaderCode(const ShaderCode&) = default;
+  ShaderCode& operator=(const ShaderCode&) = default;
+  ShaderCode(ShaderCode&&) = default;
+  ShaderCode& operator=(ShaderCode&&) = default;
+
   const std::string& GetBuffer() const { return m_buffer; }
 
   // Writes format strings using fmtlib format strings.
@@ -115,10 +126,40 @@ public:
     fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
   }
 
+  // Writes text as is. Unlike with Write, braces don't need to be escaped.
+  void WriteRaw(std::string_view text) { m_buffer.append(text); }
+
 protected:
   std::string m_buffer;
 };
 
+// Remembers pieces of shader code that only depend on a few parameters, like the API type or parts
+// of the host config, so that they aren't generated again for every shader UID. Key must include
+// everything that the generated code depends on.
+template <typename Key>
+class ShaderCodeFragmentCache
+{
+public:
+  template <typename Generator>
+  const std::string& Get(const Key& key, Generator&& generate)
+  {
+    std::lock_guard lk(m_mutex);
+    auto it = m_fragments.find(key);
+    if (it == m_fragments.end())
+    {
+      ShaderCode code;
+      generate(code);
+      it = m_fragments.emplace(key, code.GetBuffer()).first;
+    }
+    // Fragments are never removed, so the reference stays valid.
+    return it->second;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::map<Key, std::string> m_fragments;
+};
+
 /**
  * Generates a shader constant profile which can be used to query which constants are used in a
  * shader
@@ -3,15 +3,24 @@
 
 #include "VideoCommon/Spirv.h"
 
+#include <algorithm>
 #include <fstream>
+#include <memory>
+#include <mutex>
 
+#include <fmt/format.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
 
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
 #include "Common/Version.h"
 
+#include "Core/Config/GraphicsSettings.h"
+
+#include "VideoCommon/SpirvCache.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -157,10 +166,13 @@ const TBuiltInResource* GetCompilerResourceLimits()
 }
 
 std::optional<SPIRV::CodeVector>
-CompileShaderToSPV(EShLanguage stage, APIType api_type,
-                   glslang::EShTargetLanguageVersion language_version, const char* stage_filename,
-                   std::string_view source, glslang::TShader::Includer* shader_includer)
+CompileShaderToSPVUncached(EShLanguage stage, APIType api_type,
+                           glslang::EShTargetLanguageVersion language_version,
+                           const char* stage_filename, std::string_view source,
+                           glslang::TShader::Includer* shader_includer)
 {
+  TRACE_SCOPE("Shader", "glslang");
+
   if (!InitializeGlslang())
     return std::nullopt;
 
@@ -272,6 +284,60 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
 
   return out_code;
 }
+
+std::mutex s_compile_cache_mutex;
+std::unique_ptr<SPIRV::CompileCache> s_compile_cache;
+bool s_compile_cache_initialized = false;
+
+std::string GetCompileCacheFileName()
+{
+  return File::GetUserPath(D_SHADERCACHE_IDX) + "SPIRV.cache";
+}
+
+SPIRV::CompileCache* GetCompileCache()
+{
+  std::lock_guard lk(s_compile_cache_mutex);
+  if (!s_compile_cache_initialized)
+  {
+    s_compile_cache_initialized = true;
+    const u64 max_size = u64(std::max(Config::Get(Config::GFX_SPIRV_CACHE_SIZE), 0)) << 20;
+    if (g_ActiveConfig.bShaderCache && max_size != 0)
+    {
+      s_compile_cache = std::make_unique<SPIRV::CompileCache>(max_size);
+      s_compile_cache->Load(GetCompileCacheFileName());
+    }
+  }
+  return s_compile_cache.get();
+}
+
+std::optional<SPIRV::CodeVector>
+CompileShaderToSPV(EShLanguage stage, APIType api_type,
+                   glslang::EShTargetLanguageVersion language_version, const char* stage_filename,
+                   std::string_view source, glslang::TShader::Includer* shader_includer)
+{
+  // The source of included files isn't part of the key, so those shaders can't be cached.
+  SPIRV::CompileCache* cache = shader_includer ? nullptr : GetCompileCache();
+  if (!cache)
+  {
+    return CompileShaderToSPVUncached(stage, api_type, language_version, stage_filename, source,
+                                      shader_includer);
+  }
+
+  // The output of glslang may change between versions.
+  const std::string options =
+      fmt::format("{} {} {} {} {}", Common::GetScmRevGitStr(), static_cast<int>(stage),
+                  static_cast<int>(api_type), static_cast<int>(language_version),
+                  g_ActiveConfig.bEnableValidationLayer);
+  const SPIRV::CompileCache::Key key = SPIRV::CompileCache::ComputeKey(source, options);
+  if (std::optional<SPIRV::CodeVector> code = cache->Lookup(key))
+    return code;
+
+  std::optional<SPIRV::CodeVector> code = CompileShaderToSPVUncached(
+      stage, api_type, language_version, stage_filename, source, shader_includer);
+  if (code)
+    cache->Insert(key, *code);
+  return code;
+}
 }  // namespace
 
 namespace SPIRV
@@ -307,4 +373,18 @@ std::optional<CodeVector> CompileComputeShader(std::string_view source_code, API
   return CompileShaderToSPV(EShLangCompute, api_type, language_version, "cs", source_code,
                             shader_includer);
 }
+
+void FlushCompileCache()
+{
+  std::lock_guard lk(s_compile_cache_mutex);
+  if (s_compile_cache)
+  {
+    File::CreateDir(File::GetUserPath(D_SHADERCACHE_IDX));
+    s_compile_cache->Save();
+  }
+
+  // Settings may have changed by the next time a shader is compiled.
+  s_compile_cache.reset();
+  s_compile_cache_initialized = false;
+}
 }  // namespace SPIRV
@@ -38,4 +38,8 @@ std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, AP
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version,
                                                glslang::TShader::Includer* shader_includer);
+
+// Writes the cache of compiled shaders to disk and releases it. The functions above share this
+// cache, so shaders that were compiled before, by any game or backend, aren't compiled again.
+void FlushCompileCache();
 }  // namespace SPIRV
@@ -0,0 +1,284 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/SpirvCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace SPIRV
+{
+namespace
+{
+constexpr u32 CACHE_MAGIC = 0x43565053;  // "SPVC"
+constexpr u32 CACHE_VERSION = 1;
+
+// On disk format:
+// FileHeader header;
+// FileIndexEntry index[header.num_entries];  // most recently used first
+// u32 code[];  // referenced by the index entries
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u64 num_entries;
+};
+
+struct FileIndexEntry
+{
+  u64 key_low;
+  u64 key_high;
+  u64 offset;
+  u64 size;
+};
+
+u64 GetStoredSize(size_t code_size)
+{
+  return sizeof(FileIndexEntry) + code_size;
+}
+}  // namespace
+
+CompileCache::Key CompileCache::ComputeKey(std::string_view source, std::string_view options)
+{
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_128bits_reset(&state);
+  const u64 options_size = options.size();
+  XXH3_128bits_update(&state, &options_size, sizeof(options_size));
+  XXH3_128bits_update(&state, options.data(), options.size());
+  XXH3_128bits_update(&state, source.data(), source.size());
+  const XXH128_hash_t hash = XXH3_128bits_digest(&state);
+  return {hash.low64, hash.high64};
+}
+
+CompileCache::CompileCache(u64 max_size) : m_max_size(max_size)
+{
+}
+
+CompileCache::~CompileCache() = default;
+
+bool CompileCache::Load(const std::string& path)
+{
+  std::lock_guard lk(m_mutex);
+
+  m_entries.clear();
+  m_size = 0;
+  m_use_counter = 0;
+  m_path = path;
+  // Whatever happens below, the file should be rewritten if it doesn't match the entries.
+  m_dirty = true;
+
+  if (!m_file.Open(path))
+    return false;
+
+  const std::span<const u8> data = m_file.GetData();
+  FileHeader header;
+  if (data.size() < sizeof(header))
+  {
+    m_file.Close();
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+      header.num_entries > (data.size() - sizeof(header)) / sizeof(FileIndexEntry))
+  {
+    WARN_LOG_FMT(VIDEO, "Ignoring invalid SPIR-V cache {}", path);
+    m_file.Close();
+    return false;
+  }
+
+  bool fits = true;
+  for (u64 i = 0; i < header.num_entries; ++i)
+  {
+    FileIndexEntry index_entry;
+    std::memcpy(&index_entry, data.data() + sizeof(header) + i * sizeof(index_entry),
+                sizeof(index_entry));
+    if (index_entry.offset > data.size() || index_entry.size > data.size() - index_entry.offset ||
+        index_entry.size % sizeof(u32) != 0)
+    {
+      WARN_LOG_FMT(VIDEO, "Ignoring invalid SPIR-V cache entry {} in {}", i, path);
+      continue;
+    }
+
+    // The index is sorted by recency, so the remaining entries are all older than this one.
+    if (m_size + GetStoredSize(index_entry.size) > m_max_size)
+    {
+      fits = false;
+      break;
+    }
+
+    const Key key{index_entry.key_low, index_entry.key_high};
+    const std::span<const u8> code = data.subspan(index_entry.offset, index_entry.size);
+    if (m_entries.try_emplace(key, Entry{code, {}, header.num_entries - i}).second)
+    {
+      m_size += GetStoredSize(index_entry.size);
+    }
+  }
+
+  m_use_counter = header.num_entries;
+  m_dirty = !fits;
+  return true;
+}
+
+bool CompileCache::Save()
+{
+  std::lock_guard lk(m_mutex);
+
+  INFO_LOG_FMT(VIDEO, "SPIR-V cache: {} hits, {} misses, {} evictions, {} entries ({} bytes)",
+               m_stats.hits, m_stats.misses, m_stats.evictions, m_entries.size(), m_size);
+
+  if (!m_dirty || m_path.empty())
+    return true;
+
+  std::vector<std::pair<const Key*, Entry*>> sorted;
+  sorted.reserve(m_entries.size());
+  for (auto& [key, entry] : m_entries)
+    sorted.emplace_back(&key, &entry);
+  std::ranges::sort(sorted, std::ranges::greater{},
+                    [](const auto& pair) { return pair.second->last_use; });
+
+  std::vector<FileIndexEntry> index(sorted.size());
+  u64 size = sizeof(FileHeader) + index.size() * sizeof(FileIndexEntry);
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    index[i] = {sorted[i].first->low, sorted[i].first->high, size, sorted[i].second->code.size()};
+    size += index[i].size;
+  }
+
+  const FileHeader header{CACHE_MAGIC, CACHE_VERSION, index.size()};
+  std::vector<u8> buffer(size);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  std::memcpy(buffer.data() + sizeof(header), index.data(), index.size() * sizeof(FileIndexEntry));
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    const std::span<const u8> code = sorted[i].second->code;
+    std::ranges::copy(code, buffer.begin() + index[i].offset);
+  }
+
+  // Write to a temporary file first, so that other instances that have the old file mapped keep
+  // seeing valid data.
+  const std::string temp_path = m_path + ".tmp";
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file || !file.WriteBytes(buffer.data(), buffer.size()))
+    {
+      file.Close();
+      File::Delete(temp_path);
+      return false;
+    }
+  }
+
+  // The entries still point into the old mapping, which must be closed before it's replaced.
+  m_file.Close();
+  if (!File::Rename(temp_path, m_path) || !m_file.Open(m_path) || m_file.GetSize() != size)
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to replace SPIR-V cache {}", m_path);
+    m_file.Close();
+    File::Delete(temp_path);
+    m_entries.clear();
+    m_size = 0;
+    return false;
+  }
+
+  const std::span<const u8> data = m_file.GetData();
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    sorted[i].second->code = data.subspan(index[i].offset, index[i].size);
+    sorted[i].second->owned_code = {};
+  }
+
+  m_dirty = false;
+  return true;
+}
+
+std::optional<std::vector<u32>> CompileCache::Lookup(const Key& key)
+{
+  std::lock_guard lk(m_mutex);
+
+  const auto it = m_entries.find(key);
+  if (it == m_entries.end())
+  {
+    ++m_stats.misses;
+    return std::nullopt;
+  }
+
+  ++m_stats.hits;
+  Entry& entry = it->second;
+  // Only the order of the entries in the file would change, which just decides what is dropped
+  // if the file is loaded with a smaller limit. Leave that to the next save that is needed anyway.
+  entry.last_use = ++m_use_counter;
+
+  std::vector<u32> code(entry.code.size() / sizeof(u32));
+  std::memcpy(code.data(), entry.code.data(), entry.code.size());
+  return code;
+}
+
+void CompileCache::Insert(const Key& key, std::span<const u32> code)
+{
+  std::lock_guard lk(m_mutex);
+
+  // Another thread may have compiled the same shader.
+  const auto [it, inserted] = m_entries.try_emplace(key);
+  if (!inserted)
+    return;
+
+  Entry& entry = it->second;
+  entry.owned_code.assign(code.begin(), code.end());
+  entry.code = {reinterpret_cast<const u8*>(entry.owned_code.data()), code.size_bytes()};
+  entry.last_use = ++m_use_counter;
+  m_size += GetStoredSize(entry.code.size());
+  m_dirty = true;
+
+  EvictIfNeeded();
+}
+
+void CompileCache::EvictIfNeeded()
+{
+  if (m_size <= m_max_size)
+    return;
+
+  // Evict a bit more than necessary, so that the next insertions don't have to sort again.
+  const u64 target_size = m_max_size - m_max_size / 8;
+
+  std::vector<std::pair<u64, Key>> by_last_use;
+  by_last_use.reserve(m_entries.size());
+  for (const auto& [key, entry] : m_entries)
+    by_last_use.emplace_back(entry.last_use, key);
+  std::ranges::sort(by_last_use, {}, [](const auto& pair) { return pair.first; });
+
+  for (const auto& [last_use, key] : by_last_use)
+  {
+    if (m_size <= target_size)
+      break;
+    const auto it = m_entries.find(key);
+    m_size -= GetStoredSize(it->second.code.size());
+    m_entries.erase(it);
+    ++m_stats.evictions;
+  }
+}
+
+u64 CompileCache::GetSize() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_size;
+}
+
+size_t CompileCache::GetEntryCount() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_entries.size();
+}
+
+CompileCache::Stats CompileCache::GetStats() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_stats;
+}
+}  // namespace SPIRV
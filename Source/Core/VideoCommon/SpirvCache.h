@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+
+namespace SPIRV
+{
+// A cache of compiled SPIR-V, addressed by a hash of the shader source and the compile options.
+//
+// Unlike the per-game shader caches, which are keyed by shader UIDs, the same entry is used by
+// every game and backend that generates the same source. All entries are kept in a single file
+// that is mapped on load; entries are only copied out of the mapping when they are used. When the
+// cache grows past its size limit, the least recently used entries are evicted.
+//
+// All functions are thread-safe, since shaders are compiled on multiple threads.
+class CompileCache final
+{
+public:
+  struct Key
+  {
+    u64 low = 0;
+    u64 high = 0;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct Stats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 evictions = 0;
+  };
+
+  // options must contain everything besides the source that affects the compiled code.
+  static Key ComputeKey(std::string_view source, std::string_view options);
+
+  explicit CompileCache(u64 max_size);
+  ~CompileCache();
+
+  CompileCache(const CompileCache&) = delete;
+  CompileCache& operator=(const CompileCache&) = delete;
+
+  // Replaces the contents of the cache with the entries stored in a file. Entries that don't fit
+  // in the size limit are dropped. Returns false if the file is missing or invalid.
+  bool Load(const std::string& path);
+  // Writes all entries to the file they were loaded from, most recently used first. The file is
+  // only rewritten if entries were added or evicted; uses alone don't make it worth rewriting.
+  bool Save();
+
+  std::optional<std::vector<u32>> Lookup(const Key& key);
+  void Insert(const Key& key, std::span<const u32> code);
+
+  // Total size of the entries, as they are stored in the file.
+  u64 GetSize() const;
+  size_t GetEntryCount() const;
+  Stats GetStats() const;
+
+private:
+  struct Entry
+  {
+    // Points either into the mapped file or to owned_code.
+    std::span<const u8> code;
+    std::vector<u32> owned_code;
+    u64 last_use = 0;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(key.low); }
+  };
+
+  void EvictIfNeeded();
+
+  mutable std::mutex m_mutex;
+  u64 m_max_size;
+  std::string m_path;
+  File::MappedFile m_file;
+  std::unordered_map<Key, Entry, KeyHash> m_entries;
+  u64 m_size = 0;
+  u64 m_use_counter = 0;
+  bool m_dirty = false;
+  Stats m_stats;
+};
+}  // namespace SPIRV
@@ -105,6 +105,11 @@ void Statistics::Display() const
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
+  draw_statistic("GPU wakeups (sleep/spin):", "%d/%d", this_frame.num_gpu_sleep_wakeups,
+                 this_frame.num_gpu_spin_wakeups);
+  draw_statistic("GPU idle:", "%.2f ms", this_frame.gpu_idle_us / 1000.0f);
+  draw_statistic("Sync stalls:", "%d (%.2f ms)", this_frame.num_sync_stalls,
+                 this_frame.sync_stall_us / 1000.0f);
 
   ImGui::Columns(1);
 
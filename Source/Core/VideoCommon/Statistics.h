@@ -79,6 +79,13 @@ struct Statistics
     int num_draw_done = 0;
     int num_token = 0;
     int num_token_int = 0;
+
+    // Handoff between the CPU and GPU threads in dual core mode.
+    int num_gpu_sleep_wakeups = 0;
+    int num_gpu_spin_wakeups = 0;
+    int gpu_idle_us = 0;
+    int num_sync_stalls = 0;
+    int sync_stall_us = 0;
   };
   ThisFrame this_frame;
   void ResetFrame();
@@ -16,6 +16,11 @@
 #endif
 
 #include <fmt/format.h>
+#include <xxhash.h>
+#ifdef XXHASH_X86_DISPATCH
+// Replaces the XXH3 functions with ones that use AVX2 or AVX-512 if the CPU has them.
+#include <xxh_x86dispatch.h>
+#endif
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -65,6 +70,17 @@ static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
 
 static int xfb_count = 0;
 
+// Full hashes can use XXH3, which has fewer collisions than GetHash64. It is only about as fast as
+// GetHash64 with AVX2 though, and much slower with SSE2, so it is off by default. The
+// TextureHashBenchmark unit test compares them. Sampled hashes always use GetHash64, as they only
+// read a few hundred bytes of the texture.
+static u64 HashTextureData(const u8* data, u32 size, u32 samples)
+{
+  if (samples == 0 && g_ActiveConfig.bHashTexturesWithXXH3)
+    return XXH3_64bits(data, size);
+  return Common::GetHash64(data, size, samples);
+}
+
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
 TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
@@ -158,6 +174,7 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != m_backup_config.color_samples ||
+      config.bHashTexturesWithXXH3 != m_backup_config.hash_textures_with_xxh3 ||
       config.bTexFmtOverlayEnable != m_backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != m_backup_config.texfmt_overlay_center ||
       config.bHiresTextures != m_backup_config.hires_textures ||
@@ -247,6 +264,7 @@ bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   m_backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
+  m_backup_config.hash_textures_with_xxh3 = config.bHashTexturesWithXXH3;
   m_backup_config.texfmt_overlay = config.bTexFmtOverlayEnable;
   m_backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   m_backup_config.hires_textures = config.bHiresTextures;
@@ -1339,15 +1357,15 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  base_hash = HashTextureData(texture_info.GetData(), texture_info.GetTextureSize(),
+                              textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
     palette_size = *texture_info.GetPaletteSize();
     full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
-                                      textureCacheSafetyColorSampleSize);
+        base_hash ^ HashTextureData(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
+                                    textureCacheSafetyColorSampleSize);
   }
   else
   {
@@ -1824,7 +1842,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  const u8* src_data = memory.GetPointerForRange(address, total_size);
+  const u8* src_data = memory.GetReadPointerForRange(address, total_size);
   if (!src_data)
   {
     ERROR_LOG_FMT(VIDEO, "Trying to load XFB texture from invalid address {:#010x}", address);
@@ -2272,7 +2290,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       if (skip == true)
       {
         if (copy_to_ram)
+        {
           UninitializeEFBMemory(dst, dstStride, bytes_per_row, num_blocks_y);
+          memory.MarkDirty(dstAddr, covered_range);
+        }
         return;
       }
     }
@@ -2428,6 +2449,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     }
   }
 
+  // Deferred copies are marked again when they are flushed.
+  memory.MarkDirty(dstAddr, covered_range);
+
   // Invalidate all textures, if they are either fully overwritten by our efb copy, or if they
   // have a different stride than our efb copy. Partly overwritten textures with the same stride
   // as our efb copy are marked to check them for partial texture updates.
@@ -2550,6 +2574,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   u8* const dst = memory.GetPointerForRange(entry->addr, covered_range);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
                     entry->memory_stride, std::move(entry->pending_efb_copy));
+  memory.MarkDirty(entry->addr, covered_range);
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), we don't
   // need to do anything more. The entry will be automatically deleted by smart pointers
@@ -3238,7 +3263,7 @@ u64 TCacheEntry::CalculateHash() const
   u8* ptr = memory.GetPointerForRange(addr, size_in_bytes);
   if (memory_stride == bytes_per_row)
   {
-    return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
+    return HashTextureData(ptr, size_in_bytes, hash_sample_size);
   }
   else
   {
@@ -3257,7 +3282,7 @@ u64 TCacheEntry::CalculateHash() const
     {
       // Multiply by a prime number to mix the hash up a bit. This prevents identical blocks from
       // canceling each other out
-      temp_hash = (temp_hash * 397) ^ Common::GetHash64(ptr, bytes_per_row, samples_per_row);
+      temp_hash = (temp_hash * 397) ^ HashTextureData(ptr, bytes_per_row, samples_per_row);
       ptr += memory_stride;
     }
     return temp_hash;
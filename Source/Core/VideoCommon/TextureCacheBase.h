@@ -429,6 +429,7 @@ private:
   struct BackupConfig
   {
     int color_samples;
+    bool hash_textures_with_xxh3;
     bool texfmt_overlay;
     bool texfmt_overlay_center;
     bool hires_textures;
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/UberShaderPixel.h"
 
+#include <utility>
+
 #include "Common/Assert.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -54,6 +56,230 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
     uid_data->uint_output = 0;
 }
 
+// Writes the functions used by the main function of the ubershader. Unlike the rest of the
+// ubershader, they don't depend on the UID.
+static void WriteHelperFunctions(ShaderCode& out, APIType api_type, bool dynamic_sampler_indexing)
+{
+  // =====================
+  //   Texture Sampling
+  // =====================
+
+  if (dynamic_sampler_indexing)
+  {
+    // Doesn't look like DirectX supports this. Oh well the code path is here just in case it
+    // supports this in the future.
+    out.Write("int4 sampleTextureWrapper(uint texmap, int2 uv, int layer) {{\n");
+    out.Write("  return sampleTexture(texmap, samp[texmap], uv, layer);\n");
+    out.Write("}}\n\n");
+  }
+  else
+  {
+    out.Write("int4 sampleTextureWrapper(uint sampler_num, int2 uv, int layer) {{\n"
+              "  // This is messy, but DirectX, OpenGL 3.3, and OpenGL ES 3.0 don't support "
+              "dynamic indexing of the sampler array\n"
+              "  // With any luck the shader compiler will optimise this if the hardware supports "
+              "dynamic indexing.\n"
+              "  switch(sampler_num) {{\n");
+    for (int i = 0; i < 8; i++)
+    {
+      out.Write("  case {0}u: return sampleTexture({0}u, samp[{0}u], uv, layer);\n", i);
+    }
+    out.Write("  }}\n"
+              "}}\n\n");
+  }
+
+  // ======================
+  //   Arbitrary Swizzling
+  // ======================
+
+  out.Write("int4 Swizzle(uint s, int4 color) {{\n"
+            "  // AKA: Color Channel Swapping\n"
+            "\n"
+            "  int4 ret;\n");
+  out.Write("  ret.r = color[{}];\n", BitfieldExtract<&TevKSel::swap_rb>("bpmem_tevksel(s * 2u)"));
+  out.Write("  ret.g = color[{}];\n", BitfieldExtract<&TevKSel::swap_ga>("bpmem_tevksel(s * 2u)"));
+  out.Write("  ret.b = color[{}];\n",
+            BitfieldExtract<&TevKSel::swap_rb>("bpmem_tevksel(s * 2u + 1u)"));
+  out.Write("  ret.a = color[{}];\n",
+            BitfieldExtract<&TevKSel::swap_ga>("bpmem_tevksel(s * 2u + 1u)"));
+  out.Write("  return ret;\n"
+            "}}\n\n");
+
+  // ======================
+  //   Indirect Wrapping
+  // ======================
+  out.Write("int Wrap(int coord, uint mode) {{\n"
+            "  if (mode == 0u) // ITW_OFF\n"
+            "    return coord;\n"
+            "  else if (mode < 6u) // ITW_256 to ITW_16\n"
+            "    return coord & (0xfffe >> mode);\n"
+            "  else // ITW_0\n"
+            "    return 0;\n"
+            "}}\n\n");
+
+  // ======================
+  //   TEV's Special Lerp
+  // ======================
+  const auto WriteTevLerp = [&out](std::string_view components) {
+    out.Write("// TEV's Linear Interpolate, plus bias, add/subtract and scale\n"
+              "int{0} tevLerp{0}(int{0} A, int{0} B, int{0} C, int{0} D, uint bias, bool op, "
+              "uint scale) {{\n"
+              " // Scale C from 0..255 to 0..256\n"
+              "  C += C >> 7;\n"
+              "\n"
+              " // Add bias to D\n"
+              "  if (bias == 1u) D += 128;\n"
+              "  else if (bias == 2u) D -= 128;\n"
+              "\n"
+              "  int{0} lerp = (A << 8) + (B - A)*C;\n"
+              "  if (scale != 3u) {{\n"
+              "    lerp = lerp << scale;\n"
+              "    D = D << scale;\n"
+              "  }}\n"
+              "\n"
+              "  // This rounding bias is not added when the scale is divide by 2\n"
+              "  if (scale != 3u)\n"
+              "    lerp = lerp + (op ? 127 : 128);\n"
+              "\n"
+              "  int{0} result = lerp >> 8;\n"
+              "\n"
+              "  // Add/Subtract D\n"
+              "  if (op) // Subtract\n"
+              "    result = D - result;\n"
+              "  else // Add\n"
+              "    result = D + result;\n"
+              "\n"
+              "  // Most of the Scale was moved inside the lerp for improved precision\n"
+              "  // But we still do the divide by 2 here\n"
+              "  if (scale == 3u)\n"
+              "    result = result >> 1;\n"
+              "  return result;\n"
+              "}}\n\n",
+              components);
+  };
+  WriteTevLerp("");   // int
+  WriteTevLerp("3");  // int3
+
+  // =======================
+  //   TEV's Color Compare
+  // =======================
+
+  out.Write(
+      "// Implements operations 0-5 of TEV's compare mode,\n"
+      "// which are common to both color and alpha channels\n"
+      "bool tevCompare(uint op, int3 color_A, int3 color_B) {{\n"
+      "  switch (op) {{\n"
+      "  case 0u: // TevCompareMode::R8, TevComparison::GT\n"
+      "    return (color_A.r > color_B.r);\n"
+      "  case 1u: // TevCompareMode::R8, TevComparison::EQ\n"
+      "    return (color_A.r == color_B.r);\n"
+      "  case 2u: // TevCompareMode::GR16, TevComparison::GT\n"
+      "    int A_16 = (color_A.r | (color_A.g << 8));\n"
+      "    int B_16 = (color_B.r | (color_B.g << 8));\n"
+      "    return A_16 > B_16;\n"
+      "  case 3u: // TevCompareMode::GR16, TevComparison::EQ\n"
+      "    return (color_A.r == color_B.r && color_A.g == color_B.g);\n"
+      "  case 4u: // TevCompareMode::BGR24, TevComparison::GT\n"
+      "    int A_24 = (color_A.r | (color_A.g << 8) | (color_A.b << 16));\n"
+      "    int B_24 = (color_B.r | (color_B.g << 8) | (color_B.b << 16));\n"
+      "    return A_24 > B_24;\n"
+      "  case 5u: // TevCompareMode::BGR24, TevComparison::EQ\n"
+      "    return (color_A.r == color_B.r && color_A.g == color_B.g && color_A.b == color_B.b);\n"
+      "  default:\n"
+      "    return false;\n"
+      "  }}\n"
+      "}}\n\n");
+
+  // =================
+  //   Input Selects
+  // =================
+
+  out.Write("struct State {{\n"
+            "  int4 Reg[4];\n"
+            "  int4 RawTexColor;\n"
+            "  int4 TexColor;\n"
+            "  int AlphaBump;\n"
+            "}};\n"
+            "struct StageState {{\n"
+            "  uint stage;\n"
+            "  uint order;\n"
+            "  uint cc;\n"
+            "  uint ac;\n"
+            "}};\n"
+            "\n"
+            "int4 getRasColor(State s, StageState ss, float4 colors_0, float4 colors_1);\n"
+            "int4 getKonstColor(State s, StageState ss);\n"
+            "\n");
+
+  static constexpr Common::EnumMap<std::string_view, CompareMode::Always> tev_alpha_funcs_table{
+      "return false;",   // CompareMode::Never
+      "return a <  b;",  // CompareMode::Less
+      "return a == b;",  // CompareMode::Equal
+      "return a <= b;",  // CompareMode::LEqual
+      "return a >  b;",  // CompareMode::Greater
+      "return a != b;",  // CompareMode::NEqual
+      "return a >= b;",  // CompareMode::GEqual
+      "return true;"     // CompareMode::Always
+  };
+
+  static constexpr Common::EnumMap<std::string_view, TevColorArg::Zero> tev_c_input_table{
+      "return s.Reg[0].rgb;",                                // CPREV,
+      "return s.Reg[0].aaa;",                                // APREV,
+      "return s.Reg[1].rgb;",                                // C0,
+      "return s.Reg[1].aaa;",                                // A0,
+      "return s.Reg[2].rgb;",                                // C1,
+      "return s.Reg[2].aaa;",                                // A1,
+      "return s.Reg[3].rgb;",                                // C2,
+      "return s.Reg[3].aaa;",                                // A2,
+      "return s.TexColor.rgb;",                              // TEXC,
+      "return s.TexColor.aaa;",                              // TEXA,
+      "return getRasColor(s, ss, colors_0, colors_1).rgb;",  // RASC,
+      "return getRasColor(s, ss, colors_0, colors_1).aaa;",  // RASA,
+      "return int3(255, 255, 255);",                         // ONE
+      "return int3(128, 128, 128);",                         // HALF
+      "return getKonstColor(s, ss).rgb;",                    // KONST
+      "return int3(0, 0, 0);",                               // ZERO
+  };
+
+  static constexpr Common::EnumMap<std::string_view, TevAlphaArg::Zero> tev_a_input_table{
+      "return s.Reg[0].a;",                                // APREV,
+      "return s.Reg[1].a;",                                // A0,
+      "return s.Reg[2].a;",                                // A1,
+      "return s.Reg[3].a;",                                // A2,
+      "return s.TexColor.a;",                              // TEXA,
+      "return getRasColor(s, ss, colors_0, colors_1).a;",  // RASA,
+      "return getKonstColor(s, ss).a;",                    // KONST,  (hw1 had quarter)
+      "return 0;",                                         // ZERO
+  };
+
+  static constexpr Common::EnumMap<std::string_view, TevOutput::Color2> tev_regs_lookup_table{
+      "return s.Reg[0];",
+      "return s.Reg[1];",
+      "return s.Reg[2];",
+      "return s.Reg[3];",
+  };
+
+  out.Write("// Helper function for Alpha Test\n"
+            "bool alphaCompare(int a, int b, uint compare) {{\n");
+  WriteSwitch(out, api_type, "compare", tev_alpha_funcs_table, 2, false);
+  out.Write("}}\n"
+            "\n"
+            "int3 selectColorInput(State s, StageState ss, float4 colors_0, float4 colors_1, "
+            "uint index) {{\n");
+  WriteSwitch(out, api_type, "index", tev_c_input_table, 2, false);
+  out.Write("}}\n"
+            "\n"
+            "int selectAlphaInput(State s, StageState ss, float4 colors_0, float4 colors_1, "
+            "uint index) {{\n");
+  WriteSwitch(out, api_type, "index", tev_a_input_table, 2, false);
+  out.Write("}}\n"
+            "\n"
+            "int4 getTevReg(in State s, uint index) {{\n");
+  WriteSwitch(out, api_type, "index", tev_regs_lookup_table, 2, false);
+  out.Write("}}\n"
+            "\n");
+}
+
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data)
 {
@@ -296,62 +522,12 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
     out.Write("}}\n\n");
   }
 
-  // =====================
-  //   Texture Sampling
-  // =====================
-
-  if (host_config.backend_dynamic_sampler_indexing)
-  {
-    // Doesn't look like DirectX supports this. Oh well the code path is here just in case it
-    // supports this in the future.
-    out.Write("int4 sampleTextureWrapper(uint texmap, int2 uv, int layer) {{\n");
-    out.Write("  return sampleTexture(texmap, samp[texmap], uv, layer);\n");
-    out.Write("}}\n\n");
-  }
-  else
-  {
-    out.Write("int4 sampleTextureWrapper(uint sampler_num, int2 uv, int layer) {{\n"
-              "  // This is messy, but DirectX, OpenGL 3.3, and OpenGL ES 3.0 don't support "
-              "dynamic indexing of the sampler array\n"
-              "  // With any luck the shader compiler will optimise this if the hardware supports "
-              "dynamic indexing.\n"
-              "  switch(sampler_num) {{\n");
-    for (int i = 0; i < 8; i++)
-    {
-      out.Write("  case {0}u: return sampleTexture({0}u, samp[{0}u], uv, layer);\n", i);
-    }
-    out.Write("  }}\n"
-              "}}\n\n");
-  }
-
-  // ======================
-  //   Arbitrary Swizzling
-  // ======================
-
-  out.Write("int4 Swizzle(uint s, int4 color) {{\n"
-            "  // AKA: Color Channel Swapping\n"
-            "\n"
-            "  int4 ret;\n");
-  out.Write("  ret.r = color[{}];\n", BitfieldExtract<&TevKSel::swap_rb>("bpmem_tevksel(s * 2u)"));
-  out.Write("  ret.g = color[{}];\n", BitfieldExtract<&TevKSel::swap_ga>("bpmem_tevksel(s * 2u)"));
-  out.Write("  ret.b = color[{}];\n",
-            BitfieldExtract<&TevKSel::swap_rb>("bpmem_tevksel(s * 2u + 1u)"));
-  out.Write("  ret.a = color[{}];\n",
-            BitfieldExtract<&TevKSel::swap_ga>("bpmem_tevksel(s * 2u + 1u)"));
-  out.Write("  return ret;\n"
-            "}}\n\n");
-
-  // ======================
-  //   Indirect Wrapping
-  // ======================
-  out.Write("int Wrap(int coord, uint mode) {{\n"
-            "  if (mode == 0u) // ITW_OFF\n"
-            "    return coord;\n"
-            "  else if (mode < 6u) // ITW_256 to ITW_16\n"
-            "    return coord & (0xfffe >> mode);\n"
-            "  else // ITW_0\n"
-            "    return 0;\n"
-            "}}\n\n");
+  // The helper functions are the same for every UID, so they are only generated once.
+  static ShaderCodeFragmentCache<std::pair<APIType, bool>> s_helper_functions;
+  const bool dynamic_sampler_indexing = host_config.backend_dynamic_sampler_indexing;
+  out.WriteRaw(s_helper_functions.Get({api_type, dynamic_sampler_indexing}, [&](ShaderCode& code) {
+    WriteHelperFunctions(code, api_type, dynamic_sampler_indexing);
+  }));
 
   // ======================
   //    Indirect Lookup
@@ -378,148 +554,6 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
               in_index_name, in_index_name, in_index_name, in_index_name, out_var_name);
   };
 
-  // ======================
-  //   TEV's Special Lerp
-  // ======================
-  const auto WriteTevLerp = [&out](std::string_view components) {
-    out.Write("// TEV's Linear Interpolate, plus bias, add/subtract and scale\n"
-              "int{0} tevLerp{0}(int{0} A, int{0} B, int{0} C, int{0} D, uint bias, bool op, "
-              "uint scale) {{\n"
-              " // Scale C from 0..255 to 0..256\n"
-              "  C += C >> 7;\n"
-              "\n"
-              " // Add bias to D\n"
-              "  if (bias == 1u) D += 128;\n"
-              "  else if (bias == 2u) D -= 128;\n"
-              "\n"
-              "  int{0} lerp = (A << 8) + (B - A)*C;\n"
-              "  if (scale != 3u) {{\n"
-              "    lerp = lerp << scale;\n"
-              "    D = D << scale;\n"
-              "  }}\n"
-              "\n"
-              "  // This rounding bias is not added when the scale is divide by 2\n"
-              "  if (scale != 3u)\n"
-              "    lerp = lerp + (op ? 127 : 128);\n"
-              "\n"
-              "  int{0} result = lerp >> 8;\n"
-              "\n"
-              "  // Add/Subtract D\n"
-              "  if (op) // Subtract\n"
-              "    result = D - result;\n"
-              "  else // Add\n"
-              "    result = D + result;\n"
-              "\n"
-              "  // Most of the Scale was moved inside the lerp for improved precision\n"
-              "  // But we still do the divide by 2 here\n"
-              "  if (scale == 3u)\n"
-              "    result = result >> 1;\n"
-              "  return result;\n"
-              "}}\n\n",
-              components);
-  };
-  WriteTevLerp("");   // int
-  WriteTevLerp("3");  // int3
-
-  // =======================
-  //   TEV's Color Compare
-  // =======================
-
-  out.Write(
-      "// Implements operations 0-5 of TEV's compare mode,\n"
-      "// which are common to both color and alpha channels\n"
-      "bool tevCompare(uint op, int3 color_A, int3 color_B) {{\n"
-      "  switch (op) {{\n"
-      "  case 0u: // TevCompareMode::R8, TevComparison::GT\n"
-      "    return (color_A.r > color_B.r);\n"
-      "  case 1u: // TevCompareMode::R8, TevComparison::EQ\n"
-      "    return (color_A.r == color_B.r);\n"
-      "  case 2u: // TevCompareMode::GR16, TevComparison::GT\n"
-      "    int A_16 = (color_A.r | (color_A.g << 8));\n"
-      "    int B_16 = (color_B.r | (color_B.g << 8));\n"
-      "    return A_16 > B_16;\n"
-      "  case 3u: // TevCompareMode::GR16, TevComparison::EQ\n"
-      "    return (color_A.r == color_B.r && color_A.g == color_B.g);\n"
-      "  case 4u: // TevCompareMode::BGR24, TevComparison::GT\n"
-      "    int A_24 = (color_A.r | (color_A.g << 8) | (color_A.b << 16));\n"
-      "    int B_24 = (color_B.r | (color_B.g << 8) | (color_B.b << 16));\n"
-      "    return A_24 > B_24;\n"
-      "  case 5u: // TevCompareMode::BGR24, TevComparison::EQ\n"
-      "    return (color_A.r == color_B.r && color_A.g == color_B.g && color_A.b == color_B.b);\n"
-      "  default:\n"
-      "    return false;\n"
-      "  }}\n"
-      "}}\n\n");
-
-  // =================
-  //   Input Selects
-  // =================
-
-  out.Write("struct State {{\n"
-            "  int4 Reg[4];\n"
-            "  int4 RawTexColor;\n"
-            "  int4 TexColor;\n"
-            "  int AlphaBump;\n"
-            "}};\n"
-            "struct StageState {{\n"
-            "  uint stage;\n"
-            "  uint order;\n"
-            "  uint cc;\n"
-            "  uint ac;\n"
-            "}};\n"
-            "\n"
-            "int4 getRasColor(State s, StageState ss, float4 colors_0, float4 colors_1);\n"
-            "int4 getKonstColor(State s, StageState ss);\n"
-            "\n");
-
-  static constexpr Common::EnumMap<std::string_view, CompareMode::Always> tev_alpha_funcs_table{
-      "return false;",   // CompareMode::Never
-      "return a <  b;",  // CompareMode::Less
-      "return a == b;",  // CompareMode::Equal
-      "return a <= b;",  // CompareMode::LEqual
-      "return a >  b;",  // CompareMode::Greater
-      "return a != b;",  // CompareMode::NEqual
-      "return a >= b;",  // CompareMode::GEqual
-      "return true;"     // CompareMode::Always
-  };
-
-  static constexpr Common::EnumMap<std::string_view, TevColorArg::Zero> tev_c_input_table{
-      "return s.Reg[0].rgb;",                                // CPREV,
-      "return s.Reg[0].aaa;",                                // APREV,
-      "return s.Reg[1].rgb;",                                // C0,
-      "return s.Reg[1].aaa;",                                // A0,
-      "return s.Reg[2].rgb;",                                // C1,
-      "return s.Reg[2].aaa;",                                // A1,
-      "return s.Reg[3].rgb;",                                // C2,
-      "return s.Reg[3].aaa;",                                // A2,
-      "return s.TexColor.rgb;",                              // TEXC,
-      "return s.TexColor.aaa;",                              // TEXA,
-      "return getRasColor(s, ss, colors_0, colors_1).rgb;",  // RASC,
-      "return getRasColor(s, ss, colors_0, colors_1).aaa;",  // RASA,
-      "return int3(255, 255, 255);",                         // ONE
-      "return int3(128, 128, 128);",                         // HALF
-      "return getKonstColor(s, ss).rgb;",                    // KONST
-      "return int3(0, 0, 0);",                               // ZERO
-  };
-
-  static constexpr Common::EnumMap<std::string_view, TevAlphaArg::Zero> tev_a_input_table{
-      "return s.Reg[0].a;",                                // APREV,
-      "return s.Reg[1].a;",                                // A0,
-      "return s.Reg[2].a;",                                // A1,
-      "return s.Reg[3].a;",                                // A2,
-      "return s.TexColor.a;",                              // TEXA,
-      "return getRasColor(s, ss, colors_0, colors_1).a;",  // RASA,
-      "return getKonstColor(s, ss).a;",                    // KONST,  (hw1 had quarter)
-      "return 0;",                                         // ZERO
-  };
-
-  static constexpr Common::EnumMap<std::string_view, TevOutput::Color2> tev_regs_lookup_table{
-      "return s.Reg[0];",
-      "return s.Reg[1];",
-      "return s.Reg[2];",
-      "return s.Reg[3];",
-  };
-
   static constexpr Common::EnumMap<std::string_view, TevOutput::Color2> tev_c_set_table{
       "s.Reg[0].rgb = color;",
       "s.Reg[1].rgb = color;",
@@ -534,26 +568,6 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
       "s.Reg[3].a = alpha;",
   };
 
-  out.Write("// Helper function for Alpha Test\n"
-            "bool alphaCompare(int a, int b, uint compare) {{\n");
-  WriteSwitch(out, api_type, "compare", tev_alpha_funcs_table, 2, false);
-  out.Write("}}\n"
-            "\n"
-            "int3 selectColorInput(State s, StageState ss, float4 colors_0, float4 colors_1, "
-            "uint index) {{\n");
-  WriteSwitch(out, api_type, "index", tev_c_input_table, 2, false);
-  out.Write("}}\n"
-            "\n"
-            "int selectAlphaInput(State s, StageState ss, float4 colors_0, float4 colors_1, "
-            "uint index) {{\n");
-  WriteSwitch(out, api_type, "index", tev_a_input_table, 2, false);
-  out.Write("}}\n"
-            "\n"
-            "int4 getTevReg(in State s, uint index) {{\n");
-  WriteSwitch(out, api_type, "index", tev_regs_lookup_table, 2, false);
-  out.Write("}}\n"
-            "\n");
-
   // Since the fixed-point texture coordinate variables aren't global, we need to pass
   // them to the select function.  This applies to all backends.
   if (numTexgen > 0)
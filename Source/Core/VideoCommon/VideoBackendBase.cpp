@@ -59,6 +59,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/Resources/CustomResourceManager.h"
+#include "VideoCommon/Spirv.h"
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -270,16 +271,16 @@ void VideoBackendBase::PopulateBackendInfo(const WindowSystemInfo& wsi)
   g_Config.VerifyValidity();
 }
 
-void VideoBackendBase::DoState(PointerWrap& p)
+void VideoBackendBase::DoState(PointerWrap& p, VideoStateScope scope)
 {
   auto& system = Core::System::GetInstance();
   if (!system.IsDualCoreMode())
   {
-    VideoCommon_DoState(p);
+    VideoCommon_DoState(p, scope);
     return;
   }
 
-  AsyncRequests::GetInstance()->PushBlockingEvent([&] { VideoCommon_DoState(p); });
+  AsyncRequests::GetInstance()->PushBlockingEvent([&] { VideoCommon_DoState(p, scope); });
 
   // Let the GPU thread sleep after loading the state, so we're not spinning if paused after loading
   // a state. The next GP burst will wake it up again.
@@ -381,6 +382,7 @@ void VideoBackendBase::ShutdownShared()
     g_shader_cache->Shutdown();
   if (g_texture_cache)
     g_texture_cache->Shutdown();
+  SPIRV::FlushCompileCache();
 
   g_bounding_box.reset();
   g_perf_query.reset();
@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/WindowSystemInfo.h"
 #include "VideoCommon/PerfQueryBase.h"
+#include "VideoCommon/VideoState.h"
 
 namespace MMIO
 {
@@ -62,7 +63,7 @@ public:
   static void PopulateBackendInfo(const WindowSystemInfo& wsi);
 
   // Wrapper function which pushes the event to the GPU thread.
-  void DoState(PointerWrap& p);
+  void DoState(PointerWrap& p, VideoStateScope scope = VideoStateScope::Full);
 
 protected:
   // For hardware backends
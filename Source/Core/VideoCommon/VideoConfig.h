@@ -264,6 +264,7 @@ struct VideoConfig final
   bool bTexFmtOverlayEnable = false;
   bool bTexFmtOverlayCenter = false;
   bool bLogRenderTimeToFile = false;
+  int iPerfReportInterval = 0;
 
   // Render
   bool bWireFrame = false;
@@ -299,6 +300,7 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  bool bHashTexturesWithXXH3 = false;
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -27,7 +27,7 @@
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStateManager.h"
 
-void VideoCommon_DoState(PointerWrap& p)
+void VideoCommon_DoState(PointerWrap& p, VideoStateScope scope)
 {
   bool software = false;
   p.Do(software);
@@ -88,15 +88,23 @@ void VideoCommon_DoState(PointerWrap& p)
   g_vertex_manager->DoState(p);
   p.DoMarker("VertexManager");
 
-  g_framebuffer_manager->DoState(p);
-  p.DoMarker("FramebufferManager");
+  if (scope == VideoStateScope::Full)
+  {
+    g_framebuffer_manager->DoState(p);
+    p.DoMarker("FramebufferManager");
 
-  g_texture_cache->DoState(p);
-  p.DoMarker("TextureCache");
+    g_texture_cache->DoState(p);
+    p.DoMarker("TextureCache");
 
-  g_presenter->DoState(p);
-  g_frame_dumper->DoState(p);
-  p.DoMarker("Presenter");
+    g_presenter->DoState(p);
+    g_frame_dumper->DoState(p);
+    p.DoMarker("Presenter");
+  }
+  else
+  {
+    // Pending EFB copies to RAM still have to land in the RAM that is saved or replaced.
+    g_texture_cache->FlushEFBCopies();
+  }
 
   g_bounding_box->DoState(p);
   p.DoMarker("Bounding Box");
@@ -5,4 +5,13 @@
 
 class PointerWrap;
 
-void VideoCommon_DoState(PointerWrap& p);
+enum class VideoStateScope
+{
+  // Everything, including the EFB and the EFB copies that only exist on the host GPU.
+  Full,
+  // Only the emulated GPU's registers and memory. Reading the EFB and the texture cache back from
+  // the host GPU is too slow to do every frame, and they are rebuilt as the game renders again.
+  EmulatedOnly,
+};
+
+void VideoCommon_DoState(PointerWrap& p, VideoStateScope scope = VideoStateScope::Full);
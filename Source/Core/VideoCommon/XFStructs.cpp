@@ -262,7 +262,7 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
 
   const u32 buf_size = size * sizeof(u32);
   u32* currData = reinterpret_cast<u32*>(&xfmem) + address;
-  u32* newData;
+  const u32* newData;
   auto& system = Core::System::GetInstance();
   auto& fifo = system.GetFifo();
   if (fifo.UseDeterministicGPUThread())
@@ -272,7 +272,7 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
   else
   {
     auto& memory = system.GetMemory();
-    newData = reinterpret_cast<u32*>(memory.GetPointerForRange(
+    newData = reinterpret_cast<const u32*>(memory.GetReadPointerForRange(
         g_main_cp_state.array_bases[array] + g_main_cp_state.array_strides[array] * index,
         buf_size));
   }
@@ -301,7 +301,7 @@ void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
-  const u8* new_data = memory.GetPointerForRange(
+  const u8* new_data = memory.GetReadPointerForRange(
       g_preprocess_cp_state.array_bases[array] + g_preprocess_cp_state.array_strides[array] * index,
       buf_size);
 
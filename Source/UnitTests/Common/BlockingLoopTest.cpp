@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <gtest/gtest.h>
 
 #include "Common/BlockingLoop.h"
+#include "Common/CommonTypes.h"
 
 TEST(BlockingLoop, MultiThreaded)
 {
@@ -77,3 +79,51 @@ TEST(BlockingLoop, MultiThreaded)
     loop_thread.join();
   }
 }
+
+TEST(BlockingLoop, SpinThenSleep)
+{
+  Common::BlockingLoop loop;
+  std::atomic signaled(0);
+  std::atomic received(0);
+  std::atomic<u64> spin_wakeups(0);
+  std::atomic<u64> sleep_wakeups(0);
+
+  // Long enough that the worker is always still spinning when the next Wakeup comes.
+  loop.SetSpinTime(std::chrono::seconds(1), std::chrono::seconds(1));
+
+  std::thread loop_thread([&] {
+    loop.Run([&] {
+      received.store(signaled.load());
+      const Common::BlockingLoop::Statistics statistics = loop.TakeStatistics();
+      spin_wakeups += statistics.spin_wakeups;
+      sleep_wakeups += statistics.sleep_wakeups;
+    });
+  });
+  loop.Prepare();
+  loop.Wait();
+
+  for (int i = 0; i < 100; i++)
+  {
+    signaled++;
+    loop.Wakeup();
+    loop.Wait();
+    EXPECT_EQ(signaled.load(), received.load());
+  }
+  EXPECT_GT(spin_wakeups.load(), 0u);
+  EXPECT_EQ(sleep_wakeups.load(), 0u);
+
+  // Now the worker has to go to sleep, and must still be woken up by the next Wakeup.
+  loop.SetSpinTime(std::chrono::microseconds(0), std::chrono::microseconds(100));
+  signaled++;
+  loop.Wakeup();
+  loop.Wait();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  signaled++;
+  loop.Wakeup();
+  loop.Wait();
+  EXPECT_EQ(signaled.load(), received.load());
+  EXPECT_GT(sleep_wakeups.load(), 0u);
+
+  loop.Stop();
+  loop_thread.join();
+}
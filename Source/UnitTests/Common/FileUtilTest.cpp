@@ -11,6 +11,8 @@
 #include "Common/BitUtils.h"
 #include "Common/DirectIOFile.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 
 class FileUtilTest : public testing::Test
 {
@@ -412,3 +414,33 @@ TEST_F(FileUtilTest, DirectIOFile)
   file.Close();
   EXPECT_TRUE(file.Open(destination_path_2, File::AccessMode::Write, File::OpenMode::Always));
 }
+
+TEST_F(FileUtilTest, MappedFile)
+{
+  EXPECT_FALSE(File::MappedFile(m_invalid_path));
+
+  // Empty files can't be mapped.
+  File::CreateEmptyFile(m_file_path);
+  EXPECT_FALSE(File::MappedFile(m_file_path));
+
+  std::array<u8, 5000> data;
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 3);
+  {
+    File::IOFile file(m_file_path, "wb");
+    ASSERT_TRUE(file.WriteBytes(data.data(), data.size()));
+  }
+
+  File::MappedFile mapped(m_file_path);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped.GetSize(), data.size());
+  EXPECT_TRUE(std::ranges::equal(mapped.GetData(), data));
+
+  File::MappedFile moved = std::move(mapped);
+  EXPECT_FALSE(mapped);
+  EXPECT_TRUE(std::ranges::equal(moved.GetData(), data));
+
+  moved.Close();
+  EXPECT_FALSE(moved);
+  EXPECT_TRUE(moved.GetData().empty());
+}
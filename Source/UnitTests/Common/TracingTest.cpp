@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Thread.h"
+#include "Common/Tracing.h"
+
+namespace
+{
+size_t CountOccurrences(const std::string& str, const std::string& needle)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(needle); pos != std::string::npos; pos = str.find(needle, pos + 1))
+    ++count;
+  return count;
+}
+
+std::string StopAndRead()
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+  std::string trace;
+  EXPECT_TRUE(Common::Tracing::Stop(path));
+  EXPECT_TRUE(File::ReadFileToString(path, trace));
+  File::DeleteDirRecursively(directory);
+  return trace;
+}
+}  // namespace
+
+TEST(Tracing, RecordsSpansOfAllThreads)
+{
+  Common::Tracing::Start();
+
+  {
+    TRACE_SCOPE("Test", "Main thread span");
+  }
+  std::thread thread([] {
+    Common::SetCurrentThreadName("Tracing test thread");
+    for (int i = 0; i < 10000; ++i)
+      TRACE_SCOPE("Test", "Other thread span");
+  });
+  thread.join();
+
+  const std::string trace = StopAndRead();
+  EXPECT_EQ(trace.front(), '{');
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Main thread span\""), 1u);
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Other thread span\""), 10000u);
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Tracing test thread\""), 1u);
+}
+
+TEST(Tracing, KeepsNamesOfThreadsNamedBeforeStart)
+{
+  std::thread thread([] {
+    Common::SetCurrentThreadName("Named before start");
+    Common::Tracing::Start();
+    TRACE_SCOPE("Test", "Span after start");
+  });
+  thread.join();
+
+  const std::string trace = StopAndRead();
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Named before start\""), 1u);
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Span after start\""), 1u);
+}
+
+TEST(Tracing, RecordsNothingWhileStopped)
+{
+  Common::Tracing::Start();
+  {
+    TRACE_SCOPE("Test", "Before stop");
+  }
+  StopAndRead();
+
+  EXPECT_FALSE(Common::Tracing::IsEnabled());
+  {
+    TRACE_SCOPE("Test", "While stopped");
+  }
+
+  // A span that is open when tracing starts isn't recorded either.
+  {
+    TRACE_SCOPE("Test", "Open at start");
+    Common::Tracing::Start();
+  }
+  const std::string trace = StopAndRead();
+  EXPECT_EQ(trace.find("Before stop"), std::string::npos);
+  EXPECT_EQ(trace.find("While stopped"), std::string::npos);
+  EXPECT_EQ(trace.find("Open at start"), std::string::npos);
+}
@@ -0,0 +1,218 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/CheatSearch.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 TEST_MEMORY_SIZE = 0x100000;
+
+class CheatSearchTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    SConfig::Init();
+    Core::System::GetInstance().GetMemory().Init();
+    Core::DeclareAsCPUThread();
+  }
+
+  static void TearDownTestSuite()
+  {
+    Core::UndeclareAsCPUThread();
+    Core::System::GetInstance().GetMemory().Shutdown();
+    SConfig::Shutdown();
+  }
+
+  void SetUp() override
+  {
+    m_system.GetPowerPC().Reset();
+    m_memory.Memset(0, 0, TEST_MEMORY_SIZE);
+  }
+
+  template <typename T>
+  Cheats::SearchResults<T> NewSearch(const std::vector<Cheats::MemoryRange>& ranges, bool aligned,
+                                     const Cheats::SearchFilter<T>& filter)
+  {
+    const Core::CPUThreadGuard guard(m_system);
+    auto results = Cheats::NewSearch<T>(guard, ranges, PowerPC::RequestedAddressSpace::Physical,
+                                        aligned, filter);
+    if (!results)
+    {
+      ADD_FAILURE() << "New search failed";
+      return {};
+    }
+    return std::move(*results);
+  }
+
+  template <typename T>
+  Cheats::SearchResults<T> NextSearch(const Cheats::SearchResults<T>& previous,
+                                      const Cheats::SearchFilter<T>& filter)
+  {
+    const Core::CPUThreadGuard guard(m_system);
+    auto results =
+        Cheats::NextSearch<T>(guard, previous, PowerPC::RequestedAddressSpace::Physical, filter);
+    if (!results)
+    {
+      ADD_FAILURE() << "Next search failed";
+      return {};
+    }
+    return std::move(*results);
+  }
+
+  template <typename T>
+  static std::vector<u32> GetAddresses(const Cheats::SearchResults<T>& results)
+  {
+    std::vector<u32> addresses;
+    for (size_t i = 0; i < results.Size(); ++i)
+      addresses.push_back(results.GetAddress(i));
+    return addresses;
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+};
+
+template <typename T>
+Cheats::SearchFilter<T> MakeFilter(Cheats::CompareType compare_type, T value)
+{
+  return {Cheats::FilterType::CompareAgainstSpecificValue, compare_type, value};
+}
+
+template <typename T>
+Cheats::SearchFilter<T> MakeFilter(Cheats::FilterType filter_type,
+                                   Cheats::CompareType compare_type = Cheats::CompareType::Equal)
+{
+  return {filter_type, compare_type, T{}};
+}
+}  // namespace
+
+TEST_F(CheatSearchTest, NewSearchFindsValuesInEverySegment)
+{
+  const std::vector<u32> expected{0x1000, 0x1ffc, 0x10000, 0x10004, 0x23450, 0x2fffc};
+  for (const u32 address : expected)
+    m_memory.Write_U32(0x12345678, address);
+  // Only aligned values are candidates.
+  m_memory.Write_U32(0x12345678, 0x1002);
+
+  const auto results =
+      NewSearch<u32>({{0x1000, 0x1000}, {0x10000, 0x100}, {0x20000, 0x10000}}, true,
+                     MakeFilter<u32>(Cheats::CompareType::Equal, 0x12345678));
+  EXPECT_EQ(GetAddresses(results), expected);
+  EXPECT_EQ(results.GetValidValueCount(), expected.size());
+  for (size_t i = 0; i < results.Size(); ++i)
+  {
+    EXPECT_EQ(results.GetValue(i), 0x12345678u);
+    EXPECT_EQ(results.GetValueState(i), Cheats::SearchResultValueState::ValueFromPhysicalMemory);
+  }
+}
+
+TEST_F(CheatSearchTest, ParallelSearchMatchesEveryCandidate)
+{
+  // Large enough to be split across several threads, with values straddling every page.
+  for (u32 address = 0; address < TEST_MEMORY_SIZE; ++address)
+    m_memory.Write_U8(static_cast<u8>(address * 7 + (address >> 12)), address);
+
+  std::vector<u32> expected;
+  for (u32 address = 0; address + sizeof(u16) <= TEST_MEMORY_SIZE; ++address)
+  {
+    if (m_memory.Read_U16(address) < 0x0400)
+      expected.push_back(address);
+  }
+  ASSERT_FALSE(expected.empty());
+
+  const auto results = NewSearch<u16>({{0, TEST_MEMORY_SIZE}}, false,
+                                      MakeFilter<u16>(Cheats::CompareType::Less, 0x0400));
+  ASSERT_EQ(GetAddresses(results), expected);
+  for (size_t i = 0; i < results.Size(); ++i)
+    EXPECT_EQ(results.GetValue(i), m_memory.Read_U16(expected[i])) << i;
+}
+
+TEST_F(CheatSearchTest, NextSearchComparesAgainstLastValues)
+{
+  const auto first = NewSearch<u8>({{0x4000, 0x2000}}, false,
+                                   MakeFilter<u8>(Cheats::FilterType::DoNotFilter));
+  ASSERT_EQ(first.Size(), 0x2000u);
+
+  const std::vector<u32> changed{0x4000, 0x403f, 0x4040, 0x5123, 0x5fff};
+  for (const u32 address : changed)
+    m_memory.Write_U8(0x42, address);
+
+  const auto second = NextSearch(first, MakeFilter<u8>(Cheats::FilterType::CompareAgainstLastValue,
+                                                      Cheats::CompareType::NotEqual));
+  EXPECT_EQ(GetAddresses(second), changed);
+  for (size_t i = 0; i < second.Size(); ++i)
+    EXPECT_EQ(second.GetValue(i), 0x42);
+
+  // Unchanged values are filtered out again.
+  const auto third = NextSearch(second, MakeFilter<u8>(Cheats::FilterType::CompareAgainstLastValue,
+                                                      Cheats::CompareType::NotEqual));
+  EXPECT_EQ(third.Size(), 0u);
+}
+
+TEST_F(CheatSearchTest, RemoveKeepsLaterIndicesInOrder)
+{
+  // One result in each of several bitmap words, and several in one word.
+  const std::vector<u32> addresses{0x100, 0x200, 0x204, 0x208, 0x300, 0x400};
+  for (const u32 address : addresses)
+    m_memory.Write_U32(0xdeadbeef, address);
+
+  auto results = NewSearch<u32>({{0, 0x1000}}, true,
+                                MakeFilter<u32>(Cheats::CompareType::Equal, 0xdeadbeef));
+  ASSERT_EQ(GetAddresses(results), addresses);
+
+  results.Remove(2);
+  EXPECT_EQ(GetAddresses(results), (std::vector<u32>{0x100, 0x200, 0x208, 0x300, 0x400}));
+  results.Remove(0);
+  results.Remove(3);
+  EXPECT_EQ(GetAddresses(results), (std::vector<u32>{0x200, 0x208, 0x300}));
+  EXPECT_EQ(results.GetValidValueCount(), 3u);
+
+  // A removed result doesn't come back in a next search.
+  const auto next = NextSearch(results, MakeFilter<u32>(Cheats::FilterType::DoNotFilter));
+  EXPECT_EQ(GetAddresses(next), GetAddresses(results));
+}
+
+TEST_F(CheatSearchTest, SliceOnlyCoversTheSlicedResults)
+{
+  const auto results = NewSearch<u8>({{0, 0x1000}, {0x10000, 0x1000}, {0x20000, 0x1000}}, false,
+                                     MakeFilter<u8>(Cheats::FilterType::DoNotFilter));
+  ASSERT_EQ(results.Size(), 0x3000u);
+  EXPECT_EQ(results.GetWordCount(), 3 * 0x1000u / 64);
+
+  // The slice crosses from the first segment into the second one.
+  const auto slice = results.Slice(0xf80, 0x10c0);
+  ASSERT_EQ(slice.Size(), 0x140u);
+  for (size_t i = 0; i < slice.Size(); ++i)
+    EXPECT_EQ(slice.GetAddress(i), results.GetAddress(0xf80 + i)) << i;
+  EXPECT_EQ(slice.GetWordCount(), 5u);
+
+  m_memory.Write_U8(0x99, 0xfff);
+  m_memory.Write_U8(0x99, 0x10000);
+  const auto next = NextSearch(slice, MakeFilter<u8>(Cheats::CompareType::Equal, 0x99));
+  EXPECT_EQ(GetAddresses(next), (std::vector<u32>{0xfff, 0x10000}));
+
+  // Results in the middle of a word keep their neighbours out of the slice.
+  const auto middle = results.Slice(0x2005, 0x2007);
+  EXPECT_EQ(GetAddresses(middle), (std::vector<u32>{0x20005, 0x20006}));
+  EXPECT_EQ(middle.GetWordCount(), 1u);
+
+  const auto empty = results.Slice(10, 10);
+  EXPECT_EQ(empty.Size(), 0u);
+  EXPECT_EQ(empty.GetWordCount(), 0u);
+  EXPECT_EQ(NextSearch(empty, MakeFilter<u8>(Cheats::FilterType::DoNotFilter)).Size(), 0u);
+
+  // The end is clamped to the number of results.
+  EXPECT_EQ(results.Slice(0x2ff0, 0x5000).Size(), 0x10u);
+}
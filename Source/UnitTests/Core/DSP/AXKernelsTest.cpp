@@ -0,0 +1,141 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXKernels.h"
+
+namespace
+{
+// Longest frame processed by AX Wii, plus some extra to test unaligned tails.
+constexpr u32 MAX_COUNT = 100;
+
+s16 ClampS16(s64 sample)
+{
+  return std::clamp<s64>(sample, -0x8000, 0x7FFF);
+}
+
+// Reference implementations, matching the scalar loops previously used by AXVoice.h.
+s16 ReferenceApplyVolumeEnvelope(s16* samples, u32 count, s16 cur_volume, s16 volume_delta,
+                                 bool unsigned_volume)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 volume = unsigned_volume ? (u16)cur_volume : (s16)cur_volume;
+    const s32 sample = ((s32)samples[i] * volume) >> 15;
+    samples[i] = ClampS16(sample);
+    cur_volume += volume_delta;
+  }
+  return cur_volume;
+}
+
+u16 ReferenceMixAdd(int* out, const s16* input, u32 count, u16 volume, u16 volume_delta,
+                    s16* dpop)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    s16 sample16 = ClampS16((s32)sample);
+
+    out[i] += sample16;
+    volume += volume_delta;
+
+    *dpop = sample16;
+  }
+  return volume;
+}
+
+// Random voice data with a bias towards the extreme values, where saturation happens.
+class VoiceDataGenerator
+{
+public:
+  s16 Sample()
+  {
+    switch (m_dist(m_rng) % 8)
+    {
+    case 0:
+      return -0x8000;
+    case 1:
+      return 0x7FFF;
+    default:
+      return static_cast<s16>(m_dist(m_rng));
+    }
+  }
+
+  u16 Value() { return static_cast<u16>(m_dist(m_rng)); }
+
+  std::array<s16, MAX_COUNT> Samples()
+  {
+    std::array<s16, MAX_COUNT> samples;
+    std::ranges::generate(samples, [this] { return Sample(); });
+    return samples;
+  }
+
+private:
+  std::mt19937 m_rng{0x4158};
+  std::uniform_int_distribution<u32> m_dist{0, 0xFFFF};
+};
+}  // namespace
+
+TEST(AXKernels, VolumeEnvelopeMatchesReference)
+{
+  VoiceDataGenerator gen;
+
+  for (int iteration = 0; iteration < 2000; ++iteration)
+  {
+    const u32 count = iteration % (MAX_COUNT + 1);
+    const s16 volume = static_cast<s16>(gen.Value());
+    const s16 delta = iteration % 4 == 0 ? 0 : static_cast<s16>(gen.Value());
+
+    for (const bool unsigned_volume : {false, true})
+    {
+      std::array<s16, MAX_COUNT> expected = gen.Samples();
+      std::array<s16, MAX_COUNT> actual = expected;
+
+      const s16 expected_volume = ReferenceApplyVolumeEnvelope(expected.data(), count, volume,
+                                                               delta, unsigned_volume);
+      const s16 actual_volume =
+          DSP::HLE::AXKernels::ApplyVolumeEnvelope(actual.data(), count, volume, delta,
+                                                   unsigned_volume);
+
+      EXPECT_EQ(expected_volume, actual_volume);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(AXKernels, MixAddMatchesReference)
+{
+  VoiceDataGenerator gen;
+
+  for (int iteration = 0; iteration < 2000; ++iteration)
+  {
+    const u32 count = iteration % (MAX_COUNT + 1);
+    const std::array<s16, MAX_COUNT> input = gen.Samples();
+    const u16 volume = gen.Value();
+    const u16 delta = iteration % 4 == 0 ? 0 : gen.Value();
+
+    std::array<int, MAX_COUNT> expected;
+    std::ranges::generate(expected, [&gen] { return gen.Sample() * 4; });
+    std::array<int, MAX_COUNT> actual = expected;
+
+    s16 expected_dpop = 0x1234;
+    s16 actual_dpop = 0x1234;
+
+    const u16 expected_volume =
+        ReferenceMixAdd(expected.data(), input.data(), count, volume, delta, &expected_dpop);
+    const u16 actual_volume = DSP::HLE::AXKernels::MixAdd(actual.data(), input.data(), count,
+                                                          volume, delta, &actual_dpop);
+
+    EXPECT_EQ(expected_volume, actual_volume);
+    EXPECT_EQ(expected_dpop, actual_dpop);
+    EXPECT_EQ(expected, actual);
+  }
+}
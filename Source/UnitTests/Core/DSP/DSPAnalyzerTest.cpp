@@ -0,0 +1,134 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPTables.h"
+
+#include <gtest/gtest.h>
+
+class DSPAnalyzerTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite() { DSP::InitInstructionTable(); }
+
+  DSPAnalyzerTest() { analyzer.SetSkipDeadFlagUpdates(true); }
+
+  DSP::Analyzer analyzer;
+};
+
+TEST_F(DSPAnalyzerTest, FlagsAreAlwaysUpdatedByDefault)
+{
+  static constexpr std::array<u16, 3> code = {
+      0xb100,  // 0: TST $acc0
+      0xb900,  // 1: TST $acc1
+      0x0021,  // 2: HALT
+  };
+  DSP::Analyzer default_analyzer;
+  default_analyzer.Analyze(code);
+
+  EXPECT_TRUE(default_analyzer.IsUpdateSR(0));
+  EXPECT_FALSE(default_analyzer.IsUpdateSRStickyOnly(0));
+  EXPECT_TRUE(default_analyzer.IsUpdateSR(1));
+}
+
+TEST_F(DSPAnalyzerTest, OverwrittenFlagsAreDead)
+{
+  static constexpr std::array<u16, 5> code = {
+      0xb100,          // 0: TST $acc0
+      0xb900,          // 1: TST $acc1
+      0x0295, 0x0000,  // 2: JZ 0x0000
+      0x0021,          // 4: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_FALSE(analyzer.IsUpdateSR(0));
+  EXPECT_TRUE(analyzer.IsUpdateSR(1));
+}
+
+TEST_F(DSPAnalyzerTest, FlagsAreLiveAcrossBranches)
+{
+  static constexpr std::array<u16, 6> code = {
+      0xb100,          // 0: TST $acc0
+      0x029f, 0x0004,  // 1: JMP 0x0004
+      0xb900,          // 3: TST $acc1
+      0x0021,          // 4: HALT
+      0x0021,          // 5: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(0));
+  EXPECT_TRUE(analyzer.IsUpdateSR(3));
+}
+
+TEST_F(DSPAnalyzerTest, StickyOverflowIsKept)
+{
+  static constexpr std::array<u16, 3> code = {
+      0x4c00,  // 0: ADD $acc0, $acc1
+      0xb100,  // 1: TST $acc0
+      0x0021,  // 2: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(0));
+  EXPECT_TRUE(analyzer.IsUpdateSRStickyOnly(0));
+  EXPECT_FALSE(analyzer.IsUpdateSRStickyOnly(1));
+}
+
+TEST_F(DSPAnalyzerTest, ReadingSRKeepsFlagsLive)
+{
+  static constexpr std::array<u16, 4> code = {
+      0xb100,  // 0: TST $acc0
+      0x1fd3,  // 1: MRR $ac0.m, $sr
+      0xb900,  // 2: TST $acc1
+      0x0021,  // 3: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(0));
+}
+
+TEST_F(DSPAnalyzerTest, LogicZeroIsTrackedSeparately)
+{
+  static constexpr std::array<u16, 7> code = {
+      0xb100,          // 0: TST $acc0
+      0x02c0, 0x8000,  // 1: ANDCF $ac0.m, #0x8000
+      0x0295, 0x0000,  // 3: JZ 0x0000
+      0xb900,          // 5: TST $acc1
+      0x0021,          // 6: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(0));
+  EXPECT_TRUE(analyzer.IsUpdateSR(1));
+}
+
+TEST_F(DSPAnalyzerTest, FlagsAreLiveAtLoopEnd)
+{
+  static constexpr std::array<u16, 5> code = {
+      0x1104, 0x0002,  // 0: BLOOPI #4, 0x0002
+      0xb100,          // 2: TST $acc0
+      0xb900,          // 3: TST $acc1
+      0x0021,          // 4: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(2));
+}
+
+TEST_F(DSPAnalyzerTest, InstructionsThatKeepFlagsDoNotKillThem)
+{
+  static constexpr std::array<u16, 6> code = {
+      0x8200,          // 0: CMP
+      0x0801,          // 1: LRIS $ax0.l, #0x01
+      0x9000,          // 2: MUL $ax0.l, $ax0.h
+      0x0295, 0x0000,  // 3: JZ 0x0000
+      0x0021,          // 5: HALT
+  };
+  analyzer.Analyze(code);
+
+  EXPECT_TRUE(analyzer.IsUpdateSR(0));
+  EXPECT_FALSE(analyzer.IsUpdateSRStickyOnly(0));
+}
@@ -0,0 +1,116 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/DSPHLE/RenderMemory.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 PB_ADDR = 0x1000;
+constexpr u32 OUTPUT_ADDR = 0x2000;
+
+class RenderMemoryTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    SConfig::Init();
+    Core::System::GetInstance().GetMemory().Init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    Core::System::GetInstance().GetMemory().Shutdown();
+    SConfig::Shutdown();
+  }
+
+  void SetUp() override
+  {
+    m_memory.Memset(PB_ADDR, 0, 0x2000);
+    m_memory.Write_U32(0x11223344, PB_ADDR);
+  }
+
+  Memory::MemoryManager& m_memory = Core::System::GetInstance().GetMemory();
+  DSP::HLE::RenderMemory m_render_memory{m_memory};
+};
+}  // namespace
+
+TEST_F(RenderMemoryTest, DirectAccessesGuestMemory)
+{
+  EXPECT_FALSE(m_render_memory.IsDeferred());
+
+  u32 value = 0;
+  m_render_memory.CopyFromEmuSwapped(&value, PB_ADDR, sizeof(value));
+  EXPECT_EQ(value, 0x11223344u);
+
+  const u32 output = 0xCAFEBABE;
+  m_render_memory.CopyToEmuSwapped(OUTPUT_ADDR, &output, sizeof(output));
+  EXPECT_EQ(m_memory.Read_U32(OUTPUT_ADDR), 0xCAFEBABEu);
+}
+
+TEST_F(RenderMemoryTest, DeferredReadsComeFromCapture)
+{
+  m_render_memory.BeginDeferred();
+  m_render_memory.Capture(PB_ADDR, 0x100);
+  EXPECT_TRUE(m_render_memory.IsCaptured(PB_ADDR + 4, 4));
+  EXPECT_FALSE(m_render_memory.IsCaptured(PB_ADDR + 0xFE, 4));
+
+  // The game keeps running while the command list is rendered.
+  m_memory.Write_U32(0x55667788, PB_ADDR);
+
+  u32 value = 0;
+  m_render_memory.CopyFromEmuSwapped(&value, PB_ADDR, sizeof(value));
+  EXPECT_EQ(value, 0x11223344u);
+
+  m_render_memory.ApplyDeferredWrites();
+  m_render_memory.CopyFromEmuSwapped(&value, PB_ADDR, sizeof(value));
+  EXPECT_EQ(value, 0x55667788u);
+}
+
+TEST_F(RenderMemoryTest, DeferredUncapturedReadIsZero)
+{
+  m_render_memory.BeginDeferred();
+
+  u32 value = 0xFFFFFFFF;
+  m_render_memory.CopyFromEmuSwapped(&value, PB_ADDR, sizeof(value));
+  EXPECT_EQ(value, 0u);
+
+  m_render_memory.ApplyDeferredWrites();
+}
+
+TEST_F(RenderMemoryTest, DeferredWritesAreAppliedInOrder)
+{
+  m_render_memory.BeginDeferred();
+  m_render_memory.Capture(PB_ADDR, 0x100);
+
+  const std::array<u16, 4> first{1, 2, 3, 4};
+  const std::array<u16, 2> second{5, 6};
+  m_render_memory.CopyToEmuSwapped(PB_ADDR + 4, first.data(), sizeof(first));
+  m_render_memory.CopyToEmuSwapped(PB_ADDR + 8, second.data(), sizeof(second));
+  m_render_memory.CopyToEmuSwapped(OUTPUT_ADDR, second.data(), sizeof(second));
+
+  // Nothing reaches guest memory until the CPU thread applies the writes.
+  EXPECT_EQ(m_memory.Read_U16(PB_ADDR + 4), 0);
+  EXPECT_EQ(m_memory.Read_U16(OUTPUT_ADDR), 0);
+
+  // Reads see the buffered writes on top of the captured data.
+  std::array<u16, 6> pb{};
+  m_render_memory.CopyFromEmuSwapped(pb.data(), PB_ADDR + 2, sizeof(pb));
+  EXPECT_EQ(pb, (std::array<u16, 6>{0x3344, 1, 2, 5, 6, 0}));
+
+  m_render_memory.ApplyDeferredWrites();
+  EXPECT_FALSE(m_render_memory.IsDeferred());
+  EXPECT_EQ(m_memory.Read_U16(PB_ADDR + 4), 1);
+  EXPECT_EQ(m_memory.Read_U16(PB_ADDR + 6), 2);
+  EXPECT_EQ(m_memory.Read_U16(PB_ADDR + 8), 5);
+  EXPECT_EQ(m_memory.Read_U16(PB_ADDR + 10), 6);
+  EXPECT_EQ(m_memory.Read_U16(OUTPUT_ADDR), 5);
+  EXPECT_EQ(m_memory.Read_U16(OUTPUT_ADDR + 2), 6);
+}
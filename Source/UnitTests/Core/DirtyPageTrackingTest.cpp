@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 PAGE_SIZE = Memory::MemoryManager::DIRTY_PAGE_SIZE;
+
+class DirtyPageTrackingTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    SConfig::Init();
+    Core::System::GetInstance().GetMemory().Init();
+    Core::DeclareAsCPUThread();
+  }
+
+  static void TearDownTestSuite()
+  {
+    Core::UndeclareAsCPUThread();
+    Core::System::GetInstance().GetMemory().Shutdown();
+    SConfig::Shutdown();
+  }
+
+  void SetUp() override { m_system.GetPowerPC().Reset(); }
+  void TearDown() override { SetEnabled(false); }
+
+  void SetEnabled(bool enabled)
+  {
+    const Core::CPUThreadGuard guard(m_system);
+    m_memory.SetDirtyPageTrackingEnabled(guard, enabled);
+  }
+
+  std::vector<u32> Collect()
+  {
+    std::vector<u32> pages;
+    m_memory.CollectDirtyPages(pages);
+    return pages;
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+};
+}  // namespace
+
+TEST_F(DirtyPageTrackingTest, DisabledByDefault)
+{
+  EXPECT_FALSE(m_memory.IsDirtyPageTrackingEnabled());
+  m_memory.Write_U32(1, 5 * PAGE_SIZE);
+  EXPECT_TRUE(Collect().empty());
+}
+
+TEST_F(DirtyPageTrackingTest, CollectReturnsAndResetsDirtyPages)
+{
+  SetEnabled(true);
+  EXPECT_TRUE(m_memory.IsDirtyPageTrackingEnabled());
+  EXPECT_TRUE(Collect().empty());
+
+  m_memory.Write_U32(1, 5 * PAGE_SIZE + 0x10);
+  m_memory.Write_U8(2, 2 * PAGE_SIZE);
+  EXPECT_EQ(Collect(), (std::vector<u32>{2 * PAGE_SIZE, 5 * PAGE_SIZE}));
+  EXPECT_TRUE(Collect().empty());
+}
+
+TEST_F(DirtyPageTrackingTest, WritesAcrossPagesMarkBoth)
+{
+  SetEnabled(true);
+
+  const u32 value = 0x12345678;
+  m_memory.CopyToEmu(8 * PAGE_SIZE - 2, &value, sizeof(value));
+  EXPECT_EQ(Collect(), (std::vector<u32>{7 * PAGE_SIZE, 8 * PAGE_SIZE}));
+
+  m_memory.Memset(10 * PAGE_SIZE, 0, 3 * PAGE_SIZE);
+  EXPECT_EQ(Collect(), (std::vector<u32>{10 * PAGE_SIZE, 11 * PAGE_SIZE, 12 * PAGE_SIZE}));
+}
+
+TEST_F(DirtyPageTrackingTest, PointersForWritingMarkPages)
+{
+  SetEnabled(true);
+
+  // Devices like memory cards and IOS write to the pointer they get from GetPointerForRange.
+  u8* const pointer = m_memory.GetPointerForRange(6 * PAGE_SIZE - 4, 8);
+  ASSERT_NE(pointer, nullptr);
+  EXPECT_EQ(Collect(), (std::vector<u32>{5 * PAGE_SIZE, 6 * PAGE_SIZE}));
+
+  EXPECT_NE(m_memory.GetReadPointerForRange(6 * PAGE_SIZE, PAGE_SIZE), nullptr);
+  u32 value;
+  m_memory.CopyFromEmu(&value, 9 * PAGE_SIZE, sizeof(value));
+  EXPECT_TRUE(Collect().empty());
+}
+
+TEST_F(DirtyPageTrackingTest, CPUStoresMarkPages)
+{
+  SetEnabled(true);
+
+  // Data translation is off after a reset, so this is a store to physical memory.
+  m_system.GetMMU().Write<u32>(1, 3 * PAGE_SIZE + 4);
+  EXPECT_EQ(Collect(), (std::vector<u32>{3 * PAGE_SIZE}));
+}
+
+TEST_F(DirtyPageTrackingTest, TogglingResetsPages)
+{
+  SetEnabled(true);
+  m_memory.Write_U32(1, 4 * PAGE_SIZE);
+  SetEnabled(false);
+  EXPECT_FALSE(m_memory.IsDirtyPageTrackingEnabled());
+  SetEnabled(true);
+  EXPECT_TRUE(Collect().empty());
+
+  m_memory.MarkAllDirty();
+  EXPECT_EQ(Collect().size(), m_memory.GetRamSize() / PAGE_SIZE);
+}
+
+// Times collecting the dirty pages of MEM1. The timings are only printed, so this is disabled by
+// default. Run it with:
+//   tests --gtest_also_run_disabled_tests --gtest_filter=DirtyPageTrackingTest.*
+TEST_F(DirtyPageTrackingTest, DISABLED_CollectBenchmark)
+{
+  SetEnabled(true);
+
+  std::vector<u32> pages;
+  for (const u32 stride : {m_memory.GetRamSize(), 64 * PAGE_SIZE, PAGE_SIZE})
+  {
+    constexpr int ITERATIONS = 1000;
+    std::chrono::steady_clock::duration total{};
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+      for (u32 address = 0; address < m_memory.GetRamSize(); address += stride)
+        m_memory.Write_U32(i, address);
+
+      const auto start = std::chrono::steady_clock::now();
+      m_memory.CollectDirtyPages(pages);
+      total += std::chrono::steady_clock::now() - start;
+    }
+
+    fmt::print("{:>5} dirty pages: {:>8.0f}ns per collect\n", pages.size(),
+               std::chrono::duration<double, std::nano>(total).count() / ITERATIONS);
+  }
+}
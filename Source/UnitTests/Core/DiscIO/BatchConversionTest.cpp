@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/StringUtil.h"
+#include "DiscIO/BatchConversion.h"
+
+using DiscIO::BatchConversionInput;
+using DiscIO::PlanBatchConversion;
+
+TEST(BatchConversion, KeepsDirectoryLayout)
+{
+  const std::vector<BatchConversionInput> inputs = {
+      {"games/x/a.iso", "games"},
+      {"games/y/a.iso", "games"},
+      {"other/b.gcz", ""},
+  };
+
+  const auto jobs = PlanBatchConversion(inputs, "out", ".rvz");
+  ASSERT_TRUE(jobs.has_value()) << jobs.error();
+  ASSERT_EQ(jobs->size(), 3u);
+  EXPECT_EQ((*jobs)[0].input_path, "games/x/a.iso");
+  EXPECT_EQ(WithUnifiedPathSeparators((*jobs)[0].output_path), "out/x/a.rvz");
+  EXPECT_EQ((*jobs)[1].input_path, "games/y/a.iso");
+  EXPECT_EQ(WithUnifiedPathSeparators((*jobs)[1].output_path), "out/y/a.rvz");
+  EXPECT_EQ((*jobs)[2].input_path, "other/b.gcz");
+  EXPECT_EQ(WithUnifiedPathSeparators((*jobs)[2].output_path), "out/b.rvz");
+}
+
+TEST(BatchConversion, DuplicateOutputFails)
+{
+  const std::vector<BatchConversionInput> same_directory = {
+      {"games/a.iso", "games"},
+      {"games/a.gcz", "games"},
+  };
+  EXPECT_FALSE(PlanBatchConversion(same_directory, "out", ".rvz").has_value());
+
+  const std::vector<BatchConversionInput> passed_directly = {
+      {"x/a.iso", ""},
+      {"y/a.iso", ""},
+  };
+  EXPECT_FALSE(PlanBatchConversion(passed_directly, "out", ".rvz").has_value());
+}
+
+TEST(BatchConversion, OutputOverwritingInputFails)
+{
+  // a.iso would be written to games/a.rvz, which is converted at the same time.
+  const std::vector<BatchConversionInput> other_input = {
+      {"games/a.iso", "games"},
+      {"games/a.rvz", "games"},
+  };
+  EXPECT_FALSE(PlanBatchConversion(other_input, "games", ".rvz").has_value());
+
+  // Different spellings of the same path are caught too.
+  const std::vector<BatchConversionInput> own_input = {
+      {"games/a.rvz", "games"},
+  };
+  EXPECT_FALSE(PlanBatchConversion(own_input, "./games/", ".rvz").has_value());
+}
@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/MemoryWatcherRing.h"
+
+using MemoryWatcherRing::Reader;
+using MemoryWatcherRing::Writer;
+
+class MemoryWatcherRingTest : public testing::Test
+{
+protected:
+  MemoryWatcherRingTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/ring") {}
+
+  ~MemoryWatcherRingTest() override
+  {
+    m_reader.Close();
+    m_writer.Close();
+    File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_writer.Open(m_path, 4096));
+    ASSERT_TRUE(m_reader.Open(m_path));
+  }
+
+  void WriteBatch(u64 frame, u32 watch, u8 fill, size_t size)
+  {
+    const std::vector<u8> data(size, fill);
+    m_writer.BeginBatch(frame);
+    m_writer.AddEntry(watch, 0, 0x80000000 + watch, data);
+    ASSERT_TRUE(m_writer.EndBatch());
+  }
+
+  void ExpectBatch(u64 frame, u32 watch, u8 fill, size_t size)
+  {
+    Reader::Batch batch;
+    ASSERT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Success);
+    EXPECT_EQ(batch.frame, frame);
+    ASSERT_EQ(batch.entries.size(), 1u);
+    EXPECT_EQ(batch.entries[0].watch, watch);
+    EXPECT_EQ(batch.entries[0].address, 0x80000000 + watch);
+    ASSERT_EQ(batch.entries[0].data.size(), size);
+    for (const u8 byte : batch.entries[0].data)
+      EXPECT_EQ(byte, fill);
+  }
+
+  std::string m_directory;
+  std::string m_path;
+  Writer m_writer;
+  Reader m_reader;
+};
+
+TEST_F(MemoryWatcherRingTest, RoundTrip)
+{
+  Reader::Batch batch;
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Empty);
+
+  static constexpr std::array<u8, 3> first = {1, 2, 3};
+  static constexpr std::array<u8, 8> second = {4, 5, 6, 7, 8, 9, 10, 11};
+  m_writer.BeginBatch(7, MemoryWatcherRing::BATCH_FLAG_SNAPSHOT);
+  m_writer.AddEntry(0, 0, 0x80001000, first);
+  m_writer.AddEntry(2, 0x20, 0x80002020, second);
+  ASSERT_TRUE(m_writer.EndBatch());
+
+  ASSERT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Success);
+  EXPECT_EQ(batch.frame, 7u);
+  EXPECT_EQ(batch.flags, MemoryWatcherRing::BATCH_FLAG_SNAPSHOT);
+  ASSERT_EQ(batch.entries.size(), 2u);
+  EXPECT_EQ(batch.entries[0].watch, 0u);
+  EXPECT_EQ(batch.entries[0].address, 0x80001000u);
+  EXPECT_TRUE(std::ranges::equal(batch.entries[0].data, first));
+  EXPECT_EQ(batch.entries[1].watch, 2u);
+  EXPECT_EQ(batch.entries[1].offset, 0x20u);
+  EXPECT_EQ(batch.entries[1].address, 0x80002020u);
+  EXPECT_TRUE(std::ranges::equal(batch.entries[1].data, second));
+
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Empty);
+}
+
+TEST_F(MemoryWatcherRingTest, EmptyBatchesAreNotPublished)
+{
+  m_writer.BeginBatch(0);
+  ASSERT_TRUE(m_writer.EndBatch());
+
+  Reader::Batch batch;
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Empty);
+}
+
+TEST_F(MemoryWatcherRingTest, WrapsAround)
+{
+  // 1000 byte batches don't divide the 4096 byte ring evenly, so this hits the padding records.
+  for (u64 frame = 0; frame < 50; ++frame)
+  {
+    WriteBatch(frame, static_cast<u32>(frame % 5), static_cast<u8>(frame), 1000);
+    ExpectBatch(frame, static_cast<u32>(frame % 5), static_cast<u8>(frame), 1000);
+  }
+}
+
+TEST_F(MemoryWatcherRingTest, ReaderCatchesUp)
+{
+  for (u64 frame = 0; frame < 3; ++frame)
+    WriteBatch(frame, 1, static_cast<u8>(frame), 500);
+  for (u64 frame = 0; frame < 3; ++frame)
+    ExpectBatch(frame, 1, static_cast<u8>(frame), 500);
+}
+
+TEST_F(MemoryWatcherRingTest, OverrunRequestsSnapshot)
+{
+  // Opening the reader requests a snapshot.
+  EXPECT_TRUE(m_writer.TakeSnapshotRequest());
+  EXPECT_FALSE(m_writer.TakeSnapshotRequest());
+
+  for (u64 frame = 0; frame < 20; ++frame)
+    WriteBatch(frame, 0, static_cast<u8>(frame), 1000);
+
+  Reader::Batch batch;
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Overrun);
+  EXPECT_TRUE(m_writer.TakeSnapshotRequest());
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Empty);
+
+  WriteBatch(20, 0, 20, 1000);
+  ExpectBatch(20, 0, 20, 1000);
+}
+
+TEST_F(MemoryWatcherRingTest, OversizedBatchIsDropped)
+{
+  const std::vector<u8> data(8192);
+  m_writer.BeginBatch(0);
+  m_writer.AddEntry(0, 0, 0, data);
+  EXPECT_FALSE(m_writer.EndBatch());
+
+  Reader::Batch batch;
+  EXPECT_EQ(m_reader.Read(&batch), Reader::ReadStatus::Empty);
+}
+
+TEST_F(MemoryWatcherRingTest, ReaderRejectsOtherFiles)
+{
+  const std::string path = m_directory + "/not_a_ring";
+  ASSERT_TRUE(File::WriteStringToFile(path, std::string(0x1100, 'x')));
+
+  Reader reader;
+  EXPECT_FALSE(reader.Open(path));
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/MemoryWatcher.h"
+
+TEST(MemoryWatcher, ParsesSingleValue)
+{
+  const MemoryWatcher::Watch watch = MemoryWatcher::ParseLine("80001234");
+  EXPECT_EQ(watch.line, "80001234");
+  EXPECT_EQ(watch.offsets, std::vector<u32>{0x80001234});
+  EXPECT_EQ(watch.length, 0u);
+  EXPECT_EQ(watch.value.size(), sizeof(u32));
+  EXPECT_FALSE(watch.IsIgnored());
+}
+
+TEST(MemoryWatcher, ParsesPointerChain)
+{
+  const MemoryWatcher::Watch watch = MemoryWatcher::ParseLine("ABCD EF 10");
+  EXPECT_EQ(watch.offsets, (std::vector<u32>{0xABCD, 0xEF, 0x10}));
+  EXPECT_EQ(watch.length, 0u);
+  EXPECT_EQ(watch.value.size(), sizeof(u32));
+}
+
+TEST(MemoryWatcher, ParsesRange)
+{
+  const MemoryWatcher::Watch watch = MemoryWatcher::ParseLine("ABCD EF:40");
+  EXPECT_EQ(watch.line, "ABCD EF:40");
+  EXPECT_EQ(watch.offsets, (std::vector<u32>{0xABCD, 0xEF}));
+  EXPECT_EQ(watch.length, 0x40u);
+  EXPECT_EQ(watch.value.size(), 0x40u);
+  EXPECT_FALSE(watch.IsIgnored());
+
+  const MemoryWatcher::Watch largest = MemoryWatcher::ParseLine("80000000:100000");
+  EXPECT_EQ(largest.length, 0x100000u);
+  EXPECT_EQ(largest.value.size(), 0x100000u);
+}
+
+TEST(MemoryWatcher, RangeWithoutLengthWatchesValue)
+{
+  for (const char* line : {"80001234:", "80001234:zz", "80001234:0"})
+  {
+    const MemoryWatcher::Watch watch = MemoryWatcher::ParseLine(line);
+    EXPECT_EQ(watch.offsets, std::vector<u32>{0x80001234}) << line;
+    EXPECT_EQ(watch.length, 0u) << line;
+    EXPECT_EQ(watch.value.size(), sizeof(u32)) << line;
+  }
+}
+
+TEST(MemoryWatcher, IgnoresOversizedRange)
+{
+  // The watch is still returned, so that it keeps its index among the watches.
+  const MemoryWatcher::Watch watch = MemoryWatcher::ParseLine("80000000:100001");
+  EXPECT_EQ(watch.line, "80000000:100001");
+  EXPECT_TRUE(watch.IsIgnored());
+}
@@ -0,0 +1,323 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Movie.h"
+#include "Core/MovieFormat.h"
+
+using Movie::DTMHeader;
+using Movie::MovieKeyframe;
+
+class MovieFormatTest : public testing::Test
+{
+protected:
+  MovieFormatTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/movie.dtm") {}
+
+  ~MovieFormatTest() override { File::DeleteDirRecursively(m_directory); }
+
+  static DTMHeader MakeHeader()
+  {
+    DTMHeader header{};
+    header.filetype = {'D', 'T', 'M', 0x1A};
+    header.gameID = {'G', 'A', 'L', 'E', '0', '1'};
+    header.frameCount = 1234;
+    header.numRerecords = 5;
+    return header;
+  }
+
+  static std::vector<u8> MakeInput(size_t size)
+  {
+    std::vector<u8> input(size);
+    for (size_t i = 0; i < size; ++i)
+      input[i] = static_cast<u8>((i * 7) ^ (i >> 9));
+    return input;
+  }
+
+  static std::vector<u8> MakeState(u64 frame)
+  {
+    std::vector<u8> state(10000);
+    std::iota(state.begin(), state.end(), static_cast<u8>(frame));
+    return state;
+  }
+
+  static void ExpectState(const std::vector<u8>& state, u64 frame)
+  {
+    ASSERT_EQ(state.size(), 10000u) << frame;
+    EXPECT_EQ(state[0], static_cast<u8>(frame)) << frame;
+    EXPECT_EQ(state[9999], static_cast<u8>(frame + 9999)) << frame;
+  }
+
+  // Appends a keyframe, whose savestate is added to m_states.
+  void AddKeyframe(std::vector<MovieKeyframe>* keyframes, u64 frame, bool with_state)
+  {
+    MovieKeyframe keyframe;
+    keyframe.frame = frame;
+    keyframe.input_byte = frame * 8;
+    keyframe.input_count = frame * 2;
+    keyframe.lag_count = frame / 10;
+    keyframe.tick_count = frame * 8100000;
+    keyframe.memory_hash = 0x0123456789ABCDEF ^ frame;
+    if (with_state)
+      EXPECT_TRUE(m_states.AddState(MakeState(frame), *keyframes, &keyframe)) << frame;
+    keyframes->push_back(keyframe);
+  }
+
+  std::vector<MovieKeyframe> MakeKeyframes()
+  {
+    std::vector<MovieKeyframe> keyframes;
+    AddKeyframe(&keyframes, 0, true);
+    AddKeyframe(&keyframes, 600, false);
+    AddKeyframe(&keyframes, 1200, true);
+    return keyframes;
+  }
+
+  bool Read(DTMHeader* header, std::vector<u8>* input, std::vector<MovieKeyframe>* keyframes)
+  {
+    File::IOFile file(m_path, "rb");
+    return Movie::ReadMovieFile(file, header, input, keyframes);
+  }
+
+  std::string m_directory;
+  std::string m_path;
+  Movie::KeyframeStateFile m_states;
+};
+
+TEST_F(MovieFormatTest, ReadsVersion1)
+{
+  const DTMHeader header = MakeHeader();
+  const std::vector<u8> input = MakeInput(1000);
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+    ASSERT_TRUE(file.WriteBytes(input.data(), input.size()));
+  }
+
+  DTMHeader read_header;
+  std::vector<u8> read_input;
+  std::vector<MovieKeyframe> keyframes;
+  AddKeyframe(&keyframes, 1, false);
+  ASSERT_TRUE(Read(&read_header, &read_input, &keyframes));
+  EXPECT_TRUE(Movie::IsMovieHeader(read_header.filetype));
+  EXPECT_EQ(read_header.frameCount, header.frameCount);
+  EXPECT_EQ(read_input, input);
+  EXPECT_TRUE(keyframes.empty());
+}
+
+TEST_F(MovieFormatTest, IndexedRoundTrip)
+{
+  const DTMHeader header = MakeHeader();
+  // Spans several input blocks, with a partial one at the end.
+  const std::vector<u8> input = MakeInput(Movie::DTM_INPUT_BLOCK_SIZE * 3 + 123);
+  const std::vector<MovieKeyframe> keyframes = MakeKeyframes();
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, header, input, keyframes, m_states));
+  }
+
+  DTMHeader read_header;
+  std::vector<u8> read_input;
+  std::vector<MovieKeyframe> read_keyframes;
+  ASSERT_TRUE(Read(&read_header, &read_input, &read_keyframes));
+  EXPECT_TRUE(Movie::IsIndexedMovieHeader(read_header.filetype));
+  EXPECT_FALSE(Movie::IsMovieHeader(read_header.filetype));
+  EXPECT_EQ(read_header.GetGameID(), "GALE01");
+  EXPECT_EQ(read_header.numRerecords, header.numRerecords);
+  EXPECT_EQ(read_input, input);
+
+  ASSERT_EQ(read_keyframes.size(), keyframes.size());
+  for (size_t i = 0; i < keyframes.size(); ++i)
+  {
+    EXPECT_EQ(read_keyframes[i].frame, keyframes[i].frame);
+    EXPECT_EQ(read_keyframes[i].input_byte, keyframes[i].input_byte);
+    EXPECT_EQ(read_keyframes[i].input_count, keyframes[i].input_count);
+    EXPECT_EQ(read_keyframes[i].lag_count, keyframes[i].lag_count);
+    EXPECT_EQ(read_keyframes[i].tick_count, keyframes[i].tick_count);
+    EXPECT_EQ(read_keyframes[i].memory_hash, keyframes[i].memory_hash);
+    EXPECT_EQ(read_keyframes[i].HasState(), keyframes[i].HasState());
+    EXPECT_EQ(read_keyframes[i].state_compressed_size, keyframes[i].state_compressed_size);
+    EXPECT_EQ(read_keyframes[i].state_size, keyframes[i].state_size);
+  }
+
+  // The states are read from the movie file when they are needed.
+  Movie::KeyframeStateFile read_states;
+  read_states.SetMovieFile(File::IOFile(m_path, "rb"), m_path);
+  EXPECT_EQ(read_states.GetMoviePath(), m_path);
+
+  std::vector<u8> state;
+  ASSERT_TRUE(read_states.ReadState(read_keyframes[2], &state));
+  ExpectState(state, 1200);
+  ASSERT_TRUE(read_states.ReadState(read_keyframes[0], &state));
+  ExpectState(state, 0);
+  EXPECT_FALSE(read_states.ReadState(read_keyframes[1], &state));
+
+  std::vector<u8> compressed;
+  std::vector<u8> read_compressed;
+  ASSERT_TRUE(m_states.ReadCompressedState(keyframes[2], &compressed));
+  ASSERT_TRUE(read_states.ReadCompressedState(read_keyframes[2], &read_compressed));
+  EXPECT_EQ(read_compressed, compressed);
+}
+
+TEST_F(MovieFormatTest, EmptyIndexedMovie)
+{
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, MakeHeader(), {}, {}, m_states));
+  }
+
+  DTMHeader header;
+  std::vector<u8> input = MakeInput(10);
+  std::vector<MovieKeyframe> keyframes;
+  ASSERT_TRUE(Read(&header, &input, &keyframes));
+  EXPECT_TRUE(input.empty());
+  EXPECT_TRUE(keyframes.empty());
+}
+
+TEST_F(MovieFormatTest, RejectsTruncatedIndexedMovie)
+{
+  const std::vector<u8> input = MakeInput(Movie::DTM_INPUT_BLOCK_SIZE * 2);
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, MakeHeader(), input, {}, m_states));
+  }
+  {
+    File::IOFile file(m_path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 1));
+  }
+
+  DTMHeader header;
+  std::vector<u8> read_input;
+  std::vector<MovieKeyframe> keyframes;
+  EXPECT_FALSE(Read(&header, &read_input, &keyframes));
+}
+
+TEST_F(MovieFormatTest, FindKeyframe)
+{
+  std::vector<MovieKeyframe> keyframes;
+  AddKeyframe(&keyframes, 100, true);
+  AddKeyframe(&keyframes, 200, false);
+  AddKeyframe(&keyframes, 300, true);
+
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 99), nullptr);
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 100), &keyframes[0]);
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 299), &keyframes[1]);
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 299, true), &keyframes[0]);
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 300, true), &keyframes[2]);
+  EXPECT_EQ(Movie::FindKeyframe(keyframes, 100000, true), &keyframes[2]);
+  EXPECT_EQ(Movie::FindKeyframe({}, 100), nullptr);
+}
+
+TEST_F(MovieFormatTest, SeeksToKeyframeWithState)
+{
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, MakeHeader(), MakeInput(10000), MakeKeyframes(),
+                                             m_states));
+  }
+
+  DTMHeader header;
+  std::vector<u8> input;
+  std::vector<MovieKeyframe> read_keyframes;
+  ASSERT_TRUE(Read(&header, &input, &read_keyframes));
+  Movie::KeyframeStateFile read_states;
+  read_states.SetMovieFile(File::IOFile(m_path, "rb"), m_path);
+
+  // Seeks resume from the last keyframe with a savestate, skipping the one without.
+  for (const auto [frame, keyframe_frame] :
+       {std::pair<u64, u64>{0, 0}, {599, 0}, {700, 0}, {1199, 0}, {1200, 1200}, {5000, 1200}})
+  {
+    std::vector<u8> state;
+    const MovieKeyframe* keyframe =
+        Movie::LoadSeekState(read_keyframes, read_states, frame, &state);
+    ASSERT_NE(keyframe, nullptr) << frame;
+    EXPECT_EQ(keyframe->frame, keyframe_frame) << frame;
+    ExpectState(state, keyframe_frame);
+  }
+
+  // A keyframe whose savestate doesn't decompress can't be seeked to.
+  read_keyframes[2].state_compressed_size /= 2;
+  std::vector<u8> state;
+  EXPECT_EQ(Movie::LoadSeekState(read_keyframes, read_states, 1200, &state), nullptr);
+  EXPECT_EQ(Movie::LoadSeekState({}, read_states, 1200, &state), nullptr);
+}
+
+TEST_F(MovieFormatTest, RejectsOversizedState)
+{
+  const std::vector<u8> compressed = Movie::CompressKeyframeState(MakeState(0));
+  std::vector<u8> state;
+  ASSERT_TRUE(Movie::DecompressKeyframeState(compressed, 10000, &state));
+  ExpectState(state, 0);
+
+  // Sizes that the compressed data can't expand to are rejected before the state is resized.
+  state.clear();
+  EXPECT_FALSE(Movie::DecompressKeyframeState(compressed, Movie::MAX_KEYFRAME_STATE_SIZE + 1,
+                                              &state));
+  EXPECT_FALSE(Movie::DecompressKeyframeState(compressed, Movie::MAX_KEYFRAME_STATE_SIZE, &state));
+  EXPECT_FALSE(Movie::DecompressKeyframeState({}, 10000, &state));
+  EXPECT_TRUE(state.empty());
+}
+
+TEST_F(MovieFormatTest, AddStateOverwritesRemovedKeyframes)
+{
+  std::vector<MovieKeyframe> keyframes = MakeKeyframes();
+  AddKeyframe(&keyframes, 1800, true);
+  const u64 removed_offset = keyframes[2].state_offset;
+
+  // Going back to an earlier savestate removes the later keyframes.
+  keyframes.resize(2);
+  AddKeyframe(&keyframes, 900, true);
+  EXPECT_EQ(keyframes[2].state_offset, removed_offset);
+
+  std::vector<u8> state;
+  ASSERT_TRUE(m_states.ReadState(keyframes[0], &state));
+  ExpectState(state, 0);
+  ASSERT_TRUE(m_states.ReadState(keyframes[2], &state));
+  ExpectState(state, 900);
+}
+
+TEST_F(MovieFormatTest, MovesStatesOutOfMovieFile)
+{
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, MakeHeader(), MakeInput(100), MakeKeyframes(),
+                                             m_states));
+  }
+
+  DTMHeader header;
+  std::vector<u8> input;
+  std::vector<MovieKeyframe> keyframes;
+  ASSERT_TRUE(Read(&header, &input, &keyframes));
+  m_states.SetMovieFile(File::IOFile(m_path, "rb"), m_path);
+
+  // Recording on top of the movie copies its states out of the movie file first.
+  AddKeyframe(&keyframes, 1800, true);
+  EXPECT_TRUE(m_states.GetMoviePath().empty());
+
+  // So that the movie file can be overwritten.
+  {
+    File::IOFile file(m_path, "wb");
+    ASSERT_TRUE(Movie::WriteIndexedMovieFile(file, MakeHeader(), {}, {}, m_states));
+  }
+
+  std::vector<u8> state;
+  for (const MovieKeyframe& keyframe : keyframes)
+  {
+    if (!keyframe.HasState())
+      continue;
+    ASSERT_TRUE(m_states.ReadState(keyframe, &state)) << keyframe.frame;
+    ExpectState(state, keyframe.frame);
+  }
+
+  // Moving the states again keeps them readable.
+  EXPECT_TRUE(m_states.MoveToTemporaryFile(keyframes));
+  ASSERT_TRUE(m_states.ReadState(keyframes[2], &state));
+  ExpectState(state, 1200);
+}
@@ -0,0 +1,230 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MovieFormat.h"
+#include "Core/MovieVerifier.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+using Movie::MovieVerifier;
+
+class MovieVerifierTest : public testing::Test
+{
+protected:
+  MovieVerifierTest()
+      : m_directory(File::CreateTempDir()), m_hashes_path(m_directory + "/movie.dtm.hashes")
+  {
+  }
+
+  ~MovieVerifierTest() override { File::DeleteDirRecursively(m_directory); }
+
+  static void SetUpTestSuite()
+  {
+    SConfig::Init();
+    Core::System::GetInstance().GetMemory().Init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    Core::System::GetInstance().GetMemory().Shutdown();
+    SConfig::Shutdown();
+  }
+
+  void SetUp() override
+  {
+    m_memory.Memset(0, 0, m_memory.GetRamSizeReal());
+    m_system.GetPPCState().gpr[3] = 0;
+  }
+
+  MovieVerifier MakeVerifier(MovieVerifier::Mode mode, u32 interval = 1)
+  {
+    return MovieVerifier(mode, m_hashes_path, interval,
+                         [this](const MovieVerifier::Result& result) {
+                           m_results.push_back(result);
+                         });
+  }
+
+  // Records the hashes of frames 0 to frame_count - 1, with the RAM changing on every frame.
+  void Record(u64 frame_count, u32 interval)
+  {
+    MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Record, interval);
+    ASSERT_TRUE(verifier.Start({}));
+    for (u64 frame = 0; frame < frame_count; ++frame)
+    {
+      m_memory.Write_U32(static_cast<u32>(frame), 0x1000);
+      verifier.FrameUpdate(m_system, frame);
+    }
+    verifier.Finish(frame_count);
+    ASSERT_EQ(m_results.size(), 1u);
+    m_results.clear();
+  }
+
+  bool StartWithHashesFile(const std::string& contents)
+  {
+    EXPECT_TRUE(File::WriteStringToFile(m_hashes_path, contents));
+    MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+    return verifier.Start({});
+  }
+
+  std::string m_directory;
+  std::string m_hashes_path;
+  std::vector<MovieVerifier::Result> m_results;
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+};
+
+TEST_F(MovieVerifierTest, RecordsEveryIntervalthFrame)
+{
+  Record(7, 3);
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_hashes_path, contents));
+  const std::vector<std::string> lines = SplitString(contents, '\n');
+  // A comment, then frames 0, 3 and 6.
+  ASSERT_EQ(lines.size(), 4u);
+  EXPECT_TRUE(lines[0].starts_with('#'));
+  EXPECT_TRUE(lines[1].starts_with("0 "));
+  EXPECT_TRUE(lines[2].starts_with("3 "));
+  EXPECT_TRUE(lines[3].starts_with("6 "));
+}
+
+TEST_F(MovieVerifierTest, VerifiesRecordedHashes)
+{
+  Record(10, 2);
+
+  MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+  ASSERT_TRUE(verifier.Start({}));
+  for (u64 frame = 0; frame < 10; ++frame)
+  {
+    m_memory.Write_U32(static_cast<u32>(frame), 0x1000);
+    verifier.FrameUpdate(m_system, frame);
+  }
+  verifier.Finish(10);
+
+  ASSERT_EQ(m_results.size(), 1u);
+  EXPECT_FALSE(m_results[0].diverged);
+  EXPECT_EQ(m_results[0].frame, 10u);
+  EXPECT_EQ(m_results[0].frames_checked, 5u);
+}
+
+TEST_F(MovieVerifierTest, ReportsFirstDivergence)
+{
+  Record(10, 1);
+
+  MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+  ASSERT_TRUE(verifier.Start({}));
+  for (u64 frame = 0; frame < 10; ++frame)
+  {
+    m_memory.Write_U32(static_cast<u32>(frame), 0x1000);
+    if (frame == 4)
+    {
+      m_memory.Write_U8(0xff, 0x2000);
+      m_system.GetPPCState().gpr[3] = 0x12345678;
+    }
+    verifier.FrameUpdate(m_system, frame);
+  }
+  // Only the first divergence is reported.
+  verifier.Finish(10);
+
+  ASSERT_EQ(m_results.size(), 1u);
+  EXPECT_TRUE(m_results[0].diverged);
+  EXPECT_EQ(m_results[0].frame, 4u);
+  EXPECT_EQ(m_results[0].frames_checked, 5u);
+  EXPECT_EQ(m_results[0].regions, "MEM1, CPU");
+}
+
+TEST_F(MovieVerifierTest, SkipsFramesThatWereNotPlayed)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_hashes_path, "0 0 0 0 0\n5 0 0 0 0\n"));
+
+  // Frames before the first one that is played, like after seeking, aren't checked.
+  MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+  ASSERT_TRUE(verifier.Start({}));
+  verifier.FrameUpdate(m_system, 3);
+  verifier.FrameUpdate(m_system, 4);
+  verifier.Finish(4);
+
+  ASSERT_EQ(m_results.size(), 1u);
+  EXPECT_FALSE(m_results[0].diverged);
+  EXPECT_EQ(m_results[0].frames_checked, 0u);
+}
+
+TEST_F(MovieVerifierTest, ParsesCommentsAndWhitespace)
+{
+  EXPECT_TRUE(StartWithHashesFile("# frame mem1 mem2 aram cpu\n"
+                                  "\n"
+                                  "  0 1 2 3 4  \n"
+                                  "# A comment between frames\n"
+                                  "10 ffffffffffffffff 0 0 ABCDEF\r\n"
+                                  "20 0 0 0 0"));
+}
+
+TEST_F(MovieVerifierTest, RejectsMalformedHashesFile)
+{
+  for (const char* contents : {
+           // Too few or too many fields.
+           "0 1 2 3\n",
+           "0 1 2 3 4 5\n",
+           // Not a number.
+           "0 1 2 3 xyz\n",
+           "frame 1 2 3 4\n",
+           // The frame is decimal.
+           "a 1 2 3 4\n",
+           // Frames have to be increasing.
+           "10 1 2 3 4\n5 1 2 3 4\n",
+           "10 1 2 3 4\n10 1 2 3 4\n",
+           // A valid line before an invalid one.
+           "0 1 2 3 4\n1 1 2 3\n",
+       })
+  {
+    EXPECT_FALSE(StartWithHashesFile(contents)) << contents;
+  }
+}
+
+TEST_F(MovieVerifierTest, RejectsEmptyHashesFile)
+{
+  EXPECT_FALSE(StartWithHashesFile(""));
+  EXPECT_FALSE(StartWithHashesFile("# frame mem1 mem2 aram cpu\n\n"));
+}
+
+TEST_F(MovieVerifierTest, VerifiesAgainstKeyframes)
+{
+  std::vector<Movie::MovieKeyframe> keyframes(2);
+  keyframes[0].frame = 2;
+  keyframes[0].memory_hash = m_memory.ComputeHash();
+  keyframes[1].frame = 5;
+  keyframes[1].memory_hash = m_memory.ComputeHash();
+
+  MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+  ASSERT_TRUE(verifier.Start(keyframes));
+  verifier.FrameUpdate(m_system, 2);
+  m_memory.Write_U8(0xff, 0x2000);
+  verifier.FrameUpdate(m_system, 5);
+
+  ASSERT_EQ(m_results.size(), 1u);
+  EXPECT_TRUE(m_results[0].diverged);
+  EXPECT_EQ(m_results[0].frame, 5u);
+  EXPECT_EQ(m_results[0].frames_checked, 2u);
+  EXPECT_EQ(m_results[0].regions, "MEM1/MEM2");
+}
+
+TEST_F(MovieVerifierTest, NeedsSomethingToVerifyAgainst)
+{
+  MovieVerifier verifier = MakeVerifier(MovieVerifier::Mode::Verify);
+  EXPECT_FALSE(verifier.Start({}));
+
+  // Keyframes with a savestate have a hash-only twin, which is the one that is checked.
+  std::vector<Movie::MovieKeyframe> keyframes(1);
+  keyframes[0].state_compressed_size = 100;
+  EXPECT_FALSE(verifier.Start(keyframes));
+}
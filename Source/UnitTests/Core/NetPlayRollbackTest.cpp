@@ -0,0 +1,419 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <span>
+
+#include <gtest/gtest.h>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRollback.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::RollbackController;
+using NetPlay::RollbackSession;
+
+namespace
+{
+constexpr size_t NUM_PLAYERS = 2;
+
+// The input that a player gives on the given poll. It changes every few polls so that some
+// predictions are right and some are wrong.
+GCPadStatus GetPlayerInput(size_t player, u64 index)
+{
+  const u64 seed = ((index / (3 + player)) + player * 1000) * 0x9E3779B97F4A7C15;
+  GCPadStatus status;
+  status.button = static_cast<u16>(seed >> 48) & 0x0F7F;
+  status.stickX = static_cast<u8>(seed >> 40);
+  status.stickY = static_cast<u8>(seed >> 32);
+  return status;
+}
+
+// A deterministic stand-in for the emulated game.
+struct ToyGame
+{
+  u64 frame = 0;
+  std::array<s32, NUM_PLAYERS> x{};
+  std::array<s32, NUM_PLAYERS> y{};
+  u64 checksum = 0;
+
+  void RunFrame(const std::array<GCPadStatus, NUM_PLAYERS>& inputs)
+  {
+    for (size_t i = 0; i < NUM_PLAYERS; ++i)
+    {
+      x[i] += inputs[i].stickX - GCPadStatus::MAIN_STICK_CENTER_X;
+      y[i] += inputs[i].stickY - GCPadStatus::MAIN_STICK_CENTER_Y;
+      checksum = (checksum ^ inputs[i].button ^ static_cast<u32>(x[i] * 31 + y[i])) *
+                 0x100000001B3;
+    }
+    ++frame;
+  }
+
+  bool operator==(const ToyGame&) const = default;
+};
+
+ToyGame RunReference(u64 frames)
+{
+  ToyGame game;
+  while (game.frame < frames)
+  {
+    std::array<GCPadStatus, NUM_PLAYERS> inputs;
+    for (size_t i = 0; i < NUM_PLAYERS; ++i)
+      inputs[i] = GetPlayerInput(i, game.frame);
+    game.RunFrame(inputs);
+  }
+  return game;
+}
+
+// One player, running the toy game the way the CPU thread runs the emulation: a safe point at the
+// start of every frame, and then a poll of every pad. Both go through RollbackController, like in
+// NetPlayClient, and the peer stops where NetPlayClient would wait for an input.
+class LoopbackPeer final : private NetPlay::RollbackHost
+{
+public:
+  LoopbackPeer(size_t player, u32 max_frames) : m_player(player), m_controller(max_frames, *this)
+  {
+  }
+
+  // Runs until the game has to wait for an input or reaches the last frame. Returns the inputs
+  // that this player polled for the other one.
+  std::deque<GCPadStatus> Run(u64 last_frame)
+  {
+    m_sent.clear();
+    while (true)
+    {
+      if (!m_polling)
+      {
+        if (m_game.frame == last_frame && !m_controller.GetRollbackFrame())
+          break;
+
+        const auto result = m_controller.TryRunSafePoint();
+        if (result == RollbackController::SafePointResult::Wait)
+          break;
+        if (result == RollbackController::SafePointResult::RolledBack)
+          ++m_rollbacks;
+
+        if (m_resimulating)
+          ++m_resimulated_frames;
+        m_polling = true;
+        m_next_pad = 0;
+      }
+
+      for (; m_next_pad < NUM_PLAYERS; ++m_next_pad)
+      {
+        const std::optional<GCPadStatus> input = m_controller.TryGetInput(m_next_pad);
+        if (!input)
+        {
+          ++m_stalls;
+          return std::move(m_sent);
+        }
+        m_inputs[m_next_pad] = *input;
+      }
+
+      m_game.RunFrame(m_inputs);
+      m_polling = false;
+    }
+    return std::move(m_sent);
+  }
+
+  void Receive(size_t pad, const GCPadStatus& input) { m_controller.AddRemoteInput(pad, input); }
+
+  const ToyGame& GetGame() const { return m_game; }
+  const RollbackController& GetController() const { return m_controller; }
+  u32 GetRollbacks() const { return m_rollbacks; }
+  u32 GetResimulatedFrames() const { return m_resimulated_frames; }
+  u32 GetStalls() const { return m_stalls; }
+
+private:
+  bool IsLocalPad(size_t pad) const override { return pad == m_player; }
+
+  GCPadStatus PollLocalInput(size_t pad) override
+  {
+    EXPECT_EQ(pad, m_player);
+    const GCPadStatus input = GetPlayerInput(m_player, m_local_inputs++);
+    m_sent.push_back(input);
+    return input;
+  }
+
+  size_t SaveState(Common::UniqueBuffer<u8>& buffer) override
+  {
+    if (buffer.size() < sizeof(ToyGame))
+      buffer.reset(sizeof(ToyGame));
+    std::memcpy(buffer.data(), &m_game, sizeof(ToyGame));
+    return sizeof(ToyGame);
+  }
+
+  bool LoadState(std::span<u8> state) override
+  {
+    if (state.size() != sizeof(ToyGame))
+      return false;
+    std::memcpy(&m_game, state.data(), sizeof(ToyGame));
+    return true;
+  }
+
+  void SetResimulating(bool resimulating) override { m_resimulating = resimulating; }
+
+  size_t m_player;
+  RollbackController m_controller;
+  ToyGame m_game;
+  u64 m_local_inputs = 0;
+  std::deque<GCPadStatus> m_sent;
+  bool m_resimulating = false;
+
+  bool m_polling = false;
+  size_t m_next_pad = 0;
+  std::array<GCPadStatus, NUM_PLAYERS> m_inputs{};
+
+  u32 m_rollbacks = 0;
+  u32 m_resimulated_frames = 0;
+  u32 m_stalls = 0;
+};
+
+struct InFlightInput
+{
+  u64 arrival;
+  size_t pad;
+  GCPadStatus input;
+};
+
+struct LoopbackResult
+{
+  u32 rollbacks = 0;
+  u32 resimulated_frames = 0;
+  u32 stalls = 0;
+};
+
+// Runs both players a frame at a time, with inputs taking latency frames to reach the other one.
+LoopbackResult RunLoopback(u32 max_frames, u64 latency, u64 last_frame)
+{
+  std::array<LoopbackPeer, NUM_PLAYERS> peers = {LoopbackPeer(0, max_frames),
+                                                 LoopbackPeer(1, max_frames)};
+  std::array<std::deque<InFlightInput>, NUM_PLAYERS> in_flight;
+
+  for (u64 tick = 0; tick < last_frame * 4; ++tick)
+  {
+    for (size_t player = 0; player < NUM_PLAYERS; ++player)
+    {
+      std::deque<InFlightInput>& incoming = in_flight[player];
+      while (!incoming.empty() && incoming.front().arrival <= tick)
+      {
+        peers[player].Receive(incoming.front().pad, incoming.front().input);
+        incoming.pop_front();
+      }
+
+      // Only one frame per tick, so that both players run at the same speed.
+      const u64 frame = std::min(peers[player].GetGame().frame + 1, last_frame);
+      for (const GCPadStatus& input : peers[player].Run(frame))
+        in_flight[1 - player].push_back({tick + latency, player, input});
+    }
+  }
+
+  const ToyGame reference = RunReference(last_frame);
+  LoopbackResult result;
+  for (const LoopbackPeer& peer : peers)
+  {
+    EXPECT_EQ(peer.GetGame(), reference);
+    EXPECT_FALSE(peer.GetController().GetRollbackFrame().has_value());
+    result.rollbacks += peer.GetRollbacks();
+    result.resimulated_frames += peer.GetResimulatedFrames();
+    result.stalls += peer.GetStalls();
+  }
+  return result;
+}
+}  // namespace
+
+TEST(NetPlayRollback, PredictsLastConfirmedInput)
+{
+  RollbackSession session(4);
+  EXPECT_FALSE(session.HasInput(0));
+  EXPECT_FALSE(session.CanPredict(0));
+
+  session.AdvanceFrame();
+  EXPECT_TRUE(session.CanPredict(0));
+  EXPECT_EQ(session.GetInput(0).button, 0);
+
+  // Matches the prediction of the first input.
+  session.AddInput(0, GCPadStatus{});
+  GCPadStatus input;
+  input.button = PAD_BUTTON_A;
+  session.AddInput(0, input);
+  EXPECT_FALSE(session.GetRollbackFrame().has_value());
+
+  session.AdvanceFrame();
+  EXPECT_TRUE(session.HasInput(0));
+  EXPECT_EQ(session.GetInput(0).button, PAD_BUTTON_A);
+  EXPECT_FALSE(session.HasInput(0));
+  EXPECT_EQ(session.GetInput(0).button, PAD_BUTTON_A);
+  session.AddInput(0, input);
+  EXPECT_FALSE(session.GetRollbackFrame().has_value());
+}
+
+TEST(NetPlayRollback, RollsBackToFrameOfMisprediction)
+{
+  RollbackSession session(4);
+  for (u64 frame = 0; frame < 3; ++frame)
+  {
+    session.AdvanceFrame().state_size = frame + 1;
+    session.GetInput(0);
+  }
+
+  // The input of frame 0 was right, the one of frame 1 wasn't.
+  session.AddInput(0, GCPadStatus{});
+  GCPadStatus input;
+  input.button = PAD_BUTTON_B;
+  session.AddInput(0, input);
+  ASSERT_EQ(session.GetRollbackFrame(), 1u);
+
+  const RollbackSession::SavedFrame& saved = session.RollBack(1);
+  EXPECT_EQ(saved.frame, 1u);
+  EXPECT_EQ(saved.state_size, 2u);
+  EXPECT_FALSE(session.GetRollbackFrame().has_value());
+  EXPECT_TRUE(session.IsResimulating());
+
+  EXPECT_EQ(session.GetInput(0).button, PAD_BUTTON_B);
+  session.AdvanceFrame();
+  EXPECT_TRUE(session.IsResimulating());
+  EXPECT_EQ(session.GetInput(0).button, PAD_BUTTON_B);
+  session.AdvanceFrame();
+  EXPECT_FALSE(session.IsResimulating());
+}
+
+TEST(NetPlayRollback, LimitsPredictionToMaxFrames)
+{
+  RollbackSession session(2);
+  session.AdvanceFrame();
+  ASSERT_TRUE(session.CanPredict(0));
+  session.GetInput(0);
+  session.AdvanceFrame();
+  ASSERT_TRUE(session.CanPredict(0));
+  session.GetInput(0);
+  session.AdvanceFrame();
+  EXPECT_FALSE(session.CanPredict(0));
+  EXPECT_FALSE(session.CanAdvanceFrame());
+
+  session.AddInput(0, GCPadStatus{});
+  EXPECT_TRUE(session.CanPredict(0));
+  EXPECT_TRUE(session.CanAdvanceFrame());
+}
+
+TEST(NetPlayRollback, LoopbackResyncs)
+{
+  const LoopbackResult result = RunLoopback(8, 3, 600);
+  EXPECT_GT(result.rollbacks, 0u);
+  EXPECT_GT(result.resimulated_frames, 0u);
+  EXPECT_LE(result.resimulated_frames, result.rollbacks * 8);
+  EXPECT_EQ(result.stalls, 0u);
+}
+
+TEST(NetPlayRollback, LoopbackStallsBeyondMaxFrames)
+{
+  const LoopbackResult result = RunLoopback(2, 5, 300);
+  EXPECT_GT(result.rollbacks, 0u);
+  EXPECT_GT(result.stalls, 0u);
+}
+
+namespace
+{
+// Records what RollbackController asks of the emulator. The state is just the frame number.
+class RecordingHost final : public NetPlay::RollbackHost
+{
+public:
+  bool IsLocalPad(size_t pad) const override { return pad == 0; }
+
+  GCPadStatus PollLocalInput(size_t) override
+  {
+    GCPadStatus input;
+    input.button = static_cast<u16>(++polls);
+    return input;
+  }
+
+  size_t SaveState(Common::UniqueBuffer<u8>& buffer) override
+  {
+    if (buffer.size() < sizeof(frame))
+      buffer.reset(sizeof(frame));
+    std::memcpy(buffer.data(), &frame, sizeof(frame));
+    return sizeof(frame);
+  }
+
+  bool LoadState(std::span<u8> state) override
+  {
+    std::memcpy(&frame, state.data(), sizeof(frame));
+    ++loads;
+    return true;
+  }
+
+  void SetResimulating(bool resimulating_) override { resimulating = resimulating_; }
+
+  u64 frame = 0;
+  u32 polls = 0;
+  u32 loads = 0;
+  bool resimulating = false;
+};
+}  // namespace
+
+TEST(NetPlayRollback, ControllerPollsLocalPadsOnce)
+{
+  RecordingHost host;
+  RollbackController controller(4, host);
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+
+  // The local pad is polled when the game asks for its input. The remote one is predicted.
+  EXPECT_EQ(controller.TryGetInput(0)->button, 1);
+  EXPECT_EQ(controller.TryGetInput(1)->button, 0);
+  EXPECT_EQ(host.polls, 1u);
+  host.frame = 1;
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+  EXPECT_EQ(controller.TryGetInput(0)->button, 2);
+  EXPECT_EQ(controller.TryGetInput(1)->button, 0);
+  host.frame = 2;
+
+  // The remote input of frame 0 was mispredicted, so frame 0 is loaded and run again with the
+  // local inputs that were polled the first time.
+  GCPadStatus remote;
+  remote.button = PAD_BUTTON_X;
+  controller.AddRemoteInput(1, remote);
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::RolledBack);
+  EXPECT_EQ(host.loads, 1u);
+  EXPECT_EQ(host.frame, 0u);
+  EXPECT_TRUE(host.resimulating);
+  EXPECT_EQ(controller.TryGetInput(0)->button, 1);
+  EXPECT_EQ(controller.TryGetInput(1)->button, PAD_BUTTON_X);
+
+  host.frame = 1;
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+  EXPECT_TRUE(host.resimulating);
+  EXPECT_EQ(controller.TryGetInput(0)->button, 2);
+  // The remote input of frame 1 is now predicted from the confirmed one.
+  EXPECT_EQ(controller.TryGetInput(1)->button, PAD_BUTTON_X);
+
+  host.frame = 2;
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+  EXPECT_FALSE(host.resimulating);
+  EXPECT_EQ(controller.TryGetInput(0)->button, 3);
+  EXPECT_EQ(host.polls, 3u);
+
+  const RollbackController::SnapshotStats& stats = controller.GetSnapshotStats();
+  EXPECT_EQ(stats.states_saved, 4u);
+  EXPECT_EQ(stats.states_loaded, 1u);
+  EXPECT_EQ(stats.state_size, sizeof(host.frame));
+  EXPECT_LE(stats.max_save_time, stats.total_save_time);
+  EXPECT_LE(stats.max_load_time, stats.total_load_time);
+}
+
+TEST(NetPlayRollback, ControllerWaitsBeyondMaxFrames)
+{
+  RecordingHost host;
+  RollbackController controller(1, host);
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+  ASSERT_TRUE(controller.TryGetInput(1).has_value());
+  ASSERT_EQ(controller.TryRunSafePoint(), RollbackController::SafePointResult::Saved);
+
+  // One frame ahead of the missing remote input is as far as a rollback can fix.
+  EXPECT_FALSE(controller.TryGetInput(1).has_value());
+  controller.AddRemoteInput(1, GCPadStatus{});
+  EXPECT_TRUE(controller.TryGetInput(1).has_value());
+}
@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayStateHash.h"
+
+using NetPlay::HashedRegion;
+using NetPlay::StateHasher;
+
+namespace
+{
+constexpr u32 PAGE_SIZE = StateHasher::PAGE_SIZE;
+
+// The memory of one player.
+struct Instance
+{
+  Instance(u32 frames_per_window, u32 commit_delay)
+      : mem1(PAGE_SIZE * 24), aram(PAGE_SIZE * 2 + 0x100), hasher(frames_per_window, commit_delay)
+  {
+    for (size_t i = 0; i < mem1.size(); ++i)
+      mem1[i] = static_cast<u8>(i * 7);
+  }
+
+  std::array<HashedRegion, 2> GetRegions() const
+  {
+    return {{{"MEM1", 0x80000000, mem1}, {"ARAM", 0, aram}}};
+  }
+
+  void HashFrame(u64 frame)
+  {
+    const std::array<HashedRegion, 2> regions = GetRegions();
+    hasher.HashFrame(frame, regions, cpu_hash, 0);
+  }
+
+  std::vector<u8> mem1;
+  std::vector<u8> aram;
+  u64 cpu_hash = 0;
+  StateHasher hasher;
+};
+}  // namespace
+
+TEST(NetPlayStateHash, InstancesWithSameStateMatch)
+{
+  Instance a(10, 0), b(10, 0);
+  for (u64 frame = 0; frame < 30; ++frame)
+  {
+    a.HashFrame(frame);
+    b.HashFrame(frame);
+  }
+
+  for (u32 index = 0; index < 3; ++index)
+  {
+    ASSERT_EQ(a.hasher.PopCompletedWindow(), index);
+    ASSERT_EQ(b.hasher.PopCompletedWindow(), index);
+    const StateHasher::Window* window_a = a.hasher.GetWindow(index);
+    const StateHasher::Window* window_b = b.hasher.GetWindow(index);
+    ASSERT_TRUE(window_a && window_b);
+    EXPECT_EQ(window_a->last_frame, index * 10 + 9);
+    EXPECT_EQ(window_a->GetDigest(), window_b->GetDigest());
+    EXPECT_EQ(StateHasher::DescribeDifference(a.GetRegions(), *window_a, *window_b), "");
+  }
+  EXPECT_FALSE(a.hasher.PopCompletedWindow().has_value());
+}
+
+TEST(NetPlayStateHash, FindsFirstDifferingPage)
+{
+  Instance a(8, 0), b(8, 0);
+  b.mem1[PAGE_SIZE * 5 + 0x123] ^= 1;
+  b.mem1[PAGE_SIZE * 20] ^= 1;
+  b.aram.back() = 1;
+  for (u64 frame = 0; frame < 8; ++frame)
+  {
+    a.HashFrame(frame);
+    b.HashFrame(frame);
+  }
+
+  ASSERT_EQ(a.hasher.PopCompletedWindow(), 0u);
+  const StateHasher::Window& window_a = *a.hasher.GetWindow(0);
+  const StateHasher::Window& window_b = *b.hasher.GetWindow(0);
+  EXPECT_NE(window_a.GetDigest(), window_b.GetDigest());
+  EXPECT_EQ(StateHasher::DescribeDifference(a.GetRegions(), window_a, window_b),
+            "MEM1 0x80050000-0x8005ffff, 2 more pages");
+}
+
+TEST(NetPlayStateHash, ReportsPartialLastPage)
+{
+  Instance a(4, 0), b(4, 0);
+  b.aram.back() = 1;
+  b.cpu_hash = 1;
+  for (u64 frame = 0; frame < 4; ++frame)
+  {
+    a.HashFrame(frame);
+    b.HashFrame(frame);
+  }
+
+  const StateHasher::Window& window_a = *a.hasher.GetWindow(0);
+  const StateHasher::Window& window_b = *b.hasher.GetWindow(0);
+  EXPECT_EQ(StateHasher::DescribeDifference(a.GetRegions(), window_a, window_b),
+            "ARAM 0x00020000-0x000200ff, CPU registers");
+}
+
+TEST(NetPlayStateHash, FramesCanBeHashedAgainUntilCommitted)
+{
+  Instance a(4, 3), b(4, 3);
+  for (u64 frame = 0; frame < 6; ++frame)
+    a.HashFrame(frame);
+  EXPECT_FALSE(a.hasher.PopCompletedWindow().has_value());
+
+  // Roll back to frame 2 and run again with a different state, as if a prediction was wrong.
+  a.mem1[PAGE_SIZE * 23] = 0xFF;
+  for (u64 frame = 2; frame < 6; ++frame)
+    a.HashFrame(frame);
+
+  // The other player predicted correctly.
+  b.mem1[PAGE_SIZE * 23] = 0xFF;
+  for (u64 frame = 0; frame < 6; ++frame)
+    b.HashFrame(frame);
+
+  EXPECT_FALSE(a.hasher.PopCompletedWindow().has_value());
+  a.HashFrame(6);
+  b.HashFrame(6);
+  ASSERT_EQ(a.hasher.PopCompletedWindow(), 0u);
+  ASSERT_EQ(b.hasher.PopCompletedWindow(), 0u);
+  EXPECT_EQ(a.hasher.GetWindow(0)->GetDigest(), b.hasher.GetWindow(0)->GetDigest());
+
+  // Completed windows don't change anymore.
+  const u64 digest = a.hasher.GetWindow(0)->GetDigest();
+  a.mem1[0] ^= 1;
+  a.HashFrame(0);
+  EXPECT_EQ(a.hasher.GetWindow(0)->GetDigest(), digest);
+}
+
+TEST(NetPlayStateHash, DropsOldWindows)
+{
+  Instance a(2, 0);
+  for (u64 frame = 0; frame < 2 * (StateHasher::NUM_KEPT_WINDOWS + 4); ++frame)
+    a.HashFrame(frame);
+
+  EXPECT_EQ(a.hasher.GetWindow(0), nullptr);
+  EXPECT_NE(a.hasher.GetWindow(StateHasher::NUM_KEPT_WINDOWS + 3), nullptr);
+}
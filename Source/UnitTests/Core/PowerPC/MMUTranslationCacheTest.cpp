@@ -0,0 +1,146 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 PAGE_TABLE_BASE = 0x00020000;
+constexpr u32 PAGE_TABLE_MASK = 0x0000ffff;
+
+constexpr u32 LOGICAL_ADDRESS = 0x10100000;
+constexpr u32 PHYSICAL_ADDRESS_A = 0x00100000;
+constexpr u32 PHYSICAL_ADDRESS_B = 0x00200000;
+
+constexpr u32 VSID_A = 123;
+constexpr u32 VSID_B = 456;
+
+class MMUTranslationCacheTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    SConfig::Init();
+    Core::System::GetInstance().GetMemory().Init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    Core::System::GetInstance().GetMemory().Shutdown();
+    SConfig::Shutdown();
+  }
+
+  void SetUp() override
+  {
+    // Also resets the TLB, the translation cache and its stats.
+    m_power_pc.Reset();
+
+    m_memory.Memset(PAGE_TABLE_BASE, 0, PAGE_TABLE_MASK + 1);
+    m_memory.Write_U32(0xAAAAAAAA, PHYSICAL_ADDRESS_A);
+    m_memory.Write_U32(0xBBBBBBBB, PHYSICAL_ADDRESS_B);
+
+    SetSR(VSID_A);
+
+    UReg_SDR1 sdr{};
+    sdr.htabmask = PAGE_TABLE_MASK >> 16;
+    sdr.htaborg = PAGE_TABLE_BASE >> 16;
+    m_ppc_state.spr[SPR_SDR] = sdr.Hex;
+    m_mmu.SDRUpdated();
+
+    m_ppc_state.msr.DR = 1;
+    m_power_pc.MSRUpdated();
+  }
+
+  void TearDown() override
+  {
+    m_ppc_state.msr.DR = 0;
+    m_power_pc.MSRUpdated();
+  }
+
+  void SetSR(u32 vsid)
+  {
+    UReg_SR sr{};
+    sr.VSID = vsid;
+    m_ppc_state.sr[LOGICAL_ADDRESS >> 28] = sr.Hex;
+    m_mmu.SRUpdated();
+  }
+
+  // Writes a PTE to the first slot of the primary PTEG, like the game would. The TLB and the
+  // translation cache are left alone.
+  void SetPTE(u32 vsid, u32 physical_address)
+  {
+    UPTE_Lo pte1{};
+    pte1.API = LOGICAL_ADDRESS >> 22;
+    pte1.VSID = vsid;
+    pte1.V = 1;
+
+    UPTE_Hi pte2{};
+    pte2.R = 1;
+    pte2.C = 1;
+    pte2.RPN = physical_address >> 12;
+
+    const u32 hash = vsid ^ (LOGICAL_ADDRESS >> 12);
+    const u32 pteg_address = ((hash << 6) & m_ppc_state.pagetable_mask) | PAGE_TABLE_BASE;
+    m_memory.Write_U32(pte1.Hex, pteg_address);
+    m_memory.Write_U32(pte2.Hex, pteg_address + 4);
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  Memory::MemoryManager& m_memory = m_system.GetMemory();
+  PowerPC::PowerPCManager& m_power_pc = m_system.GetPowerPC();
+  PowerPC::PowerPCState& m_ppc_state = m_system.GetPPCState();
+  PowerPC::MMU& m_mmu = m_system.GetMMU();
+};
+}  // namespace
+
+TEST_F(MMUTranslationCacheTest, CountsHitsAndTableWalks)
+{
+  SetPTE(VSID_A, PHYSICAL_ADDRESS_A);
+
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+  EXPECT_EQ(m_mmu.GetTranslationCacheStats().table_walks, 1u);
+  const u64 hits = m_mmu.GetTranslationCacheStats().hits;
+
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+  EXPECT_EQ(m_mmu.GetTranslationCacheStats().table_walks, 1u);
+  EXPECT_GT(m_mmu.GetTranslationCacheStats().hits, hits);
+}
+
+TEST_F(MMUTranslationCacheTest, TlbieInvalidates)
+{
+  SetPTE(VSID_A, PHYSICAL_ADDRESS_A);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+
+  // Like the TLB, the translation cache keeps the old mapping until tlbie.
+  SetPTE(VSID_A, PHYSICAL_ADDRESS_B);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+
+  const u64 invalidations = m_mmu.GetTranslationCacheStats().invalidations;
+  m_mmu.InvalidateTLBEntry(LOGICAL_ADDRESS);
+  EXPECT_GT(m_mmu.GetTranslationCacheStats().invalidations, invalidations);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xBBBBBBBBu);
+}
+
+TEST_F(MMUTranslationCacheTest, SegmentRegisterWriteInvalidates)
+{
+  SetPTE(VSID_A, PHYSICAL_ADDRESS_A);
+  SetPTE(VSID_B, PHYSICAL_ADDRESS_B);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+
+  // The cache is indexed by effective address, so it must not survive a VSID change.
+  const u64 invalidations = m_mmu.GetTranslationCacheStats().invalidations;
+  SetSR(VSID_B);
+  EXPECT_GT(m_mmu.GetTranslationCacheStats().invalidations, invalidations);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xBBBBBBBBu);
+
+  SetSR(VSID_A);
+  EXPECT_EQ(m_mmu.Read<u32>(LOGICAL_ADDRESS), 0xAAAAAAAAu);
+}
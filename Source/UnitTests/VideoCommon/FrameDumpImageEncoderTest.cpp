@@ -0,0 +1,203 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "VideoCommon/FrameDumpFFMpeg.h"
+#include "VideoCommon/FrameDumpImageEncoder.h"
+
+namespace
+{
+// An RGBA frame whose pixels encode the frame number and their position, with padding at the end
+// of each row like a mapped readback texture.
+struct SyntheticFrame
+{
+  SyntheticFrame(u32 number, int width_, int height_)
+      : width(width_), height(height_), stride(width_ * 4 + 12),
+        data(static_cast<size_t>(stride) * height_, 0xEE)
+  {
+    for (int y = 0; y < height; ++y)
+    {
+      for (int x = 0; x < width; ++x)
+      {
+        u8* pixel = &data[y * stride + x * 4];
+        pixel[0] = static_cast<u8>(number);
+        pixel[1] = static_cast<u8>(x);
+        pixel[2] = static_cast<u8>(y);
+        pixel[3] = 0xFF;
+      }
+    }
+  }
+
+  FrameData GetFrameData() const { return {data.data(), width, height, stride, {}}; }
+
+  std::vector<u8> GetRGB() const
+  {
+    std::vector<u8> rgb;
+    for (int y = 0; y < height; ++y)
+      for (int x = 0; x < width; ++x)
+        rgb.insert(rgb.end(), &data[y * stride + x * 4], &data[y * stride + x * 4 + 3]);
+    return rgb;
+  }
+
+  int width;
+  int height;
+  int stride;
+  std::vector<u8> data;
+};
+
+std::string GetFileName(u32 number)
+{
+  return fmt::format("framedump_{}.png", number);
+}
+
+// Records the frames that the encoder threads save, instead of writing them to disk.
+class SavedFrames
+{
+public:
+  FrameDumpImageEncoder::SaveFunction GetSaveFunction()
+  {
+    return [this](const std::string& file_name, std::span<const u8> rgb_data, u32 width,
+                  u32 height) {
+      EXPECT_EQ(rgb_data.size(), width * height * 3) << file_name;
+      std::lock_guard lk(m_lock);
+      EXPECT_EQ(m_frames.count(file_name), 0u) << file_name;
+      m_frames[file_name] = {rgb_data.begin(), rgb_data.end()};
+      return true;
+    };
+  }
+
+  std::map<std::string, std::vector<u8>> Get()
+  {
+    std::lock_guard lk(m_lock);
+    return m_frames;
+  }
+
+private:
+  std::mutex m_lock;
+  std::map<std::string, std::vector<u8>> m_frames;
+};
+}  // namespace
+
+TEST(FrameDumpImageEncoder, SavesEachFrameToItsFile)
+{
+  SavedFrames saved;
+  std::vector<SyntheticFrame> frames;
+  {
+    FrameDumpImageEncoder encoder(4, saved.GetSaveFunction());
+    for (u32 i = 0; i < 50; ++i)
+    {
+      // The frame is overwritten as soon as it was added, like the readback texture.
+      SyntheticFrame frame(i, 64 + i % 3, 48);
+      encoder.AddFrame(GetFileName(i), frame.GetFrameData());
+      frames.push_back(frame);
+      frame.data.assign(frame.data.size(), 0);
+    }
+
+    encoder.WaitForIdle();
+    const FrameDumpImageEncoder::Stats stats = encoder.GetStats();
+    EXPECT_EQ(stats.frames_queued, 50u);
+    EXPECT_EQ(stats.frames_failed, 0u);
+    EXPECT_LE(stats.peak_frames_in_flight, stats.max_frames_in_flight);
+    EXPECT_EQ(stats.max_frames_in_flight, 8u);
+  }
+
+  const std::map<std::string, std::vector<u8>> files = saved.Get();
+  ASSERT_EQ(files.size(), frames.size());
+  for (u32 i = 0; i < frames.size(); ++i)
+  {
+    const auto it = files.find(GetFileName(i));
+    ASSERT_NE(it, files.end()) << i;
+    EXPECT_EQ(it->second, frames[i].GetRGB()) << i;
+  }
+}
+
+TEST(FrameDumpImageEncoder, DestructionWaitsForQueuedFrames)
+{
+  SavedFrames saved;
+  {
+    FrameDumpImageEncoder encoder(2, saved.GetSaveFunction());
+    for (u32 i = 0; i < 4; ++i)
+      encoder.AddFrame(GetFileName(i), SyntheticFrame(i, 320, 240).GetFrameData());
+  }
+  EXPECT_EQ(saved.Get().size(), 4u);
+}
+
+TEST(FrameDumpImageEncoder, ReusesBuffersOfEncodedFrames)
+{
+  SavedFrames saved;
+  FrameDumpImageEncoder encoder(2, saved.GetSaveFunction());
+  for (u32 i = 0; i < 10; ++i)
+  {
+    // A frame of another size resizes the buffer instead of needing a new one.
+    const SyntheticFrame frame(i, i % 2 ? 32 : 64, 32);
+    encoder.AddFrame(GetFileName(i), frame.GetFrameData());
+    encoder.WaitForIdle();
+    EXPECT_EQ(saved.Get().at(GetFileName(i)), frame.GetRGB()) << i;
+  }
+
+  const FrameDumpImageEncoder::Stats stats = encoder.GetStats();
+  EXPECT_EQ(stats.buffers_created, 1u);
+  EXPECT_EQ(stats.frames_stalled, 0u);
+  EXPECT_EQ(stats.peak_frames_in_flight, 1u);
+}
+
+TEST(FrameDumpImageEncoder, StallsWhenAllEncodersAreBusy)
+{
+  Common::Event release;
+  SavedFrames saved;
+  FrameDumpImageEncoder encoder(1, [&, save = saved.GetSaveFunction()](
+                                       const std::string& file_name, std::span<const u8> rgb_data,
+                                       u32 width, u32 height) {
+    if (file_name == GetFileName(0))
+      release.Wait();
+    return save(file_name, rgb_data, width, height);
+  });
+
+  // The encoder is stuck on the first frame, and a second one may wait for it.
+  encoder.AddFrame(GetFileName(0), SyntheticFrame(0, 16, 16).GetFrameData());
+  encoder.AddFrame(GetFileName(1), SyntheticFrame(1, 16, 16).GetFrameData());
+  EXPECT_EQ(encoder.GetStats().frames_stalled, 0u);
+
+  std::thread dump_thread([&] {
+    encoder.AddFrame(GetFileName(2), SyntheticFrame(2, 16, 16).GetFrameData());
+  });
+  while (encoder.GetStats().frames_stalled == 0)
+    std::this_thread::yield();
+  // The third frame can't be queued until the first one is saved.
+  EXPECT_EQ(encoder.GetStats().frames_queued, 2u);
+  EXPECT_EQ(saved.Get().size(), 0u);
+
+  release.Set();
+  dump_thread.join();
+  encoder.WaitForIdle();
+
+  const FrameDumpImageEncoder::Stats stats = encoder.GetStats();
+  EXPECT_EQ(stats.frames_queued, 3u);
+  EXPECT_EQ(stats.frames_stalled, 1u);
+  EXPECT_EQ(stats.peak_frames_in_flight, 2u);
+  EXPECT_EQ(stats.max_frames_in_flight, 2u);
+  // The stalled frame reuses the buffer of the frame it waited for.
+  EXPECT_EQ(stats.buffers_created, 2u);
+  EXPECT_EQ(saved.Get().size(), 3u);
+}
+
+TEST(FrameDumpImageEncoder, CountsFailedFrames)
+{
+  FrameDumpImageEncoder encoder(2, [](const std::string& file_name, std::span<const u8>, u32,
+                                      u32) { return file_name != GetFileName(1); });
+  for (u32 i = 0; i < 3; ++i)
+    encoder.AddFrame(GetFileName(i), SyntheticFrame(i, 8, 8).GetFrameData());
+  encoder.WaitForIdle();
+  EXPECT_EQ(encoder.GetStats().frames_failed, 1u);
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/LatencyHistogram.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+double ToMs(DT value)
+{
+  return DT_ms(value).count();
+}
+}  // namespace
+
+TEST(LatencyHistogram, BucketsCoverAllValues)
+{
+  size_t previous_index = 0;
+  for (u64 value = 0; value < (u64{1} << 20); ++value)
+  {
+    const size_t index = LatencyHistogram::GetBucketIndex(value);
+    ASSERT_TRUE(index == previous_index || index == previous_index + 1) << value;
+    ASSERT_LE(value, LatencyHistogram::GetBucketMaxValue(index)) << value;
+    // Buckets are at most 1/32 as wide as the values in them.
+    ASSERT_LE(LatencyHistogram::GetBucketMaxValue(index) - value, value / 32) << value;
+    previous_index = index;
+  }
+
+  EXPECT_LT(LatencyHistogram::GetBucketIndex(~u64{0}), LatencyHistogram::NUM_BUCKETS);
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.TakePercentiles().count, 0u);
+
+  // 1000 frames between 1 ms and 1 s.
+  for (int i = 1; i <= 1000; ++i)
+    histogram.Record(std::chrono::milliseconds(i));
+
+  const LatencyHistogram::Percentiles percentiles = histogram.TakePercentiles();
+  EXPECT_EQ(percentiles.count, 1000u);
+  EXPECT_NEAR(ToMs(percentiles.p50), 500.0, 500.0 / 32);
+  EXPECT_NEAR(ToMs(percentiles.p95), 950.0, 950.0 / 32);
+  EXPECT_NEAR(ToMs(percentiles.p99), 990.0, 990.0 / 32);
+  EXPECT_EQ(percentiles.max, DT(1s));
+
+  // Taking the percentiles starts a new interval.
+  histogram.Record(16ms);
+  const LatencyHistogram::Percentiles next = histogram.TakePercentiles();
+  EXPECT_EQ(next.count, 1u);
+  EXPECT_EQ(next.p50, DT(16ms));
+  EXPECT_EQ(next.max, DT(16ms));
+}
+
+TEST(LatencyHistogram, RareStutterShowsInTail)
+{
+  LatencyHistogram histogram;
+  for (int i = 0; i < 990; ++i)
+    histogram.Record(16667us);
+  for (int i = 0; i < 10; ++i)
+    histogram.Record(100ms);
+
+  const LatencyHistogram::Percentiles percentiles = histogram.TakePercentiles();
+  EXPECT_NEAR(ToMs(percentiles.p50), 16.667, 16.667 / 32);
+  EXPECT_NEAR(ToMs(percentiles.p95), 16.667, 16.667 / 32);
+  EXPECT_NEAR(ToMs(percentiles.p99), 16.667, 16.667 / 32);
+  EXPECT_EQ(percentiles.max, DT(100ms));
+
+  histogram.Record(16667us);
+  histogram.Reset();
+  EXPECT_EQ(histogram.TakePercentiles().count, 0u);
+}
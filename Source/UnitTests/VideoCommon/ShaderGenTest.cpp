@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/UberShaderPixel.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+std::vector<std::string> GenerateAllUberShaders(APIType api_type,
+                                                const ShaderHostConfig& host_config)
+{
+  std::vector<std::string> shaders;
+  UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& uid) {
+    UberShader::PixelShaderUid cleared_uid = uid;
+    UberShader::ClearUnusedPixelShaderUidBits(api_type, host_config, &cleared_uid);
+    shaders.push_back(
+        UberShader::GenPixelShader(api_type, host_config, cleared_uid.GetUidData()).GetBuffer());
+  });
+  return shaders;
+}
+}  // namespace
+
+TEST(ShaderGen, RecycledBuffersStartEmpty)
+{
+  {
+    ShaderCode code;
+    code.Write("{}", std::string(100000, 'a'));
+  }
+
+  ShaderCode code;
+  EXPECT_TRUE(code.GetBuffer().empty());
+  code.Write("{{{}}}", 1);
+  code.WriteRaw("{}");
+  EXPECT_EQ(code.GetBuffer(), "{1}{}");
+
+  ShaderCode moved = std::move(code);
+  EXPECT_EQ(moved.GetBuffer(), "{1}{}");
+}
+
+TEST(ShaderGen, FragmentCacheGeneratesOncePerKey)
+{
+  ShaderCodeFragmentCache<int> cache;
+  int generated = 0;
+  const auto generate = [&](int key) {
+    return cache.Get(key, [&](ShaderCode& code) {
+      ++generated;
+      code.Write("fragment {}", key);
+    });
+  };
+
+  EXPECT_EQ(generate(1), "fragment 1");
+  EXPECT_EQ(generate(2), "fragment 2");
+  EXPECT_EQ(generate(1), "fragment 1");
+  EXPECT_EQ(generated, 2);
+}
+
+// Generates every ubershader UID for a few configurations, which doubles as a benchmark of shader
+// generation. The time is reported as a test property.
+TEST(ShaderGen, GeneratesAllUberShaderUids)
+{
+  Common::Timer timer;
+  timer.Start();
+
+  for (const APIType api_type : {APIType::OpenGL, APIType::Vulkan, APIType::D3D})
+  {
+    ShaderHostConfig host_config{};
+    host_config.backend_dynamic_sampler_indexing = false;
+    const std::vector<std::string> shaders = GenerateAllUberShaders(api_type, host_config);
+    ASSERT_FALSE(shaders.empty());
+    for (const std::string& shader : shaders)
+      EXPECT_NE(shader.find("int idot(int3 x, int3 y)"), std::string::npos);
+
+    // Memoized parts of the shaders must not leak into other configurations.
+    EXPECT_EQ(GenerateAllUberShaders(api_type, host_config), shaders);
+    host_config.backend_dynamic_sampler_indexing = true;
+    const std::vector<std::string> dynamic_indexing_shaders =
+        GenerateAllUberShaders(api_type, host_config);
+    ASSERT_EQ(dynamic_indexing_shaders.size(), shaders.size());
+    for (size_t i = 0; i < shaders.size(); ++i)
+      EXPECT_NE(dynamic_indexing_shaders[i], shaders[i]);
+  }
+
+  RecordProperty("GenerationTimeMs", static_cast<int>(timer.ElapsedMs()));
+}
+
+TEST(ShaderGen, PixelShaderHeaderDependsOnBoundingBox)
+{
+  const ShaderHostConfig host_config{};
+  pixel_shader_uid_data uid_data{};
+
+  const std::string without_bbox =
+      GeneratePixelShaderCode(APIType::Vulkan, host_config, &uid_data, {}).GetBuffer();
+  uid_data.bounding_box = true;
+  const std::string with_bbox =
+      GeneratePixelShaderCode(APIType::Vulkan, host_config, &uid_data, {}).GetBuffer();
+
+  EXPECT_EQ(without_bbox.find("BBox"), std::string::npos);
+  EXPECT_NE(with_bbox.find("BBox"), std::string::npos);
+}
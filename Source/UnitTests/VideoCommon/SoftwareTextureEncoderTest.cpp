@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TextureEncoder.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TextureCacheBase.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+constexpr EFBCopyFormat COLOR_FORMATS[] = {
+    EFBCopyFormat::R4,  EFBCopyFormat::R8_0x1, EFBCopyFormat::RA4,    EFBCopyFormat::RA8,
+    EFBCopyFormat::R8,  EFBCopyFormat::A8,     EFBCopyFormat::G8,     EFBCopyFormat::B8,
+    EFBCopyFormat::RG8, EFBCopyFormat::GB8,    EFBCopyFormat::RGB565, EFBCopyFormat::RGB5A3,
+    EFBCopyFormat::RGBA8,
+};
+
+constexpr EFBCopyFormat DEPTH_FORMATS[] = {
+    EFBCopyFormat::R4, EFBCopyFormat::R8_0x1, EFBCopyFormat::R8,  EFBCopyFormat::G8,
+    EFBCopyFormat::B8, EFBCopyFormat::RG8,    EFBCopyFormat::GB8, EFBCopyFormat::RGBA8,
+};
+
+class SoftwareTextureEncoderTest : public ::testing::Test
+{
+protected:
+  SoftwareTextureEncoderTest()
+  {
+    // Copies may read a block past the right and bottom edges of the source rectangle.
+    m_efb.resize(EFB_WIDTH * (EFB_HEIGHT + 8) * 3);
+    for (u8& byte : m_efb)
+      byte = static_cast<u8>(m_rng());
+  }
+
+  void ExpectSIMDMatchesGeneric(PixelFormat efb_format, EFBCopyFormat copy_format, bool yuv)
+  {
+    std::memset(&bpmem, 0, sizeof(bpmem));
+
+    for (const bool scale_by_half : {false, true})
+    {
+      for (int i = 0; i < 8; i++)
+      {
+        const u32 max_size = scale_by_half ? 2 * 128 : 128;
+        const u32 width = std::uniform_int_distribution<u32>(1, max_size)(m_rng);
+        const u32 height = std::uniform_int_distribution<u32>(1, max_size)(m_rng);
+        bpmem.copyTexSrcWH.x = width - 1;
+        bpmem.copyTexSrcWH.y = height - 1;
+        bpmem.triggerEFBCopy.half_scale = scale_by_half;
+
+        // Enough space for a row of blocks of up to 64 bytes, each 4 texels wide.
+        const u32 blocks_per_row = (width >> scale_by_half) / 4 + 1;
+        bpmem.copyDestStride = blocks_per_row * 2;
+        const size_t dst_size = ((height >> scale_by_half) / 4 + 1) * blocks_per_row * 64;
+
+        const u32 x = std::uniform_int_distribution<u32>(0, EFB_WIDTH - width)(m_rng);
+        const u32 y = std::uniform_int_distribution<u32>(0, EFB_HEIGHT - height)(m_rng);
+        const u8* src = &m_efb[(y * EFB_WIDTH + x) * 3];
+
+        const EFBCopyParams params(efb_format, copy_format, efb_format == PixelFormat::Z24, yuv,
+                                   false, false, false);
+        std::vector<u8> generic(dst_size, 0xcd);
+        std::vector<u8> simd(dst_size, 0xcd);
+        TextureEncoder::EncodeEfbCopy(generic.data(), src, params, scale_by_half, false);
+        TextureEncoder::EncodeEfbCopy(simd.data(), src, params, scale_by_half, true);
+
+        const auto mismatch = std::ranges::mismatch(generic, simd);
+        EXPECT_TRUE(mismatch.in1 == generic.end())
+            << fmt::format("{} {} yuv={} half={} {}x{} at {},{}: differs at byte {}", efb_format,
+                           copy_format, yuv, scale_by_half, width, height, x, y,
+                           mismatch.in1 - generic.begin());
+      }
+    }
+  }
+
+  std::vector<u8> m_efb;
+  std::mt19937 m_rng{1234};
+};
+}  // namespace
+
+TEST_F(SoftwareTextureEncoderTest, ColorFormats)
+{
+  for (const PixelFormat efb_format :
+       {PixelFormat::RGBA6_Z24, PixelFormat::RGB8_Z24, PixelFormat::RGB565_Z16})
+  {
+    for (const EFBCopyFormat copy_format : COLOR_FORMATS)
+    {
+      ExpectSIMDMatchesGeneric(efb_format, copy_format, false);
+      ExpectSIMDMatchesGeneric(efb_format, copy_format, true);
+    }
+  }
+}
+
+TEST_F(SoftwareTextureEncoderTest, DepthFormats)
+{
+  for (const EFBCopyFormat copy_format : DEPTH_FORMATS)
+    ExpectSIMDMatchesGeneric(PixelFormat::Z24, copy_format, false);
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/TransformUnit.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace
+{
+class SoftwareTransformTest : public ::testing::Test
+{
+protected:
+  float RandomFloat() { return std::uniform_real_distribution<float>(-4.0f, 4.0f)(m_rng); }
+  u32 RandomInt(u32 max) { return std::uniform_int_distribution<u32>(0, max)(m_rng); }
+
+  void RandomizeXFMemory(bool perspective)
+  {
+    std::memset(&xfmem, 0, sizeof(xfmem));
+    for (float& value : xfmem.posMatrices)
+      value = RandomFloat();
+    for (float& value : xfmem.normalMatrices)
+      value = RandomFloat();
+    for (float& value : xfmem.postMatrices)
+      value = RandomFloat();
+    for (float& value : xfmem.projection.rawProjection)
+      value = RandomFloat();
+    xfmem.projection.type =
+        perspective ? ProjectionType::Perspective : ProjectionType::Orthographic;
+
+    for (Light& light : xfmem.lights)
+    {
+      for (u8& component : light.color)
+        component = static_cast<u8>(RandomInt(255));
+      for (int i = 0; i < 3; i++)
+      {
+        light.cosatt[i] = RandomFloat();
+        light.distatt[i] = RandomFloat();
+        light.dpos[i] = RandomFloat();
+        light.ddir[i] = RandomFloat();
+      }
+    }
+    for (u32 chan = 0; chan < NUM_XF_COLOR_CHANNELS; chan++)
+    {
+      xfmem.ambColor[chan] = RandomInt(0xffffffff);
+      xfmem.matColor[chan] = RandomInt(0xffffffff);
+      for (LitChannel* channel : {&xfmem.color[chan], &xfmem.alpha[chan]})
+      {
+        channel->hex = RandomInt(0xffffffff);
+        channel->diffusefunc = static_cast<DiffuseFunc>(RandomInt(2));
+      }
+    }
+
+    xfmem.numTexGen.numTexGens = 2;
+    xfmem.texMtxInfo[0].texgentype = TexGenType::Regular;
+    xfmem.texMtxInfo[0].sourcerow = SourceRow::Normal;
+    xfmem.texMtxInfo[1].texgentype = TexGenType::EmbossMap;
+    xfmem.texMtxInfo[1].embosssourceshift = 0;
+    xfmem.texMtxInfo[1].embosslightshift = 2;
+    std::memset(&bpmem, 0, sizeof(bpmem));
+  }
+
+  InputVertexData RandomVertex(u8 posMtx)
+  {
+    InputVertexData vertex{};
+    vertex.posMtx = posMtx;
+    vertex.position = Common::Vec3(RandomFloat(), RandomFloat(), RandomFloat());
+    for (Common::Vec3& normal : vertex.normal)
+      normal = Common::Vec3(RandomFloat(), RandomFloat(), RandomFloat());
+    for (auto& color : vertex.color)
+    {
+      for (u8& component : color)
+        component = static_cast<u8>(RandomInt(255));
+    }
+    return vertex;
+  }
+
+  static void ExpectBatchMatchesScalar(const std::array<InputVertexData, 4>& vertices, u32 count)
+  {
+    std::array<OutputVertexData, 4> batch{};
+    TransformUnit::TransformBatch(vertices.data(), batch.data(), count);
+
+    for (u32 i = 0; i < count; i++)
+    {
+      OutputVertexData scalar{};
+      TransformUnit::TransformPosition(&vertices[i], &scalar);
+      TransformUnit::TransformNormal(&vertices[i], &scalar);
+      TransformUnit::TransformColor(&vertices[i], &scalar);
+      TransformUnit::TransformTexCoord(&vertices[i], &scalar);
+
+      EXPECT_EQ(std::memcmp(&scalar, &batch[i], sizeof(OutputVertexData)), 0) << "vertex " << i;
+    }
+  }
+
+  std::mt19937 m_rng{0x5f3759df};
+};
+}  // namespace
+
+TEST_F(SoftwareTransformTest, BatchMatchesScalar)
+{
+  for (int iteration = 0; iteration < 1000; iteration++)
+  {
+    RandomizeXFMemory(iteration % 2 == 0);
+
+    // Batches where all vertices share a matrix and ones where they don't.
+    const bool same_matrix = iteration % 4 < 2;
+    const u8 posMtx = static_cast<u8>(RandomInt(31));
+    std::array<InputVertexData, 4> vertices;
+    for (InputVertexData& vertex : vertices)
+      vertex = RandomVertex(same_matrix ? posMtx : static_cast<u8>(RandomInt(63)));
+
+    ExpectBatchMatchesScalar(vertices, 1 + iteration % 4);
+  }
+}
+
+TEST_F(SoftwareTransformTest, ZeroLightDirection)
+{
+  RandomizeXFMemory(true);
+
+  // With the identity matrix, vertices at the origin are at the position of light 3, so the
+  // direction to the light can't be normalized.
+  std::fill(std::begin(xfmem.posMatrices), std::end(xfmem.posMatrices), 0.0f);
+  xfmem.posMatrices[0] = xfmem.posMatrices[5] = xfmem.posMatrices[10] = 1;
+  std::fill(std::begin(xfmem.lights[3].dpos), std::end(xfmem.lights[3].dpos), 0.0f);
+  for (LitChannel* channel : {&xfmem.color[0], &xfmem.alpha[0]})
+  {
+    channel->enablelighting = true;
+    channel->lightMask0_3 = 0b1000;
+    channel->lightMask4_7 = 0;
+    channel->attnfunc = AttenuationFunc::Dir;
+  }
+
+  std::array<InputVertexData, 4> vertices;
+  for (InputVertexData& vertex : vertices)
+    vertex = RandomVertex(0);
+  vertices[1].position = Common::Vec3(0, 0, 0);
+  vertices[3].position = Common::Vec3(0, 0, 0);
+
+  ExpectBatchMatchesScalar(vertices, 4);
+}
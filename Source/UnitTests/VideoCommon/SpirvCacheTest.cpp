@@ -0,0 +1,189 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/SpirvCache.h"
+
+using SPIRV::CompileCache;
+
+namespace
+{
+constexpr u64 ENTRY_OVERHEAD = 32;
+
+std::vector<u32> MakeCode(u32 seed, size_t size)
+{
+  std::vector<u32> code(size);
+  for (size_t i = 0; i < size; ++i)
+    code[i] = seed * 0x9E3779B9 + static_cast<u32>(i);
+  return code;
+}
+
+CompileCache::Key MakeKey(u32 shader)
+{
+  return CompileCache::ComputeKey(fmt::format("void main() {{ /* {} */ }}", shader), "options");
+}
+
+class SpirvCacheTest : public testing::Test
+{
+protected:
+  SpirvCacheTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/SPIRV.cache") {}
+  ~SpirvCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST(SpirvCache, KeyDependsOnSourceAndOptions)
+{
+  EXPECT_EQ(CompileCache::ComputeKey("source", "options"),
+            CompileCache::ComputeKey("source", "options"));
+  EXPECT_NE(CompileCache::ComputeKey("source", "options"),
+            CompileCache::ComputeKey("source2", "options"));
+  EXPECT_NE(CompileCache::ComputeKey("source", "options"),
+            CompileCache::ComputeKey("source", "options2"));
+  // Moving characters between the options and the source must change the key.
+  EXPECT_NE(CompileCache::ComputeKey("ab", "c"), CompileCache::ComputeKey("b", "ca"));
+}
+
+TEST_F(SpirvCacheTest, AvoidsCompilingAgain)
+{
+  // A stream of shaders in which most shaders were already seen, like the draws of a fifolog.
+  std::vector<u32> shaders;
+  for (u32 i = 0; i < 1000; ++i)
+    shaders.push_back((i * 7) % 100);
+
+  u32 compiles = 0;
+  auto run = [&](CompileCache& cache) {
+    for (const u32 shader : shaders)
+    {
+      const CompileCache::Key key = MakeKey(shader);
+      if (const auto code = cache.Lookup(key))
+      {
+        EXPECT_EQ(*code, MakeCode(shader, 64 + shader));
+        continue;
+      }
+      ++compiles;
+      cache.Insert(key, MakeCode(shader, 64 + shader));
+    }
+  };
+
+  {
+    CompileCache cache(1 << 20);
+    EXPECT_FALSE(cache.Load(m_path));
+    run(cache);
+    EXPECT_EQ(compiles, 100u);
+    EXPECT_EQ(cache.GetStats().hits, 900u);
+    EXPECT_EQ(cache.GetEntryCount(), 100u);
+    EXPECT_TRUE(cache.Save());
+  }
+
+  // Nothing has to be compiled when the same shaders are used again, e.g. by another game.
+  compiles = 0;
+  CompileCache cache(1 << 20);
+  EXPECT_TRUE(cache.Load(m_path));
+  EXPECT_EQ(cache.GetEntryCount(), 100u);
+  run(cache);
+  EXPECT_EQ(compiles, 0u);
+  EXPECT_EQ(cache.GetStats().misses, 0u);
+
+  // Entries keep working after they have been moved to the new file.
+  EXPECT_TRUE(cache.Save());
+  run(cache);
+  EXPECT_EQ(compiles, 0u);
+}
+
+TEST_F(SpirvCacheTest, EvictsLeastRecentlyUsed)
+{
+  const u64 entry_size = ENTRY_OVERHEAD + 256 * sizeof(u32);
+  CompileCache cache(entry_size * 8);
+  for (u32 shader = 0; shader < 8; ++shader)
+    cache.Insert(MakeKey(shader), MakeCode(shader, 256));
+  EXPECT_EQ(cache.GetSize(), entry_size * 8);
+
+  // Shader 0 is now the most recently used one.
+  EXPECT_TRUE(cache.Lookup(MakeKey(0)));
+  cache.Insert(MakeKey(8), MakeCode(8, 256));
+
+  EXPECT_LE(cache.GetSize(), entry_size * 7);
+  EXPECT_GE(cache.GetStats().evictions, 2u);
+  EXPECT_TRUE(cache.Lookup(MakeKey(0)));
+  EXPECT_TRUE(cache.Lookup(MakeKey(8)));
+  EXPECT_FALSE(cache.Lookup(MakeKey(1)));
+  EXPECT_FALSE(cache.Lookup(MakeKey(2)));
+}
+
+TEST_F(SpirvCacheTest, LoadKeepsMostRecentlyUsedWithinLimit)
+{
+  const u64 entry_size = ENTRY_OVERHEAD + 16 * sizeof(u32);
+  {
+    CompileCache cache(entry_size * 4);
+    cache.Load(m_path);
+    for (u32 shader = 0; shader < 4; ++shader)
+      cache.Insert(MakeKey(shader), MakeCode(shader, 16));
+    EXPECT_TRUE(cache.Lookup(MakeKey(1)));
+    EXPECT_TRUE(cache.Save());
+  }
+
+  // A smaller limit only keeps the entries that were used last.
+  CompileCache cache(entry_size * 2);
+  EXPECT_TRUE(cache.Load(m_path));
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.Lookup(MakeKey(1)), MakeCode(1, 16));
+  EXPECT_EQ(cache.Lookup(MakeKey(3)), MakeCode(3, 16));
+  EXPECT_FALSE(cache.Lookup(MakeKey(0)));
+}
+
+TEST_F(SpirvCacheTest, OnlyRewritesFileWhenEntriesChange)
+{
+  {
+    CompileCache cache(1 << 20);
+    cache.Load(m_path);
+    cache.Insert(MakeKey(0), MakeCode(0, 16));
+    cache.Insert(MakeKey(1), MakeCode(1, 16));
+    EXPECT_TRUE(cache.Save());
+  }
+
+  // Saving fails from now on if the cache tries to write the file.
+  ASSERT_TRUE(File::CreateDir(m_path + ".tmp"));
+
+  CompileCache cache(1 << 20);
+  EXPECT_TRUE(cache.Load(m_path));
+  EXPECT_TRUE(cache.Lookup(MakeKey(0)));
+  EXPECT_TRUE(cache.Lookup(MakeKey(1)));
+  EXPECT_TRUE(cache.Save());
+
+  cache.Insert(MakeKey(2), MakeCode(2, 16));
+  EXPECT_FALSE(cache.Save());
+}
+
+TEST_F(SpirvCacheTest, IgnoresInvalidFile)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_path, "not a cache"));
+  CompileCache cache(1 << 20);
+  EXPECT_FALSE(cache.Load(m_path));
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+
+  cache.Insert(MakeKey(0), MakeCode(0, 16));
+  EXPECT_TRUE(cache.Save());
+  CompileCache reloaded(1 << 20);
+  EXPECT_TRUE(reloaded.Load(m_path));
+  EXPECT_EQ(reloaded.Lookup(MakeKey(0)), MakeCode(0, 16));
+}
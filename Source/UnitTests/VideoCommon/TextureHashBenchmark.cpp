@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <xxhash.h>
+#ifdef XXHASH_X86_DISPATCH
+#define XXH_DISPATCH_DISABLE_REPLACE
+#include <xxh_x86dispatch.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+// Compares the texture cache's full hashes. The timings are only printed, as they depend on the
+// machine, so the benchmark is disabled by default. Run it with:
+//   tests --gtest_also_run_disabled_tests --gtest_filter=TextureHashBenchmark.*
+
+namespace
+{
+constexpr u32 SIZES[] = {2 * 1024, 32 * 1024, 512 * 1024, 2 * 1024 * 1024};
+
+std::vector<u8> MakeTextureData(u32 size)
+{
+  std::vector<u8> data(size);
+  u32 state = 0x12345678;
+  for (u8& byte : data)
+  {
+    state = state * 1664525 + 1013904223;
+    byte = static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+
+template <typename Hash>
+double MeasureNanoseconds(const std::vector<u8>& data, Hash hash)
+{
+  // Hash roughly 1 GiB per measurement, so that small sizes aren't dominated by timer overhead.
+  const u32 iterations = std::max<u32>(16, (1u << 30) / static_cast<u32>(data.size()));
+
+  u64 result = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 i = 0; i < iterations; ++i)
+    result += hash(data.data(), static_cast<u32>(data.size()));
+  const auto end = std::chrono::steady_clock::now();
+
+  // Keeps the loop from being optimized out.
+  EXPECT_NE(result, 1u);
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+}  // namespace
+
+#ifdef XXHASH_X86_DISPATCH
+TEST(TextureHashBenchmark, DispatchMatchesBaseline)
+{
+  // Texture cache entries must not depend on which code path the dispatcher picks.
+  for (u32 size : SIZES)
+  {
+    const std::vector<u8> data = MakeTextureData(size);
+    EXPECT_EQ(XXH3_64bits_dispatch(data.data(), size), XXH3_64bits(data.data(), size)) << size;
+  }
+}
+#endif
+
+TEST(TextureHashBenchmark, DISABLED_FullHashes)
+{
+  fmt::print("{:>10} {:>12} {:>12} {:>12}\n", "size", "GetHash64", "XXH3", "XXH3 best");
+  for (u32 size : SIZES)
+  {
+    const std::vector<u8> data = MakeTextureData(size);
+    const double get_hash64 = MeasureNanoseconds(
+        data, [](const u8* src, u32 len) { return Common::GetHash64(src, len, 0); });
+    // Without the dispatcher, this is whatever the compiler targets, which is SSE2 on x86-64.
+    const double xxh3 =
+        MeasureNanoseconds(data, [](const u8* src, u32 len) { return XXH3_64bits(src, len); });
+#ifdef XXHASH_X86_DISPATCH
+    const double xxh3_best = MeasureNanoseconds(
+        data, [](const u8* src, u32 len) { return XXH3_64bits_dispatch(src, len); });
+#else
+    const double xxh3_best = xxh3;
+#endif
+    fmt::print("{:>9}K {:>10.0f}ns {:>10.0f}ns {:>10.0f}ns\n", size / 1024, get_hash64, xxh3,
+               xxh3_best);
+  }
+}
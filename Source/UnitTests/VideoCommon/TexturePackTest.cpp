@@ -0,0 +1,169 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TexturePack.h"
+
+using VideoCommon::CustomTextureData;
+using VideoCommon::TexturePack;
+using VideoCommon::TexturePackWriter;
+
+namespace
+{
+CustomTextureData::ArraySlice::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height,
+                                               size_t size, u8 seed)
+{
+  CustomTextureData::ArraySlice::Level level;
+  level.data.reset(size);
+  for (size_t i = 0; i < size; i++)
+    level.data.data()[i] = static_cast<u8>(seed + i);
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  return level;
+}
+
+class TexturePackTest : public testing::Test
+{
+protected:
+  TexturePackTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/pack.dtp") {}
+  ~TexturePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(TexturePackTest, RoundTrip)
+{
+  CustomTextureData::ArraySlice rgba;
+  rgba.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 2, 4 * 2 * 4, 1));
+  rgba.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 2, 1, 2 * 1 * 4, 2));
+  CustomTextureData::ArraySlice bc1;
+  bc1.m_levels.push_back(MakeLevel(AbstractTextureFormat::DXT1, 8, 8, 4 * 8, 3));
+
+  TexturePackWriter writer;
+  ASSERT_TRUE(writer.Open(m_path));
+  ASSERT_TRUE(writer.AddTexture("tex1_4x2_0123456789abcdef_3", false, rgba));
+  ASSERT_TRUE(writer.AddTexture("tex1_8x8_m_fedcba9876543210_14", true, bc1));
+  ASSERT_TRUE(writer.Finish());
+
+  TexturePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+  ASSERT_EQ(pack.GetTextureCount(), 2u);
+  EXPECT_EQ(pack.GetTextureName(0), "tex1_4x2_0123456789abcdef_3");
+  EXPECT_FALSE(pack.HasArbitraryMipmaps(0));
+  EXPECT_EQ(pack.GetTextureName(1), "tex1_8x8_m_fedcba9876543210_14");
+  EXPECT_TRUE(pack.HasArbitraryMipmaps(1));
+
+  for (const auto& [index, expected] : {std::pair{0, &rgba}, std::pair{1, &bc1}})
+  {
+    CustomTextureData data;
+    ASSERT_TRUE(pack.LoadTexture(index, &data));
+    ASSERT_EQ(data.m_slices.size(), 1u);
+    const auto& levels = data.m_slices[0].m_levels;
+    ASSERT_EQ(levels.size(), expected->m_levels.size());
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+      const auto& level = levels[i];
+      const auto& expected_level = expected->m_levels[i];
+      EXPECT_EQ(level.format, expected_level.format);
+      EXPECT_EQ(level.width, expected_level.width);
+      EXPECT_EQ(level.height, expected_level.height);
+      EXPECT_EQ(level.row_length, expected_level.row_length);
+      EXPECT_TRUE(std::ranges::equal(level.data, expected_level.data));
+    }
+  }
+}
+
+TEST_F(TexturePackTest, UnfinishedPackFailsToOpen)
+{
+  CustomTextureData::ArraySlice slice;
+  slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 1, 1, 4, 0));
+
+  {
+    TexturePackWriter writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    ASSERT_TRUE(writer.AddTexture("tex1_1x1_0000000000000000_3", false, slice));
+  }
+  TexturePack pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
+
+TEST_F(TexturePackTest, TruncatedPackFailsToOpen)
+{
+  CustomTextureData::ArraySlice slice;
+  slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 16, 16, 16 * 16 * 4, 0));
+
+  TexturePackWriter writer;
+  ASSERT_TRUE(writer.Open(m_path));
+  ASSERT_TRUE(writer.AddTexture("tex1_16x16_0000000000000000_3", false, slice));
+  ASSERT_TRUE(writer.Finish());
+
+  const u64 size = File::GetSize(m_path);
+  {
+    File::IOFile file(m_path, "r+b");
+    ASSERT_TRUE(file.Resize(size - 1));
+  }
+  TexturePack pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
+
+TEST_F(TexturePackTest, UnknownFormatFailsToOpen)
+{
+  CustomTextureData::ArraySlice slice;
+  slice.m_levels.push_back(MakeLevel(static_cast<AbstractTextureFormat>(0x100), 1, 1, 4, 0));
+
+  TexturePackWriter writer;
+  ASSERT_TRUE(writer.Open(m_path));
+  ASSERT_TRUE(writer.AddTexture("tex1_1x1_0000000000000000_3", false, slice));
+  ASSERT_TRUE(writer.Finish());
+
+  TexturePack pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
+
+TEST_F(TexturePackTest, ShortLevelFailsToOpen)
+{
+  struct ShortLevel
+  {
+    AbstractTextureFormat format;
+    u32 size;
+    size_t data_size;
+  };
+  // One byte short of the pixels of a 4x4 RGBA8 level, and of the 2x2 blocks of an 8x8 DXT1 one.
+  for (const ShortLevel& short_level : {ShortLevel{AbstractTextureFormat::RGBA8, 4, 4 * 4 * 4 - 1},
+                                        ShortLevel{AbstractTextureFormat::DXT1, 8, 2 * 2 * 8 - 1}})
+  {
+    CustomTextureData::ArraySlice slice;
+    slice.m_levels.push_back(MakeLevel(short_level.format, short_level.size, short_level.size,
+                                       short_level.data_size, 0));
+
+    TexturePackWriter writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    ASSERT_TRUE(writer.AddTexture("tex1_4x4_0000000000000000_3", false, slice));
+    ASSERT_TRUE(writer.Finish());
+
+    TexturePack pack;
+    EXPECT_FALSE(pack.Open(m_path));
+  }
+}